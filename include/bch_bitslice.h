@@ -0,0 +1,65 @@
+/**
+ * @file bch_bitslice.h
+ * @brief Bitsliced BCH(250,202) encoder (bulk parity for many frames)
+ *
+ * Encodes BCH_SLICE_FRAMES frames at once. Data is bit-position major:
+ * lane i holds information bit i of every frame, one frame per bit of
+ * the lane. A parity bit is then the XOR of the lanes of the information
+ * bits whose syndrome column (x^(48+201-i) mod g(x), derived from
+ * BCH_GENERATOR_POLY) contains it: ~24 lane XORs per parity bit, with no
+ * shifts, tables or branches per frame.
+ * - 64-bit lanes (64 frames) everywhere
+ * - 128-bit lanes (NEON, SSE2) or 256-bit lanes (AVX2) when available
+ *
+ * bch_slice_parity() wraps the sliced core for frame-major packed data:
+ * 64×64 bit transposes in and out. Words equal in all 64 frames of a block
+ * (fields held fixed while enumerating) are broadcast instead of transposed.
+ */
+
+#ifndef BCH_BITSLICE_H
+#define BCH_BITSLICE_H
+
+#include <stdint.h>
+#include "t018_protocol.h"
+
+#if defined(__AVX2__)
+#define BCH_SLICE_WORDS         4           // 256-bit lanes
+#elif defined(__ARM_NEON) || defined(__SSE2__)
+#define BCH_SLICE_WORDS         2           // 128-bit lanes
+#else
+#define BCH_SLICE_WORDS         1
+#endif
+
+#define BCH_SLICE_FRAMES        (64 * BCH_SLICE_WORDS)  // Frames per encode
+#define BCH_SLICE_INFO_WORDS    4           // Packed information bits per frame (202 of 256)
+
+// One bit position of BCH_SLICE_FRAMES frames (element e: frames 64e..64e+63)
+typedef uint64_t bch_lane_t __attribute__((vector_size(8 * BCH_SLICE_WORDS)));
+
+/**
+ * @brief Encode BCH_SLICE_FRAMES frames
+ * @param info Information bit lanes (info[i] = bit i, T.018 order)
+ * @param parity Output parity lanes (parity[j] = j-th transmitted parity bit)
+ */
+void bch_slice_encode(const bch_lane_t info[BCH_INFO_BITS], bch_lane_t parity[BCH_PARITY_BITS]);
+
+/**
+ * @brief Transpose a 64×64 bit matrix in place
+ * @param m Rows, bit 63 = column 0
+ *
+ * Afterwards bit 63-c of m[r] is the former bit 63-r of m[c]: 64 frame
+ * words become 64 lanes (frame r at bit 63-r) and back.
+ */
+void bch_slice_transpose64(uint64_t m[64]);
+
+/**
+ * @brief BCH(250,202) parity of packed frames
+ * @param info count × BCH_SLICE_INFO_WORDS words per frame, information bit 0
+ *             in bit 63 of the first word (bits past 201 ignored)
+ * @param count Number of frames (any; the last block is zero padded)
+ * @param parity Output, one word per frame: 48 parity bits, first
+ *               transmitted bit in bit 47 (as t018_bch_parity_packed())
+ */
+void bch_slice_parity(const uint64_t *info, uint32_t count, uint64_t *parity);
+
+#endif // BCH_BITSLICE_H
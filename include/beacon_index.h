@@ -0,0 +1,129 @@
+/**
+ * @file beacon_index.h
+ * @brief Decoded-beacon index with time-windowed deduplication
+ *
+ * Keeps one record per 23 HEX beacon ID seen in a stream:
+ * - Open-addressing hash table (linear probing, load <= 0.5) over a fixed
+ *   entry pool: no allocation after init, O(1) lookups
+ * - Copies of one burst within the dedup window (neighbouring channels,
+ *   several receivers) are reported as duplicates and not counted
+ * - Records not seen for the expiry time are dropped by a timing wheel of
+ *   BEACON_INDEX_BUCKETS buckets, amortized O(1) per observation
+ * - Per-beacon burst count, first/last time and last position
+ *
+ * About 56 bytes per beacon: 100k IDs fit in ~6 MB. Not thread-safe
+ * (callers serialize, as the receiver's report path does).
+ */
+
+#ifndef BEACON_INDEX_H
+#define BEACON_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "t018_protocol.h"
+
+#define BEACON_INDEX_BUCKETS    64          // Timing wheel slots per expiry period
+#define BEACON_INDEX_NONE       0xFFFFFFFFu // Empty list link
+
+// Per-beacon record
+typedef struct {
+    t018_beacon_id_t id;
+    double first_seen;                      // Stream time of the first burst (s)
+    double last_seen;                       // Stream time of the latest burst (s)
+    uint32_t bursts;                        // Bursts counted (duplicates excluded), 0 = unused
+    uint32_t next;                          // Timing wheel or free list link
+    float latitude;                         // Last decoded position (degrees)
+    float longitude;
+} beacon_entry_t;
+
+// Outcome of an observation
+typedef enum {
+    BEACON_NEW = 0,                         // First burst of this ID
+    BEACON_REPEAT = 1,                      // Known ID, new burst
+    BEACON_DUPLICATE = 2,                   // Same burst seen again within the dedup window
+    BEACON_FULL = 3                         // New ID but the index is full (not tracked)
+} beacon_event_t;
+
+// Index state
+typedef struct {
+    beacon_entry_t *entries;                // Entry pool
+    uint32_t *slots;                        // Hash table: entry index + 1, 0 = empty
+    uint32_t capacity;                      // Pool size
+    uint32_t mask;                          // Hash table size - 1
+    uint32_t count;                         // Live entries
+    uint32_t free_head;                     // Recycled entries
+    uint32_t unused;                        // Entries never handed out (from here on)
+
+    double expiry;                          // Drop records idle for this long (s)
+    double dedup_window;                    // Same ID within this time is one burst (s)
+    double bucket_width;                    // expiry / BEACON_INDEX_BUCKETS
+    int64_t tick;                           // Latest wheel tick processed
+    uint32_t wheel[BEACON_INDEX_BUCKETS];   // Entry lists by tick of insertion/last check
+
+    uint64_t observed;                      // Observations (all outcomes)
+    uint64_t duplicates;                    // BEACON_DUPLICATE outcomes
+    uint64_t expired;                       // Records dropped by the wheel
+    uint64_t rejected;                      // BEACON_FULL outcomes
+} beacon_index_t;
+
+/**
+ * @brief Initialize an empty index
+ * @param idx Index state
+ * @param capacity Maximum simultaneous beacons
+ * @param expiry Idle time before a record is dropped (s, > 0)
+ * @param dedup_window Observations of one ID closer than this are one burst (s)
+ * @return 0 on success, -1 on error
+ */
+int beacon_index_init(beacon_index_t *idx, uint32_t capacity, double expiry, double dedup_window);
+
+/**
+ * @brief Record a decoded burst
+ * @param idx Index state
+ * @param id Beacon ID
+ * @param t Stream time of the burst (s, roughly non-decreasing)
+ * @param msg Decoded fields (position), may be NULL
+ * @param entry Output: record of this ID (NULL when BEACON_FULL), may be NULL
+ * @return Outcome of the observation
+ */
+beacon_event_t beacon_index_observe(beacon_index_t *idx, const t018_beacon_id_t *id, double t,
+                                    const t018_message_t *msg, const beacon_entry_t **entry);
+
+/**
+ * @brief Look up a beacon
+ * @param idx Index state
+ * @param id Beacon ID
+ * @return Record, or NULL if unknown or expired
+ */
+const beacon_entry_t *beacon_index_find(const beacon_index_t *idx, const t018_beacon_id_t *id);
+
+/**
+ * @brief Drop records idle for the expiry time
+ * @param idx Index state
+ * @param now Current stream time (s)
+ *
+ * Called by beacon_index_observe(); call it directly when no bursts arrive.
+ */
+void beacon_index_expire(beacon_index_t *idx, double now);
+
+/**
+ * @brief Iterate over live records (pool order)
+ * @param idx Index state
+ * @param pos Iterator, 0 to start
+ * @return Next record, NULL when done
+ */
+const beacon_entry_t *beacon_index_next(const beacon_index_t *idx, uint32_t *pos);
+
+/**
+ * @brief Memory held by the index
+ * @param idx Index state
+ * @return Bytes allocated
+ */
+size_t beacon_index_memory(const beacon_index_t *idx);
+
+/**
+ * @brief Release index buffers
+ * @param idx Index state
+ */
+void beacon_index_free(beacon_index_t *idx);
+
+#endif // BEACON_INDEX_H
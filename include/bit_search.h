@@ -0,0 +1,124 @@
+/**
+ * @file bit_search.h
+ * @brief Bit-parallel T.018 sync and frame search over packed bit logs
+ *
+ * Scans demodulated bitstreams (receiver logs, 8 bits per byte) for frames
+ * at any bit alignment:
+ * - The stream is loaded into 64-bit words, first bit most significant;
+ *   any alignment is a funnel shift of two words. A table lookup per byte
+ *   of the stream flags the alignments where that byte can lie within the
+ *   sync, then the flagged ones get the XOR/popcount distance to the whole
+ *   sync (up to 64 bits, max_errors bit errors accepted)
+ * - Complemented matches are candidates too (180° phase ambiguity)
+ * - The 250 bits after each match are BCH-checked in both message layouts
+ *   (202 info + 48 BCH, or 2 header + 202 info + 46 BCH as sent by
+ *   bin/sarsat_sgb), optionally corrected, and their beacon ID decoded
+ * - Chunks of the stream are searched in parallel on the default task
+ *   pool; frames are reported in stream order
+ *
+ * The default sync is the preamble: the modulator sends 50 zero bits
+ * before the message (OQPSK_PREAMBLE_BITS).
+ *
+ * A bit log does not always fix where a message starts: shifted by k bits
+ * it is still a codeword when the k bits shifted out are zeros, and a
+ * zero preamble supplies the bits shifted in. Likewise a window can check
+ * in both layouts. Candidates are ranked by sync Hamming distance, then
+ * BCH corrections; only those at the best rank are reported, all of them
+ * when several tie, with the alternatives count set.
+ */
+
+#ifndef BIT_SEARCH_H
+#define BIT_SEARCH_H
+
+#include <stdint.h>
+#include "t018_protocol.h"
+
+#define BIT_SEARCH_MAX_PATTERN      64          // Sync bits matched per alignment
+#define BIT_SEARCH_DEFAULT_SYNC     50          // Whole preamble (OQPSK_PREAMBLE_BITS zeros)
+#define BIT_SEARCH_DEFAULT_ERRORS   4           // Accepted sync bit errors
+#define BIT_SEARCH_WINDOW_BITS      T018_DATA_BITS   // Message bits checked after the sync
+#define BIT_SEARCH_FRAME_BYTES      32          // 252 frame bits, MSB first
+
+// Message layout of a decoded frame
+typedef enum {
+    BIT_SEARCH_LAYOUT_SPEC = 0,                 // 202 info + 48 BCH (T.018)
+    BIT_SEARCH_LAYOUT_HEADER = 1                // 2 header + 202 info + 46 BCH (bin/sarsat_sgb)
+} bit_search_layout_t;
+
+// Search parameters
+typedef struct {
+    uint64_t pattern;                           // Sync bits, first bit most significant
+    uint32_t length;                            // Sync length (1..BIT_SEARCH_MAX_PATTERN)
+    uint32_t max_errors;                        // Accepted sync bit errors
+    uint8_t inverted;                           // Also match the complemented sync
+    uint8_t lsb_first;                          // First bit of each byte in bit 0
+    uint8_t correct;                            // BCH correction when the parity check fails
+    uint8_t keep_failed;                        // Also report candidates failing BCH
+} bit_search_config_t;
+
+// One candidate (decoded frame, or BCH failure with keep_failed)
+typedef struct {
+    uint64_t bit_offset;                        // First message bit in the stream
+    uint32_t sync_errors;                       // Sync bit errors (of the complement if inverted)
+    uint8_t inverted;                           // Bits complemented before decoding
+    bit_search_layout_t layout;
+    uint32_t alternatives;                      // Other alignments reported for this frame
+    int bch_errors;                             // Corrected bit errors, -1 = BCH failure
+    uint8_t frame[BIT_SEARCH_FRAME_BYTES];      // 2 header + 202 info + 48 BCH (raw window on failure)
+    t018_beacon_id_t id;                        // Beacon ID (decoded frames)
+} bit_search_hit_t;
+
+// Search counters
+typedef struct {
+    uint64_t bits;                              // Bits searched
+    uint64_t candidates;                        // Sync matches
+    uint64_t frames;                            // Frames reported
+    uint64_t ambiguous;                         // Frames reported at several alignments
+    uint64_t corrected;                         // Frames needing BCH correction
+    uint64_t failed;                            // Candidates failing BCH
+    uint64_t duplicates;                        // Less likely alignments of a reported frame
+} bit_search_stats_t;
+
+/**
+ * @brief Called for every reported candidate, in stream order
+ * @param ctx Caller context
+ * @param hit Candidate (valid during the call)
+ */
+typedef void (*bit_search_fn_t)(void *ctx, const bit_search_hit_t *hit);
+
+/**
+ * @brief Default parameters: BIT_SEARCH_DEFAULT_SYNC preamble zeros,
+ *        BIT_SEARCH_DEFAULT_ERRORS errors, both polarities, MSB first
+ * @param cfg Output
+ */
+void bit_search_default_config(bit_search_config_t *cfg);
+
+/**
+ * @brief Parse a sync pattern written as '0'/'1' characters
+ * @param text Pattern, first bit first
+ * @param cfg Output (pattern and length)
+ * @return 0 on success, -1 if malformed or longer than BIT_SEARCH_MAX_PATTERN
+ */
+int bit_search_parse_pattern(const char *text, bit_search_config_t *cfg);
+
+/**
+ * @brief Search a packed bitstream
+ * @param cfg Parameters
+ * @param data Packed bits (e.g. a mapped log file)
+ * @param bytes Length in bytes
+ * @param fn Candidate callback (called from the calling thread)
+ * @param ctx Callback context
+ * @param stats Output counters (may be NULL)
+ * @return 0 on success, -1 on error
+ *
+ * Candidates starting within one message of each other are alignments of
+ * the same frame: only the most likely ones are reported (decoded, then
+ * fewest sync errors, then fewest BCH corrections). The same frame decoded in both layouts (T.018
+ * layout at n, header layout with a zero header at n - 2) is reported once,
+ * in the T.018 layout.
+ * Failed candidates (keep_failed) are reported only where nothing decodes.
+ */
+int bit_search_scan(const bit_search_config_t *cfg, const uint8_t *data, uint64_t bytes,
+                    bit_search_fn_t fn, void *ctx, bit_search_stats_t *stats);
+
+#endif // BIT_SEARCH_H
@@ -0,0 +1,156 @@
+/**
+ * @file burst_record.h
+ * @brief Parametric burst recordings (.sgbr) with on-read synthesis
+ *
+ * A rendered burst costs ~19.7 MB of cf32 per second of signal; a burst
+ * record keeps only what the waveform is made from:
+ * - The 252 frame bits, PRN mode
+ * - Start time, carrier offset and phase, amplitude, chip clock error
+ *
+ * 64 bytes per burst on disk (32-byte file header with the noise floor).
+ * Samples are synthesized on demand, at any sample rate and for any window
+ * of the timeline (random access): half-sine OQPSK exactly as
+ * oqpsk_modulate_frame() builds it (identical at 64 samples/chip), plus
+ * deterministic Gaussian noise keyed on the sample index.
+ *
+ * Recordings can also be exported as SigMF with one annotation per burst
+ * carrying the "sarsat:" extension fields (with or without the data file).
+ */
+
+#ifndef BURST_RECORD_H
+#define BURST_RECORD_H
+
+#include <stdint.h>
+#include <complex.h>
+
+#define BURST_RECORD_MAGIC          "SGBR"
+#define BURST_RECORD_VERSION        1
+#define BURST_RECORD_HEADER_SIZE    32          // Bytes before the first record
+#define BURST_RECORD_SIZE           64          // Bytes per burst on disk
+#define BURST_RECORD_FRAME_BYTES    32          // 252 frame bits, MSB first (63 hex digits)
+#define BURST_RECORD_CHIP_RATE      38400.0     // Nominal chip rate per channel (chips/s)
+#define BURST_RECORD_CHIPS          38400       // Chips per channel and burst
+#define BURST_RECORD_DEFAULT_RATE   2457600     // Synthesis rate when none is given (64 samples/chip)
+#define BURST_RECORD_NO_NOISE       (-200.0f)   // noise_db: noiseless recording
+
+// One burst
+typedef struct {
+    double time;                                // Start of the first chip (s from recording start)
+    double freq_offset;                         // Carrier offset (Hz)
+    float amplitude;                            // Linear gain (1 = modulator output)
+    float phase;                                // Carrier phase at burst start (rad)
+    float chip_rate_ppm;                        // Chip clock error (ppm)
+    uint8_t prn_mode;                           // 0=Normal, 1=Self-test
+    uint8_t frame[BURST_RECORD_FRAME_BYTES];    // Frame bits, MSB first
+} burst_record_t;
+
+// Recording (records sorted by time)
+typedef struct {
+    burst_record_t *records;
+    uint32_t count;
+    float noise_db;                             // Complex noise power (dB re burst power 1)
+    uint64_t noise_seed;                        // Noise sequence
+    double duration;                            // Length (s), at least the end of the last burst
+    double max_burst;                           // Longest burst (s), for window lookups
+} burst_recording_t;
+
+/**
+ * @brief Store frame bits in a record
+ * @param rec Burst record
+ * @param frame_bits 252 bits (one per byte), as built by t018_build_frame()
+ */
+void burst_record_set_frame(burst_record_t *rec, const uint8_t *frame_bits);
+
+/**
+ * @brief Expand the frame bits of a record
+ * @param rec Burst record
+ * @param frame_bits Output, 252 bits (one per byte)
+ */
+void burst_record_get_frame(const burst_record_t *rec, uint8_t *frame_bits);
+
+/**
+ * @brief Burst duration
+ * @param rec Burst record
+ * @return Seconds from the first chip to the end of the last I chip
+ */
+double burst_record_duration(const burst_record_t *rec);
+
+/**
+ * @brief Add one burst to a window of the timeline
+ * @param rec Burst record
+ * @param sample_rate Output sample rate (Hz, any value)
+ * @param first Timeline index of out[0] (sample 0 = recording start)
+ * @param count Window length
+ * @param out Samples, the burst is added to the existing content
+ */
+void burst_record_render(const burst_record_t *rec, double sample_rate,
+                         uint64_t first, uint32_t count, float complex *out);
+
+/**
+ * @brief Load a recording
+ * @param rc Recording
+ * @param path .sgbr file
+ * @return 0 on success, -1 on error
+ */
+int burst_recording_load(burst_recording_t *rc, const char *path);
+
+/**
+ * @brief Write a recording (replaces the file)
+ * @param rc Recording
+ * @param path .sgbr file
+ * @return 0 on success, -1 on error
+ */
+int burst_recording_save(const burst_recording_t *rc, const char *path);
+
+/**
+ * @brief Append one burst, creating a noiseless recording if needed
+ * @param path .sgbr file
+ * @param rec Burst record
+ * @return 0 on success, -1 on error
+ */
+int burst_recording_append(const char *path, const burst_record_t *rec);
+
+/**
+ * @brief Recording length in samples
+ * @param rc Recording
+ * @param sample_rate Sample rate (Hz)
+ * @return Samples up to the end of the recording
+ */
+uint64_t burst_recording_samples(const burst_recording_t *rc, double sample_rate);
+
+/**
+ * @brief Synthesize a window of the recording
+ * @param rc Recording
+ * @param sample_rate Sample rate (Hz)
+ * @param first Index of the first sample
+ * @param count Number of samples
+ * @param out Output samples (overwritten): noise plus every overlapping burst
+ */
+void burst_recording_render(const burst_recording_t *rc, double sample_rate,
+                            uint64_t first, uint32_t count, float complex *out);
+
+/**
+ * @brief Export as SigMF with "sarsat:" burst annotations
+ * @param rc Recording
+ * @param base Output base name (.sigmf-meta / .sigmf-data appended)
+ * @param sample_rate Sample rate (Hz)
+ * @param with_data 1 = synthesize the cf32 data file, 0 = metadata only
+ * @return 0 on success, -1 on error
+ */
+int burst_recording_save_sigmf(const burst_recording_t *rc, const char *base,
+                               uint32_t sample_rate, int with_data);
+
+/**
+ * @brief Check for the .sgbr extension
+ * @param path File name
+ * @return 1 if path names a burst recording
+ */
+int burst_recording_is_path(const char *path);
+
+/**
+ * @brief Release recording buffers
+ * @param rc Recording
+ */
+void burst_recording_free(burst_recording_t *rc);
+
+#endif // BURST_RECORD_H
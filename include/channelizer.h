@@ -0,0 +1,81 @@
+/**
+ * @file channelizer.h
+ * @brief Oversampled polyphase FFT channelizer
+ *
+ * Splits a wideband complex stream into channels spaced fs/M apart, each
+ * decimated by D (M/D times oversampled, so channel passbands may be wider
+ * than the spacing):
+ * - Prototype lowpass of M × taps_per_branch taps (Blackman-windowed sinc),
+ *   applied as a weighted overlap-add fold into M branches
+ * - One inverse FFT of size M per output instant serves all channels
+ * - Phase correction of the D-sample hop (period M/D outputs)
+ * - Vectorized fold (NEON on ARM, auto-vectorizable loop elsewhere)
+ *
+ * Channel c of N is centered at (c - (N-1)/2) × fs/M from the input center.
+ */
+
+#ifndef CHANNELIZER_H
+#define CHANNELIZER_H
+
+#include <stdint.h>
+#include <complex.h>
+#include "fft.h"
+
+// Channelizer state
+typedef struct {
+    uint32_t fft_size;                      // M: branches / channel spacing fs/M
+    uint32_t decimation;                    // D: input samples per output (divides M)
+    uint32_t num_taps;                      // Prototype length (M × taps per branch)
+    float *taps;                            // Prototype reversed, each tap twice (re, im)
+    float complex *line;                    // Delay line (2 × num_taps, linear access)
+    uint32_t line_idx;                      // Delay line write index
+    uint32_t phase;                         // Input count modulo D
+    uint32_t hop;                           // Output count modulo M/D
+
+    fft_plan_t plan;
+    float complex *fold;                    // M folded branch sums
+    uint32_t num_channels;                  // Channels produced
+    int32_t *bins;                          // FFT bin offset per channel
+    float complex *rotation;                // Hop phase, num_channels × M/D
+} channelizer_t;
+
+/**
+ * @brief Initialize channelizer
+ * @param ch Channelizer state
+ * @param fft_size Number of branches M (power of two)
+ * @param decimation Output decimation D (divides M)
+ * @param taps_per_branch Prototype taps per branch
+ * @param cutoff Prototype cutoff (-6 dB) as a fraction of the output rate (<= 0.5)
+ * @param num_channels Channels centered on the input (1..M)
+ * @return 0 on success, -1 on error
+ */
+int channelizer_init(channelizer_t *ch, uint32_t fft_size, uint32_t decimation,
+                     uint32_t taps_per_branch, double cutoff, uint32_t num_channels);
+
+/**
+ * @brief Channel center offset
+ * @param ch Channelizer state
+ * @param channel Channel index
+ * @param in_rate Input sample rate (Hz)
+ * @return Center frequency relative to the input center (Hz)
+ */
+double channelizer_offset(const channelizer_t *ch, uint32_t channel, uint32_t in_rate);
+
+/**
+ * @brief Channelize a block of samples
+ * @param ch Channelizer state
+ * @param input Wideband input samples
+ * @param num_samples Number of input samples
+ * @param output One array per channel, at least num_samples / D + 1 samples each
+ * @return Samples written to each channel
+ */
+uint32_t channelizer_process(channelizer_t *ch, const float complex *input,
+                             uint32_t num_samples, float complex **output);
+
+/**
+ * @brief Release channelizer buffers
+ * @param ch Channelizer state
+ */
+void channelizer_free(channelizer_t *ch);
+
+#endif // CHANNELIZER_H
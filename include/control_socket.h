@@ -0,0 +1,84 @@
+/**
+ * @file control_socket.h
+ * @brief Line-oriented UNIX domain control socket
+ *
+ * Clients connect to a SOCK_STREAM socket and send one command per line
+ * (e.g. "status", "tx", "stop"). Command semantics are defined by the
+ * application; this module only handles connections, line framing and
+ * replies. Use with: socat - UNIX-CONNECT:/tmp/sarsat_sgb.sock
+ */
+
+#ifndef CONTROL_SOCKET_H
+#define CONTROL_SOCKET_H
+
+#include <stdint.h>
+
+#define CONTROL_MAX_CLIENTS     4           // Simultaneous connections
+#define CONTROL_LINE_MAX        256         // Maximum command length
+
+// Connected client
+typedef struct {
+    int fd;                                 // Connection (-1 = free slot)
+    char buf[CONTROL_LINE_MAX];             // Partial command
+    uint32_t len;
+} control_client_t;
+
+// Control socket
+typedef struct {
+    int listen_fd;                          // Listening socket
+    char path[108];                         // Socket path (sun_path size)
+    control_client_t clients[CONTROL_MAX_CLIENTS];
+} control_socket_t;
+
+/**
+ * @brief Create and listen on a UNIX socket (stale socket file is replaced)
+ * @param ctrl Control socket
+ * @param path Socket path
+ * @return 0 on success, -1 on error
+ */
+int control_socket_open(control_socket_t *ctrl, const char *path);
+
+/**
+ * @brief Accept a pending connection
+ * @param ctrl Control socket
+ * @return Client, or NULL if none pending or all slots are taken
+ */
+control_client_t *control_socket_accept(control_socket_t *ctrl);
+
+/**
+ * @brief Read available data from a client
+ * @param client Client
+ * @return 0 on success, -1 if the client disconnected
+ */
+int control_client_read(control_client_t *client);
+
+/**
+ * @brief Extract the next complete command line
+ * @param client Client
+ * @param line Output buffer (newline stripped)
+ * @param size Output buffer size
+ * @return 1 if a line was extracted, 0 otherwise
+ */
+int control_client_next_line(control_client_t *client, char *line, uint32_t size);
+
+/**
+ * @brief Send a formatted reply to a client
+ * @param client Client
+ * @param fmt printf format
+ */
+void control_reply(control_client_t *client, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Close a client connection
+ * @param client Client
+ */
+void control_client_close(control_client_t *client);
+
+/**
+ * @brief Close all connections and remove the socket file
+ * @param ctrl Control socket
+ */
+void control_socket_close(control_socket_t *ctrl);
+
+#endif // CONTROL_SOCKET_H
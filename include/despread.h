@@ -0,0 +1,145 @@
+/**
+ * @file despread.h
+ * @brief Bit-parallel DSSS despreader (chip domain)
+ *
+ * Correlates chip streams against the T.018 PRN sequences without
+ * multiplies:
+ * - Hard chips packed 64 per word (bit set = logic 1 = chip -1); the
+ *   correlation of n chips is n - 2·popcount(rx XOR prn)
+ * - Unaligned windows via funnel shifts, so code-phase searches need no
+ *   repacking
+ * - Soft variant over int8 samples (dot product instructions on ARM)
+ * - Vectorized (NEON vcnt / sdot on ARM, scalar popcount elsewhere)
+ *
+ * Works on chip-synchronous data: chips dumps, tracked receiver output.
+ */
+
+#ifndef DESPREAD_H
+#define DESPREAD_H
+
+#include <stdint.h>
+#include "prn_generator.h"
+
+#define DESPREAD_WORD_CHIPS     64                                      // Chips per packed word
+#define DESPREAD_BIT_WORDS      (PRN_CHIPS_PER_BIT / DESPREAD_WORD_CHIPS)  // 4 words per bit
+#define DESPREAD_FRAME_WORDS    (PRN_FRAME_CHIPS / DESPREAD_WORD_CHIPS)    // 600 words per channel
+
+/**
+ * @brief Words needed to pack a number of chips
+ */
+static inline uint32_t despread_words(uint32_t num_chips) {
+    return (num_chips + DESPREAD_WORD_CHIPS - 1) / DESPREAD_WORD_CHIPS;
+}
+
+/**
+ * @brief Set bits of one packed word (hardware popcount when available)
+ */
+static inline uint32_t despread_popcount64(uint64_t x) {
+#if defined(__aarch64__) || defined(__POPCNT__)
+    return (uint32_t)__builtin_popcountll(x);
+#else
+    // SWAR count (libgcc's __popcountdi2 is a table lookup per byte)
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (uint32_t)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Pack chip signs into words
+ * @param chips Chips or soft samples (negative → bit set)
+ * @param stride Distance between consecutive chips (2 for interleaved I/Q)
+ * @param num_chips Number of chips
+ * @param words Output, despread_words(num_chips) words (tail bits cleared)
+ *
+ * Chip i goes to bit i % 64 of word i / 64.
+ */
+void despread_pack_i8(const int8_t *chips, uint32_t stride, uint32_t num_chips, uint64_t *words);
+void despread_pack_f32(const float *chips, uint32_t stride, uint32_t num_chips, uint64_t *words);
+
+/**
+ * @brief Packed PRN chips for a complete frame
+ * @param mode 0=Normal, 1=Self-test
+ * @param channel 0=I, 1=Q
+ * @return Read-only table of DESPREAD_FRAME_WORDS words (built once, thread-safe)
+ */
+const uint64_t *despread_prn_words(uint8_t mode, uint8_t channel);
+
+/**
+ * @brief Hard correlation of two aligned packed sequences
+ * @param a First sequence
+ * @param b Second sequence
+ * @param num_words Length in words
+ * @return Σ a[i]·b[i] over 64·num_words chips (-64n..64n)
+ */
+int32_t despread_xor(const uint64_t *a, const uint64_t *b, uint32_t num_words);
+
+/**
+ * @brief Hard correlation at an arbitrary chip offset
+ * @param rx Received packed chips (one extra word read unless word aligned)
+ * @param chip_offset First received chip of the window
+ * @param ref Reference packed chips (word aligned)
+ * @param num_words Window length in words
+ * @return Correlation over 64·num_words chips
+ */
+int32_t despread_xor_at(const uint64_t *rx, uint32_t chip_offset,
+                        const uint64_t *ref, uint32_t num_words);
+
+/**
+ * @brief Code-phase search
+ * @param rx Received packed chips
+ * @param rx_chips Received length in chips
+ * @param ref Reference packed chips
+ * @param num_words Window length in words
+ * @param max_offset Last chip offset tried
+ * @param best_offset Output: offset of the largest |correlation|
+ * @return Correlation at best_offset (sign gives the data bit)
+ */
+int32_t despread_search(const uint64_t *rx, uint32_t rx_chips, const uint64_t *ref,
+                        uint32_t num_words, uint32_t max_offset, uint32_t *best_offset);
+
+/**
+ * @brief Despread consecutive bits from packed chips
+ * @param rx Received packed chips (one word past the last bit read unless aligned)
+ * @param chip_offset Chip offset of the first bit
+ * @param prn Packed PRN for the same bits
+ * @param num_bits Number of bits
+ * @param bits Output hard bits (correlation < 0 → 1)
+ * @param corr Output correlations (±256 when chip-perfect), may be NULL
+ * @return Total chip errors against the decided bits
+ */
+uint32_t despread_bits(const uint64_t *rx, uint32_t chip_offset, const uint64_t *prn,
+                       uint32_t num_bits, uint8_t *bits, int32_t *corr);
+
+/**
+ * @brief Soft correlation of int8 sequences
+ * @param x Received soft chips
+ * @param ref Reference chips (±1 or any int8)
+ * @param n Number of chips (no alignment requirement)
+ * @return Σ x[i]·ref[i]
+ */
+int32_t despread_dot_i8(const int8_t *x, const int8_t *ref, uint32_t n);
+
+/**
+ * @brief Soft despread of consecutive bits
+ * @param x Received soft chips (contiguous, bits × 256)
+ * @param prn PRN chips for the same bits (prn_get_frame_table() layout)
+ * @param num_bits Number of bits
+ * @param bits Output hard bits
+ * @param corr Output soft correlations, may be NULL
+ */
+void despread_bits_i8(const int8_t *x, const int8_t *prn, uint32_t num_bits,
+                      uint8_t *bits, int32_t *corr);
+
+/**
+ * @brief Quantize float chips to int8 with saturation
+ * @param x Input (stride apart)
+ * @param stride Distance between consecutive inputs
+ * @param n Number of chips
+ * @param scale Gain applied before rounding
+ * @param out Output int8 chips
+ */
+void despread_quantize(const float *x, uint32_t stride, uint32_t n, float scale, int8_t *out);
+
+#endif // DESPREAD_H
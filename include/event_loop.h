@@ -0,0 +1,165 @@
+/**
+ * @file event_loop.h
+ * @brief Single-threaded epoll event loop for the daemon main loop
+ *
+ * Replaces the sleep(1) polling loop:
+ * - epoll dispatch of file descriptors to handlers
+ * - timerfd burst deadlines (absolute CLOCK_MONOTONIC, no drift)
+ * - signalfd for SIGINT/SIGTERM/SIGUSR1 (no code runs in signal context)
+ * - Worker thread for heavy rendering, completion signalled via eventfd
+ */
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+// Event loop limits
+#define EVENT_LOOP_MAX_FDS      16          // Registered descriptors
+
+// Handler called from the loop thread
+typedef void (*event_handler_t)(int fd, uint32_t events, void *user);
+
+// Registered descriptor
+typedef struct {
+    int fd;                                 // File descriptor (-1 = free slot)
+    event_handler_t handler;                // Handler
+    void *user;                             // Handler argument
+} event_source_t;
+
+// Event loop
+typedef struct {
+    int epoll_fd;                           // epoll instance
+    event_source_t sources[EVENT_LOOP_MAX_FDS];
+    uint8_t running;                        // Cleared by event_loop_stop()
+} event_loop_t;
+
+// Worker job (runs on the worker thread)
+typedef int (*event_job_t)(void *arg);
+
+// Worker thread (one job at a time)
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    event_job_t job;                        // Pending job
+    void *arg;                              // Job argument
+    int result;                             // Last job result
+    int done_fd;                            // eventfd, readable when a job completes
+    uint8_t busy;                           // Job submitted and not yet collected
+    uint8_t stop;                           // Shutdown request
+} event_worker_t;
+
+/**
+ * @brief Create event loop
+ * @param loop Event loop
+ * @return 0 on success, -1 on error
+ */
+int event_loop_init(event_loop_t *loop);
+
+/**
+ * @brief Register a descriptor
+ * @param loop Event loop
+ * @param fd File descriptor
+ * @param events epoll events (EPOLLIN, ...)
+ * @param handler Handler called when fd is ready
+ * @param user Handler argument
+ * @return 0 on success, -1 on error
+ */
+int event_loop_add(event_loop_t *loop, int fd, uint32_t events,
+                   event_handler_t handler, void *user);
+
+/**
+ * @brief Unregister a descriptor (does not close it)
+ * @param loop Event loop
+ * @param fd File descriptor
+ */
+void event_loop_remove(event_loop_t *loop, int fd);
+
+/**
+ * @brief Dispatch events until event_loop_stop() is called
+ * @param loop Event loop
+ * @return 0 on normal stop, -1 on error
+ */
+int event_loop_run(event_loop_t *loop);
+
+/**
+ * @brief Request loop exit (from a handler)
+ * @param loop Event loop
+ */
+void event_loop_stop(event_loop_t *loop);
+
+/**
+ * @brief Close event loop
+ * @param loop Event loop
+ */
+void event_loop_cleanup(event_loop_t *loop);
+
+/**
+ * @brief Create a CLOCK_MONOTONIC timerfd
+ * @return File descriptor, or -1 on error
+ */
+int event_timer_create(void);
+
+/**
+ * @brief Arm timer for an absolute CLOCK_MONOTONIC deadline (one shot)
+ * @param fd timerfd
+ * @param deadline Absolute deadline
+ * @return 0 on success, -1 on error
+ */
+int event_timer_arm(int fd, const struct timespec *deadline);
+
+/**
+ * @brief Acknowledge timer expiration
+ * @param fd timerfd
+ * @return Number of expirations since last read
+ */
+uint64_t event_timer_ack(int fd);
+
+/**
+ * @brief Block signals and create a signalfd for them
+ * @param signals Signal numbers
+ * @param count Number of signals
+ * @return File descriptor, or -1 on error
+ */
+int event_signal_create(const int *signals, int count);
+
+/**
+ * @brief Start worker thread
+ * @param worker Worker
+ * @return 0 on success, -1 on error
+ */
+int event_worker_start(event_worker_t *worker);
+
+/**
+ * @brief Submit a job to the worker
+ * @param worker Worker
+ * @param job Job function
+ * @param arg Job argument
+ * @return 0 on success, -1 if a job is still running
+ */
+int event_worker_submit(event_worker_t *worker, event_job_t job, void *arg);
+
+/**
+ * @brief Collect the result of a completed job (call when done_fd is readable)
+ * @param worker Worker
+ * @return Job return value
+ */
+int event_worker_collect(event_worker_t *worker);
+
+/**
+ * @brief Stop worker thread (waits for the running job)
+ * @param worker Worker
+ */
+void event_worker_stop(event_worker_t *worker);
+
+/**
+ * @brief Add seconds to a timespec
+ * @param ts Timespec to update
+ * @param sec Seconds (may be fractional)
+ */
+void event_timespec_add(struct timespec *ts, double sec);
+
+#endif // EVENT_LOOP_H
@@ -0,0 +1,52 @@
+/**
+ * @file fft.h
+ * @brief Radix-2 complex FFT (power-of-two sizes)
+ *
+ * Small in-place iterative FFT with precomputed twiddles and bit-reversal
+ * table. One plan per size; a plan is read-only after fft_plan_init() and
+ * can be shared by several threads.
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdint.h>
+#include <complex.h>
+
+// FFT plan
+typedef struct {
+    uint32_t size;                  // Transform length (power of two)
+    uint32_t log2_size;
+    float complex *twiddle;         // exp(-j2πk/N), k < N/2
+    uint32_t *bitrev;               // Bit-reversal permutation
+} fft_plan_t;
+
+/**
+ * @brief Prepare an FFT plan
+ * @param plan Plan
+ * @param size Transform length (power of two, >= 2)
+ * @return 0 on success, -1 on error
+ */
+int fft_plan_init(fft_plan_t *plan, uint32_t size);
+
+/**
+ * @brief In-place forward FFT
+ * @param plan Plan
+ * @param data plan->size complex samples
+ */
+void fft_forward(const fft_plan_t *plan, float complex *data);
+
+/**
+ * @brief In-place inverse FFT (unnormalized)
+ * @param plan Plan
+ * @param data plan->size complex samples
+ */
+void fft_inverse(const fft_plan_t *plan, float complex *data);
+
+/**
+ * @brief Release plan tables
+ * @param plan Plan
+ */
+void fft_plan_free(fft_plan_t *plan);
+
+#endif // FFT_H
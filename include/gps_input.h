@@ -0,0 +1,68 @@
+/**
+ * @file gps_input.h
+ * @brief NMEA GPS input (serial device, FIFO or replay file)
+ *
+ * Non-blocking line reader for an NMEA 0183 stream. Only GGA sentences
+ * ($GPGGA, $GNGGA, ...) are decoded: they carry position, altitude and fix
+ * quality, which is all the T.018 position field needs.
+ */
+
+#ifndef GPS_INPUT_H
+#define GPS_INPUT_H
+
+#include <stdint.h>
+
+#define GPS_LINE_MAX    128         // NMEA sentences are at most 82 characters
+
+// Position fix
+typedef struct {
+    double latitude;                // Degrees, + north
+    double longitude;               // Degrees, + east
+    double altitude;                // Meters above mean sea level
+    uint8_t satellites;             // Satellites used
+    uint8_t valid;                  // Fix quality > 0
+} gps_fix_t;
+
+// GPS input state
+typedef struct {
+    int fd;                         // Source descriptor (non-blocking)
+    char line[GPS_LINE_MAX];        // Partial sentence
+    uint32_t line_len;
+    uint8_t discard;                // Overlong line: skip to the next newline
+    gps_fix_t fix;                  // Last valid fix
+    uint32_t sentences;             // Sentences read
+    uint32_t checksum_errors;       // Sentences rejected
+    uint32_t overlong;              // Lines dropped (GPS_LINE_MAX or longer)
+    uint32_t fixes;                 // Valid GGA fixes decoded
+} gps_input_t;
+
+/**
+ * @brief Open NMEA source
+ * @param gps GPS input state
+ * @param path Serial device, FIFO or file
+ * @return 0 on success, -1 on error
+ */
+int gps_input_open(gps_input_t *gps, const char *path);
+
+/**
+ * @brief Read available data and decode complete sentences
+ * @param gps GPS input state
+ * @return Number of new valid fixes, -1 on end of stream or error
+ */
+int gps_input_read(gps_input_t *gps);
+
+/**
+ * @brief Decode one NMEA sentence
+ * @param sentence Sentence starting with '$' (checksum optional)
+ * @param fix Output fix (only written for a valid GGA fix)
+ * @return 1 if a valid fix was decoded, 0 if ignored, -1 on checksum error
+ */
+int gps_parse_nmea(const char *sentence, gps_fix_t *fix);
+
+/**
+ * @brief Close NMEA source
+ * @param gps GPS input state
+ */
+void gps_input_close(gps_input_t *gps);
+
+#endif // GPS_INPUT_H
@@ -0,0 +1,176 @@
+/**
+ * @file iq_codec.h
+ * @brief Lossless compressed ci16 I/Q recordings (.sgiq)
+ *
+ * Captures that cannot be stored parametrically are kept as int16 I/Q,
+ * compressed block by block:
+ * - Fixed polynomial prediction (order 0-3, chosen per block and channel)
+ * - Rice coding of the residuals, parameter chosen per 256-residual partition
+ * - Verbatim fallback when a channel does not compress
+ *
+ * Blocks are independently decodable: they compress and decompress in
+ * parallel, and an index at the end of the file gives random access by
+ * sample index. Files whose writer never finished (no index) are still
+ * readable by walking the block headers. Decoding runs at tens of Msamples/s
+ * on one core, well above the PlutoSDR sample rate.
+ */
+
+#ifndef IQ_CODEC_H
+#define IQ_CODEC_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define IQ_CODEC_MAGIC              "SGIQ"
+#define IQ_CODEC_VERSION            1
+#define IQ_CODEC_HEADER_SIZE        32          // File header bytes
+#define IQ_CODEC_BLOCK_HEADER       8           // u32 payload bytes, u32 samples
+#define IQ_CODEC_DEFAULT_BLOCK      65536       // Samples per block
+#define IQ_CODEC_MAX_BLOCK          (1 << 20)   // Largest block (samples)
+#define IQ_CODEC_PARTITION          256         // Residuals per Rice parameter
+#define IQ_CODEC_MAX_ORDER          3           // Highest predictor order
+
+/**
+ * @brief Worst-case payload size of one block
+ * @param samples Samples in the block
+ * @return Bytes to reserve for iq_block_encode()
+ */
+#define IQ_CODEC_MAX_PAYLOAD(samples)   ((size_t)(samples) * 4 + 16)
+
+// Writer
+typedef struct {
+    FILE *file;
+    uint32_t sample_rate;
+    uint32_t block_samples;
+    uint64_t total_samples;
+    uint64_t bytes_written;                     // Including headers and index
+    uint64_t *index;                            // File offset of each block
+    uint32_t block_count;
+    uint32_t index_capacity;
+    int16_t *pending;                           // Partial block (interleaved I/Q)
+    uint32_t pending_count;
+    uint8_t *payload;                           // Encode buffer
+} iq_writer_t;
+
+// Reader
+typedef struct {
+    FILE *file;
+    uint32_t sample_rate;
+    uint32_t block_samples;
+    uint64_t total_samples;
+    uint64_t compressed_bytes;                  // Block headers and payloads
+    uint64_t *index;                            // File offset of each block
+    uint32_t block_count;
+    uint32_t next_block;                        // Next block to decode
+    int16_t *block;                             // Current decoded block
+    uint32_t block_fill;                        // Samples in block
+    uint32_t block_pos;                         // Next sample in block
+    uint8_t *payload;
+} iq_reader_t;
+
+/**
+ * @brief Compress one block
+ * @param iq Interleaved int16 I/Q samples
+ * @param samples Number of complex samples (<= IQ_CODEC_MAX_BLOCK)
+ * @param payload Output, at least IQ_CODEC_MAX_PAYLOAD(samples) bytes
+ * @return Payload size in bytes
+ */
+uint32_t iq_block_encode(const int16_t *iq, uint32_t samples, uint8_t *payload);
+
+/**
+ * @brief Decompress one block
+ * @param payload Block payload
+ * @param bytes Payload size
+ * @param samples Number of complex samples in the block
+ * @param iq Output, interleaved int16 I/Q
+ * @return 0 on success, -1 on corrupt payload
+ */
+int iq_block_decode(const uint8_t *payload, uint32_t bytes, uint32_t samples, int16_t *iq);
+
+/**
+ * @brief Create a compressed recording
+ * @param w Writer
+ * @param path .sgiq file (replaced)
+ * @param sample_rate Sample rate (Hz)
+ * @param block_samples Samples per block (0 = IQ_CODEC_DEFAULT_BLOCK)
+ * @return 0 on success, -1 on error
+ */
+int iq_writer_open(iq_writer_t *w, const char *path, uint32_t sample_rate, uint32_t block_samples);
+
+/**
+ * @brief Append samples (compressed a block at a time)
+ * @param w Writer
+ * @param iq Interleaved int16 I/Q samples
+ * @param samples Number of complex samples
+ * @return 0 on success, -1 on error
+ */
+int iq_writer_write(iq_writer_t *w, const int16_t *iq, uint32_t samples);
+
+/**
+ * @brief Append a block compressed by the caller (parallel encoders)
+ * @param w Writer (no partial block pending)
+ * @param payload Output of iq_block_encode()
+ * @param bytes Payload size
+ * @param samples Samples in the block (block_samples except for the last)
+ * @return 0 on success, -1 on error
+ */
+int iq_writer_add_block(iq_writer_t *w, const uint8_t *payload, uint32_t bytes, uint32_t samples);
+
+/**
+ * @brief Flush the last block, write the index and close
+ * @param w Writer
+ * @return 0 on success, -1 on error
+ */
+int iq_writer_close(iq_writer_t *w);
+
+/**
+ * @brief Open a compressed recording
+ * @param r Reader
+ * @param path .sgiq file
+ * @return 0 on success, -1 on error
+ */
+int iq_reader_open(iq_reader_t *r, const char *path);
+
+/**
+ * @brief Position the reader on a sample
+ * @param r Reader
+ * @param sample Index of the next sample to read
+ * @return 0 on success, -1 if beyond the end or on error
+ */
+int iq_reader_seek(iq_reader_t *r, uint64_t sample);
+
+/**
+ * @brief Read the next samples
+ * @param r Reader
+ * @param iq Output, interleaved int16 I/Q
+ * @param max_samples Output capacity (complex samples)
+ * @return Samples read, 0 at end of file, -1 on error
+ */
+int iq_reader_read(iq_reader_t *r, int16_t *iq, uint32_t max_samples);
+
+/**
+ * @brief Read one block's payload (for parallel decoders)
+ * @param r Reader
+ * @param block Block number
+ * @param payload Output, at least IQ_CODEC_MAX_PAYLOAD(block_samples) bytes
+ * @param bytes Payload size
+ * @param samples Samples in the block
+ * @return 0 on success, -1 on error
+ */
+int iq_reader_get_block(iq_reader_t *r, uint32_t block, uint8_t *payload,
+                        uint32_t *bytes, uint32_t *samples);
+
+/**
+ * @brief Close reader and release buffers
+ * @param r Reader
+ */
+void iq_reader_close(iq_reader_t *r);
+
+/**
+ * @brief Check for the .sgiq extension
+ * @param path File name
+ * @return 1 if path names a compressed recording
+ */
+int iq_codec_is_path(const char *path);
+
+#endif // IQ_CODEC_H
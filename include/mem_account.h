@@ -0,0 +1,119 @@
+/**
+ * @file mem_account.h
+ * @brief Memory accounting by subsystem, peak RSS per burst, memory budget
+ *
+ * The large transmit-side allocations go through a thin wrapper that
+ * records the size in a small header and counts it against a subsystem:
+ * - Current bytes, high-water mark and allocation count per subsystem
+ * - Process RSS and its peak per burst (VmHWM, reset through
+ *   /proc/self/clear_refs at each burst start)
+ * - Optional budget: allocations that would exceed it fail with a clear
+ *   message instead of the OOM killer ending the process later
+ *
+ * Memory from mem_alloc()/mem_calloc()/mem_realloc() must be released with
+ * mem_free() (never free()).
+ */
+
+#ifndef MEM_ACCOUNT_H
+#define MEM_ACCOUNT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define MEM_MIB                 (1024.0 * 1024.0)
+
+// Accounted subsystems
+typedef enum {
+    MEM_BURST = 0,                          // Rendered bursts (modulator and resampler output)
+    MEM_MODULATOR,                          // Modulator scratch (spread chips, verification)
+    MEM_RESAMPLER,                          // Filter taps, delay lines, work buffers
+    MEM_TX,                                 // Backend conversion buffers, packet headers
+    MEM_POOL,                               // Task pool deques and range tasks
+    MEM_SUBSYS_COUNT
+} mem_subsys_t;
+
+// Subsystem counters (snapshot)
+typedef struct {
+    uint64_t current;                       // Bytes allocated now
+    uint64_t peak;                          // High-water mark
+    uint64_t allocs;                        // Allocations (realloc counts once)
+} mem_subsys_stats_t;
+
+/**
+ * @brief Allocate accounted memory
+ * @param subsys Subsystem charged
+ * @param size Bytes
+ * @return Memory (max_align_t aligned), or NULL if out of memory or over budget
+ */
+void *mem_alloc(mem_subsys_t subsys, size_t size);
+
+/**
+ * @brief Allocate zeroed accounted memory
+ * @param subsys Subsystem charged
+ * @param count Elements
+ * @param size Bytes per element
+ * @return Memory, or NULL if out of memory or over budget
+ */
+void *mem_calloc(mem_subsys_t subsys, size_t count, size_t size);
+
+/**
+ * @brief Resize accounted memory (NULL ptr allocates)
+ * @param subsys Subsystem charged (the one ptr was allocated with)
+ * @param ptr Memory from mem_alloc()/mem_calloc()/mem_realloc(), or NULL
+ * @param size New size in bytes
+ * @return Memory, or NULL (ptr untouched) if out of memory or over budget
+ */
+void *mem_realloc(mem_subsys_t subsys, void *ptr, size_t size);
+
+/**
+ * @brief Release accounted memory (NULL is ignored)
+ * @param ptr Memory from mem_alloc()/mem_calloc()/mem_realloc()
+ */
+void mem_free(void *ptr);
+
+/**
+ * @brief Set the memory budget
+ * @param bytes Budget for accounted memory (0 = unlimited)
+ */
+void mem_set_budget(uint64_t bytes);
+
+/**
+ * @brief Current memory budget
+ * @return Bytes (0 = unlimited)
+ */
+uint64_t mem_get_budget(void);
+
+/**
+ * @brief Snapshot subsystem counters
+ * @param subsys Subsystem
+ * @param stats Output counters
+ */
+void mem_get_stats(mem_subsys_t subsys, mem_subsys_stats_t *stats);
+
+/**
+ * @brief Read the process resident set size
+ * @param rss Output: current RSS in bytes
+ * @param hwm Output: peak RSS in bytes since start or the last reset (may be NULL)
+ * @return 0 on success, -1 if /proc/self/status is unreadable
+ */
+int mem_read_rss(uint64_t *rss, uint64_t *hwm);
+
+/**
+ * @brief Start a burst: reset the RSS high-water mark
+ */
+void mem_burst_begin(void);
+
+/**
+ * @brief End a burst: record its peak RSS
+ * @return Peak RSS of the burst in bytes (0 if unknown)
+ */
+uint64_t mem_burst_end(void);
+
+/**
+ * @brief Print the high-water marks (subsystems, RSS, bursts, budget)
+ * @param out Output stream
+ */
+void mem_print_report(FILE *out);
+
+#endif // MEM_ACCOUNT_H
@@ -0,0 +1,117 @@
+/**
+ * @file net_sink.h
+ * @brief Network I/Q sink (TCP/UDP) for remote decoders and test rigs
+ *
+ * Streams rendered ci16 bursts to a receiver on another host (or loopback):
+ * - tcp:host[:port]  connects to a listening receiver, flow controlled,
+ *                    MSG_ZEROCOPY sends when the kernel supports them
+ * - udp:host[:port]  MTU-sized datagrams batched with sendmmsg(), paced at
+ *                    a multiple of real time
+ *
+ * Every packet starts with a 32-byte header: sequence number (gaps = loss),
+ * burst number, index of its first sample in the stream, sample rate and
+ * burst start/end flags, so the receiver can cut bursts out of the stream.
+ */
+
+#ifndef NET_SINK_H
+#define NET_SINK_H
+
+#include <stdint.h>
+
+#define NET_SINK_MAGIC          "SGNS"
+#define NET_SINK_VERSION        1
+#define NET_SINK_HEADER_SIZE    32          // Bytes before the ci16 payload
+#define NET_SINK_DEFAULT_PORT   5555
+#define NET_SINK_UDP_SAMPLES    360         // 1440-byte payload (1472-byte datagram, 1500 MTU)
+#define NET_SINK_TCP_SAMPLES    16384       // Samples per TCP frame
+#define NET_SINK_MAX_SAMPLES    NET_SINK_TCP_SAMPLES
+#define NET_SINK_BATCH          64          // Datagrams per sendmmsg()
+#define NET_SINK_UDP_PACE       4.0         // UDP send rate (× real time, 0 = unpaced)
+#define NET_SINK_ZC_TIMEOUT_MS  1000        // Wait for zero-copy completions
+
+// Packet flags
+#define NET_FLAG_BURST_START    0x0001      // First packet of a burst
+#define NET_FLAG_BURST_END      0x0002      // Last packet of a burst
+
+// Transport
+typedef enum {
+    NET_SINK_TCP = 0,
+    NET_SINK_UDP = 1
+} net_proto_t;
+
+// Decoded packet header
+typedef struct {
+    uint16_t flags;                         // NET_FLAG_*
+    uint32_t seq;                           // Packet sequence number
+    uint32_t burst;                         // Burst number (from 0)
+    uint64_t sample_index;                  // Stream index of the first sample
+    uint32_t sample_rate;                   // Hz
+    uint16_t samples;                       // Complex ci16 samples in the payload
+} net_packet_header_t;
+
+// Sink
+typedef struct {
+    net_proto_t proto;
+    int fd;
+    uint32_t sample_rate;
+    double pace;                            // × real time (0 = unpaced)
+    uint8_t zerocopy;                       // MSG_ZEROCOPY enabled (TCP)
+    uint32_t zc_issued;                     // Zero-copy sends since open
+    uint32_t zc_completed;                  // Completions reaped
+    uint32_t seq;
+    uint32_t burst;
+    uint64_t sample_index;
+    uint8_t *headers;                       // Encoded headers of the burst in flight
+    uint32_t header_capacity;               // Packets
+    uint64_t packets_sent;
+    uint64_t bytes_sent;
+    uint64_t packets_dropped;               // UDP: refused (no listener) or no buffer
+} net_sink_t;
+
+/**
+ * @brief Check for a network sink URI
+ * @param uri Device URI
+ * @return 1 for tcp:/udp: URIs
+ */
+int net_sink_is_uri(const char *uri);
+
+/**
+ * @brief Connect a sink
+ * @param sink Sink
+ * @param uri tcp:host[:port] or udp:host[:port] (IPv6 hosts in brackets)
+ * @param sample_rate Sample rate carried in the headers (can be set later)
+ * @return 0 on success, -1 on error
+ */
+int net_sink_open(net_sink_t *sink, const char *uri, uint32_t sample_rate);
+
+/**
+ * @brief Send one burst (start/end flags on its first/last packet)
+ * @param sink Sink
+ * @param iq Interleaved ci16 samples, unchanged until the call returns
+ * @param samples Number of complex samples
+ * @return Samples sent (UDP drops included), -1 on error
+ */
+int net_sink_send_burst(net_sink_t *sink, const int16_t *iq, uint32_t samples);
+
+/**
+ * @brief Close the connection and release buffers
+ * @param sink Sink
+ */
+void net_sink_close(net_sink_t *sink);
+
+/**
+ * @brief Encode a packet header
+ * @param p Output, NET_SINK_HEADER_SIZE bytes
+ * @param h Header fields
+ */
+void net_header_encode(uint8_t *p, const net_packet_header_t *h);
+
+/**
+ * @brief Decode a packet header
+ * @param p NET_SINK_HEADER_SIZE bytes
+ * @param h Header fields
+ * @return 0 on success, -1 if magic, version or sample count are invalid
+ */
+int net_header_decode(const uint8_t *p, net_packet_header_t *h);
+
+#endif // NET_SINK_H
@@ -0,0 +1,107 @@
+/**
+ * @file oqpsk_stream.h
+ * @brief Static-memory, integer-only streaming OQPSK modulator (embedded targets)
+ *
+ * Produces the T.018 burst as interleaved 16-bit I/Q samples on demand,
+ * for beacon microcontrollers and the simulator alike:
+ * - No allocation, no floating point, no libc: only <stdint.h>
+ * - ~50 bytes of state per burst; 2.5 KB of constant tables (flash)
+ * - Pull interface (oqpsk_stream_read(), e.g. from a DMA half/complete
+ *   interrupt) or push interface (oqpsk_stream_run() with a sink callback)
+ * - Q11 output (±2047, 12-bit DAC) identical sample for sample to
+ *   oqpsk_modulate_frame() followed by pluto_convert_ci16(); Q15 output
+ *   from the same float waveform scaled by 32767
+ *
+ * At sample n the waveform only depends on n mod 64 and the signs of the
+ * current I and Q chips (half-sine pulses, Q delayed by half a chip, 1/√2
+ * normalization, π/4 rotation), so every output value is a table entry.
+ * Chips come from the two T.018 LFSRs stepped in place.
+ *
+ * tools/oqpsk_stream_test checks the tables and whole bursts against the
+ * float path of the host and regenerates the tables (-g).
+ */
+
+#ifndef OQPSK_STREAM_H
+#define OQPSK_STREAM_H
+
+#include <stdint.h>
+
+#define OQPSK_STREAM_SPS            64          // Samples per chip (2.4576 MHz)
+#define OQPSK_STREAM_CHIPS          38400       // Chips per channel (150 bits × 256)
+#define OQPSK_STREAM_SAMPLES        (OQPSK_STREAM_CHIPS * OQPSK_STREAM_SPS)  // 2,457,600 per burst
+#define OQPSK_STREAM_TX_BITS        300         // Preamble (50 zeros) + 250 frame bits
+#define OQPSK_STREAM_PREAMBLE_BITS  50
+#define OQPSK_STREAM_FRAME_BYTES    ((OQPSK_STREAM_TX_BITS + 7) / 8)
+#define OQPSK_STREAM_NO_CHIP        2           // chip_q once the Q channel has ended (last Tc/2)
+
+// Output scaling
+typedef enum {
+    OQPSK_STREAM_Q11 = 0,                   // ±2047 (PlutoSDR 12-bit DAC, pluto_convert_ci16())
+    OQPSK_STREAM_Q15 = 1                    // ±32767
+} oqpsk_stream_format_t;
+
+// Streaming modulator state (one burst)
+typedef struct {
+    uint8_t tx_bits[OQPSK_STREAM_FRAME_BYTES];  // Preamble + frame bits, MSB first
+    uint32_t lfsr_i;                        // LFSR state of the next I chip
+    uint32_t lfsr_q;                        // LFSR state of the next Q chip
+    uint32_t sample;                        // Next sample of the burst
+    uint16_t next_i;                        // Index of the next I chip
+    uint16_t next_q;                        // Index of the next Q chip
+    uint8_t chip_i;                         // Current I chip (logic: 1 = -1)
+    uint8_t chip_q;                         // Current Q chip (OQPSK_STREAM_NO_CHIP after the last)
+    uint8_t format;                         // oqpsk_stream_format_t
+} oqpsk_stream_t;
+
+// Sink of oqpsk_stream_run(): returns 0 to continue, non-zero to stop
+typedef int (*oqpsk_stream_sink_t)(void *ctx, const int16_t *samples, uint32_t num_samples);
+
+/**
+ * @brief Start a burst
+ * @param s Modulator state
+ * @param frame_bits 252-bit frame, one bit per byte (t018_build_frame());
+ *                   the first 250 bits are transmitted, as oqpsk_modulate_frame()
+ * @param prn_mode 0=Normal, 1=Self-test (T.018 Table 2.2)
+ * @param format Output scaling
+ */
+void oqpsk_stream_init(oqpsk_stream_t *s, const uint8_t *frame_bits,
+                       uint8_t prn_mode, oqpsk_stream_format_t format);
+
+/**
+ * @brief Produce the next samples of the burst
+ * @param s Modulator state
+ * @param buf Output, interleaved [I0, Q0, I1, Q1, ...] (2 × max_samples)
+ * @param max_samples Samples wanted (any size, e.g. one DMA half buffer)
+ * @return Samples written (less than max_samples at the end of the burst, 0 once done)
+ */
+uint32_t oqpsk_stream_read(oqpsk_stream_t *s, int16_t *buf, uint32_t max_samples);
+
+/**
+ * @brief Stream the rest of the burst through a sink, one chunk at a time
+ * @param s Modulator state
+ * @param buf Chunk buffer (2 × chunk_samples int16), reused for every chunk
+ * @param chunk_samples Samples per chunk
+ * @param sink Called for every chunk
+ * @param ctx Passed to sink
+ * @return 0 when the burst is complete, otherwise the sink's stop value
+ */
+int oqpsk_stream_run(oqpsk_stream_t *s, int16_t *buf, uint32_t chunk_samples,
+                     oqpsk_stream_sink_t sink, void *ctx);
+
+/**
+ * @brief Samples left in the burst
+ */
+static inline uint32_t oqpsk_stream_remaining(const oqpsk_stream_t *s) {
+    return OQPSK_STREAM_SAMPLES - s->sample;
+}
+
+/**
+ * @brief Constant sample tables (test harness)
+ * @param format Output scaling
+ * @param tail Output: samples once the last Q chip has ended [I chip][phase - 32][I, Q]
+ * @return Samples while both channels carry chips [I chip][Q chip][phase][I, Q]
+ */
+const int16_t (*oqpsk_stream_table(oqpsk_stream_format_t format,
+                                   const int16_t (**tail)[OQPSK_STREAM_SPS / 2][2]))[2][OQPSK_STREAM_SPS][2];
+
+#endif // OQPSK_STREAM_H
@@ -0,0 +1,94 @@
+/**
+ * @file perf_profile.h
+ * @brief Per-stage hardware counter profiling (perf_event_open)
+ *
+ * Opens one counter group (cycles, instructions, cache references/misses,
+ * branches/misses) bound to the calling thread and attributes counter
+ * deltas to named pipeline stages. When counters are unavailable
+ * (perf_event_paranoid, no PMU in a VM, seccomp) only wall-clock time is
+ * reported; individual events the PMU lacks are shown as "n/a".
+ */
+
+#ifndef PERF_PROFILE_H
+#define PERF_PROFILE_H
+
+#include <stdint.h>
+
+#define PROFILE_MAX_STAGES      8
+
+// Hardware events (one group, leader = cycles)
+typedef enum {
+    PERF_EV_CYCLES = 0,
+    PERF_EV_INSTRUCTIONS,
+    PERF_EV_CACHE_REFS,
+    PERF_EV_CACHE_MISSES,
+    PERF_EV_BRANCHES,
+    PERF_EV_BRANCH_MISSES,
+    PERF_EV_COUNT
+} perf_event_id_t;
+
+// Counter snapshot (values scaled for multiplexing)
+typedef struct {
+    uint64_t values[PERF_EV_COUNT];
+    double wall_sec;
+} perf_sample_t;
+
+// Accumulated stage counters
+typedef struct {
+    const char *name;               // Stage name (static string)
+    uint64_t values[PERF_EV_COUNT];
+    double wall_ms;
+    uint32_t calls;
+} profile_stage_t;
+
+// Profiler (counters count the thread that called perf_profile_init)
+typedef struct {
+    int fds[PERF_EV_COUNT];         // Event descriptors (-1 = unavailable)
+    int group_index[PERF_EV_COUNT]; // Position in the group read buffer
+    uint32_t group_size;            // Events in the group
+    uint8_t available;              // Leader (cycles) opened
+    profile_stage_t stages[PROFILE_MAX_STAGES];
+    uint32_t num_stages;
+    int current;                    // Stage being measured (-1 = none)
+    perf_sample_t start;            // Snapshot at perf_profile_begin()
+} perf_profile_t;
+
+/**
+ * @brief Open the counter group for the calling thread
+ * @param prof Profiler
+ * @return 0 (always usable; counters may be unavailable)
+ */
+int perf_profile_init(perf_profile_t *prof);
+
+/**
+ * @brief Start measuring a stage (no-op if prof is NULL)
+ * @param prof Profiler
+ * @param stage Stage name (static string; same name accumulates)
+ */
+void perf_profile_begin(perf_profile_t *prof, const char *stage);
+
+/**
+ * @brief Stop measuring the current stage (no-op if prof is NULL)
+ * @param prof Profiler
+ */
+void perf_profile_end(perf_profile_t *prof);
+
+/**
+ * @brief Clear accumulated stages
+ * @param prof Profiler
+ */
+void perf_profile_reset(perf_profile_t *prof);
+
+/**
+ * @brief Print per-stage counter table
+ * @param prof Profiler
+ */
+void perf_profile_print(const perf_profile_t *prof);
+
+/**
+ * @brief Close counters
+ * @param prof Profiler
+ */
+void perf_profile_cleanup(perf_profile_t *prof);
+
+#endif // PERF_PROFILE_H
@@ -7,6 +7,10 @@
  * - TX channel configuration
  * - I/Q buffer transmission
  * - Cleanup
+ *
+ * The same interface drives the null backend (null:), network sinks
+ * (tcp:host[:port], udp:host[:port]) streaming the ci16 samples, and the
+ * shared-memory ring (shm:[name]) read by decoders on the same host.
  */
 
 #ifndef PLUTO_CONTROL_H
@@ -15,6 +19,8 @@
 #include <stdint.h>
 #include <complex.h>
 #include <iio.h>
+#include "net_sink.h"
+#include "shm_ring.h"
 
 // PlutoSDR default parameters
 #define PLUTO_DEFAULT_URI       "ip:192.168.2.1"
@@ -22,9 +28,34 @@
 #define PLUTO_BANDWIDTH         200000      // 200 kHz RF bandwidth (signal BW ~58 kHz)
 #define PLUTO_DEFAULT_FREQ      403000000   // 403 MHz (training)
 #define PLUTO_DEFAULT_GAIN_DB   -10         // Conservative TX gain
+#define PLUTO_CHUNK_SIZE        65536       // Default samples per libiio buffer push
+#define PLUTO_CHUNK_MIN         4096        // Tunable chunk size range
+#define PLUTO_CHUNK_MAX         1048576
+#define PLUTO_KERNEL_BUFFERS_MAX 64         // Kernel buffer count limit (0 = libiio default)
+#define PLUTO_KERNEL_BUFFERS_DEFAULT 4      // libiio queue depth when not set
+#define PLUTO_NULL_URI          "null:"     // Null backend (no hardware, samples discarded)
+
+// TX backends (selected by URI scheme)
+typedef enum {
+    PLUTO_BACKEND_IIO = 0,                  // libiio device (ip:, usb:, local:)
+    PLUTO_BACKEND_NULL = 1,                 // Converts and discards (testing/benchmark)
+    PLUTO_BACKEND_NET = 2,                  // Streams ci16 over TCP/UDP (tcp:, udp:)
+    PLUTO_BACKEND_SHM = 3                   // cf32 into a /dev/shm ring (shm:)
+} pluto_backend_t;
+
+// Push timing of the last burst (pushes filling the kernel queue excluded)
+typedef struct {
+    uint32_t pushes;                        // Steady-state pushes timed
+    uint64_t samples;                       // Samples in those pushes
+    double elapsed_sec;                     // Their total duration
+    double mean_ms;                         // Push duration statistics
+    double stddev_ms;
+    double max_ms;
+} pluto_push_stats_t;
 
 // PlutoSDR context
 typedef struct {
+    pluto_backend_t backend;                // TX backend
     struct iio_context *ctx;                // IIO context
     struct iio_device *tx_dev;              // TX device (cf-ad9361-dds-core-lpc)
     struct iio_channel *tx_i;               // TX I channel
@@ -32,13 +63,26 @@ typedef struct {
     struct iio_buffer *tx_buf;              // TX buffer
     uint64_t frequency;                     // TX frequency (Hz)
     int32_t gain_db;                        // TX attenuation (dB)
+    uint32_t sample_rate;                   // TX sample rate (Hz)
+    uint32_t chunk_size;                    // Samples per push (IIO and null backends)
+    uint32_t kernel_buffers;                // Kernel buffer count (0 = libiio default)
+    pluto_push_stats_t push_stats;          // Last burst
+    uint8_t quiet;                          // No per-burst progress lines (calibration)
+    int16_t *null_buf;                      // Null backend conversion buffer
+    net_sink_t net;                         // Network backend connection
+    int16_t *net_buf;                       // Network backend burst (ci16)
+    uint32_t net_capacity;                  // Samples in net_buf
+    shm_ring_t shm;                         // Shared-memory backend ring
+    double shm_air_end;                     // Monotonic end of the last ring burst (0 = none)
     uint8_t initialized;                    // Init flag
 } pluto_ctx_t;
 
 /**
  * @brief Initialize PlutoSDR
  * @param ctx PlutoSDR context
- * @param uri Device URI (NULL = auto-detect)
+ * @param uri Device URI (NULL = auto-detect, "null:" = null backend,
+ *            "tcp:host[:port]" / "udp:host[:port]" = network sink,
+ *            "shm:[name]" = shared-memory ring /dev/shm/name)
  * @return 0 on success, -1 on error
  */
 int pluto_init(pluto_ctx_t *ctx, const char *uri);
@@ -67,6 +111,17 @@ int pluto_transmit_iq(pluto_ctx_t *ctx,
                      const float complex *iq_samples,
                      uint32_t num_samples);
 
+/**
+ * @brief Set the push chunk size and kernel buffer count
+ * @param ctx PlutoSDR context
+ * @param chunk_size Samples per push (PLUTO_CHUNK_MIN..PLUTO_CHUNK_MAX)
+ * @param kernel_buffers Kernel buffers queued to the DAC (0 = libiio default)
+ * @return 0 on success, -1 on invalid values or allocation failure
+ *
+ * Applies from the next burst. Network and shared-memory backends ignore it.
+ */
+int pluto_set_tx_buffers(pluto_ctx_t *ctx, uint32_t chunk_size, uint32_t kernel_buffers);
+
 /**
  * @brief Enable/disable TX
  * @param ctx PlutoSDR context
@@ -87,6 +142,16 @@ void pluto_cleanup(pluto_ctx_t *ctx);
  */
 void pluto_print_info(const pluto_ctx_t *ctx);
 
+/**
+ * @brief Convert float I/Q to interleaved 12-bit DAC samples (int16)
+ * @param iq_samples Complex I/Q samples (±1.0 full scale)
+ * @param buf Output buffer [I0, Q0, I1, Q1, ...] (2 × num_samples)
+ * @param num_samples Number of samples
+ */
+void pluto_convert_ci16(const float complex *iq_samples,
+                        int16_t *buf,
+                        uint32_t num_samples);
+
 /**
  * @brief Save I/Q samples to file in SigMF format
  * @param filename Output filename (.sigmf-data extension will be used)
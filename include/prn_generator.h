@@ -14,6 +14,10 @@
 // T.018 LFSR parameters
 #define PRN_LFSR_LENGTH     23          // LFSR register length
 #define PRN_CHIPS_PER_BIT   256         // Spreading factor
+#define PRN_FRAME_BITS      150         // Bits per channel (300-bit transmission)
+#define PRN_FRAME_CHIPS     38400       // 150 bits × 256 chips per channel
+#define PRN_PERIOD          8388607     // 2^23 - 1 chips (maximal length)
+#define PRN_POLYNOMIAL      0x840001    // x^23 + x^18 + 1 (characteristic polynomial)
 
 // T.018 Table 2.2 initial states (verified against Rev.12)
 #define PRN_INIT_NORMAL_I   0x000001    // Normal I:    00000000000000000000001
@@ -49,6 +53,40 @@ void prn_generate_i(prn_state_t *state, int8_t *sequence);
  */
 void prn_generate_q(prn_state_t *state, int8_t *sequence);
 
+/**
+ * @brief Get precomputed PRN chips for a complete frame
+ * @param mode 0=Normal, 1=Self-test
+ * @param channel 0=I, 1=Q
+ * @return Read-only table of PRN_FRAME_CHIPS chips (+1 or -1)
+ *
+ * Tables are built once (thread-safe) and shared by all modulators,
+ * equivalent to prn_init() followed by 150 calls to prn_generate_i/q().
+ */
+const int8_t *prn_get_frame_table(uint8_t mode, uint8_t channel);
+
+/**
+ * @brief Advance an LFSR state by any number of chips
+ * @param lfsr LFSR state (23 bits, non-zero)
+ * @param steps Chips to skip
+ * @return State after the skipped chips
+ *
+ * O(log steps): x^steps mod PRN_POLYNOMIAL applied to the next 23 chips.
+ */
+uint32_t prn_jump(uint32_t lfsr, uint64_t steps);
+
+/**
+ * @brief Generate PRN chips packed 64 per word
+ * @param lfsr LFSR state of the first chip
+ * @param words Output, chip i at bit i % 64 of word i / 64 (bit set = logic 1 = chip -1)
+ * @param num_words Number of words
+ * @return State after the 64·num_words chips
+ *
+ * Same packing as despread_pack_i8(). After the first 6 words the sequence
+ * is produced a word at a time from s[n] = s[n-80] ⊕ s[n-368] (the 16th
+ * power of the feedback polynomial).
+ */
+uint32_t prn_generate_packed(uint32_t lfsr, uint64_t *words, uint32_t num_words);
+
 /**
  * @brief Verify PRN generator against T.018 Table 2.2
  * @return 1 if valid, 0 if mismatch
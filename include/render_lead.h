@@ -0,0 +1,105 @@
+/**
+ * @file render_lead.h
+ * @brief Adaptive just-in-time render lead
+ *
+ * Decides how long before a burst deadline its render must start:
+ * - Render time is tracked per configuration (output rate, beacons per
+ *   cycle): EWMA plus a streaming 95th percentile estimate
+ * - lead = max(EWMA, p95) + safety margin
+ * - Lateness observed at the push (render finished after the deadline)
+ *   widens the margin; on-time bursts let it decay back to the minimum
+ *
+ * Rendering as late as possible keeps the position and rotating-field
+ * data fresh and holds only one burst in memory.
+ */
+
+#ifndef RENDER_LEAD_H
+#define RENDER_LEAD_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define LEAD_MAX_CONFIGS        8           // Tracked configurations
+#define LEAD_EWMA_ALPHA         0.2         // EWMA weight of a new sample
+#define LEAD_QUANTILE           0.95        // Tracked render time quantile
+#define LEAD_WARMUP_SAMPLES     5           // Use the maximum until then
+#define LEAD_DEFAULT_SEC        1.0         // Unknown configuration
+#define LEAD_MARGIN_MIN_SEC     0.010       // Safety margin floor
+#define LEAD_MARGIN_MAX_SEC     2.0         // Safety margin ceiling
+#define LEAD_MARGIN_GAIN        2.0         // Margin increase per second late
+#define LEAD_MARGIN_DECAY       0.9         // Margin factor per on-time burst
+
+// Render time statistics of one configuration
+typedef struct {
+    uint64_t key;                           // Configuration key
+    uint32_t samples;
+    double ewma;                            // Seconds
+    double abs_dev;                         // EWMA of |x - ewma| (quantile step)
+    double quantile;                        // LEAD_QUANTILE estimate
+    double max;                             // Worst render time
+} lead_stats_t;
+
+// Estimator
+typedef struct {
+    lead_stats_t configs[LEAD_MAX_CONFIGS];
+    uint32_t num_configs;
+    uint32_t next_evict;                    // Round-robin replacement
+    double margin;                          // Safety margin (seconds)
+    uint32_t on_time;                       // Bursts pushed at their deadline
+    uint32_t late;                          // Bursts pushed after their deadline
+    double worst_late;                      // Seconds
+} render_lead_t;
+
+/**
+ * @brief Initialize estimator
+ * @param lead Estimator
+ */
+void render_lead_init(render_lead_t *lead);
+
+/**
+ * @brief Build a configuration key
+ * @param output_rate Output sample rate in Hz
+ * @param bursts Bursts rendered per cycle
+ * @return Key
+ */
+uint64_t render_lead_key(uint32_t output_rate, uint32_t bursts);
+
+/**
+ * @brief Predicted render time (EWMA and quantile, no margin)
+ * @param lead Estimator
+ * @param key Configuration key
+ * @return Seconds (LEAD_DEFAULT_SEC for an unknown configuration)
+ */
+double render_lead_predict(const render_lead_t *lead, uint64_t key);
+
+/**
+ * @brief Render lead: predicted render time plus safety margin
+ * @param lead Estimator
+ * @param key Configuration key
+ * @return Seconds between render start and deadline
+ */
+double render_lead_get(const render_lead_t *lead, uint64_t key);
+
+/**
+ * @brief Add a measured render time
+ * @param lead Estimator
+ * @param key Configuration key
+ * @param render_sec Render time in seconds
+ */
+void render_lead_update(render_lead_t *lead, uint64_t key, double render_sec);
+
+/**
+ * @brief Feed back the push start relative to the deadline
+ * @param lead Estimator
+ * @param lateness_sec Push start - deadline (> 0 = late)
+ */
+void render_lead_feedback(render_lead_t *lead, double lateness_sec);
+
+/**
+ * @brief Print estimator state
+ * @param lead Estimator
+ * @param out Output stream
+ */
+void render_lead_print(const render_lead_t *lead, FILE *out);
+
+#endif // RENDER_LEAD_H
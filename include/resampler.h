@@ -0,0 +1,100 @@
+/**
+ * @file resampler.h
+ * @brief Arbitrary-rate Farrow resampler (final pipeline stage)
+ *
+ * Converts the native 2.4576 MHz modulator output (64 samples/chip) to any
+ * output sample rate, e.g. 2.0, 1.0 or 0.25 MHz for receivers and SDRs that
+ * cannot run at a chip-rate multiple:
+ * - Optional integer pre-decimation (windowed-sinc FIR, only every D-th
+ *   output computed) when the output rate is well below the input rate
+ * - Cubic Lagrange interpolator in Farrow structure for the fractional part
+ * - Streaming: history and fractional phase are carried between calls
+ * - Vectorized kernel (NEON on ARM, auto-vectorizable loops elsewhere)
+ */
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <stdint.h>
+#include <complex.h>
+
+// Resampler parameters
+#define RESAMPLER_TAPS_PER_PHASE    12      // Decimation FIR length = 12 × D + 1
+#define RESAMPLER_CUTOFF            0.45    // FIR cutoff (fraction of output sample rate)
+#define RESAMPLER_BLOCK             256     // Outputs computed per kernel call
+
+// Resampler state
+typedef struct {
+    uint32_t in_rate;                       // Input sample rate (Hz)
+    uint32_t out_rate;                      // Output sample rate (Hz)
+    uint32_t decim;                         // Integer pre-decimation factor (1 = bypass)
+    double step;                            // Decimated input samples per output sample
+    double pos;                             // Position of next output in work buffer
+
+    // Decimation FIR
+    uint32_t num_taps;                      // FIR length
+    float *taps;                            // FIR coefficients (unity DC gain)
+    float complex *fir_line;                // Delay line (2 × num_taps, linear access)
+    uint32_t fir_idx;                       // Delay line write index
+    uint32_t fir_phase;                     // Input count modulo decim
+
+    // Farrow stage
+    float complex *work;                    // 3 history samples + decimated block
+    uint32_t work_cap;                      // Work buffer capacity (samples)
+
+    uint64_t samples_in;                    // Total samples consumed
+    uint64_t samples_out;                   // Total samples produced
+} resampler_state_t;
+
+/**
+ * @brief Initialize resampler
+ * @param state Resampler state
+ * @param in_rate Input sample rate in Hz
+ * @param out_rate Output sample rate in Hz
+ * @return 0 on success, -1 on error
+ */
+int resampler_init(resampler_state_t *state, uint32_t in_rate, uint32_t out_rate);
+
+/**
+ * @brief Upper bound of output samples produced for a given input length
+ * @param state Resampler state
+ * @param num_in Number of input samples
+ * @return Maximum number of output samples
+ */
+uint32_t resampler_max_output(const resampler_state_t *state, uint32_t num_in);
+
+/**
+ * @brief Resample a block of I/Q samples
+ * @param state Resampler state
+ * @param input Input I/Q samples (in_rate)
+ * @param num_in Number of input samples
+ * @param output Output buffer (see resampler_max_output())
+ * @return Number of output samples generated
+ */
+uint32_t resampler_process(resampler_state_t *state,
+                           const float complex *input,
+                           uint32_t num_in,
+                           float complex *output);
+
+/**
+ * @brief Flush filter delay (feeds zeros so the burst tail is emitted)
+ * @param state Resampler state
+ * @param output Output buffer (see resampler_max_output() with group delay)
+ * @return Number of output samples generated
+ */
+uint32_t resampler_flush(resampler_state_t *state, float complex *output);
+
+/**
+ * @brief Filter look-ahead in input samples (output is delay-compensated)
+ * @param state Resampler state
+ * @return Look-ahead in input samples
+ */
+uint32_t resampler_delay(const resampler_state_t *state);
+
+/**
+ * @brief Release resampler buffers
+ * @param state Resampler state
+ */
+void resampler_free(resampler_state_t *state);
+
+#endif // RESAMPLER_H
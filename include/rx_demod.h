@@ -0,0 +1,126 @@
+/**
+ * @file rx_demod.h
+ * @brief Burst demodulator (receiver stages 2-6)
+ *
+ * Works on one captured burst at RX_SPS samples per chip:
+ * 2. Coarse timing/frequency acquisition: preamble PRN correlation over
+ *    2-chip segments, FFT across segments, normal and self-test PRNs; the
+ *    ±9.6 kHz ambiguity of the segment rate is resolved on the raw samples
+ *    (range ±67.2 kHz)
+ * 3. Despreading with the prn_get_frame_table() chips used by the modulator
+ * 4. OQPSK decisions: data-aided then decision-directed carrier PLL,
+ *    early/late timing tracking
+ * 5. BCH(250,202) check and correction
+ * 6. T.018 field decode
+ *
+ * One rx_demod_t per worker thread (scratch buffers and FFT plan).
+ */
+
+#ifndef RX_DEMOD_H
+#define RX_DEMOD_H
+
+#include <stdint.h>
+#include <complex.h>
+#include "fft.h"
+#include "oqpsk_modulator.h"
+#include "prn_generator.h"
+#include "t018_protocol.h"
+
+// Receiver working rate
+#define RX_SPS                  4           // Samples per chip after the front-end
+#define RX_SAMPLE_RATE          (OQPSK_CHIP_RATE * RX_SPS)  // 153.6 kHz
+#define RX_BURST_SAMPLES        (PRN_FRAME_CHIPS * RX_SPS)  // 1 s burst
+#define RX_CAPTURE_MARGIN       512         // Samples captured after the nominal burst end
+
+// Acquisition
+#define RX_ACQ_OFFSET           64          // First preamble chip used (skips ramp-up)
+#define RX_ACQ_CHIPS            1024        // Preamble chips correlated per hypothesis
+#define RX_ACQ_SEGMENT          2           // Chips summed coherently before the FFT (±9.6 kHz)
+#define RX_ACQ_FFT              1024        // Zero-padded FFT across segments
+#define RX_ACQ_THRESHOLD        20.0f       // Peak / mean bin power for sync
+#define RX_ACQ_ALIASES          3           // Segment-rate ambiguities tried each side
+#define RX_FINE_SEGMENT         64          // Chips per segment for fine frequency
+
+// Tracking
+#define RX_PLL_ALPHA            0.3f        // Carrier PLL proportional gain (per bit)
+#define RX_PLL_BETA             0.02f       // Carrier PLL integral gain
+#define RX_DLL_THRESHOLD        1.0f        // Accumulated early/late error per sample step
+
+// Demodulation outcome
+typedef enum {
+    RX_STATUS_NO_SYNC = 0,                  // No preamble correlation peak
+    RX_STATUS_BCH_FAIL = 1,                 // Demodulated, uncorrectable
+    RX_STATUS_OK = 2,                       // Valid (possibly corrected) message
+    RX_STATUS_OFF_CHANNEL = 3               // Carrier beyond max_offset_hz (channelized mode)
+} rx_status_t;
+
+// Bit layout of the 250 message bits
+typedef enum {
+    RX_LAYOUT_SPEC = 0,                     // 202 info + 48 BCH (T.018)
+    RX_LAYOUT_HEADER = 1                    // 2 header + 202 info + 46 BCH (bin/sarsat_sgb)
+} rx_layout_t;
+
+// Demodulation result
+typedef struct {
+    rx_status_t status;
+    uint8_t mode;                           // PRN set: 0 = normal, 1 = self-test
+    rx_layout_t layout;
+    float acq_metric;                       // Acquisition peak / mean bin power
+    double freq_hz;                         // Carrier offset
+    double start_sample;                    // Burst start within the capture
+    int32_t timing_steps;                   // Net early/late corrections
+    float ebn0_db;                          // Eb/N0 from decision statistics
+    int bch_errors;                         // Corrected bit errors (-1 if uncorrectable)
+    uint8_t message[OQPSK_MESSAGE_BITS];    // Message bits as received (hard decisions)
+    uint8_t codeword[T018_DATA_BITS];       // Corrected 202 info + 48 BCH
+    t018_message_t fields;                  // Decoded fields (status OK)
+} rx_result_t;
+
+// Per-thread demodulator
+typedef struct {
+    fft_plan_t plan;                        // RX_ACQ_FFT points
+    float complex *fft_buf;
+    float complex *filtered;                // Matched-filter output (capture length)
+    uint32_t capacity;
+    double max_offset_hz;                   // Accepted carrier offset (0 = any)
+} rx_demod_t;
+
+/**
+ * @brief Initialize demodulator scratch space
+ * @param dm Demodulator
+ * @param max_capture Longest capture (samples)
+ * @return 0 on success, -1 on error
+ */
+int rx_demod_init(rx_demod_t *dm, uint32_t max_capture);
+
+/**
+ * @brief Acquisition only (stages 2 and carrier check), e.g. on a partial capture
+ * @param dm Demodulator
+ * @param capture Captured samples at RX_SAMPLE_RATE
+ * @param length Samples available
+ * @param search Burst start search range (samples from capture start)
+ * @param result Output (mode, acq_metric, freq_hz, start_sample)
+ * @return RX_STATUS_OK when synchronized, RX_STATUS_NO_SYNC or RX_STATUS_OFF_CHANNEL
+ */
+rx_status_t rx_demod_acquire(rx_demod_t *dm, const float complex *capture,
+                             uint32_t length, uint32_t search, rx_result_t *result);
+
+/**
+ * @brief Demodulate and decode one burst
+ * @param dm Demodulator
+ * @param capture Captured samples at RX_SAMPLE_RATE
+ * @param length Capture length
+ * @param search Burst start search range (samples from capture start)
+ * @param result Output
+ * @return result->status
+ */
+rx_status_t rx_demod_burst(rx_demod_t *dm, const float complex *capture,
+                           uint32_t length, uint32_t search, rx_result_t *result);
+
+/**
+ * @brief Release scratch space
+ * @param dm Demodulator
+ */
+void rx_demod_free(rx_demod_t *dm);
+
+#endif // RX_DEMOD_H
@@ -0,0 +1,98 @@
+/**
+ * @file rx_detector.h
+ * @brief Energy-based burst detector (receiver stage 1)
+ *
+ * Runs at the receiver working rate on 256-sample blocks. The noise floor
+ * follows quiet blocks (fast down, slow up) and is frozen while a burst is
+ * captured. A block more than the threshold above the floor starts a
+ * fixed-length capture that includes RX_DETECT_PREROLL samples of history,
+ * so the burst start is always inside the capture. A second rise of the
+ * same size during a capture restarts it (the first trigger was noise
+ * measured against an unknown floor, e.g. at stream start).
+ */
+
+#ifndef RX_DETECTOR_H
+#define RX_DETECTOR_H
+
+#include <stdint.h>
+#include <complex.h>
+
+// Detector parameters
+#define RX_DETECT_BLOCK         256         // Samples per power measurement
+#define RX_DETECT_PREROLL       1024        // History copied ahead of the trigger block
+#define RX_DETECT_THRESHOLD_DB  6.0         // Default trigger level above noise floor
+#define RX_DETECT_FLOOR_MIN     1e-12f      // Floor clamp (digital silence)
+#define RX_DETECT_FLOOR_RISE    512         // Floor rise time constant (blocks)
+
+// Captured burst handed to the demodulator
+typedef struct {
+    float complex *samples;                 // Capture buffer (length samples)
+    uint32_t length;                        // Capture length
+    int64_t start_sample;                   // Stream index of samples[0] (< 0: zero history)
+    float floor_power;                      // Noise floor at trigger
+    float peak_power;                       // Highest block power during capture
+    uint32_t sequence;                      // Detection number
+} rx_capture_t;
+
+// Detector state
+typedef struct {
+    float threshold;                        // Linear power ratio
+    float floor;                            // Noise floor (mean |x|^2)
+    float trigger_power;                    // Block power that started the capture
+    float last_power;                       // Most recent block power
+    float block_power;                      // Accumulator
+    uint32_t block_fill;
+    float complex history[RX_DETECT_PREROLL];
+    uint32_t history_idx;                   // Next write position (ring)
+    uint64_t sample_index;                  // Samples processed
+
+    rx_capture_t *capture;                  // Buffer for the next capture (NULL = none free)
+    uint32_t capture_len;                   // Samples per capture
+    uint32_t capture_fill;
+    uint8_t capturing;
+    uint8_t holdoff;                        // Wait for power to drop after a capture
+    uint8_t foreign;                        // Floor set by rx_detector_abort(): no slow rise
+
+    uint32_t detections;                    // Captures started
+    uint32_t missed;                        // Triggers without a free capture buffer
+} rx_detector_t;
+
+/**
+ * @brief Initialize detector
+ * @param det Detector state
+ * @param threshold_db Trigger level above the noise floor (dB)
+ * @param capture_len Samples per capture (burst + pre-roll + margin)
+ */
+void rx_detector_init(rx_detector_t *det, float threshold_db, uint32_t capture_len);
+
+/**
+ * @brief Feed samples
+ * @param det Detector state
+ * @param samples Input samples (working rate)
+ * @param num_samples Number of samples
+ * @param complete Set to 1 when det->capture has been filled (caller takes
+ *                 it and installs a new buffer before the next call)
+ * @return Number of samples consumed (stops right after a completed capture)
+ */
+uint32_t rx_detector_process(rx_detector_t *det, const float complex *samples,
+                             uint32_t num_samples, int *complete);
+
+/**
+ * @brief End of stream: zero-fill a capture in progress
+ * @param det Detector state
+ * @return 1 if det->capture was completed, 0 otherwise
+ */
+int rx_detector_flush(rx_detector_t *det);
+
+/**
+ * @brief Abandon the capture in progress (e.g. no preamble at its start)
+ *
+ * The current level becomes background: the next trigger needs a rise of
+ * half the threshold (dB) above it. The floor does not creep up meanwhile
+ * and decays back at the usual fast-down rate once the foreign signal ends.
+ *
+ * @param det Detector state
+ */
+void rx_detector_abort(rx_detector_t *det);
+
+#endif // RX_DETECTOR_H
@@ -0,0 +1,97 @@
+/**
+ * @file rx_pipeline.h
+ * @brief Multi-threaded streaming receiver
+ *
+ * Threads connected by bounded queues of preallocated buffers:
+ *   reader     source → sample blocks (native rate)
+ *   front-end  resampler to RX_SAMPLE_RATE + burst detector → captures
+ *   decoders   rx_demod_burst() per capture (one or more workers)
+ *
+ * With channels > 0 the front-end instead resamples to RX_CHANNEL_RATE and
+ * runs a polyphase channelizer; each channel stream (RX_SAMPLE_RATE,
+ * RX_CHANNEL_SPACING apart) feeds its own thread running a detector and
+ * the demodulator, so a wideband input is decoded on all channels in
+ * parallel. A channel keeps a capture only if the preamble found in its
+ * first 35 ms has its carrier within ±RX_CHANNEL_SPACING/2: bursts of the
+ * neighbouring channels (which pass the wide channel filter) release the
+ * channel immediately. A message decoded on two channels is reported once.
+ *
+ * File sources apply backpressure (nothing is lost, runs faster than real
+ * time); live sources never block the reader: when the front-end or the
+ * decoders fall behind, blocks or captures are dropped and counted.
+ */
+
+#ifndef RX_PIPELINE_H
+#define RX_PIPELINE_H
+
+#include <stdint.h>
+#include "rx_source.h"
+#include "rx_demod.h"
+
+// Pipeline parameters
+#define RX_QUEUE_BLOCKS         32          // Source blocks in flight (~0.4 s at 2.4576 MS/s)
+#define RX_CAPTURE_BUFFERS      4           // Captures in flight
+#define RX_MAX_WORKERS          8           // Decoder threads
+
+// Channelized mode (406.0-406.1 MHz: 7 channels around 406.05 MHz)
+#define RX_CHANNEL_FFT          32          // Polyphase branches
+#define RX_CHANNEL_DECIMATION   4           // Channel output = RX_SAMPLE_RATE (8× oversampled)
+#define RX_CHANNEL_TAPS         8           // Prototype taps per branch
+#define RX_CHANNEL_CUTOFF       0.4         // ±61.4 kHz: burst (±46 kHz) + ±9.6 kHz offset
+#define RX_CHANNEL_RATE         (RX_SAMPLE_RATE * RX_CHANNEL_DECIMATION)   // 614.4 kHz
+#define RX_CHANNEL_SPACING      (RX_CHANNEL_RATE / RX_CHANNEL_FFT)         // 19.2 kHz
+#define RX_MAX_CHANNELS         16          // Channel threads
+#define RX_DEDUP_WINDOW         0.05        // Same beacon ID within this time is one burst (s)
+
+// Beacon index (see beacon_index.h)
+#define RX_BEACON_CAPACITY      100000      // Distinct beacons tracked (~6 MB)
+#define RX_BEACON_EXPIRY        3600.0      // Forget beacons silent for this long (s)
+#define RX_BEACON_LIST          20          // Beacons listed at the end of a run
+
+// Pipeline configuration
+typedef struct {
+    rx_source_t *source;                    // Opened source
+    float threshold_db;                     // Detector threshold above noise floor
+    uint32_t workers;                       // Decoder threads (1..RX_MAX_WORKERS)
+    uint32_t channels;                      // 0 = single channel, else channelizer outputs
+    uint8_t verbose;                        // Print failed captures too
+} rx_pipeline_config_t;
+
+// Pipeline statistics
+typedef struct {
+    uint64_t samples;                       // Source samples processed
+    uint32_t detections;                    // Energy detections
+    uint32_t decoded;                       // Valid messages
+    uint32_t corrected;                     // Valid messages with corrected bits
+    uint32_t bch_failed;                    // Synchronized, uncorrectable
+    uint32_t no_sync;                       // Detections without preamble correlation
+    uint32_t duplicates;                    // Messages also decoded on a neighbouring channel
+    uint32_t beacons;                       // Distinct beacon IDs decoded
+    uint32_t foreign;                       // Channel captures abandoned: neighbour's burst
+    uint32_t dropped_blocks;                // Live overruns (front-end too slow)
+    uint32_t dropped_captures;              // Detections without a free capture buffer
+    double wall_sec;                        // Elapsed time
+    double cpu_sec;                         // Process CPU time (all threads)
+} rx_stats_t;
+
+/**
+ * @brief Run the receiver until end of input or rx_pipeline_stop()
+ * @param config Configuration
+ * @param stats Output statistics
+ * @return 0 on success, -1 on error
+ */
+int rx_pipeline_run(const rx_pipeline_config_t *config, rx_stats_t *stats);
+
+/**
+ * @brief Request shutdown (async-signal-safe)
+ */
+void rx_pipeline_stop(void);
+
+/**
+ * @brief Print statistics and real-time factor
+ * @param stats Statistics
+ * @param sample_rate Source sample rate (Hz)
+ */
+void rx_pipeline_print_stats(const rx_stats_t *stats, uint32_t sample_rate);
+
+#endif // RX_PIPELINE_H
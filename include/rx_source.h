@@ -0,0 +1,120 @@
+/**
+ * @file rx_source.h
+ * @brief Receiver I/Q input (PlutoSDR RX, SigMF, WAV, raw cf32)
+ *
+ * Every source delivers float complex samples at its native rate:
+ * - SigMF recordings (.sigmf-meta/.sigmf-data, cf32_le or ci16_le)
+ * - WAV files (2 channels = I/Q, 16-bit PCM or 32-bit float)
+ * - Raw cf32 files (sample rate given on the command line)
+ * - Parametric burst recordings (.sgbr), synthesized at the requested rate
+ * - Compressed ci16 recordings (.sgiq), decompressed block by block
+ * - Shared-memory rings (shm:[name]) written by sarsat_sgb -u shm:
+ * - PlutoSDR RX via libiio (cf-ad9361-lpc, 12-bit ADC samples)
+ */
+
+#ifndef RX_SOURCE_H
+#define RX_SOURCE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <complex.h>
+#include <signal.h>
+#include <iio.h>
+#include "burst_record.h"
+#include "iq_codec.h"
+#include "shm_ring.h"
+
+// Source parameters
+#define RX_SOURCE_BLOCK         32768       // Samples per read (file and Pluto buffers)
+#define RX_PLUTO_BANDWIDTH      200000      // RX RF bandwidth (Hz)
+#define RX_IDENTICAL_CHECK      4096        // Non-zero samples with I == Q flagging audio input
+#define RX_GAIN_AGC             (-100)      // gain_db value selecting slow-attack AGC
+
+// Source types
+typedef enum {
+    RX_SOURCE_CF32 = 0,                     // Interleaved float32 I/Q
+    RX_SOURCE_CI16 = 1,                     // Interleaved int16 I/Q (SigMF ci16_le)
+    RX_SOURCE_WAV16 = 2,                    // WAV 16-bit PCM, 2 channels
+    RX_SOURCE_WAV32F = 3,                   // WAV 32-bit float, 2 channels
+    RX_SOURCE_PLUTO = 4,                    // PlutoSDR RX (libiio)
+    RX_SOURCE_BURSTS = 5,                   // Burst recording (.sgbr), synthesized
+    RX_SOURCE_SGIQ = 6,                     // Compressed int16 I/Q (.sgiq)
+    RX_SOURCE_SHM = 7                       // Shared-memory cf32 ring (shm:)
+} rx_source_type_t;
+
+// Receiver source
+typedef struct {
+    rx_source_type_t type;
+    uint32_t sample_rate;                   // Native sample rate (Hz)
+    uint8_t live;                           // 1 = real-time device (drop on overload)
+    uint8_t identical_iq;                   // Channels found identical (not I/Q)
+    uint32_t identical_run;                 // Non-zero samples with I == Q so far
+    uint64_t samples_read;                  // Total samples delivered
+
+    // Files
+    FILE *file;
+    uint64_t data_remaining;                // Bytes left in WAV data chunk
+    void *raw;                              // Conversion buffer
+
+    // Burst recordings
+    burst_recording_t bursts;
+    uint64_t burst_samples;                 // Timeline length at sample_rate
+
+    // Compressed recordings
+    iq_reader_t iq;
+
+    // Shared-memory ring (flow controlled: the producer waits for us)
+    shm_ring_t shm;
+    volatile sig_atomic_t cancelled;        // Stop waiting for samples (signal handler)
+
+    // PlutoSDR
+    struct iio_context *ctx;
+    struct iio_device *rx_dev;              // cf-ad9361-lpc
+    struct iio_channel *rx_i;
+    struct iio_channel *rx_q;
+    struct iio_buffer *rx_buf;
+} rx_source_t;
+
+/**
+ * @brief Open a recording
+ * @param src Source
+ * @param path .sigmf-meta/.sigmf-data/base name, .wav, .sgbr, .sgiq, raw cf32 file,
+ *             or shm:[name] ring
+ * @param sample_rate Sample rate for raw files and synthesis (0 = from metadata / default)
+ * @return 0 on success, -1 on error
+ */
+int rx_source_open_file(rx_source_t *src, const char *path, uint32_t sample_rate);
+
+/**
+ * @brief Open PlutoSDR RX
+ * @param src Source
+ * @param uri Device URI (NULL = auto-detect)
+ * @param frequency RX LO frequency (Hz)
+ * @param sample_rate Sample rate (Hz)
+ * @param gain_db Manual RX gain in dB, or RX_GAIN_AGC
+ * @return 0 on success, -1 on error
+ */
+int rx_source_open_pluto(rx_source_t *src, const char *uri, uint64_t frequency,
+                         uint32_t sample_rate, int32_t gain_db);
+
+/**
+ * @brief Read the next block of samples
+ * @param src Source
+ * @param out Output buffer (RX_SOURCE_BLOCK samples)
+ * @return Number of samples (<= RX_SOURCE_BLOCK), 0 at end of file, -1 on error
+ */
+int rx_source_read(rx_source_t *src, float complex *out);
+
+/**
+ * @brief Make a blocked live read return end of stream (async-signal-safe)
+ * @param src Source
+ */
+void rx_source_cancel(rx_source_t *src);
+
+/**
+ * @brief Close source and release buffers
+ * @param src Source
+ */
+void rx_source_close(rx_source_t *src);
+
+#endif // RX_SOURCE_H
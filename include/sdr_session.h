@@ -0,0 +1,147 @@
+/**
+ * @file sdr_session.h
+ * @brief Resilient SDR session (automatic reconnect with backoff)
+ *
+ * Wraps a pluto_ctx_t so a radio dropping off USB/Ethernet does not end the
+ * service:
+ * - A failed push marks the link down; the burst is counted as missed
+ * - A reconnect thread re-initializes and reconfigures the device with
+ *   exponential backoff, without blocking the scheduler
+ * - While the link is down, bursts are still rendered on schedule and
+ *   dropped immediately, so the first deadline after recovery is met
+ * - Fault injection (link drop after n bursts, failed reconnect attempts)
+ *   exercises the whole path on the null backend
+ * - Calibrated push settings (tx_tune) are replayed on every reconnect
+ */
+
+#ifndef SDR_SESSION_H
+#define SDR_SESSION_H
+
+#include <stdint.h>
+#include <complex.h>
+#include <pthread.h>
+#include "pluto_control.h"
+#include "tx_tune.h"
+
+#define SDR_BACKOFF_MIN_MS      500         // First reconnect attempt
+#define SDR_BACKOFF_MAX_MS      30000       // Backoff ceiling
+
+// Link state
+typedef enum {
+    SDR_LINK_UP = 0,
+    SDR_LINK_DOWN = 1
+} sdr_link_state_t;
+
+// Session statistics
+typedef struct {
+    uint64_t bursts;                        // Bursts transmitted
+    uint64_t missed;                        // Bursts lost (push failed or link down)
+    uint32_t disconnects;                   // Link losses
+    uint32_t reconnects;                    // Successful reconnections
+    uint32_t attempts;                      // Reconnect attempts
+    double downtime_sec;                    // Total time with the link down
+} sdr_session_stats_t;
+
+// Session
+typedef struct {
+    char uri[128];                          // Device URI
+    uint64_t frequency;                     // TX configuration replayed on reconnect
+    int32_t gain_db;
+    uint32_t sample_rate;
+    uint32_t chunk_size;                    // Push settings replayed on reconnect
+    uint32_t kernel_buffers;                // (chunk_size 0 = backend defaults, under lock)
+    pluto_ctx_t pluto;                      // Owned by the busy caller while up,
+                                            // by the reconnect thread while down
+    sdr_link_state_t state;
+    uint8_t busy;                           // A caller is using the device (link up)
+    double down_since;                      // CLOCK_MONOTONIC seconds
+    uint32_t backoff_ms;                    // Delay before the next attempt
+    uint32_t bursts_since_connect;
+    sdr_session_stats_t stats;
+
+    uint32_t fault_every;                   // Injected link drop after n bursts (0 = off)
+    uint32_t fault_attempts;                // Reconnect attempts failing after a drop
+    uint32_t fault_pending;                 // Attempts still to fail
+
+    pthread_t thread;                       // Reconnect thread
+    pthread_mutex_t lock;
+    pthread_cond_t cond;                    // Link down / stop
+    uint8_t thread_started;
+    uint8_t stop;
+} sdr_session_t;
+
+/**
+ * @brief Connect and configure the radio, start the reconnect thread
+ * @param session Session
+ * @param uri Device URI (see pluto_init)
+ * @param frequency TX frequency in Hz
+ * @param gain_db TX attenuation in dB
+ * @param sample_rate Sample rate in Hz
+ * @return 0 on success, -1 if the radio cannot be opened at startup
+ */
+int sdr_session_open(sdr_session_t *session, const char *uri,
+                     uint64_t frequency, int32_t gain_db, uint32_t sample_rate);
+
+/**
+ * @brief Enable fault injection
+ * @param session Session
+ * @param every Drop the link after this many bursts per connection (0 = off)
+ * @param failed_attempts Reconnect attempts that fail after each drop
+ */
+void sdr_session_set_fault(sdr_session_t *session, uint32_t every, uint32_t failed_attempts);
+
+/**
+ * @brief Set the push chunk size and kernel buffer count (kept across reconnects)
+ * @param session Session
+ * @param chunk_size Samples per push
+ * @param kernel_buffers Kernel buffers (0 = libiio default)
+ * @return 0 on success, -1 on invalid values
+ *
+ * Waits for a burst in flight to finish; safe from any thread.
+ */
+int sdr_session_set_tx_buffers(sdr_session_t *session, uint32_t chunk_size, uint32_t kernel_buffers);
+
+/**
+ * @brief Calibrate the push settings on the live radio (tx_tune_run)
+ * @param session Session
+ * @param best Output: selected settings
+ * @return 0 on success, -1 if the link is down, the backend has nothing to
+ *         tune or calibration failed (a failed push marks the link down)
+ *
+ * Call while no burst is in flight: the radio pushes silence meanwhile.
+ */
+int sdr_session_tune(sdr_session_t *session, tx_tune_result_t *best);
+
+/**
+ * @brief Transmit one burst
+ * @param session Session
+ * @param iq_samples Complex I/Q samples
+ * @param num_samples Number of samples
+ * @return Samples transmitted, 0 if the burst was missed (link already down),
+ *         -1 if the push failed (link now down); never blocks on reconnection
+ */
+int sdr_session_transmit(sdr_session_t *session,
+                         const float complex *iq_samples,
+                         uint32_t num_samples);
+
+/**
+ * @brief Check link state
+ * @param session Session
+ * @return 1 if the radio is connected
+ */
+int sdr_session_is_up(sdr_session_t *session);
+
+/**
+ * @brief Snapshot statistics (downtime includes a current outage)
+ * @param session Session
+ * @param stats Output statistics
+ */
+void sdr_session_get_stats(sdr_session_t *session, sdr_session_stats_t *stats);
+
+/**
+ * @brief Stop the reconnect thread and release the radio
+ * @param session Session
+ */
+void sdr_session_close(sdr_session_t *session);
+
+#endif // SDR_SESSION_H
@@ -0,0 +1,207 @@
+/**
+ * @file shm_ring.h
+ * @brief Shared-memory I/Q ring (/dev/shm) for decoders on the same host
+ *
+ * One producer (the transmitter, URI shm:[name]) writes cf32 samples into a
+ * POSIX shared-memory ring; any number of local readers map it and consume
+ * the samples in place:
+ * - One header page: sample rate, frequency, atomic head (samples written)
+ *   and tail (samples consumed by the flow-controlling reader), burst markers
+ * - Data region mapped twice back to back, so every span of up to capacity
+ *   samples is contiguous in memory: producers render straight into the
+ *   ring and readers process it without copying, across the wrap
+ * - Burst markers (stream index, length, time) in a small ring of their own
+ * - Without a flow-controlling reader the producer never waits: readers
+ *   that fall more than one ring behind skip ahead and count the overrun.
+ *   A reader opened with flow control makes the producer wait for space
+ *
+ * Samples are float complex (cf32, GNU Radio gr_complex), ±1.0 full scale.
+ */
+
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <complex.h>
+#include <stddef.h>
+
+#define SHM_RING_MAGIC          "SGBSHMR1"
+#define SHM_RING_VERSION        1
+#define SHM_RING_DEFAULT_NAME   "sarsat_iq"  // /dev/shm/sarsat_iq
+#define SHM_RING_DEFAULT_SAMPLES (1u << 23)  // 64 MiB, 3.4 s at 2.4576 MHz
+#define SHM_RING_MIN_SAMPLES    4096
+#define SHM_RING_HEADER_SIZE    4096        // Header page before the data
+#define SHM_RING_MARKERS        64          // Burst markers kept
+#define SHM_RING_WAIT_MS        1000        // Producer wait for a flow-controlling reader
+
+// Burst marker
+typedef struct {
+    uint64_t start;                         // Stream index of the first sample
+    uint64_t time_ns;                       // CLOCK_REALTIME when the burst was queued
+    uint32_t samples;
+    uint32_t burst;                         // Burst number (from 0)
+} shm_ring_marker_t;
+
+// Shared header (first page of the segment)
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t capacity;                      // Samples (power of two)
+    uint32_t sample_size;                   // Bytes per sample (8, cf32)
+    _Atomic uint32_t sample_rate;           // Hz
+    _Atomic uint64_t frequency;             // Hz (informational)
+    _Atomic uint32_t producer_pid;
+    _Atomic uint32_t closed;                // Producer gone: drain then stop
+    _Alignas(64) _Atomic uint64_t head;     // Samples written (producer)
+    _Atomic uint64_t writing;               // End of the span being written (>= head)
+    _Alignas(64) _Atomic uint64_t tail;     // Samples consumed (flow-controlling reader)
+    _Atomic uint32_t reader_pid;            // Flow-controlling reader (0 = none)
+    _Alignas(64) _Atomic uint64_t marker_count;  // Markers published
+    _Atomic uint64_t overwritten;           // Samples a flow-controlling reader never got
+    shm_ring_marker_t markers[SHM_RING_MARKERS];
+} shm_ring_header_t;
+
+// Mapped ring (producer or reader side)
+typedef struct {
+    shm_ring_header_t *hdr;
+    float complex *data;                    // Double-mapped: 2 × capacity samples addressable
+    void *map_base;
+    size_t map_size;
+    int fd;
+    char path[64];                          // Shared memory object name ("/name")
+    uint64_t mask;                          // capacity - 1
+    uint8_t producer;
+    uint8_t flow_control;                   // Reader: producer waits for us
+    uint64_t read_pos;                      // Reader: next stream index
+    uint64_t next_marker;                   // Reader: next marker to report
+    uint64_t overruns;                      // Reader: samples skipped (fell behind)
+    uint64_t samples_read;                  // Reader: samples released
+} shm_ring_t;
+
+/**
+ * @brief Check for a shared-memory ring URI
+ * @param uri Device URI
+ * @return 1 for shm: URIs
+ */
+int shm_ring_is_uri(const char *uri);
+
+/**
+ * @brief Create (or replace) a ring as its producer
+ * @param ring Ring
+ * @param name Shared memory name (NULL or "" = SHM_RING_DEFAULT_NAME)
+ * @param capacity Samples (rounded up to a power of two)
+ * @param sample_rate Hz
+ * @return 0 on success, -1 on error
+ */
+int shm_ring_create(shm_ring_t *ring, const char *name, uint64_t capacity, uint32_t sample_rate);
+
+/**
+ * @brief Map an existing ring as a reader
+ * @param ring Ring
+ * @param name Shared memory name (NULL or "" = SHM_RING_DEFAULT_NAME)
+ * @param flow_control 1 = the producer waits for this reader (one at a time)
+ * @return 0 on success, -1 on error (no such ring, bad header)
+ *
+ * Reading starts at the current head: only samples written afterwards are seen.
+ */
+int shm_ring_open(shm_ring_t *ring, const char *name, int flow_control);
+
+/**
+ * @brief Unmap the ring (the producer also marks it closed and unlinks it)
+ * @param ring Ring
+ */
+void shm_ring_close(shm_ring_t *ring);
+
+// =============================================================================
+// PRODUCER
+// =============================================================================
+
+/**
+ * @brief Announce a burst starting at the current head
+ * @param ring Ring (producer)
+ * @param samples Burst length
+ */
+void shm_ring_mark_burst(shm_ring_t *ring, uint32_t samples);
+
+/**
+ * @brief Contiguous space for the next samples, written in place
+ * @param ring Ring (producer)
+ * @param samples Samples to write (at most capacity)
+ * @return Pointer into the ring, or NULL if samples > capacity
+ *
+ * With a live flow-controlling reader, waits up to SHM_RING_WAIT_MS for it
+ * to free the space, then overwrites anyway (the reader is counted behind).
+ */
+float complex *shm_ring_reserve(shm_ring_t *ring, uint32_t samples);
+
+/**
+ * @brief Publish reserved samples to the readers
+ * @param ring Ring (producer)
+ * @param samples Samples written since shm_ring_reserve()
+ */
+void shm_ring_commit(shm_ring_t *ring, uint32_t samples);
+
+/**
+ * @brief Copy a whole burst into the ring (marker, reserve, commit)
+ * @param ring Ring (producer)
+ * @param iq_samples Samples
+ * @param num_samples Count (bursts longer than the ring are written in parts)
+ * @return num_samples, or -1 on error
+ */
+int shm_ring_write_burst(shm_ring_t *ring, const float complex *iq_samples, uint32_t num_samples);
+
+/**
+ * @brief Append silence (idle air between bursts)
+ * @param ring Ring (producer)
+ * @param samples Zero samples to write (at most capacity)
+ * @return samples, or -1 on error
+ */
+int shm_ring_write_silence(shm_ring_t *ring, uint32_t samples);
+
+/**
+ * @brief Update the sample rate and frequency advertised to readers
+ * @param ring Ring (producer)
+ * @param sample_rate Hz
+ * @param frequency Hz
+ */
+void shm_ring_set_format(shm_ring_t *ring, uint32_t sample_rate, uint64_t frequency);
+
+// =============================================================================
+// READER
+// =============================================================================
+
+/**
+ * @brief Samples available to read, in place
+ * @param ring Ring (reader)
+ * @param samples Output: pointer to the next sample in the ring
+ * @param max Maximum samples wanted
+ * @return Samples available at *samples (contiguous), 0 if none yet,
+ *         -1 if the producer closed the ring and everything was read
+ *
+ * A reader more than one ring behind the head skips to the oldest sample
+ * still present and counts the skipped samples in overruns.
+ */
+int64_t shm_ring_peek(shm_ring_t *ring, const float complex **samples, uint32_t max);
+
+/**
+ * @brief Release samples returned by shm_ring_peek()
+ * @param ring Ring (reader)
+ * @param samples Samples consumed
+ * @return 0 if they were intact while read, 1 if the producer overwrote
+ *         them meanwhile (only possible without flow control)
+ */
+int shm_ring_release(shm_ring_t *ring, uint32_t samples);
+
+/**
+ * @brief Next burst marker not yet reported
+ * @param ring Ring (reader)
+ * @param marker Output marker
+ * @return 1 if a marker was returned, 0 if none
+ *
+ * Markers older than SHM_RING_MARKERS behind the newest are skipped.
+ */
+int shm_ring_next_marker(shm_ring_t *ring, shm_ring_marker_t *marker);
+
+#endif // SHM_RING_H
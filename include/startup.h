@@ -0,0 +1,107 @@
+/**
+ * @file startup.h
+ * @brief Parallel startup orchestrator
+ *
+ * Runs the startup steps (radio connection and configuration, protocol
+ * tables, first-frame render) as a small dependency graph:
+ * - One thread per task, started as soon as its dependencies completed
+ * - A failed task skips everything depending on it
+ * - Start/end of every task relative to process start, for the
+ *   "time to first RF sample" report
+ * - Serial mode (tasks in order on the calling thread) for comparison
+ */
+
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+#define STARTUP_MAX_TASKS       8
+
+// Task function: 0 on success, -1 on error
+typedef int (*startup_fn_t)(void *arg);
+
+// Task state
+typedef enum {
+    STARTUP_PENDING = 0,
+    STARTUP_RUNNING = 1,
+    STARTUP_DONE = 2,
+    STARTUP_FAILED = 3,
+    STARTUP_SKIPPED = 4                     // A dependency failed
+} startup_state_t;
+
+// Task
+typedef struct {
+    const char *name;
+    startup_fn_t fn;
+    void *arg;
+    uint32_t deps;                          // Bit mask of task indices
+    startup_state_t state;
+    double start_sec;                       // Relative to plan t0
+    double end_sec;
+    pthread_t thread;
+} startup_task_t;
+
+// Plan
+typedef struct {
+    startup_task_t tasks[STARTUP_MAX_TASKS];
+    uint32_t num_tasks;
+    double t0;                              // CLOCK_MONOTONIC seconds (process start)
+    pthread_mutex_t lock;
+    pthread_cond_t cond;                    // A task finished
+} startup_plan_t;
+
+/**
+ * @brief Get CLOCK_MONOTONIC time in seconds
+ * @return Seconds
+ */
+double startup_now(void);
+
+/**
+ * @brief Initialize an empty plan
+ * @param plan Plan
+ * @param t0 Reference time (startup_now() at process start)
+ */
+void startup_init(startup_plan_t *plan, double t0);
+
+/**
+ * @brief Add a task
+ * @param plan Plan
+ * @param name Task name (static string)
+ * @param fn Task function
+ * @param arg Task argument
+ * @param deps Bit mask of tasks that must complete first (1u << index)
+ * @return Task index, or -1 if the plan is full
+ */
+int startup_add(startup_plan_t *plan, const char *name, startup_fn_t fn, void *arg, uint32_t deps);
+
+/**
+ * @brief Run all tasks and wait for them
+ * @param plan Plan
+ * @param parallel 1 = one thread per task, 0 = in order on the calling thread
+ * @return 0 if every task succeeded, -1 otherwise
+ */
+int startup_run(startup_plan_t *plan, int parallel);
+
+/**
+ * @brief Check a task result
+ * @param plan Plan
+ * @param index Task index
+ * @return 1 if the task completed successfully
+ */
+int startup_succeeded(const startup_plan_t *plan, int index);
+
+/**
+ * @brief Print the startup timeline (one line per task)
+ * @param plan Plan
+ */
+void startup_print(const startup_plan_t *plan);
+
+/**
+ * @brief Release plan resources
+ * @param plan Plan
+ */
+void startup_free(startup_plan_t *plan);
+
+#endif // STARTUP_H
@@ -43,6 +43,64 @@ typedef struct {
     uint8_t valid;              // 1=valid, 0=invalid
 } gps_data_t;
 
+// Information field layout (t018_field_layout[], shared by encoder and decoder)
+typedef enum {
+    T018_FIELD_TAC = 0,             // Type Approval Certificate (16 bits)
+    T018_FIELD_SERIAL,              // Serial number (14 bits)
+    T018_FIELD_COUNTRY,             // MID (10 bits)
+    T018_FIELD_HOMING,              // Homing device status (1 bit)
+    T018_FIELD_RLS,                 // RLS capability (1 bit)
+    T018_FIELD_TEST,                // Test protocol flag (1 bit)
+    T018_FIELD_LATITUDE,            // N/S, degrees, 1/32768 degree (23 bits)
+    T018_FIELD_LONGITUDE,           // E/W, degrees, 1/32768 degree (24 bits)
+    T018_FIELD_VESSEL_TYPE,         // Vessel ID type (3 bits)
+    T018_FIELD_VESSEL_ID,           // Vessel ID (30 bits)
+    T018_FIELD_AIS_ID,              // EPIRB-AIS system identity (14 bits)
+    T018_FIELD_BEACON_TYPE,         // Beacon type (3 bits)
+    T018_FIELD_SPARE,               // Spare (14 bits)
+    T018_FIELD_ROTATING_ID,         // Rotating field identifier (4 bits)
+    T018_FIELD_ROTATING_DATA,       // Rotating field content (44 bits)
+    T018_FIELD_COUNT
+} t018_field_t;
+
+// Field position in the 202 information bits
+typedef struct {
+    const char *name;
+    uint8_t offset;                 // First bit (0 = T.018 bit 1)
+    uint8_t width;                  // Bits (<= 48)
+} t018_field_desc_t;
+
+extern const t018_field_desc_t t018_field_layout[T018_FIELD_COUNT];
+
+// Raw field values (lossless view of the information bits)
+typedef struct {
+    uint64_t value[T018_FIELD_COUNT];
+} t018_fields_t;
+
+// Decoded information field (see t018_decode_message())
+typedef struct {
+    uint16_t tac_number;        // Type Approval Certificate (16 bits)
+    uint16_t serial_number;     // Serial (14 bits)
+    uint16_t country_code;      // MID (10 bits)
+    uint8_t homing;             // Homing device status
+    uint8_t rls;                // RLS capability
+    uint8_t test_protocol;      // Test protocol flag
+    gps_data_t position;        // Encoded position (altitude not carried)
+    uint8_t vessel_id_type;     // Vessel ID type (3 bits)
+    uint32_t vessel_id;         // Vessel ID (30 bits)
+    uint16_t ais_id;            // EPIRB-AIS system identity (14 bits)
+    uint8_t beacon_type;        // Beacon type (3 bits)
+    uint16_t spare;             // Spare bits (14 bits)
+    uint8_t rotating_field;     // Rotating field identifier (4 bits)
+    uint64_t rotating_data;     // Rotating field content (44 bits)
+} t018_message_t;
+
+// 23 HEX beacon ID (92 bits, T.018 Table 3.9)
+typedef struct {
+    uint64_t hi;                // '1', MID, '101', TAC, serial, test flag, vessel ID type (48 bits)
+    uint64_t lo;                // Vessel ID field (44 bits)
+} t018_beacon_id_t;
+
 // Beacon configuration
 typedef struct {
     beacon_type_t type;         // Beacon type
@@ -79,6 +137,115 @@ void t018_calculate_bch(const uint8_t *info_bits, uint8_t *parity_bits);
  */
 uint8_t t018_verify_bch(const uint8_t *frame_bits);
 
+/**
+ * @brief Correct a received BCH(250,202) codeword in place
+ * @param codeword 250 bits (202 info + 48 BCH), one bit per byte
+ * @return Number of bit errors corrected (0-6), -1 if uncorrectable
+ *
+ * Syndromes over GF(2^8), Berlekamp-Massey and Chien search. Thread-safe.
+ */
+int t018_bch_correct(uint8_t *codeword);
+
+/**
+ * @brief Decode the 202 information bits into fields
+ * @param info_bits 202 information bits (same layout as t018_build_frame())
+ * @param msg Output fields
+ */
+void t018_decode_message(const uint8_t *info_bits, t018_message_t *msg);
+
+/**
+ * @brief Encode fields into the 202 information bits (inverse of t018_decode_message())
+ * @param msg Fields
+ * @param info_bits Output, 202 bits one per byte
+ */
+void t018_encode_message(const t018_message_t *msg, uint8_t *info_bits);
+
+/**
+ * @brief Convert raw field values to message fields
+ * @param fields Raw values
+ * @param msg Output fields
+ */
+void t018_fields_to_message(const t018_fields_t *fields, t018_message_t *msg);
+
+/**
+ * @brief Convert message fields to raw field values
+ * @param msg Fields
+ * @param fields Output raw values
+ */
+void t018_message_to_fields(const t018_message_t *msg, t018_fields_t *fields);
+
+/**
+ * @brief Write raw field values into the information bits
+ * @param fields Raw values (masked to the field widths)
+ * @param info_bits Output, 202 bits one per byte
+ */
+void t018_pack_fields(const t018_fields_t *fields, uint8_t *info_bits);
+
+/**
+ * @brief Read raw field values from the information bits
+ * @param info_bits 202 bits one per byte
+ * @param fields Output raw values
+ */
+void t018_unpack_fields(const uint8_t *info_bits, t018_fields_t *fields);
+
+/**
+ * @brief Read raw field values from packed bits
+ * @param bytes Packed bits, MSB first (readable up to 8 bytes past the last field byte)
+ * @param bit_offset Position of information bit 0
+ * @param fields Output raw values
+ */
+void t018_unpack_fields_packed(const uint8_t *bytes, uint32_t bit_offset, t018_fields_t *fields);
+
+/**
+ * @brief BCH(250,202) parity of packed information bits (table driven)
+ * @param bytes Packed bits, MSB first (same padding as t018_unpack_fields_packed())
+ * @param bit_offset Position of information bit 0
+ * @return 48 parity bits, first transmitted bit in bit 47
+ */
+uint64_t t018_bch_parity_packed(const uint8_t *bytes, uint32_t bit_offset);
+
+/**
+ * @brief Read up to 57 packed bits
+ * @param bytes Packed bits, MSB first (8 bytes readable from bit_offset / 8)
+ * @param bit_offset First bit
+ * @param width Number of bits (1..57)
+ * @return Bits, first one most significant
+ */
+static inline uint64_t t018_read_packed(const uint8_t *bytes, uint32_t bit_offset, uint32_t width) {
+    const uint8_t *p = bytes + bit_offset / 8;
+    uint64_t w = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) |
+                 ((uint64_t)p[3] << 32) | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+                 ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+    return (w << (bit_offset % 8)) >> (64 - width);
+}
+
+/**
+ * @brief Print decoded fields
+ * @param msg Decoded message
+ */
+void t018_print_message(const t018_message_t *msg);
+
+/**
+ * @brief Derive the 23 HEX beacon ID from the information bits
+ * @param info_bits 202 information bits (same layout as t018_build_frame())
+ * @param id Output ID
+ */
+void t018_beacon_id(const uint8_t *info_bits, t018_beacon_id_t *id);
+
+/**
+ * @brief Derive the 23 HEX beacon ID from raw field values
+ * @param fields Raw values (t018_unpack_fields() or t018_unpack_fields_packed())
+ * @param id Output ID
+ */
+void t018_beacon_id_from_fields(const t018_fields_t *fields, t018_beacon_id_t *id);
+
+/**
+ * @brief Format a beacon ID as 23 hex digits
+ * @param id Beacon ID
+ * @param hex Output string (at least 24 bytes)
+ */
+void t018_format_beacon_id(const t018_beacon_id_t *id, char *hex);
+
 /**
  * @brief Encode GPS position (T.018 format)
  * @param position GPS data
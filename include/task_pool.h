@@ -0,0 +1,159 @@
+/**
+ * @file task_pool.h
+ * @brief Work-stealing task pool
+ *
+ * Shared parallel runtime for rendering, batch generation and analysis:
+ * - One deque per worker: a worker pushes and pops its own tasks at the
+ *   bottom (LIFO, cache-warm), idle workers steal from the top of others
+ * - Task groups: spawn any number of tasks, wait for all of them; a waiting
+ *   thread executes queued tasks instead of blocking, so groups nest
+ *   (a task may spawn and wait on its own group)
+ * - Parallel-for over index ranges (chips, samples, frames) with a fixed
+ *   grain, so results do not depend on the thread count
+ * - Optional CPU affinity (worker n pinned to CPU n)
+ *
+ * A pool of n threads starts n - 1 workers: the thread waiting on a group
+ * is the n-th. A 1-thread pool runs every task inline.
+ */
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define TASK_POOL_MAX_THREADS   64
+#define TASK_DEQUE_INITIAL      64          // Tasks per deque (grows)
+
+// Task function
+typedef void (*task_fn_t)(void *arg);
+
+// Parallel-for body: processes [begin, end)
+typedef void (*task_range_fn_t)(void *ctx, uint32_t begin, uint32_t end);
+
+// Task group (completion counter)
+typedef struct {
+    atomic_uint pending;                    // Spawned and not yet finished
+} task_group_t;
+
+// Queued task
+typedef struct {
+    task_fn_t fn;
+    void *arg;
+    task_group_t *group;
+} task_t;
+
+// Per-worker deque (bottom = owner end, top = steal end)
+typedef struct {
+    pthread_mutex_t lock;
+    task_t *tasks;                          // Ring buffer
+    uint32_t capacity;
+    uint32_t top;                           // Index of the oldest task
+    uint32_t count;
+} task_deque_t;
+
+// Per-thread counters
+typedef struct {
+    atomic_ullong executed;                 // Tasks run
+    atomic_ullong stolen;                   // Tasks taken from another deque
+} task_worker_stats_t;
+
+struct task_pool;
+
+// Worker thread
+typedef struct {
+    struct task_pool *pool;
+    uint32_t index;
+    pthread_t thread;
+} task_worker_t;
+
+// Pool
+typedef struct task_pool {
+    uint32_t num_threads;                   // Workers + the waiting caller
+    uint32_t num_workers;
+    task_worker_t *workers;
+    task_deque_t *deques;                   // num_workers + 1 (last: external threads)
+    task_worker_stats_t *stats;             // num_workers + 1
+    atomic_uint queued;                     // Tasks in all deques
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;               // Work available / stop
+    uint8_t stop;
+    uint8_t pinned;                         // CPU affinity applied
+} task_pool_t;
+
+/**
+ * @brief Start a pool
+ * @param pool Pool
+ * @param threads Total threads including the caller (0 = online CPUs)
+ * @param pin_cpus 1 = pin worker n to CPU n (the caller stays unpinned)
+ * @return 0 on success, -1 on error
+ */
+int task_pool_init(task_pool_t *pool, uint32_t threads, int pin_cpus);
+
+/**
+ * @brief Stop workers and release the pool (no group may be pending)
+ * @param pool Pool
+ */
+void task_pool_destroy(task_pool_t *pool);
+
+/**
+ * @brief Initialize a task group
+ * @param group Group
+ */
+void task_group_init(task_group_t *group);
+
+/**
+ * @brief Queue a task in a group
+ * @param pool Pool
+ * @param group Group (task_pool_wait() must be called on it)
+ * @param fn Task function
+ * @param arg Task argument
+ */
+void task_pool_spawn(task_pool_t *pool, task_group_t *group, task_fn_t fn, void *arg);
+
+/**
+ * @brief Run queued tasks until every task of the group has finished
+ * @param pool Pool
+ * @param group Group
+ */
+void task_pool_wait(task_pool_t *pool, task_group_t *group);
+
+/**
+ * @brief Parallel loop over [begin, end) in chunks of grain indices
+ * @param pool Pool (NULL = run inline)
+ * @param begin First index
+ * @param end End index (exclusive)
+ * @param grain Indices per task (0 = split into 4 chunks per thread)
+ * @param fn Body called once per chunk
+ * @param ctx Body context
+ */
+void task_pool_parallel_for(task_pool_t *pool, uint32_t begin, uint32_t end, uint32_t grain,
+                            task_range_fn_t fn, void *ctx);
+
+/**
+ * @brief Configure the process-wide pool (before its first use)
+ * @param threads Total threads (0 = online CPUs)
+ * @param pin_cpus Pin workers to CPUs
+ */
+void task_pool_configure_default(uint32_t threads, int pin_cpus);
+
+/**
+ * @brief Use a caller-owned pool as the process-wide pool (benchmarks)
+ * @param pool Pool, or NULL to return to the configured default pool
+ */
+void task_pool_set_default(task_pool_t *pool);
+
+/**
+ * @brief Process-wide pool shared by the DSP modules (started on first use)
+ * @return Pool, or NULL if it could not be started (callers then run inline)
+ */
+task_pool_t *task_pool_default(void);
+
+/**
+ * @brief Print per-thread task counters
+ * @param pool Pool
+ */
+void task_pool_print_stats(const task_pool_t *pool);
+
+#endif // TASK_POOL_H
@@ -0,0 +1,63 @@
+/**
+ * @file trace.h
+ * @brief Chrome/Perfetto trace-event timeline of the burst pipeline
+ *
+ * Each thread appends begin/end events to its own fixed-size buffer (no
+ * locks, no allocation after the first event of a thread). trace_stop()
+ * writes every buffer as Chrome trace-event JSON, which opens directly in
+ * https://ui.perfetto.dev or chrome://tracing.
+ *
+ * The TRACE_* macros compile to nothing unless SGB_TRACE is defined
+ * (make trace). Event names must be string literals or otherwise outlive
+ * the trace.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#define TRACE_BUFFER_EVENTS     32768       // Events per thread (24 bytes each)
+#define TRACE_THREAD_NAME_LEN   32
+
+#ifdef SGB_TRACE
+#define TRACE_BEGIN(name)           trace_event((name), 'B')
+#define TRACE_END(name)             trace_event((name), 'E')
+#define TRACE_INSTANT(name)         trace_event((name), 'i')
+#define TRACE_THREAD_NAME(name)     trace_thread_name(name)
+#else
+#define TRACE_BEGIN(name)           ((void)0)
+#define TRACE_END(name)             ((void)0)
+#define TRACE_INSTANT(name)         ((void)0)
+#define TRACE_THREAD_NAME(name)     ((void)0)
+#endif
+
+/**
+ * @brief Start recording (events before this call are ignored)
+ * @param path Output JSON file written by trace_stop()
+ * @return 0 on success, -1 if tracing is not compiled in
+ */
+int trace_start(const char *path);
+
+/**
+ * @brief Stop recording and write the JSON file
+ * @return Number of events written, -1 on error or if not started
+ *
+ * Call once all traced threads are idle or joined.
+ */
+int trace_stop(void);
+
+/**
+ * @brief Record one event for the calling thread (use the TRACE_* macros)
+ * @param name Event name (static string)
+ * @param phase 'B' begin, 'E' end, 'i' instant
+ */
+void trace_event(const char *name, char phase);
+
+/**
+ * @brief Name the calling thread in the timeline
+ * @param name Thread name (copied)
+ */
+void trace_thread_name(const char *name);
+
+#endif // TRACE_H
@@ -0,0 +1,133 @@
+/**
+ * @file tx_fanout.h
+ * @brief Multi-radio fan-out (one TX thread per SDR device)
+ *
+ * Drives several PlutoSDR devices (or null backends) concurrently:
+ * - One TX thread and one pluto_ctx_t per device
+ * - Each device carries its own beacon set (list of serial numbers)
+ * - Bursts are rendered once per cycle and shared read-only by all devices
+ *   transmitting the same beacon
+ * - Per-device metrics (bursts, failures, push time, throughput)
+ * - Each device reconnects on its own (sdr_session_t): bursts for a device
+ *   that is offline are counted as missed, the other devices keep going
+ */
+
+#ifndef TX_FANOUT_H
+#define TX_FANOUT_H
+
+#include <stdint.h>
+#include <complex.h>
+#include <pthread.h>
+#include "sdr_session.h"
+#include "tx_journal.h"
+
+// Fan-out limits
+#define FANOUT_MAX_DEVICES      8           // SDR devices per process
+#define FANOUT_MAX_BEACONS      8           // Beacons per device
+
+// Rendered burst (shared read-only between device threads)
+typedef struct {
+    uint32_t serial_number;                 // Beacon serial
+    const float complex *iq_samples;        // I/Q samples
+    uint32_t num_samples;                   // Number of samples
+    uint8_t frame[TX_JOURNAL_FRAME_BYTES];  // Packed frame bits (transmission journal)
+} fanout_burst_t;
+
+// Per-device metrics
+typedef struct {
+    uint64_t bursts;                        // Bursts transmitted
+    uint64_t failures;                      // Failed bursts
+    uint64_t missed;                        // Bursts dropped (radio offline)
+    uint64_t samples;                       // Samples pushed
+    double busy_sec;                        // Time spent in pluto_transmit_iq()
+    double last_cycle_ms;                   // Duration of last cycle
+    double max_cycle_ms;                    // Worst cycle duration
+} fanout_metrics_t;
+
+struct tx_fanout;
+
+// SDR device
+typedef struct {
+    char uri[128];                          // Device URI (ip:, usb:, null:)
+    uint32_t serials[FANOUT_MAX_BEACONS];   // Beacon set
+    uint32_t num_beacons;                   // Beacons in set
+    const fanout_burst_t *bursts[FANOUT_MAX_BEACONS];  // Current cycle bursts
+    uint16_t outcome[FANOUT_MAX_BEACONS];   // TX_JOURNAL_SENT/OFFLINE/FAILED of each burst
+    sdr_session_t session;                  // Device session (auto-reconnect)
+    fanout_metrics_t metrics;               // Metrics (written by device thread)
+    pthread_t thread;                       // TX thread
+    uint8_t thread_started;                 // Thread running
+    struct tx_fanout *fanout;               // Owner
+} tx_device_t;
+
+// Fan-out controller
+typedef struct tx_fanout {
+    tx_device_t devices[FANOUT_MAX_DEVICES];
+    uint32_t num_devices;
+    pthread_mutex_t lock;
+    pthread_cond_t start_cond;              // Signals a new cycle
+    pthread_cond_t done_cond;               // Signals cycle completion
+    uint64_t cycle;                         // Cycle generation counter
+    uint32_t pending;                       // Devices still transmitting
+    uint32_t cycle_failures;                // Devices that failed this cycle
+    uint8_t stop;                           // Thread shutdown request
+} tx_fanout_t;
+
+/**
+ * @brief Initialize fan-out controller
+ * @param fanout Fan-out controller
+ */
+void fanout_init(tx_fanout_t *fanout);
+
+/**
+ * @brief Add a device from a "<uri>[@serial[,serial...]]" specification
+ * @param fanout Fan-out controller
+ * @param spec Device specification (e.g. "ip:192.168.2.1@13398,13399")
+ * @param default_serial Serial used when the spec has no beacon set
+ * @return 0 on success, -1 on error
+ */
+int fanout_add_device(tx_fanout_t *fanout, const char *spec, uint32_t default_serial);
+
+/**
+ * @brief Connect and configure all devices, start TX threads
+ * @param fanout Fan-out controller
+ * @param frequency TX frequency in Hz
+ * @param gain_db TX attenuation in dB
+ * @param sample_rate Sample rate in Hz
+ * @return 0 on success, -1 on error
+ */
+int fanout_start(tx_fanout_t *fanout, uint64_t frequency, int32_t gain_db, uint32_t sample_rate);
+
+/**
+ * @brief Transmit one cycle on all devices concurrently
+ * @param fanout Fan-out controller
+ * @param bursts Rendered bursts (one per distinct serial)
+ * @param num_bursts Number of bursts
+ * @return Number of devices that failed, -1 on error
+ *
+ * Blocks until every device has pushed its beacon set.
+ */
+int fanout_transmit(tx_fanout_t *fanout, const fanout_burst_t *bursts, uint32_t num_bursts);
+
+/**
+ * @brief Outcome of one burst of the last cycle across the devices carrying it
+ * @param fanout Fan-out controller (no cycle in flight)
+ * @param serial Beacon serial
+ * @param devices Output: devices that pushed the burst
+ * @return TX_JOURNAL_SENT / OFFLINE / FAILED flags, one per outcome seen
+ */
+uint16_t fanout_burst_outcome(const tx_fanout_t *fanout, uint32_t serial, uint16_t *devices);
+
+/**
+ * @brief Print per-device metrics table
+ * @param fanout Fan-out controller
+ */
+void fanout_print_metrics(tx_fanout_t *fanout);
+
+/**
+ * @brief Stop TX threads and release devices
+ * @param fanout Fan-out controller
+ */
+void fanout_stop(tx_fanout_t *fanout);
+
+#endif // TX_FANOUT_H
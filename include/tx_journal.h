@@ -0,0 +1,151 @@
+/**
+ * @file tx_journal.h
+ * @brief Append-only binary transmission journal (mmap'd, fixed-size records)
+ *
+ * One 128-byte record per transmitted burst, for post-exercise audits:
+ * - Push start in CLOCK_MONOTONIC and UTC, scheduled deadline, timing slack
+ * - Frequency, gain, serial, packed frame bits, 64-bit hash of the samples
+ * - One header page, then the records; the file is preallocated
+ *   (posix_fallocate) and mapped shared, so appending is a memory copy.
+ *   Full journals grow by doubling.
+ * - The sequence number is stored last: a record is valid once its seq is
+ *   non-zero, even if the process dies before the header count is updated
+ * - msync(MS_ASYNC) after each record, MS_SYNC every TX_JOURNAL_SYNC_SEC
+ *   and on close
+ *
+ * Readers (tools/tx_journal_query) map the file read-only, also while the
+ * transmitter appends.
+ */
+
+#ifndef TX_JOURNAL_H
+#define TX_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TX_JOURNAL_MAGIC            "SGBJRNL1"
+#define TX_JOURNAL_VERSION          1
+#define TX_JOURNAL_HEADER_SIZE      4096        // Header page before the records
+#define TX_JOURNAL_RECORD_SIZE      128
+#define TX_JOURNAL_DEFAULT_RECORDS  65536       // 8 MiB preallocated (~7.5 days at 10 s)
+#define TX_JOURNAL_SYNC_SEC         30          // MS_SYNC period
+#define TX_JOURNAL_FRAME_BYTES      32          // 252 frame bits, MSB first
+#define TX_JOURNAL_LATE_US          1000        // Slack below -1 ms = missed deadline (as the daemon)
+
+// Record flags
+#define TX_JOURNAL_SENT             0x0001      // Pushed to the radio (one device or more)
+#define TX_JOURNAL_OFFLINE          0x0002      // Radio offline, burst missed (one device or more)
+#define TX_JOURNAL_FAILED           0x0004      // Push failed (one device or more)
+#define TX_JOURNAL_REUSED           0x0008      // Startup render transmitted
+#define TX_JOURNAL_FANOUT           0x0010      // Multi-radio fan-out cycle
+
+// File header (first page)
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;                      // Records preallocated
+    uint64_t count;                         // Records committed (may lag by the last few)
+    int64_t created_utc_ns;
+} tx_journal_header_t;
+
+// One burst
+typedef struct {
+    uint64_t seq;                           // 1-based, written last (0 = free slot)
+    int64_t utc_ns;                         // CLOCK_REALTIME at push start
+    int64_t mono_ns;                        // CLOCK_MONOTONIC at push start
+    int64_t deadline_ns;                    // Scheduled first RF sample (CLOCK_MONOTONIC)
+    uint64_t frequency;                     // Hz
+    uint64_t waveform_hash;                 // tx_journal_hash() of the pushed samples
+    int32_t slack_us;                       // Deadline - push start (< 0 = late)
+    uint32_t render_us;                     // Render time of the cycle
+    int32_t gain_db;                        // TX gain (attenuation, dB)
+    uint32_t serial_number;
+    uint32_t output_rate;                   // Hz
+    uint32_t num_samples;
+    uint32_t cycle;                         // Transmission number (daemon counter)
+    uint16_t flags;                         // TX_JOURNAL_*
+    uint16_t devices;                       // Radios the burst was pushed to
+    uint8_t frame[TX_JOURNAL_FRAME_BYTES];  // Frame bits (2 header + 250)
+    uint8_t reserved[16];
+} tx_journal_record_t;
+
+_Static_assert(sizeof(tx_journal_record_t) == TX_JOURNAL_RECORD_SIZE, "journal record size");
+
+// Open journal (writer or read-only reader)
+typedef struct {
+    int fd;
+    uint8_t *map;                           // Header page + records
+    size_t map_size;
+    uint64_t capacity;                      // Records mapped
+    uint64_t count;                         // Records valid
+    uint64_t synced;                        // Records covered by the last MS_SYNC
+    double last_sync;                       // CLOCK_MONOTONIC seconds
+    uint8_t writable;
+    char path[256];
+} tx_journal_t;
+
+/**
+ * @brief Open or create a journal for appending
+ * @param j Journal
+ * @param path File path
+ * @param records Records to preallocate when creating (0 = TX_JOURNAL_DEFAULT_RECORDS)
+ * @return 0 on success, -1 on error
+ *
+ * An existing journal is resumed after its last valid record.
+ */
+int tx_journal_open(tx_journal_t *j, const char *path, uint64_t records);
+
+/**
+ * @brief Map a journal read-only
+ * @param j Journal
+ * @param path File path
+ * @return 0 on success, -1 on error
+ */
+int tx_journal_open_read(tx_journal_t *j, const char *path);
+
+/**
+ * @brief Append one record
+ * @param j Journal opened with tx_journal_open()
+ * @param rec Record (seq is assigned)
+ * @return 0 on success, -1 on error (journal full and cannot grow)
+ */
+int tx_journal_append(tx_journal_t *j, tx_journal_record_t *rec);
+
+/**
+ * @brief Flush appended records to disk (MS_SYNC of the dirty range)
+ * @param j Journal
+ */
+void tx_journal_sync(tx_journal_t *j);
+
+/**
+ * @brief Sync, unmap and close (no-op if not open)
+ * @param j Journal
+ */
+void tx_journal_close(tx_journal_t *j);
+
+/**
+ * @brief Records of an open journal
+ * @param j Journal
+ * @return j->count records
+ */
+static inline const tx_journal_record_t *tx_journal_records(const tx_journal_t *j) {
+    return (const tx_journal_record_t *)(j->map + TX_JOURNAL_HEADER_SIZE);
+}
+
+/**
+ * @brief Pack frame bits, one per byte, MSB first
+ * @param frame_bits T018_FRAME_BITS bits
+ * @param packed Output, TX_JOURNAL_FRAME_BYTES bytes
+ */
+void tx_journal_pack_frame(const uint8_t *frame_bits, uint8_t *packed);
+
+/**
+ * @brief 64-bit hash of a sample buffer (identifies a waveform, not cryptographic)
+ * @param data Samples
+ * @param bytes Size in bytes
+ * @return Hash
+ */
+uint64_t tx_journal_hash(const void *data, size_t bytes);
+
+#endif // TX_JOURNAL_H
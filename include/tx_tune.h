@@ -0,0 +1,87 @@
+/**
+ * @file tx_tune.h
+ * @brief TX push calibration (chunk size, kernel buffers) with a per-URI cache
+ *
+ * The best libiio push size depends on the link (USB or network URI) and on
+ * the number of kernel buffers queued ahead of the DAC. Calibration pushes
+ * silence with each candidate and measures, after the kernel queue is full:
+ * - Sustained throughput (must keep up with the sample rate)
+ * - Push time jitter (standard deviation of the push duration)
+ * - Headroom: samples queued in the kernel must outlast the slowest push
+ *
+ * The steadiest candidate that keeps up wins; near-equal candidates resolve
+ * to the one buffering the fewest samples (lowest latency). Results are kept
+ * per URI in a small text cache and applied at the next start.
+ */
+
+#ifndef TX_TUNE_H
+#define TX_TUNE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pluto_control.h"
+
+#define TX_TUNE_SECONDS         0.25        // Minimum silence pushed per candidate
+#define TX_TUNE_MIN_PUSHES      8           // Timed pushes per candidate (queue full)
+#define TX_TUNE_REALTIME_MIN    0.98        // Sustained throughput needed (× sample rate)
+#define TX_TUNE_HEADROOM_MS     10.0        // Queued time left at the slowest push (IIO)
+#define TX_TUNE_JITTER_TOL      1.10        // Within 10% of the best jitter...
+#define TX_TUNE_JITTER_FLOOR_MS 0.05        // ...or 50 µs: prefer less buffering
+#define TX_TUNE_CACHE_ENTRIES   32          // URIs kept in the cache file
+#define TX_TUNE_CACHE_NAME      "sarsat_sgb/tx_tune"  // Under $XDG_CACHE_HOME or ~/.cache
+#define TX_TUNE_PUSH_FAILED     -2          // tx_tune_run(): link lost
+
+// Measured candidate
+typedef struct {
+    uint32_t chunk_size;                    // Samples per push
+    uint32_t kernel_buffers;                // 0 = libiio default
+    double throughput;                      // Sustained samples/s
+    double jitter_ms;                       // Push duration standard deviation
+    double max_push_ms;                     // Slowest push
+} tx_tune_result_t;
+
+/**
+ * @brief Check whether a backend has push settings to calibrate
+ * @param ctx PlutoSDR context
+ * @return 1 for IIO and null backends
+ */
+int tx_tune_supported(const pluto_ctx_t *ctx);
+
+/**
+ * @brief Measure every candidate, apply the best one
+ * @param ctx PlutoSDR context (configured, TX idle)
+ * @param best Output: selected candidate
+ * @return 0 on success, -1 if nothing kept up (settings unchanged),
+ *         TX_TUNE_PUSH_FAILED if a push failed (link lost)
+ *
+ * Pushes a few seconds of silence in total on a radio.
+ */
+int tx_tune_run(pluto_ctx_t *ctx, tx_tune_result_t *best);
+
+/**
+ * @brief Default cache file path
+ * @param path Output path
+ * @param size Size of path
+ * @return 0 on success, -1 if neither $XDG_CACHE_HOME nor $HOME is set
+ */
+int tx_tune_cache_path(char *path, size_t size);
+
+/**
+ * @brief Look up the calibration of a URI
+ * @param path Cache file
+ * @param uri Device URI
+ * @param result Output: cached candidate
+ * @return 1 if found, 0 if not (or no cache file yet)
+ */
+int tx_tune_cache_load(const char *path, const char *uri, tx_tune_result_t *result);
+
+/**
+ * @brief Store the calibration of a URI (replaces its previous entry)
+ * @param path Cache file (parent directories created)
+ * @param uri Device URI
+ * @param result Candidate to store
+ * @return 0 on success, -1 on error
+ */
+int tx_tune_cache_store(const char *path, const char *uri, const tx_tune_result_t *result);
+
+#endif // TX_TUNE_H
@@ -0,0 +1,114 @@
+/**
+ * @file bch_bitslice.c
+ * @brief Bitsliced BCH(250,202) encoder implementation
+ *
+ * The code is linear: parity(m) = Σ m_i · (x^(48+201-i) mod g(x)). Reading
+ * the 202 syndrome columns row by row gives, for each parity bit, the list
+ * of information bits it depends on; in bitsliced form each list entry is
+ * one lane XOR covering every frame of the block.
+ */
+
+#include "bch_bitslice.h"
+#include <string.h>
+#include <pthread.h>
+
+#define BCH_PARITY_MASK     0xFFFFFFFFFFFFULL
+
+// Information bits feeding each parity bit (built once from g(x))
+static uint8_t taps[BCH_PARITY_BITS][BCH_INFO_BITS];
+static uint8_t num_taps[BCH_PARITY_BITS];
+static pthread_once_t taps_once = PTHREAD_ONCE_INIT;
+
+static void build_taps(void) {
+    // Column of the last information bit is x^48 mod g(x); each earlier bit
+    // is one more multiplication by x
+    uint64_t column = BCH_GENERATOR_POLY & BCH_PARITY_MASK;
+    for (int i = BCH_INFO_BITS - 1; i >= 0; i--) {
+        for (int j = 0; j < BCH_PARITY_BITS; j++) {
+            if ((column >> (BCH_PARITY_BITS - 1 - j)) & 1) {
+                taps[j][num_taps[j]++] = (uint8_t)i;
+            }
+        }
+        column = (column & (1ULL << 47)) ? ((column << 1) ^ BCH_GENERATOR_POLY) & BCH_PARITY_MASK
+                                         : column << 1;
+    }
+}
+
+// =============================================================================
+// SLICED ENCODER
+// =============================================================================
+
+void bch_slice_encode(const bch_lane_t info[BCH_INFO_BITS], bch_lane_t parity[BCH_PARITY_BITS]) {
+    pthread_once(&taps_once, build_taps);
+
+    for (int j = 0; j < BCH_PARITY_BITS; j++) {
+        const uint8_t *t = taps[j];
+        bch_lane_t acc = info[t[0]];
+        for (uint32_t k = 1; k < num_taps[j]; k++) {
+            acc ^= info[t[k]];
+        }
+        parity[j] = acc;
+    }
+}
+
+// =============================================================================
+// FRAME-MAJOR WRAPPER
+// =============================================================================
+
+void bch_slice_transpose64(uint64_t m[64]) {
+    // Swap off-diagonal blocks of 32, 16, ... 1 bits (Hacker's Delight 7-3)
+    uint64_t mask = 0x00000000FFFFFFFFULL;
+    for (uint32_t j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+        for (uint32_t k = 0; k < 64; k = (k + j + 1) & ~j) {
+            uint64_t t = (m[k] ^ (m[k + j] >> j)) & mask;
+            m[k] ^= t;
+            m[k + j] ^= t << j;
+        }
+    }
+}
+
+void bch_slice_parity(const uint64_t *info, uint32_t count, uint64_t *parity) {
+    bch_lane_t lanes[BCH_SLICE_INFO_WORDS * 64];
+    bch_lane_t out[BCH_PARITY_BITS];
+    uint64_t block[64];
+
+    for (uint32_t base = 0; base < count; base += BCH_SLICE_FRAMES) {
+        // 64 frames per lane element: one transpose per information word
+        for (uint32_t e = 0; e < BCH_SLICE_WORDS; e++) {
+            uint32_t first = base + 64 * e;
+            for (uint32_t w = 0; w < BCH_SLICE_INFO_WORDS; w++) {
+                uint64_t diff = 0;
+                for (uint32_t r = 0; r < 64; r++) {
+                    block[r] = (first + r < count) ? info[(size_t)(first + r) * BCH_SLICE_INFO_WORDS + w] : 0;
+                    diff |= block[r] ^ block[0];
+                }
+                if (diff == 0) {
+                    // Same word in every frame (fixed fields): broadcast its bits
+                    for (uint32_t c = 0; c < 64; c++) {
+                        lanes[64 * w + c][e] = 0 - ((block[0] >> (63 - c)) & 1);
+                    }
+                    continue;
+                }
+                bch_slice_transpose64(block);
+                for (uint32_t c = 0; c < 64; c++) {
+                    lanes[64 * w + c][e] = block[c];
+                }
+            }
+        }
+
+        bch_slice_encode(lanes, out);
+
+        for (uint32_t e = 0; e < BCH_SLICE_WORDS; e++) {
+            uint32_t first = base + 64 * e;
+            if (first >= count) break;
+            for (uint32_t j = 0; j < BCH_PARITY_BITS; j++) {
+                block[j] = out[j][e];
+            }
+            memset(&block[BCH_PARITY_BITS], 0, (64 - BCH_PARITY_BITS) * sizeof(uint64_t));
+            bch_slice_transpose64(block);
+            for (uint32_t r = 0; r < 64 && first + r < count; r++) {
+                parity[first + r] = block[r] >> (64 - BCH_PARITY_BITS);
+            }
+        }
+    }
+}
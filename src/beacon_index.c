@@ -0,0 +1,255 @@
+/**
+ * @file beacon_index.c
+ * @brief Decoded-beacon index implementation
+ *
+ * Entries never move once allocated: the hash table holds entry indices,
+ * so deletion (backward-shift, no tombstones) only rewrites slots and the
+ * timing wheel lists stay valid.
+ *
+ * Wheel: an entry sits in exactly one bucket list. Refreshing an entry does
+ * not relink it; when its bucket comes round again the entry is either
+ * dropped (idle for a full turn) or moved to the bucket of its last burst.
+ */
+
+#include "beacon_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// =============================================================================
+// HASHING
+// =============================================================================
+
+static inline uint32_t hash_id(const t018_beacon_id_t *id) {
+    // splitmix64 finalizer over both halves
+    uint64_t x = id->hi * 0x9E3779B97F4A7C15ULL ^ id->lo;
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return (uint32_t)x;
+}
+
+static inline int same_id(const t018_beacon_id_t *a, const t018_beacon_id_t *b) {
+    return a->hi == b->hi && a->lo == b->lo;
+}
+
+// Slot holding the ID, or the empty slot where it would go
+static uint32_t find_slot(const beacon_index_t *idx, const t018_beacon_id_t *id) {
+    uint32_t i = hash_id(id) & idx->mask;
+    while (idx->slots[i] && !same_id(&idx->entries[idx->slots[i] - 1].id, id)) {
+        i = (i + 1) & idx->mask;
+    }
+    return i;
+}
+
+// =============================================================================
+// INITIALIZATION
+// =============================================================================
+
+int beacon_index_init(beacon_index_t *idx, uint32_t capacity, double expiry, double dedup_window) {
+    if (!idx || capacity == 0 || capacity > (1u << 30) || expiry <= 0.0 || dedup_window < 0.0) {
+        fprintf(stderr, "Invalid beacon index parameters\n");
+        return -1;
+    }
+
+    memset(idx, 0, sizeof(beacon_index_t));
+
+    // Table at least twice the capacity: probes stay short at full load
+    uint32_t size = 1;
+    while (size < 2 * capacity) {
+        size <<= 1;
+    }
+
+    idx->entries = calloc(capacity, sizeof(beacon_entry_t));
+    idx->slots = calloc(size, sizeof(uint32_t));
+    if (!idx->entries || !idx->slots) {
+        fprintf(stderr, "Failed to allocate beacon index (%u beacons)\n", capacity);
+        beacon_index_free(idx);
+        return -1;
+    }
+
+    idx->capacity = capacity;
+    idx->mask = size - 1;
+    idx->free_head = BEACON_INDEX_NONE;
+    idx->expiry = expiry;
+    idx->dedup_window = dedup_window;
+    idx->bucket_width = expiry / BEACON_INDEX_BUCKETS;
+    idx->tick = -1;
+    for (int b = 0; b < BEACON_INDEX_BUCKETS; b++) {
+        idx->wheel[b] = BEACON_INDEX_NONE;
+    }
+    return 0;
+}
+
+// =============================================================================
+// EXPIRY
+// =============================================================================
+
+static inline int64_t tick_of(const beacon_index_t *idx, double t) {
+    return (int64_t)floor(t / idx->bucket_width);
+}
+
+static inline uint32_t bucket_of(int64_t tick) {
+    return (uint32_t)(((tick % BEACON_INDEX_BUCKETS) + BEACON_INDEX_BUCKETS) % BEACON_INDEX_BUCKETS);
+}
+
+static void remove_entry(beacon_index_t *idx, uint32_t e) {
+    uint32_t i = find_slot(idx, &idx->entries[e].id);
+
+    // Backward-shift deletion: pull later members of the probe run into the hole
+    uint32_t j = i;
+    for (;;) {
+        j = (j + 1) & idx->mask;
+        if (!idx->slots[j]) {
+            break;
+        }
+        uint32_t home = hash_id(&idx->entries[idx->slots[j] - 1].id) & idx->mask;
+        // Movable unless its home lies cyclically in (i, j]
+        if (((j - home) & idx->mask) >= ((j - i) & idx->mask)) {
+            idx->slots[i] = idx->slots[j];
+            i = j;
+        }
+    }
+    idx->slots[i] = 0;
+
+    idx->entries[e].bursts = 0;
+    idx->entries[e].next = idx->free_head;
+    idx->free_head = e;
+    idx->count--;
+    idx->expired++;
+}
+
+static void process_bucket(beacon_index_t *idx, int64_t tick, int64_t now_tick) {
+    uint32_t b = bucket_of(tick);
+    uint32_t e = idx->wheel[b];
+    idx->wheel[b] = BEACON_INDEX_NONE;
+
+    while (e != BEACON_INDEX_NONE) {
+        beacon_entry_t *entry = &idx->entries[e];
+        uint32_t next = entry->next;
+        int64_t last = tick_of(idx, entry->last_seen);
+
+        if (last + BEACON_INDEX_BUCKETS <= now_tick) {
+            remove_entry(idx, e);
+        } else {
+            uint32_t to = bucket_of(last);
+            entry->next = idx->wheel[to];
+            idx->wheel[to] = e;
+        }
+        e = next;
+    }
+}
+
+void beacon_index_expire(beacon_index_t *idx, double now) {
+    int64_t now_tick = tick_of(idx, now);
+    if (now_tick <= idx->tick) {
+        return;
+    }
+
+    // A jump of a full turn or more visits every bucket once
+    int64_t from = idx->tick + 1;
+    if (now_tick - from >= BEACON_INDEX_BUCKETS) {
+        from = now_tick - BEACON_INDEX_BUCKETS + 1;
+    }
+    for (int64_t t = from; t <= now_tick; t++) {
+        process_bucket(idx, t, now_tick);
+    }
+    idx->tick = now_tick;
+}
+
+// =============================================================================
+// OBSERVATIONS
+// =============================================================================
+
+static void set_position(beacon_entry_t *entry, const t018_message_t *msg) {
+    if (msg && msg->position.valid) {
+        entry->latitude = (float)msg->position.latitude;
+        entry->longitude = (float)msg->position.longitude;
+    }
+}
+
+beacon_event_t beacon_index_observe(beacon_index_t *idx, const t018_beacon_id_t *id, double t,
+                                    const t018_message_t *msg, const beacon_entry_t **entry) {
+    idx->observed++;
+    beacon_index_expire(idx, t);
+
+    uint32_t slot = find_slot(idx, id);
+    if (idx->slots[slot]) {
+        beacon_entry_t *e = &idx->entries[idx->slots[slot] - 1];
+        if (entry) *entry = e;
+
+        if (fabs(t - e->last_seen) < idx->dedup_window) {
+            idx->duplicates++;
+            return BEACON_DUPLICATE;
+        }
+        e->bursts++;
+        if (t > e->last_seen) {
+            e->last_seen = t;
+            set_position(e, msg);
+        }
+        return BEACON_REPEAT;
+    }
+
+    if (idx->count == idx->capacity) {
+        idx->rejected++;
+        if (entry) *entry = NULL;
+        return BEACON_FULL;
+    }
+
+    uint32_t n;
+    if (idx->free_head != BEACON_INDEX_NONE) {
+        n = idx->free_head;
+        idx->free_head = idx->entries[n].next;
+    } else {
+        n = idx->unused++;
+    }
+
+    beacon_entry_t *e = &idx->entries[n];
+    memset(e, 0, sizeof(beacon_entry_t));
+    e->id = *id;
+    e->first_seen = t;
+    e->last_seen = t;
+    e->bursts = 1;
+    set_position(e, msg);
+
+    // Late reports join the current bucket so they get a full turn
+    int64_t tick = tick_of(idx, t);
+    uint32_t b = bucket_of(tick > idx->tick ? tick : idx->tick);
+    e->next = idx->wheel[b];
+    idx->wheel[b] = n;
+
+    idx->slots[slot] = n + 1;
+    idx->count++;
+    if (entry) *entry = e;
+    return BEACON_NEW;
+}
+
+const beacon_entry_t *beacon_index_find(const beacon_index_t *idx, const t018_beacon_id_t *id) {
+    uint32_t slot = find_slot(idx, id);
+    return idx->slots[slot] ? &idx->entries[idx->slots[slot] - 1] : NULL;
+}
+
+const beacon_entry_t *beacon_index_next(const beacon_index_t *idx, uint32_t *pos) {
+    while (*pos < idx->unused) {
+        const beacon_entry_t *e = &idx->entries[(*pos)++];
+        if (e->bursts) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+size_t beacon_index_memory(const beacon_index_t *idx) {
+    return (size_t)idx->capacity * sizeof(beacon_entry_t) +
+           ((size_t)idx->mask + 1) * sizeof(uint32_t);
+}
+
+void beacon_index_free(beacon_index_t *idx) {
+    free(idx->entries);
+    free(idx->slots);
+    idx->entries = NULL;
+    idx->slots = NULL;
+}
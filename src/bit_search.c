@@ -0,0 +1,559 @@
+/**
+ * @file bit_search.c
+ * @brief Bit-parallel T.018 sync and frame search implementation
+ *
+ * With the stream in 64-bit words (first bit most significant), the 64 bits
+ * starting at bit 64k + j are (w[k] << j) | (w[k+1] >> (64 - j)): the sync
+ * distance at any alignment is one funnel shift, one XOR and a popcount.
+ *
+ * Sync with up to e errors: of e + 1 disjoint pieces of the sync, at least
+ * one matches exactly (pigeonhole). Pieces are taken where the stream is
+ * cut into P-bit samples (P = 8 when the sync is long enough, so bytes):
+ * a sync of L bits covers at least (L - P + 1) / P whole samples. A table
+ * indexed by the sample value gives the sync offsets d where the sync
+ * holds these P bits, each flagging alignment t - d for a sample at bit t.
+ * Only flagged alignments get the XOR/popcount distance to the whole sync,
+ * and only matches get the BCH check (byte-wise parity table on the packed
+ * window).
+ */
+
+#include "bit_search.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "task_pool.h"
+#include "despread.h"
+
+#define CHUNK_WORDS         32768       // 256 KiB of stream per task
+#define OVERLAP_WORDS       8           // Sync + message past the chunk end
+#define BLOCK_WORDS         64          // Alignment words flagged per prefilter pass
+#define BATCH_CHUNKS        64          // Chunks searched before reporting (16 MiB)
+#define WINDOW_BYTES        40          // 250 bits + read padding of t018_read_packed()
+#define SAMPLE_MAX_BITS     8           // Prefilter sample size (table of 256 entries)
+#define MERGE_ALTERNATIVES  16          // Equally likely alignments kept per frame
+
+// Prefilter: sync offsets holding each sample value
+typedef struct {
+    uint32_t sample_bits;                   // P (8, 4, 2 or 1)
+    uint64_t offsets[1 << SAMPLE_MAX_BITS]; // Bit d: sync bits d..d+P-1 equal the index
+} prefilter_t;
+
+// One chunk of a batch
+typedef struct {
+    uint64_t *words;                        // CHUNK_WORDS + OVERLAP_WORDS
+    uint64_t *flags;                        // Flagged alignments, BLOCK_WORDS + 2 words
+    bit_search_hit_t *hits;                 // Candidates kept, in stream order
+    uint32_t count;
+    uint32_t capacity;
+    uint64_t candidates;
+    uint64_t failed;
+    int error;
+} chunk_t;
+
+typedef struct {
+    const bit_search_config_t *cfg;
+    const uint8_t *data;
+    uint64_t bytes;
+    uint64_t last_bit;                      // Last sync start with a complete message after it
+    uint64_t first_chunk;                   // Chunk index of chunks[0]
+    prefilter_t filter;
+    chunk_t *chunks;
+} scan_ctx_t;
+
+// Ordered reporting: best candidates among those sharing a message window
+typedef struct {
+    bit_search_fn_t fn;
+    void *ctx;
+    bit_search_stats_t *stats;
+    uint64_t cluster_start;                 // Offset of the first candidate of the cluster
+    uint32_t count;
+    bit_search_hit_t best[MERGE_ALTERNATIVES];
+} merge_t;
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+void bit_search_default_config(bit_search_config_t *cfg) {
+    memset(cfg, 0, sizeof(bit_search_config_t));
+    cfg->pattern = 0;                               // Preamble bits are zeros
+    cfg->length = BIT_SEARCH_DEFAULT_SYNC;
+    cfg->max_errors = BIT_SEARCH_DEFAULT_ERRORS;
+    cfg->inverted = 1;
+}
+
+int bit_search_parse_pattern(const char *text, bit_search_config_t *cfg) {
+    uint64_t pattern = 0;
+    uint32_t length = 0;
+
+    for (const char *p = text; *p; p++) {
+        if (*p != '0' && *p != '1') return -1;
+        if (length == BIT_SEARCH_MAX_PATTERN) return -1;
+        pattern |= (uint64_t)(*p - '0') << (63 - length);
+        length++;
+    }
+    if (length == 0) return -1;
+
+    cfg->pattern = pattern;
+    cfg->length = length;
+    return 0;
+}
+
+static void build_prefilter(const bit_search_config_t *cfg, prefilter_t *f) {
+    memset(f, 0, sizeof(prefilter_t));
+
+    // Largest sample size leaving e + 1 whole samples in any sync window
+    f->sample_bits = SAMPLE_MAX_BITS;
+    while (f->sample_bits > 1 &&
+           (cfg->length - f->sample_bits + 1) / f->sample_bits < cfg->max_errors + 1) {
+        f->sample_bits /= 2;
+    }
+
+    uint32_t p = f->sample_bits;
+    for (uint32_t polarity = 0; polarity < (cfg->inverted ? 2u : 1u); polarity++) {
+        uint64_t pattern = polarity ? ~cfg->pattern : cfg->pattern;
+        for (uint32_t d = 0; d + p <= cfg->length; d++) {
+            f->offsets[(pattern << d) >> (64 - p)] |= 1ULL << d;
+        }
+    }
+}
+
+// =============================================================================
+// PACKED STREAM
+// =============================================================================
+
+static inline uint64_t reverse_byte_bits(uint64_t x) {
+    x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+    x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+    return ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+}
+
+static inline uint64_t load_be64(const uint8_t *p) {
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    w = __builtin_bswap64(w);
+#endif
+    return w;
+}
+
+static inline void store_be64(uint8_t *p, uint64_t w) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    w = __builtin_bswap64(w);
+#endif
+    memcpy(p, &w, sizeof(w));
+}
+
+// Words [first, first + count) of the stream, zeros past its end
+static void load_words(const scan_ctx_t *sc, uint64_t first, uint32_t count, uint64_t *words) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t byte = (first + i) * 8;
+        uint64_t w;
+        if (byte + 8 <= sc->bytes) {
+            w = load_be64(sc->data + byte);
+        } else {
+            uint8_t tail[8] = { 0 };
+            if (byte < sc->bytes) memcpy(tail, sc->data + byte, sc->bytes - byte);
+            w = load_be64(tail);
+        }
+        words[i] = sc->cfg->lsb_first ? reverse_byte_bits(w) : w;
+    }
+}
+
+// 64 bits from word k shifted left by j (0..63), first bit most significant
+static inline uint64_t funnel(const uint64_t *words, uint64_t k, uint32_t j) {
+    return (words[k] << j) | ((words[k + 1] >> 1) >> (63 - j));
+}
+
+static inline uint64_t bits_at(const uint64_t *words, uint64_t bit) {
+    return funnel(words, bit / 64, (uint32_t)(bit % 64));
+}
+
+// Frame bits, one per byte → packed MSB first
+static void pack_bits(const uint8_t *bits, uint32_t count, uint8_t *bytes) {
+    memset(bytes, 0, (count + 7) / 8);
+    for (uint32_t i = 0; i < count; i++) {
+        if (bits[i]) bytes[i >> 3] |= (uint8_t)(0x80 >> (i & 7));
+    }
+}
+
+// =============================================================================
+// CANDIDATE DECODING
+// =============================================================================
+
+static int correct_header_layout(const uint8_t *bits, uint8_t *codeword) {
+    // The last two parity bits were not transmitted: try the four values
+    int best = -1;
+    for (int guess = 0; guess < 4; guess++) {
+        uint8_t cw[T018_DATA_BITS];
+        memcpy(cw, &bits[T018_HEADER_BITS], T018_DATA_BITS - T018_HEADER_BITS);
+        cw[T018_DATA_BITS - 2] = (uint8_t)((guess >> 1) & 1);
+        cw[T018_DATA_BITS - 1] = (uint8_t)(guess & 1);
+        uint8_t guessed[2] = { cw[T018_DATA_BITS - 2], cw[T018_DATA_BITS - 1] };
+
+        int errors = t018_bch_correct(cw);
+        if (errors < 0) continue;
+        errors -= (cw[T018_DATA_BITS - 2] != guessed[0]) + (cw[T018_DATA_BITS - 1] != guessed[1]);
+        if (best < 0 || errors < best) {
+            best = errors;
+            memcpy(codeword, cw, T018_DATA_BITS);
+        }
+    }
+    return best;
+}
+
+// Decode the window in one layout: 0 on success, -1 if BCH fails
+static int decode_window(const uint8_t *raw, uint8_t correct, bit_search_hit_t *hit) {
+    uint8_t bits[BIT_SEARCH_WINDOW_BITS];
+    uint8_t codeword[T018_DATA_BITS];
+    int header = (hit->layout == BIT_SEARCH_LAYOUT_HEADER);
+    int ok;
+
+    if (header) {
+        uint64_t parity = t018_bch_parity_packed(raw, T018_HEADER_BITS);
+        ok = (parity >> 2) == t018_read_packed(raw, T018_HEADER_BITS + T018_INFO_BITS,
+                                               T018_BCH_BITS - 2);
+        codeword[T018_DATA_BITS - 2] = (uint8_t)((parity >> 1) & 1);
+        codeword[T018_DATA_BITS - 1] = (uint8_t)(parity & 1);
+    } else {
+        ok = t018_bch_parity_packed(raw, 0) == t018_read_packed(raw, T018_INFO_BITS, T018_BCH_BITS);
+    }
+    if (!ok && !correct) return -1;
+
+    for (int i = 0; i < BIT_SEARCH_WINDOW_BITS; i++) {
+        bits[i] = (uint8_t)t018_read_packed(raw, (uint32_t)i, 1);
+    }
+    if (header) {
+        memcpy(codeword, &bits[T018_HEADER_BITS], T018_DATA_BITS - T018_HEADER_BITS);
+        hit->bch_errors = ok ? 0 : correct_header_layout(bits, codeword);
+    } else {
+        memcpy(codeword, bits, T018_DATA_BITS);
+        hit->bch_errors = ok ? 0 : t018_bch_correct(codeword);
+    }
+    if (hit->bch_errors < 0) return -1;
+
+    // 252-bit frame as built by t018_build_frame(): header (zeros in the
+    // T.018 layout) + corrected codeword
+    uint8_t frame_bits[T018_FRAME_BITS];
+    frame_bits[0] = header ? bits[0] : 0;
+    frame_bits[1] = header ? bits[1] : 0;
+    memcpy(&frame_bits[T018_HEADER_BITS], codeword, T018_DATA_BITS);
+
+    uint8_t packed[WINDOW_BYTES] = { 0 };
+    pack_bits(frame_bits, T018_FRAME_BITS, packed);
+    memcpy(hit->frame, packed, BIT_SEARCH_FRAME_BYTES);
+
+    t018_fields_t fields;
+    t018_unpack_fields_packed(packed, T018_HEADER_BITS, &fields);
+    t018_beacon_id_from_fields(&fields, &hit->id);
+    return 0;
+}
+
+static int push_hit(chunk_t *ch, const bit_search_hit_t *hit) {
+    if (ch->count == ch->capacity) {
+        uint32_t capacity = ch->capacity ? ch->capacity * 2 : 64;
+        bit_search_hit_t *hits = realloc(ch->hits, capacity * sizeof(bit_search_hit_t));
+        if (!hits) {
+            ch->error = 1;
+            return -1;
+        }
+        ch->hits = hits;
+        ch->capacity = capacity;
+    }
+    ch->hits[ch->count++] = *hit;
+    return 0;
+}
+
+static void check_candidate(const scan_ctx_t *sc, chunk_t *ch, uint64_t chunk_bit,
+                            uint64_t local_bit, uint32_t errors, uint8_t inverted) {
+    const bit_search_config_t *cfg = sc->cfg;
+    uint8_t raw[WINDOW_BYTES];
+
+    // 250 message bits after the sync, padded for the packed readers
+    uint64_t message = local_bit + cfg->length;
+    uint64_t flip = inverted ? ~0ULL : 0;
+    for (int q = 0; q < 4; q++) {
+        store_be64(raw + 8 * q, bits_at(ch->words, message + 64 * (uint64_t)q) ^ flip);
+    }
+    raw[31] &= 0xC0;
+    memset(raw + 32, 0, WINDOW_BYTES - 32);
+
+    bit_search_hit_t hit;
+    hit.bit_offset = chunk_bit + message;
+    hit.sync_errors = errors;
+    hit.inverted = inverted;
+    hit.alternatives = 0;
+    ch->candidates++;
+
+    // Both layouts: a window can check in both (different frames)
+    int decoded = 0;
+    for (int layout = BIT_SEARCH_LAYOUT_SPEC; layout <= BIT_SEARCH_LAYOUT_HEADER; layout++) {
+        hit.layout = (bit_search_layout_t)layout;
+        if (decode_window(raw, cfg->correct, &hit) == 0) {
+            push_hit(ch, &hit);
+            decoded = 1;
+        }
+    }
+    if (decoded) return;
+
+    ch->failed++;
+    if (cfg->keep_failed) {
+        // Received bits as they are
+        hit.layout = BIT_SEARCH_LAYOUT_SPEC;
+        hit.bch_errors = -1;
+        memcpy(hit.frame, raw, BIT_SEARCH_FRAME_BYTES);
+        memset(&hit.id, 0, sizeof(hit.id));
+        push_hit(ch, &hit);
+    }
+}
+
+// =============================================================================
+// SEARCH
+// =============================================================================
+
+static void scan_chunk(const scan_ctx_t *sc, chunk_t *ch, uint64_t index) {
+    const bit_search_config_t *cfg = sc->cfg;
+    const prefilter_t *f = &sc->filter;
+    ch->count = 0;
+    ch->candidates = 0;
+    ch->failed = 0;
+
+    uint64_t chunk_bit = index * CHUNK_WORDS * 64;
+    if (chunk_bit > sc->last_bit) return;
+    uint64_t end_bit = chunk_bit + CHUNK_WORDS * 64;
+    if (end_bit > sc->last_bit + 1) end_bit = sc->last_bit + 1;
+
+    load_words(sc, index * CHUNK_WORDS, CHUNK_WORDS + OVERLAP_WORDS, ch->words);
+
+    const uint64_t mask = ~0ULL << (64 - cfg->length);
+    const uint64_t pattern = cfg->pattern & mask;
+    const uint32_t max_errors = cfg->max_errors;
+    const uint32_t min_inverted = cfg->inverted ? cfg->length - max_errors : 65;
+    const uint32_t p = f->sample_bits;
+    const uint64_t sample_mask = (1ULL << p) - 1;
+    const uint64_t *restrict words = ch->words;
+    uint64_t *restrict flags = ch->flags;
+    const uint32_t num_words = (uint32_t)((end_bit - chunk_bit + 63) / 64);
+
+    for (uint32_t k0 = 0; k0 < num_words; k0 += BLOCK_WORDS) {
+        uint32_t n = (num_words - k0 < BLOCK_WORDS) ? num_words - k0 : BLOCK_WORDS;
+
+        // flags[kk + 1] bit 63 - s ↔ alignment 64(k0+kk) + s. A sample at
+        // 64k + i flags alignments in words k and k - 1 (flags[0] and
+        // flags[n + 1] belong to the neighbouring blocks)
+        memset(flags, 0, (n + 2) * sizeof(uint64_t));
+        for (uint32_t kk = 0; kk <= n; kk++) {
+            uint64_t w = words[k0 + kk];
+            for (uint32_t i = 0; i < 64; i += p) {
+                uint64_t r = f->offsets[(w >> (64 - p - i)) & sample_mask];
+                if (r) {
+                    flags[kk + 1] |= r << (63 - i);
+                    flags[kk] |= (r >> i) >> 1;
+                }
+            }
+        }
+
+        for (uint32_t kk = 0; kk < n; kk++) {
+            uint64_t flagged = flags[kk + 1];
+            while (flagged) {
+                uint32_t s = (uint32_t)__builtin_clzll(flagged);
+                flagged &= ~(1ULL << (63 - s));
+
+                uint64_t local_bit = (uint64_t)(k0 + kk) * 64 + s;
+                if (chunk_bit + local_bit >= end_bit) break;
+                uint32_t errors = despread_popcount64((bits_at(words, local_bit) ^ pattern) & mask);
+                if (errors <= max_errors) {
+                    check_candidate(sc, ch, chunk_bit, local_bit, errors, 0);
+                } else if (errors >= min_inverted) {
+                    check_candidate(sc, ch, chunk_bit, local_bit, cfg->length - errors, 1);
+                }
+            }
+        }
+    }
+}
+
+static void scan_range(void *ctx, uint32_t begin, uint32_t end) {
+    scan_ctx_t *sc = (scan_ctx_t *)ctx;
+    for (uint32_t c = begin; c < end; c++) {
+        scan_chunk(sc, &sc->chunks[c], sc->first_chunk + c);
+    }
+}
+
+// =============================================================================
+// ORDERED REPORTING
+// =============================================================================
+
+static int compare_hits(const bit_search_hit_t *a, const bit_search_hit_t *b) {
+    // < 0 if a is more likely the frame: decoded, then closest to the sync,
+    // then fewer corrections
+    if ((a->bch_errors >= 0) != (b->bch_errors >= 0)) return a->bch_errors >= 0 ? -1 : 1;
+    if (a->sync_errors != b->sync_errors) return a->sync_errors < b->sync_errors ? -1 : 1;
+    if (a->bch_errors != b->bch_errors) return a->bch_errors < b->bch_errors ? -1 : 1;
+    return 0;
+}
+
+static void merge_flush(merge_t *m) {
+    if (m->count == 0) return;
+
+    // Stream order
+    for (uint32_t i = 1; i < m->count; i++) {
+        bit_search_hit_t hit = m->best[i];
+        uint32_t j = i;
+        for (; j > 0 && m->best[j - 1].bit_offset > hit.bit_offset; j--) {
+            m->best[j] = m->best[j - 1];
+        }
+        m->best[j] = hit;
+    }
+    if (m->best[0].bch_errors >= 0) {
+        m->stats->frames++;
+        if (m->best[0].bch_errors > 0) m->stats->corrected++;
+        if (m->count > 1) m->stats->ambiguous++;
+    }
+    for (uint32_t i = 0; i < m->count; i++) {
+        m->best[i].alternatives = m->count - 1;
+        m->fn(m->ctx, &m->best[i]);
+    }
+    m->count = 0;
+}
+
+static void merge_hit(merge_t *m, const bit_search_hit_t *hit) {
+    // Candidates starting within one message length of the first one are
+    // alignments of the same frame
+    if (m->count && hit->bit_offset >= m->cluster_start + BIT_SEARCH_WINDOW_BITS) {
+        merge_flush(m);
+    }
+    if (m->count == 0) {
+        m->cluster_start = hit->bit_offset;
+        m->best[m->count++] = *hit;
+        return;
+    }
+
+    int order = compare_hits(hit, &m->best[0]);
+    if (order < 0) {
+        m->stats->duplicates += m->count;
+        m->best[0] = *hit;
+        m->count = 1;
+        return;
+    }
+    if (order > 0 || hit->bch_errors < 0) {
+        m->stats->duplicates++;
+        return;
+    }
+
+    // As likely as the best: keep it unless it decodes to the same frame
+    // (T.018 layout at n, header layout with a zero header at n - 2)
+    for (uint32_t i = 0; i < m->count; i++) {
+        if (memcmp(hit->frame, m->best[i].frame, BIT_SEARCH_FRAME_BYTES) == 0) {
+            m->stats->duplicates++;
+            if (hit->layout == BIT_SEARCH_LAYOUT_SPEC && m->best[i].layout == BIT_SEARCH_LAYOUT_HEADER) {
+                m->best[i] = *hit;
+            }
+            return;
+        }
+    }
+    // Set full (codeword ending in a long run of zeros): keep the first ones
+    if (m->count < MERGE_ALTERNATIVES) {
+        m->best[m->count++] = *hit;
+    } else {
+        m->stats->duplicates++;
+    }
+}
+
+int bit_search_scan(const bit_search_config_t *cfg, const uint8_t *data, uint64_t bytes,
+                    bit_search_fn_t fn, void *ctx, bit_search_stats_t *stats) {
+    bit_search_stats_t local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(bit_search_stats_t));
+
+    if (cfg->length == 0 || cfg->length > BIT_SEARCH_MAX_PATTERN || cfg->max_errors >= cfg->length) {
+        fprintf(stderr, "Invalid sync: %u bits, %u errors accepted\n", cfg->length, cfg->max_errors);
+        return -1;
+    }
+    if (cfg->inverted && 2 * cfg->max_errors >= cfg->length) {
+        fprintf(stderr, "Sync of %u bits too short for %u errors in both polarities\n",
+                cfg->length, cfg->max_errors);
+        return -1;
+    }
+
+    stats->bits = bytes * 8;
+    if (stats->bits < (uint64_t)cfg->length + BIT_SEARCH_WINDOW_BITS) {
+        return 0;
+    }
+
+    scan_ctx_t *sc = calloc(1, sizeof(scan_ctx_t));
+    if (!sc) {
+        fprintf(stderr, "Failed to allocate search context\n");
+        return -1;
+    }
+    sc->cfg = cfg;
+    sc->data = data;
+    sc->bytes = bytes;
+    sc->last_bit = stats->bits - cfg->length - BIT_SEARCH_WINDOW_BITS;
+    build_prefilter(cfg, &sc->filter);
+
+    uint64_t total_chunks = sc->last_bit / (CHUNK_WORDS * 64) + 1;
+    uint32_t batch = total_chunks < BATCH_CHUNKS ? (uint32_t)total_chunks : BATCH_CHUNKS;
+
+    int ret = 0;
+    sc->chunks = calloc(batch, sizeof(chunk_t));
+    if (!sc->chunks) {
+        fprintf(stderr, "Failed to allocate search chunks\n");
+        free(sc);
+        return -1;
+    }
+    for (uint32_t c = 0; c < batch; c++) {
+        chunk_t *ch = &sc->chunks[c];
+        ch->words = malloc((CHUNK_WORDS + OVERLAP_WORDS) * sizeof(uint64_t));
+        ch->flags = malloc((BLOCK_WORDS + 2) * sizeof(uint64_t));
+        if (!ch->words || !ch->flags) {
+            fprintf(stderr, "Failed to allocate search buffers\n");
+            ret = -1;
+            break;
+        }
+    }
+
+    merge_t *merge = calloc(1, sizeof(merge_t));
+    if (!merge) {
+        fprintf(stderr, "Failed to allocate search results\n");
+        ret = -1;
+    } else {
+        merge->fn = fn;
+        merge->ctx = ctx;
+        merge->stats = stats;
+    }
+    task_pool_t *pool = task_pool_default();
+
+    for (uint64_t first = 0; ret == 0 && first < total_chunks; first += batch) {
+        uint32_t n = (total_chunks - first < batch) ? (uint32_t)(total_chunks - first) : batch;
+        sc->first_chunk = first;
+        task_pool_parallel_for(pool, 0, n, 1, scan_range, sc);
+
+        // Report in stream order
+        for (uint32_t c = 0; c < n; c++) {
+            chunk_t *ch = &sc->chunks[c];
+            if (ch->error) {
+                fprintf(stderr, "Failed to allocate search results\n");
+                ret = -1;
+                break;
+            }
+            stats->candidates += ch->candidates;
+            stats->failed += ch->failed;
+            for (uint32_t h = 0; h < ch->count; h++) {
+                merge_hit(merge, &ch->hits[h]);
+            }
+        }
+    }
+    if (ret == 0) {
+        merge_flush(merge);
+    }
+
+    for (uint32_t c = 0; c < batch; c++) {
+        free(sc->chunks[c].words);
+        free(sc->chunks[c].flags);
+        free(sc->chunks[c].hits);
+    }
+    free(sc->chunks);
+    free(sc);
+    free(merge);
+    return ret;
+}
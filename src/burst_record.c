@@ -0,0 +1,588 @@
+/**
+ * @file burst_record.c
+ * @brief Parametric burst recordings implementation
+ *
+ * Synthesis evaluates the OQPSK waveform at each output instant: the
+ * half-sine pulses do not overlap, so every sample is one I chip and one Q
+ * chip (delayed by Tc/2) times the pulse phase. When the sample rate is an
+ * even integer number of samples per chip and the burst starts on a sample,
+ * the pulse comes from a table and the arithmetic is the modulator's own.
+ *
+ * File layout (little endian):
+ *   header  "SGBR", u16 version, u16 record size, f32 noise dB, u32 0,
+ *           u64 noise seed, f64 duration
+ *   record  f64 time, f64 freq offset, f32 amplitude, f32 phase,
+ *           f32 chip rate ppm, u8 PRN mode, 3 × u8 0, 32 × u8 frame
+ */
+
+#include "burst_record.h"
+#include "prn_generator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+
+#define TX_BITS             300         // Preamble (50) + first 250 frame bits
+#define PREAMBLE_BITS       50
+#define ROTATOR_BLOCK       256         // Samples between exact carrier phase updates
+#define EXPORT_BLOCK        65536       // Samples per SigMF data write
+#define MAX_TABLE_SPS       4096        // Largest pulse table
+
+// =============================================================================
+// FRAME BITS
+// =============================================================================
+
+void burst_record_set_frame(burst_record_t *rec, const uint8_t *frame_bits) {
+    memset(rec->frame, 0, sizeof(rec->frame));
+    for (int i = 0; i < 252; i++) {
+        if (frame_bits[i]) rec->frame[i / 8] |= (uint8_t)(0x80 >> (i % 8));
+    }
+}
+
+void burst_record_get_frame(const burst_record_t *rec, uint8_t *frame_bits) {
+    for (int i = 0; i < 252; i++) {
+        frame_bits[i] = (rec->frame[i / 8] >> (7 - i % 8)) & 1;
+    }
+}
+
+// =============================================================================
+// SYNTHESIS
+// =============================================================================
+
+static double chip_rate(const burst_record_t *rec) {
+    return BURST_RECORD_CHIP_RATE * (1.0 + rec->chip_rate_ppm * 1e-6);
+}
+
+double burst_record_duration(const burst_record_t *rec) {
+    return BURST_RECORD_CHIPS / chip_rate(rec);
+}
+
+// Spread chips of one channel: PRN sign flipped by the data bit
+typedef struct {
+    const int8_t *prn;
+    int8_t sign[PRN_FRAME_BITS];
+} channel_chips_t;
+
+static void setup_chips(const burst_record_t *rec, channel_chips_t ch[2]) {
+    // Transmitted bits: 50 preamble zeros then frame bits 0..249, I even, Q odd
+    uint8_t frame_bits[252];
+    uint8_t tx[TX_BITS] = { 0 };
+    burst_record_get_frame(rec, frame_bits);
+    memcpy(&tx[PREAMBLE_BITS], frame_bits, TX_BITS - PREAMBLE_BITS);
+
+    for (int c = 0; c < 2; c++) {
+        ch[c].prn = prn_get_frame_table(rec->prn_mode, (uint8_t)c);
+        for (int b = 0; b < PRN_FRAME_BITS; b++) {
+            ch[c].sign[b] = tx[2 * b + c] ? -1 : 1;
+        }
+    }
+}
+
+static inline float chip_value(const channel_chips_t *ch, int64_t k) {
+    if (k < 0 || k >= BURST_RECORD_CHIPS) return 0.0f;
+    return (float)(ch->prn[k] * ch->sign[k / PRN_CHIPS_PER_BIT]);
+}
+
+void burst_record_render(const burst_record_t *rec, double sample_rate,
+                         uint64_t first, uint32_t count, float complex *out) {
+    double rate = chip_rate(rec);
+    double start = rec->time * sample_rate;                 // Timeline position of chip 0
+    int64_t n0 = (int64_t)ceil(start - 1e-9);
+    int64_t n_end = (int64_t)ceil((rec->time + BURST_RECORD_CHIPS / rate) * sample_rate - 1e-9);
+    int64_t lo = n0 > (int64_t)first ? n0 : (int64_t)first;
+    int64_t hi = (int64_t)(first + count) < n_end ? (int64_t)(first + count) : n_end;
+    if (lo >= hi) return;
+
+    channel_chips_t ch[2];
+    setup_chips(rec, ch);
+
+    // Same normalization and π/4 rotation as oqpsk_modulate_frame()
+    float normalization = 1.0f / sqrtf(2.0f);
+    float complex rotation = cexpf(I * M_PI / 4.0f);
+    int carrier = rec->amplitude != 1.0f || rec->freq_offset != 0.0 || rec->phase != 0.0f;
+    double step_phase = 2.0 * M_PI * rec->freq_offset / sample_rate;
+
+    double sps = sample_rate / rate;
+    int64_t table_sps = (int64_t)llround(sps);
+    int table = fabs(sps - (double)table_sps) < 1e-9 && fabs(start - (double)n0) < 1e-9 &&
+                table_sps >= 2 && table_sps <= MAX_TABLE_SPS && table_sps % 2 == 0;
+
+    float pulse[MAX_TABLE_SPS];
+    if (table) {
+        for (int64_t s = 0; s < table_sps; s++) {
+            pulse[s] = sinf(M_PI * (float)s / (float)table_sps);
+        }
+    }
+
+    float complex gain = 1.0f;
+    float complex step = (float complex)cexp(I * step_phase);
+
+    // Table path: chip index and pulse phase of I and Q, stepped per sample
+    int64_t ki = 0, si = 0, kq = 0, sq = 0;
+    if (table) {
+        ki = (lo - n0) / table_sps;
+        si = (lo - n0) % table_sps;
+        kq = (lo - n0 + table_sps / 2) / table_sps;
+        sq = (lo - n0 + table_sps / 2) % table_sps;
+    }
+
+    for (int64_t n = lo; n < hi; n++) {
+        float i_val, q_val;
+
+        if (table) {
+            i_val = chip_value(&ch[0], ki) * pulse[si];
+            q_val = chip_value(&ch[1], kq) * pulse[sq];
+            if (++si == table_sps) {
+                si = 0;
+                ki++;
+            }
+            if (++sq == table_sps) {
+                sq = 0;
+                kq++;
+            }
+        } else {
+            double x = ((double)n - start) * (rate / sample_rate);
+            double xi = floor(x);
+            double xq = floor(x + 0.5);
+            i_val = chip_value(&ch[0], (int64_t)xi) * sinf((float)(M_PI * (x - xi)));
+            q_val = chip_value(&ch[1], (int64_t)xq) * sinf((float)(M_PI * (x + 0.5 - xq)));
+        }
+
+        float complex v = i_val + I * q_val;
+        v *= normalization;
+        v *= rotation;
+
+        if (carrier) {
+            // Exact phase every block, recurrence in between
+            if (n == lo || (n - lo) % ROTATOR_BLOCK == 0) {
+                double theta = step_phase * ((double)n - start) + rec->phase;
+                gain = rec->amplitude * (float complex)cexp(I * theta);
+            }
+            v *= gain;
+            gain *= step;
+        }
+        out[n - (int64_t)first] += v;
+    }
+}
+
+// =============================================================================
+// FILE FORMAT
+// =============================================================================
+
+static void put_le16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void put_le64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t get_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_le64(const uint8_t *p) {
+    return (uint64_t)get_le32(p) | ((uint64_t)get_le32(p + 4) << 32);
+}
+
+static void put_f32(uint8_t *p, float f) {
+    uint32_t v;
+    memcpy(&v, &f, 4);
+    put_le32(p, v);
+}
+
+static void put_f64(uint8_t *p, double d) {
+    uint64_t v;
+    memcpy(&v, &d, 8);
+    put_le64(p, v);
+}
+
+static float get_f32(const uint8_t *p) {
+    uint32_t v = get_le32(p);
+    float f;
+    memcpy(&f, &v, 4);
+    return f;
+}
+
+static double get_f64(const uint8_t *p) {
+    uint64_t v = get_le64(p);
+    double d;
+    memcpy(&d, &v, 8);
+    return d;
+}
+
+static void encode_header(uint8_t *h, float noise_db, uint64_t seed, double duration) {
+    memset(h, 0, BURST_RECORD_HEADER_SIZE);
+    memcpy(h, BURST_RECORD_MAGIC, 4);
+    put_le16(h + 4, BURST_RECORD_VERSION);
+    put_le16(h + 6, BURST_RECORD_SIZE);
+    put_f32(h + 8, noise_db);
+    put_le64(h + 16, seed);
+    put_f64(h + 24, duration);
+}
+
+static void encode_record(uint8_t *r, const burst_record_t *rec) {
+    memset(r, 0, BURST_RECORD_SIZE);
+    put_f64(r, rec->time);
+    put_f64(r + 8, rec->freq_offset);
+    put_f32(r + 16, rec->amplitude);
+    put_f32(r + 20, rec->phase);
+    put_f32(r + 24, rec->chip_rate_ppm);
+    r[28] = rec->prn_mode;
+    memcpy(r + 32, rec->frame, BURST_RECORD_FRAME_BYTES);
+}
+
+static void decode_record(const uint8_t *r, burst_record_t *rec) {
+    rec->time = get_f64(r);
+    rec->freq_offset = get_f64(r + 8);
+    rec->amplitude = get_f32(r + 16);
+    rec->phase = get_f32(r + 20);
+    rec->chip_rate_ppm = get_f32(r + 24);
+    rec->prn_mode = r[28] ? 1 : 0;
+    memcpy(rec->frame, r + 32, BURST_RECORD_FRAME_BYTES);
+}
+
+static int check_header(const uint8_t *h, const char *path, uint32_t *record_size) {
+    if (memcmp(h, BURST_RECORD_MAGIC, 4) != 0) {
+        fprintf(stderr, "%s: not a burst recording\n", path);
+        return -1;
+    }
+    uint32_t version = h[4] | (h[5] << 8);
+    *record_size = h[6] | (h[7] << 8);
+    if (version != BURST_RECORD_VERSION || *record_size < BURST_RECORD_SIZE) {
+        fprintf(stderr, "%s: unsupported burst recording version %u (record size %u)\n",
+                path, version, *record_size);
+        return -1;
+    }
+    return 0;
+}
+
+static int compare_time(const void *a, const void *b) {
+    double ta = ((const burst_record_t *)a)->time;
+    double tb = ((const burst_record_t *)b)->time;
+    return (ta > tb) - (ta < tb);
+}
+
+int burst_recording_load(burst_recording_t *rc, const char *path) {
+    memset(rc, 0, sizeof(burst_recording_t));
+
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    uint8_t h[BURST_RECORD_HEADER_SIZE];
+    uint32_t record_size;
+    if (fread(h, 1, sizeof(h), fp) != sizeof(h)) {
+        fprintf(stderr, "%s: truncated header\n", path);
+        fclose(fp);
+        return -1;
+    }
+    if (check_header(h, path, &record_size) < 0) {
+        fclose(fp);
+        return -1;
+    }
+    rc->noise_db = get_f32(h + 8);
+    rc->noise_seed = get_le64(h + 16);
+    rc->duration = get_f64(h + 24);
+
+    uint8_t *r = malloc(record_size);
+    uint32_t capacity = 0;
+    int ret = r ? 0 : -1;
+    while (ret == 0 && fread(r, 1, record_size, fp) == record_size) {
+        if (rc->count == capacity) {
+            capacity = capacity ? 2 * capacity : 256;
+            burst_record_t *grown = realloc(rc->records, capacity * sizeof(burst_record_t));
+            if (!grown) {
+                ret = -1;
+                break;
+            }
+            rc->records = grown;
+        }
+        decode_record(r, &rc->records[rc->count++]);
+    }
+    if (ret == 0 && ferror(fp)) {
+        fprintf(stderr, "%s: read error: %s\n", path, strerror(errno));
+        ret = -1;
+    } else if (ret < 0) {
+        fprintf(stderr, "Failed to allocate burst records\n");
+    }
+    free(r);
+    fclose(fp);
+    if (ret < 0) {
+        burst_recording_free(rc);
+        return -1;
+    }
+
+    qsort(rc->records, rc->count, sizeof(burst_record_t), compare_time);
+    for (uint32_t i = 0; i < rc->count; i++) {
+        double d = burst_record_duration(&rc->records[i]);
+        if (d > rc->max_burst) rc->max_burst = d;
+        if (rc->records[i].time + d > rc->duration) rc->duration = rc->records[i].time + d;
+    }
+    return 0;
+}
+
+int burst_recording_save(const burst_recording_t *rc, const char *path) {
+    FILE *fp = fopen(path, "wb");
+    if (!fp) {
+        fprintf(stderr, "Cannot create %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    uint8_t h[BURST_RECORD_HEADER_SIZE];
+    uint8_t r[BURST_RECORD_SIZE];
+    encode_header(h, rc->noise_db, rc->noise_seed, rc->duration);
+    int ok = fwrite(h, 1, sizeof(h), fp) == sizeof(h);
+    for (uint32_t i = 0; ok && i < rc->count; i++) {
+        encode_record(r, &rc->records[i]);
+        ok = fwrite(r, 1, sizeof(r), fp) == sizeof(r);
+    }
+    if (fclose(fp) != 0) ok = 0;
+
+    if (!ok) {
+        fprintf(stderr, "Failed to write %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+int burst_recording_append(const char *path, const burst_record_t *rec) {
+    uint8_t h[BURST_RECORD_HEADER_SIZE];
+    uint8_t r[BURST_RECORD_SIZE];
+    uint32_t record_size = BURST_RECORD_SIZE;
+
+    FILE *fp = fopen(path, "r+b");
+    if (fp) {
+        if (fread(h, 1, sizeof(h), fp) != sizeof(h) || check_header(h, path, &record_size) < 0 ||
+            fseek(fp, 0, SEEK_END) != 0) {
+            fclose(fp);
+            return -1;
+        }
+    } else {
+        fp = fopen(path, "w+b");
+        if (!fp) {
+            fprintf(stderr, "Cannot create %s: %s\n", path, strerror(errno));
+            return -1;
+        }
+        encode_header(h, BURST_RECORD_NO_NOISE, 0, 0.0);
+        if (fwrite(h, 1, sizeof(h), fp) != sizeof(h)) {
+            fclose(fp);
+            return -1;
+        }
+    }
+
+    // Newer versions may use longer records: pad to their size
+    encode_record(r, rec);
+    int ok = fwrite(r, 1, sizeof(r), fp) == sizeof(r);
+    for (uint32_t i = BURST_RECORD_SIZE; ok && i < record_size; i++) {
+        ok = fputc(0, fp) != EOF;
+    }
+    if (fclose(fp) != 0) ok = 0;
+
+    if (!ok) {
+        fprintf(stderr, "Failed to append to %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+int burst_recording_is_path(const char *path) {
+    size_t len = strlen(path);
+    return len >= 5 && strcasecmp(path + len - 5, ".sgbr") == 0;
+}
+
+void burst_recording_free(burst_recording_t *rc) {
+    free(rc->records);
+    rc->records = NULL;
+    rc->count = 0;
+}
+
+// =============================================================================
+// RECORDING SYNTHESIS
+// =============================================================================
+
+uint64_t burst_recording_samples(const burst_recording_t *rc, double sample_rate) {
+    return (uint64_t)ceil(rc->duration * sample_rate - 1e-9);
+}
+
+static inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static void render_noise(const burst_recording_t *rc, uint64_t first, uint32_t count,
+                         float complex *out) {
+    // Box-Muller on a hash of the sample index: any window gives the same noise
+    float sigma = sqrtf(powf(10.0f, rc->noise_db / 10.0f) / 2.0f);
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t h = splitmix64(rc->noise_seed ^ splitmix64(first + i));
+        float u1 = ((float)(h >> 40) + 1.0f) * (1.0f / 16777217.0f);
+        float u2 = (float)((h >> 16) & 0xFFFFFF) * (1.0f / 16777216.0f);
+        float r = sigma * sqrtf(-2.0f * logf(u1));
+        float a = 2.0f * (float)M_PI * u2;
+        out[i] = r * cosf(a) + I * r * sinf(a);
+    }
+}
+
+void burst_recording_render(const burst_recording_t *rc, double sample_rate,
+                            uint64_t first, uint32_t count, float complex *out) {
+    if (rc->noise_db > BURST_RECORD_NO_NOISE) {
+        render_noise(rc, first, count, out);
+    } else {
+        memset(out, 0, count * sizeof(float complex));
+    }
+
+    // First record that can reach the window (sorted by start time)
+    double t0 = (double)first / sample_rate - rc->max_burst;
+    double t1 = (double)(first + count) / sample_rate;
+    uint32_t lo = 0, hi = rc->count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (rc->records[mid].time < t0) lo = mid + 1;
+        else hi = mid;
+    }
+
+    for (uint32_t i = lo; i < rc->count && rc->records[i].time <= t1; i++) {
+        burst_record_render(&rc->records[i], sample_rate, first, count, out);
+    }
+}
+
+// =============================================================================
+// SIGMF EXPORT
+// =============================================================================
+
+static void frame_hex(const burst_record_t *rec, char *hex) {
+    static const char digits[] = "0123456789ABCDEF";
+    for (int i = 0; i < 63; i++) {
+        hex[i] = digits[(rec->frame[i / 2] >> ((i & 1) ? 0 : 4)) & 0xF];
+    }
+    hex[63] = '\0';
+}
+
+static int write_sigmf_meta(const burst_recording_t *rc, const char *base,
+                            uint32_t sample_rate, int with_data) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s.sigmf-meta", base);
+    FILE *fp = fopen(path, "w");
+    if (!fp) {
+        fprintf(stderr, "Failed to create metadata file '%s': %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    time_t now = time(NULL);
+    char datetime[64];
+    strftime(datetime, sizeof(datetime), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "    \"global\": {\n");
+    fprintf(fp, "        \"core:datatype\": \"cf32_le\",\n");
+    fprintf(fp, "        \"core:sample_rate\": %u,\n", sample_rate);
+    fprintf(fp, "        \"core:version\": \"1.0.0\",\n");
+    fprintf(fp, "        \"core:description\": \"COSPAS-SARSAT T.018 2nd generation bursts synthesized from a parametric recording (%u bursts), SPS=%.2f\",\n",
+            rc->count, sample_rate / BURST_RECORD_CHIP_RATE);
+    fprintf(fp, "        \"core:author\": \"SARSAT_SGB Generator\",\n");
+    fprintf(fp, "        \"core:hw\": \"Software generated (baseband)\",\n");
+    if (!with_data) {
+        fprintf(fp, "        \"core:metadata_only\": true,\n");
+    }
+    if (rc->noise_db > BURST_RECORD_NO_NOISE) {
+        fprintf(fp, "        \"sarsat:noise_db\": %.2f,\n", rc->noise_db);
+        fprintf(fp, "        \"sarsat:noise_seed\": %llu,\n", (unsigned long long)rc->noise_seed);
+    }
+    fprintf(fp, "        \"core:extensions\": [\n");
+    fprintf(fp, "            { \"name\": \"sarsat\", \"version\": \"1.0.0\", \"optional\": true }\n");
+    fprintf(fp, "        ]\n");
+    fprintf(fp, "    },\n");
+    fprintf(fp, "    \"captures\": [\n");
+    fprintf(fp, "        {\n");
+    fprintf(fp, "            \"core:sample_start\": 0,\n");
+    fprintf(fp, "            \"core:frequency\": 0,\n");
+    fprintf(fp, "            \"core:datetime\": \"%s\"\n", datetime);
+    fprintf(fp, "        }\n");
+    fprintf(fp, "    ],\n");
+    fprintf(fp, "    \"annotations\": [\n");
+
+    for (uint32_t i = 0; i < rc->count; i++) {
+        const burst_record_t *rec = &rc->records[i];
+        uint64_t start = (uint64_t)ceil(rec->time * sample_rate - 1e-9);
+        uint64_t end = (uint64_t)ceil((rec->time + burst_record_duration(rec)) * sample_rate - 1e-9);
+        char hex[64];
+        frame_hex(rec, hex);
+
+        fprintf(fp, "        {\n");
+        fprintf(fp, "            \"core:sample_start\": %llu,\n", (unsigned long long)start);
+        fprintf(fp, "            \"core:sample_count\": %llu,\n", (unsigned long long)(end - start));
+        fprintf(fp, "            \"core:label\": \"T.018 burst\",\n");
+        fprintf(fp, "            \"sarsat:frame\": \"%s\",\n", hex);
+        fprintf(fp, "            \"sarsat:prn_mode\": \"%s\",\n", rec->prn_mode ? "self-test" : "normal");
+        fprintf(fp, "            \"sarsat:time\": %.9f,\n", rec->time);
+        fprintf(fp, "            \"sarsat:freq_offset\": %.3f,\n", rec->freq_offset);
+        fprintf(fp, "            \"sarsat:phase\": %.6f,\n", rec->phase);
+        fprintf(fp, "            \"sarsat:amplitude\": %.6f,\n", rec->amplitude);
+        fprintf(fp, "            \"sarsat:chip_rate_ppm\": %.3f\n", rec->chip_rate_ppm);
+        fprintf(fp, "        }%s\n", i + 1 < rc->count ? "," : "");
+    }
+
+    fprintf(fp, "    ]\n");
+    fprintf(fp, "}\n");
+
+    if (fclose(fp) != 0) {
+        fprintf(stderr, "Failed to write %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+int burst_recording_save_sigmf(const burst_recording_t *rc, const char *base,
+                               uint32_t sample_rate, int with_data) {
+    if (sample_rate == 0) {
+        fprintf(stderr, "Invalid sample rate for SigMF export\n");
+        return -1;
+    }
+    if (write_sigmf_meta(rc, base, sample_rate, with_data) < 0) {
+        return -1;
+    }
+    if (!with_data) {
+        return 0;
+    }
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s.sigmf-data", base);
+    FILE *fp = fopen(path, "wb");
+    float complex *block = malloc(EXPORT_BLOCK * sizeof(float complex));
+    if (!fp || !block) {
+        fprintf(stderr, "Cannot create %s: %s\n", path, strerror(errno));
+        if (fp) fclose(fp);
+        free(block);
+        return -1;
+    }
+
+    // float complex is interleaved cf32 in memory
+    uint64_t total = burst_recording_samples(rc, sample_rate);
+    int ok = 1;
+    for (uint64_t pos = 0; ok && pos < total; pos += EXPORT_BLOCK) {
+        uint32_t n = total - pos < EXPORT_BLOCK ? (uint32_t)(total - pos) : EXPORT_BLOCK;
+        burst_recording_render(rc, sample_rate, pos, n, block);
+        ok = fwrite(block, sizeof(float complex), n, fp) == n;
+    }
+    if (fclose(fp) != 0) ok = 0;
+    free(block);
+
+    if (!ok) {
+        fprintf(stderr, "Failed to write %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file control_socket.c
+ * @brief UNIX domain control socket implementation
+ */
+
+#define _GNU_SOURCE                 // accept4()
+
+#include "control_socket.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// =============================================================================
+// LISTENING SOCKET
+// =============================================================================
+
+int control_socket_open(control_socket_t *ctrl, const char *path) {
+    memset(ctrl, 0, sizeof(control_socket_t));
+    ctrl->listen_fd = -1;
+    for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+        ctrl->clients[i].fd = -1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Control socket path too long: %s\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+    strcpy(ctrl->path, path);
+
+    ctrl->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (ctrl->listen_fd < 0) {
+        fprintf(stderr, "Control socket creation failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    // Leftover from a previous run
+    unlink(path);
+
+    if (bind(ctrl->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(ctrl->listen_fd, CONTROL_MAX_CLIENTS) < 0) {
+        fprintf(stderr, "Control socket %s: %s\n", path, strerror(errno));
+        close(ctrl->listen_fd);
+        ctrl->listen_fd = -1;
+        return -1;
+    }
+
+    printf("✓ Control socket: %s\n", path);
+    return 0;
+}
+
+control_client_t *control_socket_accept(control_socket_t *ctrl) {
+    int fd = accept4(ctrl->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+        control_client_t *client = &ctrl->clients[i];
+        if (client->fd < 0) {
+            client->fd = fd;
+            client->len = 0;
+            return client;
+        }
+    }
+
+    const char *busy = "ERR too many clients\n";
+    if (send(fd, busy, strlen(busy), MSG_NOSIGNAL) < 0) {
+        // Client already gone
+    }
+    close(fd);
+    return NULL;
+}
+
+// =============================================================================
+// CLIENTS
+// =============================================================================
+
+int control_client_read(control_client_t *client) {
+    for (;;) {
+        if (client->len >= CONTROL_LINE_MAX - 1) {
+            // No newline in a full buffer: discard the garbage
+            client->len = 0;
+        }
+
+        ssize_t n = read(client->fd, client->buf + client->len,
+                         CONTROL_LINE_MAX - 1 - client->len);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) return 0;
+            return -1;
+        }
+        if (n == 0) {
+            return -1;
+        }
+        client->len += (uint32_t)n;
+    }
+}
+
+int control_client_next_line(control_client_t *client, char *line, uint32_t size) {
+    char *nl = memchr(client->buf, '\n', client->len);
+    if (!nl) {
+        return 0;
+    }
+
+    uint32_t line_len = (uint32_t)(nl - client->buf);
+    uint32_t copy = (line_len < size - 1) ? line_len : size - 1;
+    memcpy(line, client->buf, copy);
+    line[copy] = '\0';
+    if (copy > 0 && line[copy - 1] == '\r') {
+        line[copy - 1] = '\0';
+    }
+
+    client->len -= line_len + 1;
+    memmove(client->buf, nl + 1, client->len);
+    return 1;
+}
+
+void control_reply(control_client_t *client, const char *fmt, ...) {
+    char msg[512];
+    va_list args;
+
+    va_start(args, fmt);
+    int len = vsnprintf(msg, sizeof(msg), fmt, args);
+    va_end(args);
+
+    if (len < 0) return;
+    if (len >= (int)sizeof(msg)) len = sizeof(msg) - 1;
+
+    // Never raise SIGPIPE on a vanished client
+    if (send(client->fd, msg, (size_t)len, MSG_NOSIGNAL | MSG_DONTWAIT) < 0) {
+        // Disconnect is detected on the next read
+    }
+}
+
+void control_client_close(control_client_t *client) {
+    if (client->fd >= 0) {
+        close(client->fd);
+        client->fd = -1;
+    }
+    client->len = 0;
+}
+
+void control_socket_close(control_socket_t *ctrl) {
+    if (ctrl->listen_fd < 0) return;
+
+    for (int i = 0; i < CONTROL_MAX_CLIENTS; i++) {
+        control_client_close(&ctrl->clients[i]);
+    }
+    close(ctrl->listen_fd);
+    ctrl->listen_fd = -1;
+    unlink(ctrl->path);
+}
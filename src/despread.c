@@ -0,0 +1,218 @@
+/**
+ * @file despread.c
+ * @brief Bit-parallel DSSS despreader implementation
+ *
+ * With chips ±1 mapped to bits (−1 → 1), a·b = 1 − 2·(a ⊕ b), so the
+ * correlation of n chips is n − 2·popcount(rx ⊕ prn): one XOR and one
+ * population count per 64 chips instead of 64 multiply-adds.
+ */
+
+#include "despread.h"
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Shared packed tables [mode][channel] (read-only after first use)
+static uint64_t prn_words[2][2][DESPREAD_FRAME_WORDS];
+static pthread_once_t prn_words_once = PTHREAD_ONCE_INIT;
+
+// =============================================================================
+// PACKING
+// =============================================================================
+
+void despread_pack_i8(const int8_t *chips, uint32_t stride, uint32_t num_chips, uint64_t *words) {
+    uint32_t full = num_chips / DESPREAD_WORD_CHIPS;
+
+    for (uint32_t w = 0; w < full; w++) {
+        const int8_t *c = chips + (size_t)w * DESPREAD_WORD_CHIPS * stride;
+        uint64_t word = 0;
+        for (uint32_t b = 0; b < DESPREAD_WORD_CHIPS; b++) {
+            word |= (uint64_t)((uint8_t)c[b * stride] >> 7) << b;
+        }
+        words[w] = word;
+    }
+
+    if (num_chips % DESPREAD_WORD_CHIPS) {
+        const int8_t *c = chips + (size_t)full * DESPREAD_WORD_CHIPS * stride;
+        uint64_t word = 0;
+        for (uint32_t b = 0; b < num_chips % DESPREAD_WORD_CHIPS; b++) {
+            word |= (uint64_t)((uint8_t)c[b * stride] >> 7) << b;
+        }
+        words[full] = word;
+    }
+}
+
+void despread_pack_f32(const float *chips, uint32_t stride, uint32_t num_chips, uint64_t *words) {
+    memset(words, 0, despread_words(num_chips) * sizeof(uint64_t));
+    for (uint32_t i = 0; i < num_chips; i++) {
+        words[i / DESPREAD_WORD_CHIPS] |= (uint64_t)(chips[(size_t)i * stride] < 0.0f)
+                                          << (i % DESPREAD_WORD_CHIPS);
+    }
+}
+
+static void build_prn_words(void) {
+    for (uint8_t mode = 0; mode < 2; mode++) {
+        prn_state_t state;
+        prn_init(&state, mode);
+        prn_generate_packed(state.lfsr_i, prn_words[mode][0], DESPREAD_FRAME_WORDS);
+        prn_generate_packed(state.lfsr_q, prn_words[mode][1], DESPREAD_FRAME_WORDS);
+    }
+}
+
+const uint64_t *despread_prn_words(uint8_t mode, uint8_t channel) {
+    pthread_once(&prn_words_once, build_prn_words);
+    return prn_words[mode ? 1 : 0][channel ? 1 : 0];
+}
+
+// =============================================================================
+// HARD CORRELATION (XOR / POPCOUNT)
+// =============================================================================
+
+int32_t despread_xor(const uint64_t *a, const uint64_t *b, uint32_t num_words) {
+    uint32_t ones = 0;
+    uint32_t w = 0;
+
+#if defined(__ARM_NEON)
+    // vcnt per byte, widened pairwise; 128 chips per iteration
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (; w + 2 <= num_words; w += 2) {
+        uint8x16_t x = vreinterpretq_u8_u64(veorq_u64(vld1q_u64(a + w), vld1q_u64(b + w)));
+        acc = vpadalq_u16(acc, vpaddlq_u8(vcntq_u8(x)));
+    }
+    ones = vgetq_lane_u32(acc, 0) + vgetq_lane_u32(acc, 1) +
+           vgetq_lane_u32(acc, 2) + vgetq_lane_u32(acc, 3);
+#endif
+    for (; w < num_words; w++) {
+        ones += despread_popcount64(a[w] ^ b[w]);
+    }
+    return (int32_t)(num_words * DESPREAD_WORD_CHIPS) - 2 * (int32_t)ones;
+}
+
+int32_t despread_xor_at(const uint64_t *rx, uint32_t chip_offset,
+                        const uint64_t *ref, uint32_t num_words) {
+    const uint64_t *r = rx + chip_offset / DESPREAD_WORD_CHIPS;
+    uint32_t s = chip_offset % DESPREAD_WORD_CHIPS;
+    if (s == 0) {
+        return despread_xor(r, ref, num_words);
+    }
+
+    uint32_t ones = 0;
+    uint32_t w = 0;
+
+#if defined(__ARM_NEON)
+    // Funnel shift two words at a time: (r[w] >> s) | (r[w+1] << (64-s))
+    const int64x2_t right = vdupq_n_s64(-(int64_t)s);
+    const int64x2_t left = vdupq_n_s64(DESPREAD_WORD_CHIPS - (int64_t)s);
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (; w + 2 <= num_words; w += 2) {
+        uint64x2_t lo = vshlq_u64(vld1q_u64(r + w), right);
+        uint64x2_t hi = vshlq_u64(vld1q_u64(r + w + 1), left);
+        uint8x16_t x = vreinterpretq_u8_u64(veorq_u64(vorrq_u64(lo, hi), vld1q_u64(ref + w)));
+        acc = vpadalq_u16(acc, vpaddlq_u8(vcntq_u8(x)));
+    }
+    ones = vgetq_lane_u32(acc, 0) + vgetq_lane_u32(acc, 1) +
+           vgetq_lane_u32(acc, 2) + vgetq_lane_u32(acc, 3);
+#endif
+    for (; w < num_words; w++) {
+        uint64_t word = (r[w] >> s) | (r[w + 1] << (DESPREAD_WORD_CHIPS - s));
+        ones += despread_popcount64(word ^ ref[w]);
+    }
+    return (int32_t)(num_words * DESPREAD_WORD_CHIPS) - 2 * (int32_t)ones;
+}
+
+int32_t despread_search(const uint64_t *rx, uint32_t rx_chips, const uint64_t *ref,
+                        uint32_t num_words, uint32_t max_offset, uint32_t *best_offset) {
+    uint32_t window = num_words * DESPREAD_WORD_CHIPS;
+    int32_t best = 0;
+    *best_offset = 0;
+
+    if (rx_chips < window) {
+        return 0;
+    }
+    if (max_offset > rx_chips - window) {
+        max_offset = rx_chips - window;
+    }
+
+    for (uint32_t offset = 0; offset <= max_offset; offset++) {
+        int32_t c = despread_xor_at(rx, offset, ref, num_words);
+        if ((c < 0 ? -c : c) > (best < 0 ? -best : best)) {
+            best = c;
+            *best_offset = offset;
+        }
+    }
+    return best;
+}
+
+uint32_t despread_bits(const uint64_t *rx, uint32_t chip_offset, const uint64_t *prn,
+                       uint32_t num_bits, uint8_t *bits, int32_t *corr) {
+    uint32_t errors = 0;
+
+    for (uint32_t b = 0; b < num_bits; b++) {
+        int32_t c = despread_xor_at(rx, chip_offset + b * PRN_CHIPS_PER_BIT,
+                                    prn + b * DESPREAD_BIT_WORDS, DESPREAD_BIT_WORDS);
+        // Bit 1 inverts the PRN
+        bits[b] = c < 0;
+        errors += (PRN_CHIPS_PER_BIT - (uint32_t)(c < 0 ? -c : c)) / 2;
+        if (corr) {
+            corr[b] = c;
+        }
+    }
+    return errors;
+}
+
+// =============================================================================
+// SOFT CORRELATION (INT8)
+// =============================================================================
+
+int32_t despread_dot_i8(const int8_t *x, const int8_t *ref, uint32_t n) {
+    int32_t sum = 0;
+    uint32_t i = 0;
+
+#if defined(__ARM_NEON) && defined(__ARM_FEATURE_DOTPROD)
+    // sdot: four int8 products summed into each int32 lane
+    int32x4_t acc = vdupq_n_s32(0);
+    for (; i + 16 <= n; i += 16) {
+        acc = vdotq_s32(acc, vld1q_s8(x + i), vld1q_s8(ref + i));
+    }
+    sum = vgetq_lane_s32(acc, 0) + vgetq_lane_s32(acc, 1) +
+          vgetq_lane_s32(acc, 2) + vgetq_lane_s32(acc, 3);
+#elif defined(__ARM_NEON)
+    // Widening multiply into int16, pairwise accumulate into int32
+    int32x4_t acc = vdupq_n_s32(0);
+    for (; i + 16 <= n; i += 16) {
+        int8x16_t a = vld1q_s8(x + i);
+        int8x16_t b = vld1q_s8(ref + i);
+        acc = vpadalq_s16(acc, vmull_s8(vget_low_s8(a), vget_low_s8(b)));
+        acc = vpadalq_s16(acc, vmull_s8(vget_high_s8(a), vget_high_s8(b)));
+    }
+    sum = vgetq_lane_s32(acc, 0) + vgetq_lane_s32(acc, 1) +
+          vgetq_lane_s32(acc, 2) + vgetq_lane_s32(acc, 3);
+#endif
+    for (; i < n; i++) {
+        sum += (int32_t)x[i] * ref[i];
+    }
+    return sum;
+}
+
+void despread_bits_i8(const int8_t *x, const int8_t *prn, uint32_t num_bits,
+                      uint8_t *bits, int32_t *corr) {
+    for (uint32_t b = 0; b < num_bits; b++) {
+        int32_t c = despread_dot_i8(x + b * PRN_CHIPS_PER_BIT, prn + b * PRN_CHIPS_PER_BIT,
+                                    PRN_CHIPS_PER_BIT);
+        bits[b] = c < 0;
+        if (corr) {
+            corr[b] = c;
+        }
+    }
+}
+
+void despread_quantize(const float *x, uint32_t stride, uint32_t n, float scale, int8_t *out) {
+    for (uint32_t i = 0; i < n; i++) {
+        float v = x[(size_t)i * stride] * scale;
+        v = v > 127.0f ? 127.0f : (v < -127.0f ? -127.0f : v);
+        out[i] = (int8_t)(v < 0.0f ? v - 0.5f : v + 0.5f);
+    }
+}
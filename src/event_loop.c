@@ -0,0 +1,273 @@
+/**
+ * @file event_loop.c
+ * @brief epoll/timerfd/signalfd event loop implementation
+ */
+
+#include "event_loop.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+#include <sys/eventfd.h>
+
+// =============================================================================
+// EVENT LOOP
+// =============================================================================
+
+int event_loop_init(event_loop_t *loop) {
+    memset(loop, 0, sizeof(event_loop_t));
+    for (int i = 0; i < EVENT_LOOP_MAX_FDS; i++) {
+        loop->sources[i].fd = -1;
+    }
+
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd < 0) {
+        fprintf(stderr, "epoll_create1 failed: %s\n", strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+int event_loop_add(event_loop_t *loop, int fd, uint32_t events,
+                   event_handler_t handler, void *user) {
+    event_source_t *src = NULL;
+    for (int i = 0; i < EVENT_LOOP_MAX_FDS; i++) {
+        if (loop->sources[i].fd < 0) {
+            src = &loop->sources[i];
+            break;
+        }
+    }
+    if (!src) {
+        fprintf(stderr, "Event loop full (max %d descriptors)\n", EVENT_LOOP_MAX_FDS);
+        return -1;
+    }
+
+    struct epoll_event ev = { .events = events, .data.ptr = src };
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        // Regular files are not pollable (EPERM): caller decides the fallback
+        if (errno != EPERM) {
+            fprintf(stderr, "epoll_ctl(ADD, %d) failed: %s\n", fd, strerror(errno));
+        }
+        return -1;
+    }
+
+    src->fd = fd;
+    src->handler = handler;
+    src->user = user;
+    return 0;
+}
+
+void event_loop_remove(event_loop_t *loop, int fd) {
+    for (int i = 0; i < EVENT_LOOP_MAX_FDS; i++) {
+        if (loop->sources[i].fd == fd) {
+            epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+            loop->sources[i].fd = -1;
+            return;
+        }
+    }
+}
+
+int event_loop_run(event_loop_t *loop) {
+    struct epoll_event events[EVENT_LOOP_MAX_FDS];
+
+    loop->running = 1;
+    while (loop->running) {
+        int n = epoll_wait(loop->epoll_fd, events, EVENT_LOOP_MAX_FDS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "epoll_wait failed: %s\n", strerror(errno));
+            return -1;
+        }
+
+        for (int i = 0; i < n && loop->running; i++) {
+            event_source_t *src = (event_source_t *)events[i].data.ptr;
+            // Source may have been removed by a previous handler in this batch
+            if (src->fd >= 0) {
+                src->handler(src->fd, events[i].events, src->user);
+            }
+        }
+    }
+    return 0;
+}
+
+void event_loop_stop(event_loop_t *loop) {
+    loop->running = 0;
+}
+
+void event_loop_cleanup(event_loop_t *loop) {
+    if (loop->epoll_fd >= 0) {
+        close(loop->epoll_fd);
+        loop->epoll_fd = -1;
+    }
+}
+
+// =============================================================================
+// TIMERS & SIGNALS
+// =============================================================================
+
+int event_timer_create(void) {
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) {
+        fprintf(stderr, "timerfd_create failed: %s\n", strerror(errno));
+    }
+    return fd;
+}
+
+int event_timer_arm(int fd, const struct timespec *deadline) {
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value = *deadline;
+
+    // A zero it_value would disarm the timer: fire as soon as possible instead
+    if (its.it_value.tv_sec == 0 && its.it_value.tv_nsec == 0) {
+        its.it_value.tv_nsec = 1;
+    }
+
+    if (timerfd_settime(fd, TFD_TIMER_ABSTIME, &its, NULL) < 0) {
+        fprintf(stderr, "timerfd_settime failed: %s\n", strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+uint64_t event_timer_ack(int fd) {
+    uint64_t expirations = 0;
+    if (read(fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+        return 0;
+    }
+    return expirations;
+}
+
+int event_signal_create(const int *signals, int count) {
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (int i = 0; i < count; i++) {
+        sigaddset(&mask, signals[i]);
+    }
+
+    // Blocked in every thread created afterwards (mask is inherited)
+    if (pthread_sigmask(SIG_BLOCK, &mask, NULL) != 0) {
+        fprintf(stderr, "pthread_sigmask failed\n");
+        return -1;
+    }
+
+    int fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0) {
+        fprintf(stderr, "signalfd failed: %s\n", strerror(errno));
+    }
+    return fd;
+}
+
+void event_timespec_add(struct timespec *ts, double sec) {
+    long long ns = (long long)(sec * 1e9);
+    ts->tv_sec += ns / 1000000000LL;
+    ts->tv_nsec += ns % 1000000000LL;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    } else if (ts->tv_nsec < 0) {
+        ts->tv_sec--;
+        ts->tv_nsec += 1000000000L;
+    }
+}
+
+// =============================================================================
+// WORKER THREAD
+// =============================================================================
+
+static void *worker_thread(void *arg) {
+    event_worker_t *worker = (event_worker_t *)arg;
+
+    pthread_mutex_lock(&worker->lock);
+    for (;;) {
+        while (!worker->stop && !worker->job) {
+            pthread_cond_wait(&worker->cond, &worker->lock);
+        }
+        if (!worker->job) break;
+
+        event_job_t job = worker->job;
+        void *job_arg = worker->arg;
+        pthread_mutex_unlock(&worker->lock);
+
+        int result = job(job_arg);
+
+        pthread_mutex_lock(&worker->lock);
+        worker->result = result;
+        worker->job = NULL;
+
+        // Wake the event loop
+        uint64_t one = 1;
+        if (write(worker->done_fd, &one, sizeof(one)) != sizeof(one)) {
+            fprintf(stderr, "Worker completion notification failed\n");
+        }
+        pthread_cond_broadcast(&worker->cond);
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    return NULL;
+}
+
+int event_worker_start(event_worker_t *worker) {
+    memset(worker, 0, sizeof(event_worker_t));
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->cond, NULL);
+
+    worker->done_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (worker->done_fd < 0) {
+        fprintf(stderr, "eventfd failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    if (pthread_create(&worker->thread, NULL, worker_thread, worker) != 0) {
+        fprintf(stderr, "Failed to start worker thread\n");
+        close(worker->done_fd);
+        worker->done_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+int event_worker_submit(event_worker_t *worker, event_job_t job, void *arg) {
+    pthread_mutex_lock(&worker->lock);
+    if (worker->busy) {
+        pthread_mutex_unlock(&worker->lock);
+        return -1;
+    }
+    worker->job = job;
+    worker->arg = arg;
+    worker->busy = 1;
+    pthread_cond_broadcast(&worker->cond);
+    pthread_mutex_unlock(&worker->lock);
+    return 0;
+}
+
+int event_worker_collect(event_worker_t *worker) {
+    uint64_t count;
+    if (read(worker->done_fd, &count, sizeof(count)) < 0 && errno != EAGAIN) {
+        fprintf(stderr, "Worker eventfd read failed: %s\n", strerror(errno));
+    }
+
+    pthread_mutex_lock(&worker->lock);
+    int result = worker->result;
+    worker->busy = 0;
+    pthread_mutex_unlock(&worker->lock);
+    return result;
+}
+
+void event_worker_stop(event_worker_t *worker) {
+    if (worker->done_fd < 0) return;
+
+    pthread_mutex_lock(&worker->lock);
+    worker->stop = 1;
+    pthread_cond_broadcast(&worker->cond);
+    pthread_mutex_unlock(&worker->lock);
+
+    pthread_join(worker->thread, NULL);
+    close(worker->done_fd);
+    worker->done_fd = -1;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file fft.c
+ * @brief Radix-2 decimation-in-time FFT
+ */
+
+#include "fft.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// =============================================================================
+// PLAN
+// =============================================================================
+
+int fft_plan_init(fft_plan_t *plan, uint32_t size) {
+    memset(plan, 0, sizeof(fft_plan_t));
+
+    if (size < 2 || (size & (size - 1)) != 0) {
+        fprintf(stderr, "FFT size %u is not a power of two\n", size);
+        return -1;
+    }
+
+    plan->size = size;
+    while ((1u << plan->log2_size) < size) {
+        plan->log2_size++;
+    }
+
+    plan->twiddle = malloc((size / 2) * sizeof(float complex));
+    plan->bitrev = malloc(size * sizeof(uint32_t));
+    if (!plan->twiddle || !plan->bitrev) {
+        fprintf(stderr, "Failed to allocate FFT plan (%u points)\n", size);
+        fft_plan_free(plan);
+        return -1;
+    }
+
+    for (uint32_t k = 0; k < size / 2; k++) {
+        double angle = -2.0 * M_PI * k / size;
+        plan->twiddle[k] = (float)cos(angle) + I * (float)sin(angle);
+    }
+
+    for (uint32_t i = 0; i < size; i++) {
+        uint32_t r = 0;
+        for (uint32_t b = 0; b < plan->log2_size; b++) {
+            r |= ((i >> b) & 1u) << (plan->log2_size - 1 - b);
+        }
+        plan->bitrev[i] = r;
+    }
+
+    return 0;
+}
+
+void fft_plan_free(fft_plan_t *plan) {
+    free(plan->twiddle);
+    free(plan->bitrev);
+    plan->twiddle = NULL;
+    plan->bitrev = NULL;
+}
+
+// =============================================================================
+// TRANSFORM
+// =============================================================================
+
+static void fft_run(const fft_plan_t *plan, float complex *data, int inverse) {
+    uint32_t n = plan->size;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t j = plan->bitrev[i];
+        if (j > i) {
+            float complex t = data[i];
+            data[i] = data[j];
+            data[j] = t;
+        }
+    }
+
+    for (uint32_t half = 1, stride = n / 2; half < n; half <<= 1, stride >>= 1) {
+        for (uint32_t start = 0; start < n; start += 2 * half) {
+            for (uint32_t k = 0; k < half; k++) {
+                // Explicit real arithmetic: C99 complex '*' calls __mulsc3 (NaN/Inf rules)
+                float wr = crealf(plan->twiddle[k * stride]);
+                float wi = inverse ? -cimagf(plan->twiddle[k * stride])
+                                   : cimagf(plan->twiddle[k * stride]);
+                float complex a = data[start + k];
+                float complex c = data[start + k + half];
+                float br = crealf(c) * wr - cimagf(c) * wi;
+                float bi = crealf(c) * wi + cimagf(c) * wr;
+                data[start + k] = (crealf(a) + br) + I * (cimagf(a) + bi);
+                data[start + k + half] = (crealf(a) - br) + I * (cimagf(a) - bi);
+            }
+        }
+    }
+}
+
+void fft_forward(const fft_plan_t *plan, float complex *data) {
+    fft_run(plan, data, 0);
+}
+
+void fft_inverse(const fft_plan_t *plan, float complex *data) {
+    fft_run(plan, data, 1);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file gps_input.c
+ * @brief NMEA GPS input implementation
+ */
+
+#include "gps_input.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// =============================================================================
+// NMEA PARSING
+// =============================================================================
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/**
+ * @brief Convert NMEA (d)ddmm.mmmm + hemisphere to signed degrees
+ */
+static double nmea_to_degrees(const char *value, char hemisphere) {
+    double raw = atof(value);
+    int degrees = (int)(raw / 100.0);
+    double result = degrees + (raw - degrees * 100.0) / 60.0;
+    return (hemisphere == 'S' || hemisphere == 'W') ? -result : result;
+}
+
+int gps_parse_nmea(const char *sentence, gps_fix_t *fix) {
+    if (sentence[0] != '$') return 0;
+
+    // Checksum: XOR of all characters between '$' and '*'
+    const char *star = strchr(sentence, '*');
+    if (star) {
+        uint8_t sum = 0;
+        for (const char *p = sentence + 1; p < star; p++) {
+            sum ^= (uint8_t)*p;
+        }
+        int hi = hex_value(star[1]);
+        int lo = (hi >= 0) ? hex_value(star[2]) : -1;
+        if (lo < 0 || sum != (uint8_t)(hi << 4 | lo)) {
+            return -1;
+        }
+    }
+
+    // Talker ID is ignored ($GPGGA, $GNGGA, $GLGGA...)
+    if (strlen(sentence) < 6 || strncmp(sentence + 3, "GGA,", 4) != 0) {
+        return 0;
+    }
+
+    // Split fields (empty fields are kept)
+    char buf[GPS_LINE_MAX];
+    size_t len = star ? (size_t)(star - sentence) : strlen(sentence);
+    if (len >= sizeof(buf)) return 0;
+    memcpy(buf, sentence, len);
+    buf[len] = '\0';
+
+    char *field[15] = {0};
+    int count = 0;
+    char *p = buf;
+    while (count < 15) {
+        field[count++] = p;
+        p = strchr(p, ',');
+        if (!p) break;
+        *p++ = '\0';
+    }
+
+    // 0:$xxGGA 1:time 2:lat 3:N/S 4:lon 5:E/W 6:quality 7:sats 8:hdop 9:alt
+    if (count < 10 || field[2][0] == '\0' || field[4][0] == '\0' || atoi(field[6]) == 0) {
+        return 0;
+    }
+
+    fix->latitude = nmea_to_degrees(field[2], field[3][0]);
+    fix->longitude = nmea_to_degrees(field[4], field[5][0]);
+    fix->altitude = atof(field[9]);
+    fix->satellites = (uint8_t)atoi(field[7]);
+    fix->valid = 1;
+    return 1;
+}
+
+// =============================================================================
+// STREAM INPUT
+// =============================================================================
+
+int gps_input_open(gps_input_t *gps, const char *path) {
+    memset(gps, 0, sizeof(gps_input_t));
+
+    gps->fd = open(path, O_RDONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+    if (gps->fd < 0) {
+        fprintf(stderr, "Cannot open GPS source %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    printf("✓ GPS input: %s\n", path);
+    return 0;
+}
+
+int gps_input_read(gps_input_t *gps) {
+    char chunk[512];
+    int new_fixes = 0;
+
+    for (;;) {
+        ssize_t n = read(gps->fd, chunk, sizeof(chunk));
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EINTR) break;
+            fprintf(stderr, "GPS read error: %s\n", strerror(errno));
+            return -1;
+        }
+        if (n == 0) {
+            return new_fixes > 0 ? new_fixes : -1;
+        }
+
+        for (ssize_t i = 0; i < n; i++) {
+            char c = chunk[i];
+            if (c == '\r') continue;
+
+            if (c != '\n') {
+                // Overlong lines are garbage: drop until next newline
+                // (a truncated GGA could still parse, without checksum)
+                if (gps->discard) continue;
+                if (gps->line_len < GPS_LINE_MAX - 1) {
+                    gps->line[gps->line_len++] = c;
+                } else {
+                    gps->discard = 1;
+                    gps->overlong++;
+                    gps->line_len = 0;
+                }
+                continue;
+            }
+
+            gps->line[gps->line_len] = '\0';
+            if (gps->discard) {
+                gps->discard = 0;
+            } else if (gps->line_len > 0) {
+                gps->sentences++;
+                int result = gps_parse_nmea(gps->line, &gps->fix);
+                if (result > 0) {
+                    gps->fixes++;
+                    new_fixes++;
+                } else if (result < 0) {
+                    gps->checksum_errors++;
+                }
+            }
+            gps->line_len = 0;
+        }
+    }
+
+    return new_fixes;
+}
+
+void gps_input_close(gps_input_t *gps) {
+    if (gps->fd >= 0) {
+        close(gps->fd);
+        gps->fd = -1;
+    }
+}
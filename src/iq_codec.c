@@ -0,0 +1,701 @@
+/**
+ * @file iq_codec.c
+ * @brief Lossless compressed ci16 I/Q recordings implementation
+ *
+ * Each block is coded channel by channel (I then Q) into one MSB-first
+ * bitstream. A channel starts with a 3-bit mode: predictor order 0-3, or
+ * verbatim (16 bits per sample). Predicted channels carry `order` warm-up
+ * samples (16 bits each), then the residuals in partitions of 256, each
+ * with a 5-bit Rice parameter k. A residual is zigzag mapped to u and sent
+ * as q = u >> k zeros, a one, and the k low bits; q >= 32 is escaped as 32
+ * zeros and the 24-bit value. The exact cost is computed before writing, so
+ * a channel never takes more than its verbatim size.
+ *
+ * File layout (little endian):
+ *   header  "SGIQ", u16 version, u16 0, u32 sample rate, u32 block samples,
+ *           u64 total samples, u64 index offset (0 = writer did not finish)
+ *   block   u32 payload bytes, u32 samples, payload
+ *   index   u32 block count, u32 0, u64 block offsets
+ */
+
+#include "iq_codec.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <sys/types.h>
+
+#define MODE_BITS           3
+#define MODE_VERBATIM       4
+#define RICE_BITS           5           // Rice parameter field
+#define RICE_MAX            24          // Largest Rice parameter
+#define ESCAPE_ZEROS        32          // Quotient escape
+#define ESCAPE_BITS         24          // Escaped residual width (order-3 residuals < 2^20)
+
+// =============================================================================
+// BIT I/O
+// =============================================================================
+
+typedef struct {
+    uint8_t *buf;
+    size_t pos;
+    uint64_t acc;
+    int bits;                           // Pending bits in acc (< 8 between calls)
+} bit_writer_t;
+
+static inline void bw_put(bit_writer_t *bw, uint32_t value, int bits) {
+    // bits <= 32, value < 2^bits
+    bw->acc = (bw->acc << bits) | value;
+    bw->bits += bits;
+    while (bw->bits >= 8) {
+        bw->bits -= 8;
+        bw->buf[bw->pos++] = (uint8_t)(bw->acc >> bw->bits);
+    }
+}
+
+static void bw_flush(bit_writer_t *bw) {
+    if (bw->bits > 0) {
+        bw->buf[bw->pos++] = (uint8_t)(bw->acc << (8 - bw->bits));
+        bw->bits = 0;
+    }
+}
+
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    size_t pos;                         // Next byte to load (may pass len: zeros)
+    uint64_t acc;                       // Valid bits left-aligned
+    int bits;
+} bit_reader_t;
+
+static inline void br_refill(bit_reader_t *br) {
+    while (br->bits <= 56) {
+        uint64_t byte = br->pos < br->len ? br->buf[br->pos] : 0;
+        br->pos++;
+        br->acc |= byte << (56 - br->bits);
+        br->bits += 8;
+    }
+}
+
+static inline uint32_t br_get(bit_reader_t *br, int bits) {
+    // bits in 1..32, at least `bits` valid bits buffered
+    uint32_t v = (uint32_t)(br->acc >> (64 - bits));
+    br->acc <<= bits;
+    br->bits -= bits;
+    return v;
+}
+
+static inline int br_overrun(const bit_reader_t *br) {
+    return (uint64_t)br->pos * 8 - (uint64_t)br->bits > (uint64_t)br->len * 8;
+}
+
+// =============================================================================
+// PREDICTION
+// =============================================================================
+
+static inline uint32_t zigzag(int32_t e) {
+    return ((uint32_t)e << 1) ^ (uint32_t)(e >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t u) {
+    return (int32_t)(u >> 1) ^ -(int32_t)(u & 1);
+}
+
+static int choose_order(const int16_t *x, uint32_t n) {
+    // Sum of |residual| for the four fixed predictors (differences of order 0-3)
+    if (n <= IQ_CODEC_MAX_ORDER) return 0;
+    uint64_t sum[IQ_CODEC_MAX_ORDER + 1] = { 0 };
+    int32_t x1 = x[2 * 2], x2 = x[1 * 2], x3 = x[0];
+    for (uint32_t i = IQ_CODEC_MAX_ORDER; i < n; i++) {
+        int32_t x0 = x[2 * i];
+        int32_t e0 = x0;
+        int32_t e1 = x0 - x1;
+        int32_t e2 = e1 - (x1 - x2);
+        int32_t e3 = e2 - (x1 - 2 * x2 + x3);
+        sum[0] += (uint32_t)abs(e0);
+        sum[1] += (uint32_t)abs(e1);
+        sum[2] += (uint32_t)abs(e2);
+        sum[3] += (uint32_t)abs(e3);
+        x3 = x2;
+        x2 = x1;
+        x1 = x0;
+    }
+    int best = 0;
+    for (int p = 1; p <= IQ_CODEC_MAX_ORDER; p++) {
+        if (sum[p] < sum[best]) best = p;
+    }
+    return best;
+}
+
+static void compute_residuals(const int16_t *x, uint32_t n, int order, uint32_t *u) {
+    // x has stride 2 (one channel of interleaved I/Q)
+    for (uint32_t i = (uint32_t)order; i < n; i++) {
+        int32_t x0 = x[2 * i];
+        int32_t e;
+        switch (order) {
+        case 0:
+            e = x0;
+            break;
+        case 1:
+            e = x0 - x[2 * (i - 1)];
+            break;
+        case 2:
+            e = x0 - 2 * x[2 * (i - 1)] + x[2 * (i - 2)];
+            break;
+        default:
+            e = x0 - 3 * x[2 * (i - 1)] + 3 * x[2 * (i - 2)] - x[2 * (i - 3)];
+            break;
+        }
+        u[i - (uint32_t)order] = zigzag(e);
+    }
+}
+
+// =============================================================================
+// RICE CODING
+// =============================================================================
+
+static int rice_parameter(const uint32_t *u, uint32_t count) {
+    // 2^k close to the mean residual
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) sum += u[i];
+    int k = 0;
+    while (k < RICE_MAX && ((uint64_t)count << (k + 1)) <= sum) k++;
+    return k;
+}
+
+static uint64_t rice_cost(const uint32_t *u, uint32_t count, int k) {
+    uint64_t bits = RICE_BITS;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t q = u[i] >> k;
+        bits += q < ESCAPE_ZEROS ? q + 1 + (uint32_t)k : ESCAPE_ZEROS + ESCAPE_BITS;
+    }
+    return bits;
+}
+
+static void rice_write(bit_writer_t *bw, const uint32_t *u, uint32_t count, int k) {
+    bw_put(bw, (uint32_t)k, RICE_BITS);
+    uint32_t mask = (1u << k) - 1;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t q = u[i] >> k;
+        if (q < ESCAPE_ZEROS) {
+            bw_put(bw, 1, (int)q + 1);
+            if (k) bw_put(bw, u[i] & mask, k);
+        } else {
+            bw_put(bw, 0, ESCAPE_ZEROS);
+            bw_put(bw, u[i], ESCAPE_BITS);
+        }
+    }
+}
+
+static void encode_channel(bit_writer_t *bw, const int16_t *x, uint32_t n, uint32_t *u) {
+    int order = choose_order(x, n);
+    uint32_t count = n - (uint32_t)order;
+    compute_residuals(x, n, order, u);
+
+    // Exact cost with per-partition parameters, against verbatim
+    uint64_t bits = (uint64_t)order * 16;
+    for (uint32_t p = 0; p < count; p += IQ_CODEC_PARTITION) {
+        uint32_t len = count - p < IQ_CODEC_PARTITION ? count - p : IQ_CODEC_PARTITION;
+        bits += rice_cost(&u[p], len, rice_parameter(&u[p], len));
+    }
+
+    if (bits >= (uint64_t)n * 16) {
+        bw_put(bw, MODE_VERBATIM, MODE_BITS);
+        for (uint32_t i = 0; i < n; i++) bw_put(bw, (uint16_t)x[2 * i], 16);
+        return;
+    }
+
+    bw_put(bw, (uint32_t)order, MODE_BITS);
+    for (int i = 0; i < order; i++) bw_put(bw, (uint16_t)x[2 * i], 16);
+    for (uint32_t p = 0; p < count; p += IQ_CODEC_PARTITION) {
+        uint32_t len = count - p < IQ_CODEC_PARTITION ? count - p : IQ_CODEC_PARTITION;
+        rice_write(bw, &u[p], len, rice_parameter(&u[p], len));
+    }
+}
+
+static int decode_channel(bit_reader_t *br, uint32_t n, int16_t *x) {
+    br_refill(br);
+    uint32_t mode = br_get(br, MODE_BITS);
+
+    if (mode == MODE_VERBATIM) {
+        for (uint32_t i = 0; i < n; i++) {
+            br_refill(br);
+            x[2 * i] = (int16_t)br_get(br, 16);
+        }
+        return 0;
+    }
+    if (mode > IQ_CODEC_MAX_ORDER) {
+        return -1;
+    }
+
+    uint32_t order = mode < n ? mode : n;
+    for (uint32_t i = 0; i < order; i++) {
+        br_refill(br);
+        x[2 * i] = (int16_t)br_get(br, 16);
+    }
+
+    int32_t x1 = order > 0 ? x[2 * (order - 1)] : 0;
+    int32_t x2 = order > 1 ? x[2 * (order - 2)] : 0;
+    int32_t x3 = order > 2 ? x[2 * (order - 3)] : 0;
+
+    for (uint32_t i = order; i < n; ) {
+        br_refill(br);
+        int k = (int)br_get(br, RICE_BITS);
+        if (k > RICE_MAX) return -1;
+
+        uint32_t end = i + IQ_CODEC_PARTITION < n ? i + IQ_CODEC_PARTITION : n;
+        for (; i < end; i++) {
+            br_refill(br);
+            int zeros = br->acc ? __builtin_clzll(br->acc) : 64;
+            uint32_t u;
+            if (zeros < ESCAPE_ZEROS) {
+                br->acc <<= zeros + 1;
+                br->bits -= zeros + 1;
+                u = ((uint32_t)zeros << k) | (k ? br_get(br, k) : 0);
+            } else {
+                br->acc <<= ESCAPE_ZEROS;
+                br->bits -= ESCAPE_ZEROS;
+                u = br_get(br, ESCAPE_BITS);
+            }
+
+            int32_t e = unzigzag(u);
+            int32_t x0;
+            switch (mode) {
+            case 0:
+                x0 = e;
+                break;
+            case 1:
+                x0 = e + x1;
+                break;
+            case 2:
+                x0 = e + 2 * x1 - x2;
+                break;
+            default:
+                x0 = e + 3 * x1 - 3 * x2 + x3;
+                break;
+            }
+            x[2 * i] = (int16_t)x0;
+            x3 = x2;
+            x2 = x1;
+            x1 = x0;
+        }
+        if (br_overrun(br)) return -1;
+    }
+    return 0;
+}
+
+// =============================================================================
+// BLOCKS
+// =============================================================================
+
+uint32_t iq_block_encode(const int16_t *iq, uint32_t samples, uint8_t *payload) {
+    uint32_t *u = malloc((size_t)samples * sizeof(uint32_t) + 1);
+    if (!u) {
+        // Out of memory: verbatim needs no residual scratch
+        bit_writer_t bw = { .buf = payload };
+        for (int c = 0; c < 2; c++) {
+            bw_put(&bw, MODE_VERBATIM, MODE_BITS);
+            for (uint32_t i = 0; i < samples; i++) bw_put(&bw, (uint16_t)iq[2 * i + c], 16);
+        }
+        bw_flush(&bw);
+        return (uint32_t)bw.pos;
+    }
+
+    bit_writer_t bw = { .buf = payload };
+    encode_channel(&bw, &iq[0], samples, u);
+    encode_channel(&bw, &iq[1], samples, u);
+    bw_flush(&bw);
+    free(u);
+    return (uint32_t)bw.pos;
+}
+
+int iq_block_decode(const uint8_t *payload, uint32_t bytes, uint32_t samples, int16_t *iq) {
+    bit_reader_t br = { .buf = payload, .len = bytes };
+    if (decode_channel(&br, samples, &iq[0]) < 0 ||
+        decode_channel(&br, samples, &iq[1]) < 0 ||
+        br_overrun(&br)) {
+        return -1;
+    }
+    return 0;
+}
+
+// =============================================================================
+// FILE HELPERS
+// =============================================================================
+
+static void put_le16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void put_le64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint32_t get_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_le64(const uint8_t *p) {
+    return (uint64_t)get_le32(p) | ((uint64_t)get_le32(p + 4) << 32);
+}
+
+static void encode_header(uint8_t *h, uint32_t sample_rate, uint32_t block_samples,
+                          uint64_t total_samples, uint64_t index_offset) {
+    memset(h, 0, IQ_CODEC_HEADER_SIZE);
+    memcpy(h, IQ_CODEC_MAGIC, 4);
+    put_le16(h + 4, IQ_CODEC_VERSION);
+    put_le32(h + 8, sample_rate);
+    put_le32(h + 12, block_samples);
+    put_le64(h + 16, total_samples);
+    put_le64(h + 24, index_offset);
+}
+
+int iq_codec_is_path(const char *path) {
+    size_t len = strlen(path);
+    return len > 5 && strcasecmp(path + len - 5, ".sgiq") == 0;
+}
+
+// =============================================================================
+// WRITER
+// =============================================================================
+
+int iq_writer_open(iq_writer_t *w, const char *path, uint32_t sample_rate, uint32_t block_samples) {
+    memset(w, 0, sizeof(iq_writer_t));
+    w->sample_rate = sample_rate;
+    w->block_samples = block_samples ? block_samples : IQ_CODEC_DEFAULT_BLOCK;
+    if (w->block_samples > IQ_CODEC_MAX_BLOCK) {
+        fprintf(stderr, "Block of %u samples exceeds %d\n", w->block_samples, IQ_CODEC_MAX_BLOCK);
+        return -1;
+    }
+
+    w->pending = malloc((size_t)w->block_samples * 2 * sizeof(int16_t));
+    w->payload = malloc(IQ_CODEC_MAX_PAYLOAD(w->block_samples));
+    if (!w->pending || !w->payload) {
+        fprintf(stderr, "Failed to allocate compression buffers\n");
+        iq_writer_close(w);
+        return -1;
+    }
+
+    w->file = fopen(path, "wb");
+    if (!w->file) {
+        fprintf(stderr, "Cannot create %s: %s\n", path, strerror(errno));
+        iq_writer_close(w);
+        return -1;
+    }
+
+    uint8_t h[IQ_CODEC_HEADER_SIZE];
+    encode_header(h, sample_rate, w->block_samples, 0, 0);
+    if (fwrite(h, 1, sizeof(h), w->file) != sizeof(h)) {
+        fprintf(stderr, "Write error: %s\n", strerror(errno));
+        iq_writer_close(w);
+        return -1;
+    }
+    w->bytes_written = IQ_CODEC_HEADER_SIZE;
+    return 0;
+}
+
+int iq_writer_add_block(iq_writer_t *w, const uint8_t *payload, uint32_t bytes, uint32_t samples) {
+    if (samples == 0 || samples > w->block_samples ||
+        (w->block_count > 0 && w->total_samples % w->block_samples != 0)) {
+        fprintf(stderr, "Only the last block may be short (%u samples)\n", samples);
+        return -1;
+    }
+
+    if (w->block_count == w->index_capacity) {
+        uint32_t capacity = w->index_capacity ? w->index_capacity * 2 : 256;
+        uint64_t *index = realloc(w->index, capacity * sizeof(uint64_t));
+        if (!index) {
+            fprintf(stderr, "Failed to grow block index\n");
+            return -1;
+        }
+        w->index = index;
+        w->index_capacity = capacity;
+    }
+
+    uint8_t bh[IQ_CODEC_BLOCK_HEADER];
+    put_le32(bh, bytes);
+    put_le32(bh + 4, samples);
+    if (fwrite(bh, 1, sizeof(bh), w->file) != sizeof(bh) ||
+        fwrite(payload, 1, bytes, w->file) != bytes) {
+        fprintf(stderr, "Write error: %s\n", strerror(errno));
+        return -1;
+    }
+
+    w->index[w->block_count++] = w->bytes_written;
+    w->bytes_written += IQ_CODEC_BLOCK_HEADER + bytes;
+    w->total_samples += samples;
+    return 0;
+}
+
+static int flush_pending(iq_writer_t *w) {
+    if (w->pending_count == 0) return 0;
+    uint32_t bytes = iq_block_encode(w->pending, w->pending_count, w->payload);
+    int ret = iq_writer_add_block(w, w->payload, bytes, w->pending_count);
+    w->pending_count = 0;
+    return ret;
+}
+
+int iq_writer_write(iq_writer_t *w, const int16_t *iq, uint32_t samples) {
+    while (samples > 0) {
+        uint32_t n = w->block_samples - w->pending_count;
+        if (n > samples) n = samples;
+        memcpy(&w->pending[2 * w->pending_count], iq, (size_t)n * 2 * sizeof(int16_t));
+        w->pending_count += n;
+        iq += 2 * n;
+        samples -= n;
+
+        if (w->pending_count == w->block_samples && flush_pending(w) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int iq_writer_close(iq_writer_t *w) {
+    int ret = 0;
+    if (w->file) {
+        ret = flush_pending(w);
+
+        // Index, then the header with the totals
+        uint64_t index_offset = w->bytes_written;
+        uint8_t ih[8], entry[8];
+        put_le32(ih, w->block_count);
+        put_le32(ih + 4, 0);
+        if (ret == 0 && fwrite(ih, 1, sizeof(ih), w->file) != sizeof(ih)) ret = -1;
+        for (uint32_t i = 0; ret == 0 && i < w->block_count; i++) {
+            put_le64(entry, w->index[i]);
+            if (fwrite(entry, 1, sizeof(entry), w->file) != sizeof(entry)) ret = -1;
+        }
+
+        uint8_t h[IQ_CODEC_HEADER_SIZE];
+        encode_header(h, w->sample_rate, w->block_samples, w->total_samples, index_offset);
+        if (ret == 0 && (fseeko(w->file, 0, SEEK_SET) != 0 ||
+                         fwrite(h, 1, sizeof(h), w->file) != sizeof(h))) {
+            ret = -1;
+        }
+        if (fclose(w->file) != 0) ret = -1;
+        if (ret < 0) {
+            fprintf(stderr, "Failed to finish compressed recording: %s\n", strerror(errno));
+        }
+        w->file = NULL;
+    }
+    free(w->index);
+    free(w->pending);
+    free(w->payload);
+    w->index = NULL;
+    w->pending = NULL;
+    w->payload = NULL;
+    return ret;
+}
+
+// =============================================================================
+// READER
+// =============================================================================
+
+static int add_index(iq_reader_t *r, uint32_t *capacity, uint64_t offset) {
+    if (r->block_count == *capacity) {
+        *capacity = *capacity ? *capacity * 2 : 256;
+        uint64_t *index = realloc(r->index, *capacity * sizeof(uint64_t));
+        if (!index) return -1;
+        r->index = index;
+    }
+    r->index[r->block_count++] = offset;
+    return 0;
+}
+
+static int scan_blocks(iq_reader_t *r, const char *path) {
+    // Walk the block headers up to the last complete block
+    uint32_t capacity = 0;
+    uint64_t offset = IQ_CODEC_HEADER_SIZE;
+    uint8_t bh[IQ_CODEC_BLOCK_HEADER];
+
+    fseeko(r->file, 0, SEEK_END);
+    uint64_t file_size = (uint64_t)ftello(r->file);
+    fseeko(r->file, (off_t)offset, SEEK_SET);
+
+    while (fread(bh, 1, sizeof(bh), r->file) == sizeof(bh)) {
+        uint32_t bytes = get_le32(bh);
+        uint32_t samples = get_le32(bh + 4);
+        // A truncated last payload ends the scan
+        if (samples == 0 || samples > r->block_samples ||
+            bytes > IQ_CODEC_MAX_PAYLOAD(samples) ||
+            offset + IQ_CODEC_BLOCK_HEADER + bytes > file_size ||
+            fseeko(r->file, bytes, SEEK_CUR) != 0) {
+            break;
+        }
+
+        if (add_index(r, &capacity, offset) < 0) {
+            fprintf(stderr, "Failed to allocate block index\n");
+            return -1;
+        }
+        r->total_samples += samples;
+        offset += IQ_CODEC_BLOCK_HEADER + bytes;
+        if (samples < r->block_samples) break;
+    }
+    r->compressed_bytes = offset - IQ_CODEC_HEADER_SIZE;
+
+    printf("⚠ %s: no usable block index (unfinished or truncated), %u complete blocks found\n",
+           path, r->block_count);
+    return 0;
+}
+
+static int load_index(iq_reader_t *r, uint64_t index_offset) {
+    // Fails on a missing or inconsistent index (the caller scans instead)
+    uint8_t ih[8];
+    if (fseeko(r->file, (off_t)index_offset, SEEK_SET) != 0 ||
+        fread(ih, 1, sizeof(ih), r->file) != sizeof(ih)) {
+        return -1;
+    }
+    r->block_count = get_le32(ih);
+    if (r->block_count != (r->total_samples + r->block_samples - 1) / r->block_samples) {
+        return -1;
+    }
+
+    size_t count = r->block_count ? r->block_count : 1;
+    r->index = malloc(count * sizeof(uint64_t));
+    uint8_t *raw = malloc(count * 8);
+    int ret = (r->index && raw && fread(raw, 8, r->block_count, r->file) == r->block_count) ? 0 : -1;
+    for (uint32_t i = 0; ret == 0 && i < r->block_count; i++) {
+        r->index[i] = get_le64(raw + 8 * i);
+    }
+    free(raw);
+    r->compressed_bytes = index_offset - IQ_CODEC_HEADER_SIZE;
+    return ret;
+}
+
+int iq_reader_open(iq_reader_t *r, const char *path) {
+    memset(r, 0, sizeof(iq_reader_t));
+
+    r->file = fopen(path, "rb");
+    if (!r->file) {
+        fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    uint8_t h[IQ_CODEC_HEADER_SIZE];
+    if (fread(h, 1, sizeof(h), r->file) != sizeof(h) || memcmp(h, IQ_CODEC_MAGIC, 4) != 0) {
+        fprintf(stderr, "%s: not a compressed I/Q recording\n", path);
+        iq_reader_close(r);
+        return -1;
+    }
+    if ((h[4] | (h[5] << 8)) != IQ_CODEC_VERSION) {
+        fprintf(stderr, "%s: unsupported version %u\n", path, h[4] | (h[5] << 8));
+        iq_reader_close(r);
+        return -1;
+    }
+    r->sample_rate = get_le32(h + 8);
+    r->block_samples = get_le32(h + 12);
+    r->total_samples = get_le64(h + 16);
+    uint64_t index_offset = get_le64(h + 24);
+
+    if (r->block_samples == 0 || r->block_samples > IQ_CODEC_MAX_BLOCK) {
+        fprintf(stderr, "%s: invalid block size %u\n", path, r->block_samples);
+        iq_reader_close(r);
+        return -1;
+    }
+
+    int ret = 0;
+    if (!index_offset || load_index(r, index_offset) < 0) {
+        free(r->index);
+        r->index = NULL;
+        r->block_count = 0;
+        r->total_samples = 0;
+        ret = scan_blocks(r, path);
+    }
+
+    r->block = malloc((size_t)r->block_samples * 2 * sizeof(int16_t));
+    r->payload = malloc(IQ_CODEC_MAX_PAYLOAD(r->block_samples));
+    if (ret == 0 && (!r->block || !r->payload)) {
+        fprintf(stderr, "Failed to allocate decompression buffers\n");
+        ret = -1;
+    }
+    if (ret < 0) {
+        iq_reader_close(r);
+        return -1;
+    }
+    return 0;
+}
+
+int iq_reader_get_block(iq_reader_t *r, uint32_t block, uint8_t *payload,
+                        uint32_t *bytes, uint32_t *samples) {
+    uint8_t bh[IQ_CODEC_BLOCK_HEADER];
+    if (block >= r->block_count ||
+        fseeko(r->file, (off_t)r->index[block], SEEK_SET) != 0 ||
+        fread(bh, 1, sizeof(bh), r->file) != sizeof(bh)) {
+        fprintf(stderr, "Cannot read block %u\n", block);
+        return -1;
+    }
+    *bytes = get_le32(bh);
+    *samples = get_le32(bh + 4);
+    if (*samples == 0 || *samples > r->block_samples ||
+        *bytes > IQ_CODEC_MAX_PAYLOAD(*samples) ||
+        fread(payload, 1, *bytes, r->file) != *bytes) {
+        fprintf(stderr, "Corrupt block %u\n", block);
+        return -1;
+    }
+    return 0;
+}
+
+static int decode_next(iq_reader_t *r) {
+    uint32_t bytes, samples;
+    if (iq_reader_get_block(r, r->next_block, r->payload, &bytes, &samples) < 0) {
+        return -1;
+    }
+    if (iq_block_decode(r->payload, bytes, samples, r->block) < 0) {
+        fprintf(stderr, "Corrupt block %u\n", r->next_block);
+        return -1;
+    }
+    r->next_block++;
+    r->block_fill = samples;
+    r->block_pos = 0;
+    return 0;
+}
+
+int iq_reader_seek(iq_reader_t *r, uint64_t sample) {
+    if (sample >= r->total_samples) {
+        return -1;
+    }
+    uint32_t block = (uint32_t)(sample / r->block_samples);
+    uint32_t offset = (uint32_t)(sample % r->block_samples);
+
+    if (r->next_block != block + 1 || r->block_fill == 0) {
+        r->next_block = block;
+        if (decode_next(r) < 0) return -1;
+    }
+    r->block_pos = offset;
+    return 0;
+}
+
+int iq_reader_read(iq_reader_t *r, int16_t *iq, uint32_t max_samples) {
+    uint32_t total = 0;
+    while (total < max_samples) {
+        if (r->block_pos == r->block_fill) {
+            if (r->next_block >= r->block_count) break;
+            if (decode_next(r) < 0) return -1;
+        }
+        uint32_t n = r->block_fill - r->block_pos;
+        if (n > max_samples - total) n = max_samples - total;
+        memcpy(&iq[2 * total], &r->block[2 * r->block_pos], (size_t)n * 2 * sizeof(int16_t));
+        r->block_pos += n;
+        total += n;
+    }
+    return (int)total;
+}
+
+void iq_reader_close(iq_reader_t *r) {
+    if (r->file) {
+        fclose(r->file);
+        r->file = NULL;
+    }
+    free(r->index);
+    free(r->block);
+    free(r->payload);
+    r->index = NULL;
+    r->block = NULL;
+    r->payload = NULL;
+}
@@ -20,27 +20,44 @@
 #include <unistd.h>
 #include <signal.h>
 #include <time.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
 #include "t018_protocol.h"
 #include "oqpsk_modulator.h"
 #include "pluto_control.h"
+#include "sdr_session.h"
 #include "prn_generator.h"
+#include "resampler.h"
+#include "tx_fanout.h"
+#include "event_loop.h"
+#include "control_socket.h"
+#include "gps_input.h"
+#include "perf_profile.h"
+#include "trace.h"
+#include "burst_record.h"
+#include "startup.h"
+#include "render_lead.h"
+#include "task_pool.h"
+#include "tx_tune.h"
+#include "mem_account.h"
+#include "tx_journal.h"
 
 // =============================================================================
 // GLOBAL VARIABLES
 // =============================================================================
 
-static volatile uint8_t running = 1;
-static pluto_ctx_t pluto_ctx;
+static sdr_session_t radio;             // Single-device session (auto-reconnect)
+static tx_fanout_t fanout;
+static tx_journal_t journal;            // Transmission journal (--journal)
+static perf_profile_t profiler;
+static perf_profile_t *prof = NULL;     // Set when --profile is active
+static double process_start;            // CLOCK_MONOTONIC seconds at entry
+static double first_rf_sec = -1.0;      // Time to first RF sample (-1 = none yet)
 
-// =============================================================================
-// SIGNAL HANDLER
-// =============================================================================
-
-void signal_handler(int signum) {
-    (void)signum;
-    printf("\n\nShutdown signal received...\n");
-    running = 0;
-}
+// Pipeline stage markers (hardware counters + trace timeline)
+#define STAGE_BEGIN(name)   do { perf_profile_begin(prof, name); TRACE_BEGIN(name); } while (0)
+#define STAGE_END(name)     do { TRACE_END(name); perf_profile_end(prof); } while (0)
 
 // =============================================================================
 // CONFIGURATION
@@ -63,13 +80,44 @@ typedef struct {
     uint64_t frequency;
     int32_t tx_gain_db;
     uint32_t tx_interval_sec;
+    uint32_t output_rate;           // Output sample rate (resampled if != OQPSK_SAMPLE_RATE)
 
     // PlutoSDR
     char pluto_uri[128];
 
+    // Multi-radio fan-out ("<uri>[@serial,...]" per device)
+    char device_specs[FANOUT_MAX_DEVICES][160];
+    uint32_t num_devices;
+    uint32_t max_transmissions;     // 0 = unlimited
+
     // File output (optional)
     char output_file[256];
     uint8_t file_mode;
+
+    // Event loop inputs (optional)
+    char control_path[108];         // UNIX control socket
+    char gps_path[256];             // NMEA source (serial device, FIFO, file)
+    char trace_path[256];           // Chrome trace JSON (make trace)
+
+    uint8_t profile;                // Per-stage hardware counter table
+
+    // Fault injection (reconnect testing)
+    uint32_t fault_every;           // Drop the radio link after n bursts (0 = off)
+    uint32_t fault_attempts;        // Reconnect attempts that fail after each drop
+
+    uint8_t serial_init;            // Startup steps one after another (comparison)
+
+    // Render task pool
+    uint32_t render_threads;        // 0 = online CPUs
+    uint8_t pin_cpus;               // Pin pool workers to CPUs
+
+    // TX push calibration
+    uint8_t tune_tx;                // Calibrate at startup instead of using the cache
+    char tx_cache[256];             // Calibration cache ("" = ~/.cache/sarsat_sgb/tx_tune)
+
+    uint64_t mem_budget;            // Accounted memory limit in bytes (0 = unlimited)
+
+    char journal_path[256];         // Transmission journal ("" = none)
 } app_config_t;
 
 // Default configuration (France, EPIRB training)
@@ -87,10 +135,26 @@ static app_config_t default_config = {
     .frequency = 403000000ULL,      // 403 MHz (training)
     .tx_gain_db = 0,                // Maximum power for testing (0 dB attenuation)
     .tx_interval_sec = 10,          // 10 seconds for test mode
+    .output_rate = OQPSK_SAMPLE_RATE,
 
     .pluto_uri = "ip:192.168.2.1",
+    .num_devices = 0,
+    .max_transmissions = 0,
     .output_file = "",
-    .file_mode = 0
+    .file_mode = 0,
+    .control_path = "",
+    .gps_path = "",
+    .trace_path = "",
+    .profile = 0,
+    .fault_every = 0,
+    .fault_attempts = 0,
+    .serial_init = 0,
+    .render_threads = 0,
+    .pin_cpus = 0,
+    .tune_tx = 0,
+    .tx_cache = "",
+    .mem_budget = 0,
+    .journal_path = ""
 };
 
 // =============================================================================
@@ -111,8 +175,26 @@ void print_usage(const char *progname) {
     printf("  -lat <lat>    Latitude in degrees (default: 43.2)\n");
     printf("  -lon <lon>    Longitude in degrees (default: 5.4)\n");
     printf("  -alt <alt>    Altitude in meters (default: 0)\n");
-    printf("  -u <uri>      PlutoSDR URI (default: ip:192.168.2.1)\n");
-    printf("  -o <file>     Save I/Q to file instead of transmitting\n");
+    printf("  -u <uri>      PlutoSDR URI (default: ip:192.168.2.1, null: = no hardware,\n");
+    printf("                tcp:/udp:host[:port] = network I/Q stream,\n");
+    printf("                shm:[name] = /dev/shm ring for local decoders)\n");
+    printf("  -d <uri>[@s1,s2...]  Add fan-out device with its beacon serials (repeatable)\n");
+    printf("  -n <count>    Stop after <count> transmissions (default: unlimited)\n");
+    printf("  -o <file>     Save I/Q to file instead of transmitting (.sgbr: append a\n");
+    printf("                parametric burst record instead of samples)\n");
+    printf("  -r <rate>     Output sample rate in Hz (default: 2457600, resampled otherwise)\n");
+    printf("  -S <path>     Control socket (commands: status, tx, interval, pos, tune, stop)\n");
+    printf("  -G <path>     NMEA GPS source (serial device, FIFO or file)\n");
+    printf("  --profile     Print per-stage hardware counters (cycles, IPC, cache/branch misses)\n");
+    printf("  --trace <file> Write Chrome/Perfetto trace JSON (requires: make trace)\n");
+    printf("  --serial-init Run startup steps one after another (time to first RF sample)\n");
+    printf("  --fault <n>[:<m>] Drop the radio link every n bursts, fail m reconnects (testing)\n");
+    printf("  -j <threads>  Render threads (default: online CPUs, 1 = single-threaded)\n");
+    printf("  --pin         Pin render threads to CPUs\n");
+    printf("  --tune-tx     Calibrate TX chunk size and kernel buffers, cache them per URI\n");
+    printf("  --tx-cache <file> TX calibration cache (default: ~/.cache/sarsat_sgb/tx_tune)\n");
+    printf("  --mem-budget <MiB> Refuse configurations (rate, beacons) needing more memory\n");
+    printf("  --journal <file> Append a binary record per burst (tools/tx_journal_query)\n");
     printf("  -h            Show this help\n\n");
     printf("Beacon Types:\n");
     printf("  0 = EPIRB (Emergency Position Indicating Radio Beacon)\n");
@@ -150,9 +232,63 @@ int parse_args(int argc, char *argv[], app_config_t *config) {
             config->altitude = atoi(argv[++i]);
         } else if (strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
             strncpy(config->pluto_uri, argv[++i], sizeof(config->pluto_uri) - 1);
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            if (config->num_devices >= FANOUT_MAX_DEVICES) {
+                fprintf(stderr, "Too many devices (max %d)\n", FANOUT_MAX_DEVICES);
+                return -1;
+            }
+            strncpy(config->device_specs[config->num_devices++], argv[++i],
+                    sizeof(config->device_specs[0]) - 1);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            config->max_transmissions = atoi(argv[++i]);
         } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
             strncpy(config->output_file, argv[++i], sizeof(config->output_file) - 1);
             config->file_mode = 1;
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            config->output_rate = strtoul(argv[++i], NULL, 10);
+            if (config->output_rate == 0) {
+                fprintf(stderr, "Invalid output sample rate: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "-S") == 0 && i + 1 < argc) {
+            strncpy(config->control_path, argv[++i], sizeof(config->control_path) - 1);
+        } else if (strcmp(argv[i], "-G") == 0 && i + 1 < argc) {
+            strncpy(config->gps_path, argv[++i], sizeof(config->gps_path) - 1);
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            strncpy(config->trace_path, argv[++i], sizeof(config->trace_path) - 1);
+        } else if (strcmp(argv[i], "--fault") == 0 && i + 1 < argc) {
+            char *end;
+            config->fault_every = strtoul(argv[++i], &end, 10);
+            config->fault_attempts = (*end == ':') ? strtoul(end + 1, NULL, 10) : 0;
+            if (config->fault_every == 0) {
+                fprintf(stderr, "Invalid fault specification: %s\n", argv[i]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--serial-init") == 0) {
+            config->serial_init = 1;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            config->profile = 1;
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            config->render_threads = atoi(argv[++i]);
+            if (config->render_threads < 1 || config->render_threads > TASK_POOL_MAX_THREADS) {
+                fprintf(stderr, "Render threads must be 1-%d\n", TASK_POOL_MAX_THREADS);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--pin") == 0) {
+            config->pin_cpus = 1;
+        } else if (strcmp(argv[i], "--tune-tx") == 0) {
+            config->tune_tx = 1;
+        } else if (strcmp(argv[i], "--tx-cache") == 0 && i + 1 < argc) {
+            strncpy(config->tx_cache, argv[++i], sizeof(config->tx_cache) - 1);
+        } else if (strcmp(argv[i], "--mem-budget") == 0 && i + 1 < argc) {
+            double mib = atof(argv[++i]);
+            if (mib <= 0.0) {
+                fprintf(stderr, "Invalid memory budget: %s\n", argv[i]);
+                return -1;
+            }
+            config->mem_budget = (uint64_t)(mib * MEM_MIB);
+        } else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            strncpy(config->journal_path, argv[++i], sizeof(config->journal_path) - 1);
         } else if (strcmp(argv[i], "-h") == 0) {
             print_usage(argv[0]);
             return -1;
@@ -184,22 +320,91 @@ void print_config(const app_config_t *config) {
            (unsigned long long)config->frequency, config->frequency / 1e6);
     printf("  TX Gain:    %d dB\n", config->tx_gain_db);
     printf("  Interval:   %u seconds\n", config->tx_interval_sec);
+    printf("  Sample rate: %u Hz%s\n", config->output_rate,
+           config->output_rate != OQPSK_SAMPLE_RATE ? " (resampled)" : "");
+    if (config->profile) {
+        printf("  Render:     1 thread (--profile)\n");
+    } else if (config->render_threads) {
+        printf("  Render:     %u thread(s)%s\n", config->render_threads,
+               config->pin_cpus ? ", pinned" : "");
+    } else {
+        printf("  Render:     all CPUs%s\n", config->pin_cpus ? ", pinned" : "");
+    }
 
     if (config->file_mode) {
         printf("  Mode:       FILE OUTPUT\n");
         printf("  Output:     %s\n", config->output_file);
+    } else if (config->num_devices > 0) {
+        printf("  Mode:       FAN-OUT TX (%u devices)\n", config->num_devices);
+        for (uint32_t d = 0; d < config->num_devices; d++) {
+            printf("  Device %u:   %s\n", d, config->device_specs[d]);
+        }
     } else {
         printf("  Mode:       PLUTO TX\n");
         printf("  PlutoSDR:   %s\n", config->pluto_uri);
     }
+    if (config->control_path[0]) {
+        printf("  Control:    %s\n", config->control_path);
+    }
+    if (config->gps_path[0]) {
+        printf("  GPS:        %s\n", config->gps_path);
+    }
+    if (config->journal_path[0] && !config->file_mode) {
+        printf("  Journal:    %s\n", config->journal_path);
+    }
     printf("=======================================\n\n");
 }
 
+// =============================================================================
+// RESAMPLING STAGE
+// =============================================================================
+
+/**
+ * @brief Resample a burst from OQPSK_SAMPLE_RATE to the requested output rate
+ * @param iq_samples Modulator output
+ * @param num_samples Number of input samples, updated with output count
+ * @param out_rate Output sample rate in Hz
+ * @return Newly allocated output buffer, or NULL on error
+ */
+static float complex *resample_burst(const float complex *iq_samples,
+                                     uint32_t *num_samples,
+                                     uint32_t out_rate) {
+    resampler_state_t rs;
+    if (resampler_init(&rs, OQPSK_SAMPLE_RATE, out_rate) < 0) {
+        return NULL;
+    }
+
+    uint32_t max_out = resampler_max_output(&rs, *num_samples + resampler_delay(&rs) + 3 * rs.decim);
+    float complex *output = mem_alloc(MEM_BURST, max_out * sizeof(float complex));
+    if (!output) {
+        fprintf(stderr, "Failed to allocate resampled I/Q buffer\n");
+        resampler_free(&rs);
+        return NULL;
+    }
+
+    uint32_t count = resampler_process(&rs, iq_samples, *num_samples, output);
+    count += resampler_flush(&rs, &output[count]);
+    resampler_free(&rs);
+
+    printf("Resampled %u → %u samples (%u Hz → %u Hz)\n",
+           *num_samples, count, OQPSK_SAMPLE_RATE, out_rate);
+    *num_samples = count;
+    return output;
+}
+
 // =============================================================================
 // TRANSMISSION FUNCTION
 // =============================================================================
 
-int transmit_beacon(const app_config_t *config) {
+/**
+ * @brief Build the 252-bit frame of one beacon
+ * @param config Application configuration
+ * @param serial_number Beacon serial (beacon set member)
+ * @param frame_bits Output frame (T018_FRAME_BITS)
+ */
+static void build_beacon_frame(const app_config_t *config,
+                               uint32_t serial_number,
+                               uint8_t *frame_bits) {
     printf("\n--- Building T.018 Frame ---\n");
 
     // Build beacon configuration
@@ -207,7 +412,7 @@ int transmit_beacon(const app_config_t *config) {
         .type = config->beacon_type,
         .country_code = config->country_code,
         .tac_number = config->tac_number,
-        .serial_number = config->serial_number,
+        .serial_number = serial_number,
         .test_mode = config->test_mode,
         .position = {
             .latitude = config->latitude,
@@ -218,47 +423,433 @@ int transmit_beacon(const app_config_t *config) {
     };
 
     // Build 252-bit frame
-    uint8_t frame_bits[T018_FRAME_BITS];
+    STAGE_BEGIN("frame build");
     t018_build_frame(&beacon_cfg, frame_bits);
+    STAGE_END("frame build");
 
     // Print frame info
     t018_print_frame(frame_bits);
+}
 
+/**
+ * @brief Modulate, verify and resample one frame
+ * @param config Application configuration
+ * @param frame_bits Frame built by build_beacon_frame()
+ * @param num_samples Output: number of samples in the burst
+ * @return Newly allocated I/Q burst at config->output_rate, or NULL on error
+ *
+ * Thread-safe: several frames may be rendered concurrently.
+ */
+static float complex *render_frame(const app_config_t *config,
+                                   const uint8_t *frame_bits,
+                                   uint32_t *num_samples) {
     // Modulate frame
     printf("\n--- OQPSK Modulation ---\n");
-    float complex *iq_samples = malloc(OQPSK_TOTAL_SAMPLES * sizeof(float complex));
+    float complex *iq_samples = mem_alloc(MEM_BURST, OQPSK_TOTAL_SAMPLES * sizeof(float complex));
     if (!iq_samples) {
         fprintf(stderr, "Failed to allocate I/Q buffer\n");
-        return -1;
+        return NULL;
     }
 
-    uint32_t num_samples = oqpsk_modulate_frame(frame_bits, iq_samples);
-    printf("Generated %u I/Q samples\n", num_samples);
+    STAGE_BEGIN("modulation");
+    *num_samples = oqpsk_modulate_frame(frame_bits, iq_samples);
+    STAGE_END("modulation");
+    printf("Generated %u I/Q samples\n", *num_samples);
 
     // Verify modulation
-    if (!oqpsk_verify_output(iq_samples, num_samples)) {
+    STAGE_BEGIN("verification");
+    int verified = oqpsk_verify_output(iq_samples, *num_samples);
+    STAGE_END("verification");
+    if (!verified) {
         fprintf(stderr, "OQPSK verification failed\n");
-        free(iq_samples);
+        mem_free(iq_samples);
+        return NULL;
+    }
+
+    // Final stage: arbitrary output rate
+    if (config->output_rate != OQPSK_SAMPLE_RATE) {
+        printf("\n--- Resampling ---\n");
+        STAGE_BEGIN("resampling");
+        float complex *resampled = resample_burst(iq_samples, num_samples, config->output_rate);
+        STAGE_END("resampling");
+        mem_free(iq_samples);
+        iq_samples = resampled;
+    }
+
+    return iq_samples;
+}
+
+/**
+ * @brief Build, modulate and resample one beacon burst
+ * @param config Application configuration
+ * @param serial_number Beacon serial (beacon set member)
+ * @param frame Output: packed frame bits (TX_JOURNAL_FRAME_BYTES)
+ * @param num_samples Output: number of samples in the burst
+ * @return Newly allocated I/Q burst at config->output_rate, or NULL on error
+ */
+static float complex *render_beacon(const app_config_t *config,
+                                    uint32_t serial_number,
+                                    uint8_t *frame,
+                                    uint32_t *num_samples) {
+    uint8_t frame_bits[T018_FRAME_BITS];
+    build_beacon_frame(config, serial_number, frame_bits);
+    tx_journal_pack_frame(frame_bits, frame);
+    return render_frame(config, frame_bits, num_samples);
+}
+
+// One burst of a parallel render
+typedef struct {
+    const app_config_t *config;
+    uint8_t frame_bits[T018_FRAME_BITS];
+    float complex *iq_samples;
+    uint32_t num_samples;
+} render_task_t;
+
+static void render_task(void *arg) {
+    render_task_t *task = (render_task_t *)arg;
+    task->iq_samples = render_frame(task->config, task->frame_bits, &task->num_samples);
+}
+
+/**
+ * @brief Render several beacons, one task per burst on the shared pool
+ * @param config Application configuration
+ * @param serials Beacon serials
+ * @param count Number of beacons
+ * @param bursts Output: one burst per serial (freed by the caller)
+ * @return 0 on success, -1 if any render failed
+ *
+ * Frames are built first, one after another (the frame builder is not
+ * reentrant); modulation, verification and resampling then run in
+ * parallel. Under --profile everything stays on the calling thread, whose
+ * counters are the ones being read (the default pool is started with one
+ * thread, so shaping and verification run inline too).
+ */
+static int render_beacons(const app_config_t *config,
+                          const uint32_t *serials,
+                          uint32_t count,
+                          fanout_burst_t *bursts) {
+    render_task_t tasks[FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS];
+
+    for (uint32_t k = 0; k < count; k++) {
+        tasks[k].config = config;
+        tasks[k].iq_samples = NULL;
+        tasks[k].num_samples = 0;
+        build_beacon_frame(config, serials[k], tasks[k].frame_bits);
+    }
+
+    task_pool_t *pool = prof ? NULL : task_pool_default();
+    if (pool && count > 1) {
+        task_group_t group;
+        task_group_init(&group);
+        for (uint32_t k = 0; k < count; k++) {
+            task_pool_spawn(pool, &group, render_task, &tasks[k]);
+        }
+        task_pool_wait(pool, &group);
+    } else {
+        for (uint32_t k = 0; k < count; k++) {
+            render_task(&tasks[k]);
+        }
+    }
+
+    int result = 0;
+    for (uint32_t k = 0; k < count; k++) {
+        bursts[k].serial_number = serials[k];
+        bursts[k].iq_samples = tasks[k].iq_samples;
+        bursts[k].num_samples = tasks[k].num_samples;
+        tx_journal_pack_frame(tasks[k].frame_bits, bursts[k].frame);
+        if (!tasks[k].iq_samples) result = -1;
+    }
+    return result;
+}
+
+/**
+ * @brief Append the beacon to a parametric burst recording (.sgbr)
+ * @param config Application configuration
+ * @return 0 on success, -1 on error
+ *
+ * No samples are rendered: readers synthesize the burst at any rate. Each
+ * burst is placed tx_interval_sec after the last one already recorded.
+ */
+static int record_beacon(const app_config_t *config) {
+    uint8_t frame_bits[T018_FRAME_BITS];
+    build_beacon_frame(config, config->serial_number, frame_bits);
+
+    burst_record_t rec = { .amplitude = 1.0f };
+    burst_record_set_frame(&rec, frame_bits);
+
+    burst_recording_t existing;
+    if (access(config->output_file, F_OK) == 0) {
+        if (burst_recording_load(&existing, config->output_file) < 0) {
+            return -1;
+        }
+        if (existing.count) {
+            rec.time = existing.records[existing.count - 1].time + config->tx_interval_sec;
+        }
+        burst_recording_free(&existing);
+    }
+
+    printf("\n--- Recording Burst ---\n");
+    STAGE_BEGIN("file save");
+    int result = burst_recording_append(config->output_file, &rec);
+    STAGE_END("file save");
+    if (result < 0) {
         return -1;
     }
 
+    printf("✓ Burst recorded to '%s' at t = %.3f s (%d bytes, synthesized on read)\n",
+           config->output_file, rec.time, BURST_RECORD_SIZE);
+    return 0;
+}
+
+// =============================================================================
+// FIRST BURST (rendered during startup)
+// =============================================================================
+
+// Bursts rendered while the radio connects, consumed by the first transmission
+static fanout_burst_t prerendered[FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS];
+static uint32_t num_prerendered;
+static app_config_t prerender_config;   // Configuration they were rendered with
+
+/**
+ * @brief List the distinct beacons rendered per cycle
+ * @param config Application configuration
+ * @param serials Output: serial numbers (FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS)
+ * @return Number of beacons
+ */
+static uint32_t collect_serials(const app_config_t *config, uint32_t *serials) {
+    uint32_t count = 0;
+
+    if (config->num_devices > 0 && !config->file_mode) {
+        for (uint32_t d = 0; d < fanout.num_devices; d++) {
+            for (uint32_t b = 0; b < fanout.devices[d].num_beacons; b++) {
+                uint32_t serial = fanout.devices[d].serials[b];
+                uint8_t seen = 0;
+                for (uint32_t k = 0; k < count; k++) {
+                    if (serials[k] == serial) seen = 1;
+                }
+                if (!seen) serials[count++] = serial;
+            }
+        }
+    } else {
+        serials[count++] = config->serial_number;
+    }
+    return count;
+}
+
+/**
+ * @brief Render the first burst of every beacon transmitted at startup
+ * @param config Application configuration
+ * @return 0 on success, -1 on error
+ */
+static int prerender_bursts(const app_config_t *config) {
+    uint32_t serials[FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS];
+    uint32_t count = collect_serials(config, serials);
+
+    prerender_config = *config;
+    int result = render_beacons(config, serials, count, prerendered);
+    num_prerendered = count;
+    return result;
+}
+
+static void free_prerendered(void) {
+    for (uint32_t k = 0; k < num_prerendered; k++) {
+        mem_free((void *)prerendered[k].iq_samples);
+        prerendered[k].iq_samples = NULL;
+    }
+    num_prerendered = 0;
+}
+
+/**
+ * @brief Take the startup render of a beacon
+ * @param config Application configuration (job snapshot)
+ * @param serial_number Beacon serial
+ * @param frame Output: packed frame bits (TX_JOURNAL_FRAME_BYTES)
+ * @param num_samples Output: number of samples in the burst
+ * @return Burst (now owned by the caller), or NULL if none is usable
+ *
+ * The startup render is only used if the position has not changed since.
+ */
+static float complex *take_prerendered(const app_config_t *config,
+                                       uint32_t serial_number,
+                                       uint8_t *frame,
+                                       uint32_t *num_samples) {
+    uint8_t same = config->latitude == prerender_config.latitude &&
+                   config->longitude == prerender_config.longitude &&
+                   config->altitude == prerender_config.altitude;
+
+    for (uint32_t k = 0; k < num_prerendered; k++) {
+        fanout_burst_t *burst = &prerendered[k];
+        if (!burst->iq_samples || burst->serial_number != serial_number || !same) continue;
+
+        float complex *iq = (float complex *)burst->iq_samples;
+        *num_samples = burst->num_samples;
+        memcpy(frame, burst->frame, TX_JOURNAL_FRAME_BYTES);
+        burst->iq_samples = NULL;
+        printf("✓ Using burst rendered during startup (serial %u)\n", serial_number);
+        return iq;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Take the startup render of a beacon, or render it now
+ * @param config Application configuration (job snapshot)
+ * @param serial_number Beacon serial
+ * @param frame Output: packed frame bits (TX_JOURNAL_FRAME_BYTES)
+ * @param num_samples Output: number of samples in the burst
+ * @param reused Output: set to 1 if the startup render was used
+ * @return Newly allocated I/Q burst, or NULL on error
+ */
+static float complex *take_burst(const app_config_t *config,
+                                 uint32_t serial_number,
+                                 uint8_t *frame,
+                                 uint32_t *num_samples,
+                                 uint8_t *reused) {
+    float complex *iq = take_prerendered(config, serial_number, frame, num_samples);
+    if (iq) {
+        *reused = 1;
+        return iq;
+    }
+    return render_beacon(config, serial_number, frame, num_samples);
+}
+
+static void mark_first_rf(void) {
+    if (first_rf_sec < 0.0) {
+        first_rf_sec = startup_now() - process_start;
+        printf("✓ Time to first RF sample: %.3f s after start\n", first_rf_sec);
+    }
+}
+
+// =============================================================================
+// BURST JOB
+// =============================================================================
+
+// One burst cycle, rendered on the worker ahead of its deadline
+typedef struct {
+    app_config_t config;            // Snapshot rendered by the worker
+    struct timespec deadline;       // First RF sample due (CLOCK_MONOTONIC)
+    double render_sec;              // Measured render time
+    double lateness_sec;            // Push start - deadline (> 0 = late)
+    struct timespec push_mono;      // Push start (CLOCK_MONOTONIC)
+    struct timespec push_utc;       // Push start (CLOCK_REALTIME)
+    uint32_t cycle;                 // Transmission number
+    uint8_t reused;                 // Startup render used (render time not measured)
+} tx_job_t;
+
+static double timespec_sec(const struct timespec *ts) {
+    return ts->tv_sec + ts->tv_nsec / 1e9;
+}
+
+/**
+ * @brief Hold a rendered burst until its deadline
+ * @param job Burst job (render_sec, lateness_sec, push times are set)
+ * @param render_start CLOCK_MONOTONIC seconds when rendering started
+ */
+static void wait_for_deadline(tx_job_t *job, double render_start) {
+    job->render_sec = startup_now() - render_start;
+
+    TRACE_BEGIN("deadline wait");
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &job->deadline, NULL) == EINTR) {
+    }
+    TRACE_END("deadline wait");
+
+    clock_gettime(CLOCK_MONOTONIC, &job->push_mono);
+    clock_gettime(CLOCK_REALTIME, &job->push_utc);
+    job->lateness_sec = timespec_sec(&job->push_mono) - timespec_sec(&job->deadline);
+}
+
+static int64_t timespec_ns(const struct timespec *ts) {
+    return (int64_t)ts->tv_sec * 1000000000LL + ts->tv_nsec;
+}
+
+/**
+ * @brief Record one burst in the transmission journal
+ * @param job Burst job (push done)
+ * @param burst Burst pushed (samples hashed here, after the push)
+ * @param flags TX_JOURNAL_* outcome
+ * @param devices Radios the burst was pushed to
+ */
+static void journal_burst(const tx_job_t *job, const fanout_burst_t *burst,
+                          uint16_t flags, uint16_t devices) {
+    if (!journal.map) return;
+
+    const app_config_t *config = &job->config;
+    tx_journal_record_t rec = {
+        .utc_ns = timespec_ns(&job->push_utc),
+        .mono_ns = timespec_ns(&job->push_mono),
+        .deadline_ns = timespec_ns(&job->deadline),
+        .frequency = config->frequency,
+        .waveform_hash = tx_journal_hash(burst->iq_samples, (size_t)burst->num_samples * sizeof(float complex)),
+        .slack_us = (int32_t)(-job->lateness_sec * 1e6),
+        .render_us = (uint32_t)(job->render_sec * 1e6),
+        .gain_db = config->tx_gain_db,
+        .serial_number = burst->serial_number,
+        .output_rate = config->output_rate,
+        .num_samples = burst->num_samples,
+        .cycle = job->cycle,
+        .flags = flags | (job->reused ? TX_JOURNAL_REUSED : 0),
+        .devices = devices
+    };
+    memcpy(rec.frame, burst->frame, sizeof(rec.frame));
+
+    if (tx_journal_append(&journal, &rec) < 0) {
+        fprintf(stderr, "⚠ Burst not journaled\n");
+    }
+}
+
+int transmit_beacon(tx_job_t *job) {
+    const app_config_t *config = &job->config;
+    if (config->file_mode && burst_recording_is_path(config->output_file)) {
+        return record_beacon(config);
+    }
+
+    double render_start = startup_now();
+    uint32_t num_samples = 0;
+    fanout_burst_t burst = { .serial_number = config->serial_number };
+    float complex *iq_samples = config->file_mode ?
+                                render_beacon(config, config->serial_number, burst.frame, &num_samples) :
+                                take_burst(config, config->serial_number, burst.frame, &num_samples,
+                                           &job->reused);
+    if (!iq_samples) {
+        return -1;
+    }
+    wait_for_deadline(job, render_start);
+
     // Transmit or save to file
     int result = 0;
 
     if (config->file_mode) {
         // Save to file
         printf("\n--- Saving to File ---\n");
-        result = pluto_save_iq_file(config->output_file, iq_samples, num_samples, OQPSK_SAMPLE_RATE);
+        STAGE_BEGIN("file save");
+        result = pluto_save_iq_file(config->output_file, iq_samples, num_samples, config->output_rate);
+        STAGE_END("file save");
     } else {
         // Transmit via PlutoSDR
         printf("\n--- Transmitting via PlutoSDR ---\n");
-        result = pluto_transmit_iq(&pluto_ctx, iq_samples, num_samples);
+        mark_first_rf();
+        STAGE_BEGIN("transmit");
+        result = sdr_session_transmit(&radio, iq_samples, num_samples);
+        STAGE_END("transmit");
+
+        // RF is out: journaling (hash, record) adds nothing to the push
+        burst.iq_samples = iq_samples;
+        burst.num_samples = num_samples;
+        journal_burst(job, &burst, result > 0 ? TX_JOURNAL_SENT :
+                                   result == 0 ? TX_JOURNAL_OFFLINE : TX_JOURNAL_FAILED, 1);
     }
 
-    free(iq_samples);
+    mem_free(iq_samples);
+
+    // Radio offline or push failed: the schedule goes on, the reconnect
+    // thread restores the link
+    if (!config->file_mode && result <= 0) {
+        printf("⚠ %s, burst missed\n", result == 0 ? "Radio offline" : "Push failed");
+        return 0;
+    }
 
     if (result < 0) {
-        fprintf(stderr, "%s failed\n", config->file_mode ? "File save" : "Transmission");
+        fprintf(stderr, "File save failed\n");
         return -1;
     }
 
@@ -266,65 +857,989 @@ int transmit_beacon(const app_config_t *config) {
     return 0;
 }
 
+/**
+ * @brief Render every distinct beacon once and push all device sets
+ * @param job Burst job
+ * @return 0 on success, -1 if any device failed
+ */
+int transmit_fanout(tx_job_t *job) {
+    const app_config_t *config = &job->config;
+    fanout_burst_t bursts[FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS] = {{0}};
+    uint32_t num_bursts = 0;
+    int result = 0;
+    double render_start = startup_now();
+
+    // One render per distinct serial, shared read-only by all devices
+    uint32_t serials[FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS];
+    uint32_t missing[FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS];
+    uint32_t num_serials = collect_serials(config, serials);
+    uint32_t num_missing = 0;
+
+    for (uint32_t k = 0; k < num_serials; k++) {
+        uint32_t count = 0;
+        float complex *iq = take_prerendered(config, serials[k], bursts[num_bursts].frame, &count);
+        if (!iq) {
+            missing[num_missing++] = serials[k];
+            continue;
+        }
+        job->reused = 1;
+        bursts[num_bursts].serial_number = serials[k];
+        bursts[num_bursts].iq_samples = iq;
+        bursts[num_bursts].num_samples = count;
+        num_bursts++;
+    }
+    if (num_missing > 0) {
+        result = render_beacons(config, missing, num_missing, &bursts[num_bursts]);
+        num_bursts += num_missing;
+    }
+
+    if (result == 0) {
+        wait_for_deadline(job, render_start);
+        printf("\n--- Transmitting %u burst(s) on %u device(s) ---\n",
+               num_bursts, fanout.num_devices);
+        mark_first_rf();
+        STAGE_BEGIN("fan-out push");
+        int failures = fanout_transmit(&fanout, bursts, num_bursts);
+        STAGE_END("fan-out push");
+        if (failures != 0) {
+            fprintf(stderr, "⚠ Fan-out: %d device(s) failed, reconnecting\n", failures);
+        }
+        fanout_print_metrics(&fanout);
+
+        // Per burst: what each device carrying it did (sent, offline, failed)
+        for (uint32_t k = 0; k < num_bursts; k++) {
+            uint16_t devices = 0;
+            uint16_t outcome = fanout_burst_outcome(&fanout, bursts[k].serial_number, &devices);
+            journal_burst(job, &bursts[k], TX_JOURNAL_FANOUT | outcome, devices);
+        }
+    }
+
+    for (uint32_t k = 0; k < num_bursts; k++) {
+        mem_free((void *)bursts[k].iq_samples);
+    }
+
+    if (result == 0) {
+        printf("✓ Fan-out transmission complete\n");
+    }
+    return result;
+}
+
+
 // =============================================================================
-// MAIN APPLICATION
+// TX CALIBRATION
 // =============================================================================
 
-int main(int argc, char *argv[]) {
-    app_config_t config;
+/**
+ * @brief Resolve the TX calibration cache file
+ * @param config Application configuration (--tx-cache)
+ * @param path Output buffer
+ * @param size Buffer size
+ * @return 1 if a path is available, 0 otherwise (path left empty)
+ */
+static int tx_cache_file(const app_config_t *config, char *path, size_t size) {
+    if (config->tx_cache[0]) {
+        snprintf(path, size, "%s", config->tx_cache);
+    } else if (tx_tune_cache_path(path, size) < 0) {
+        path[0] = '\0';
+    }
+    return path[0] != '\0';
+}
 
-    printf("╔═══════════════════════════════════════════════════════════╗\n");
-    printf("║ COSPAS-SARSAT T.018 (2nd Generation) Beacon Transmitter  ║\n");
-    printf("║ Platform: Odroid-C4 + ADALM-PLUTO                        ║\n");
-    printf("╚═══════════════════════════════════════════════════════════╝\n\n");
+/**
+ * @brief Calibrate the push settings of one radio, or restore them from the cache
+ * @param config Application configuration (cache path)
+ * @param session Radio (no burst in flight)
+ * @param calibrate 1 = measure and store, 0 = apply the cached entry if any
+ */
+static void setup_tx_buffers(const app_config_t *config, sdr_session_t *session, int calibrate) {
+    if (!tx_tune_supported(&session->pluto)) {
+        if (calibrate) {
+            printf("[%s] Backend has no push settings to calibrate\n", session->uri);
+        }
+        return;
+    }
 
-    // Install signal handler
-    signal(SIGINT, signal_handler);
-    signal(SIGTERM, signal_handler);
+    char path[256] = "";
+    tx_cache_file(config, path, sizeof(path));
 
-    // Parse command line arguments
-    if (parse_args(argc, argv, &config) < 0) {
-        return 1;
+    tx_tune_result_t result;
+    if (calibrate) {
+        printf("Calibrating TX push settings of %s...\n", session->uri);
+        if (sdr_session_tune(session, &result) < 0) {
+            fprintf(stderr, "⚠ [%s] Calibration failed, keeping %u-sample chunks\n",
+                    session->uri, session->pluto.chunk_size);
+            return;
+        }
+        if (path[0] && tx_tune_cache_store(path, session->uri, &result) == 0) {
+            printf("✓ Calibration saved to %s\n", path);
+        }
+        return;
     }
 
-    print_config(&config);
+    if (path[0] && tx_tune_cache_load(path, session->uri, &result) &&
+        sdr_session_set_tx_buffers(session, result.chunk_size, result.kernel_buffers) == 0) {
+        printf("✓ [%s] Cached TX buffers: %u-sample chunks", session->uri, result.chunk_size);
+        if (result.kernel_buffers) printf(" × %u kernel buffers", result.kernel_buffers);
+        printf(" (jitter %.3f ms)\n", result.jitter_ms);
+    }
+}
 
-    // Initialize T.018 protocol
-    printf("--- Initialization ---\n");
+/**
+ * @brief Worker job: recalibrate every radio between bursts (control "tune")
+ */
+static int tune_job(void *arg) {
+    const app_config_t *config = (const app_config_t *)arg;
+    TRACE_BEGIN("tx calibration");
+    if (config->num_devices > 0) {
+        for (uint32_t d = 0; d < fanout.num_devices; d++) {
+            setup_tx_buffers(config, &fanout.devices[d].session, 1);
+        }
+    } else {
+        setup_tx_buffers(config, &radio, 1);
+    }
+    TRACE_END("tx calibration");
+    return 0;
+}
+
+// =============================================================================
+// MEMORY BUDGET
+// =============================================================================
+
+#define MEM_ESTIMATE_SLACK  (4u << 20)  // Filter taps, pool deques, packet headers, verification
+
+// Accounted memory needed by one burst cycle
+typedef struct {
+    uint32_t beacons;               // Distinct bursts held until pushed
+    uint32_t renders;               // Bursts rendered concurrently
+    uint64_t bursts;                // Rendered bursts at the output rate
+    uint64_t render;                // Modulator output being resampled, chip scratch
+    uint64_t tx;                    // Backend conversion buffers
+    uint64_t total;
+} mem_estimate_t;
+
+/**
+ * @brief Accounted memory of one TX backend
+ * @param config Application configuration (calibration cache path)
+ * @param session Radio session of the URI (push settings once connected)
+ * @param uri Device URI
+ * @param burst_samples Samples per burst at the output rate
+ * @return Bytes (the shm ring is shared memory and not counted)
+ *
+ * IIO radios queue chunk_size × kernel_buffers samples of 2 × int16 in libiio:
+ * the session's settings once connected, else the cached calibration, else
+ * PLUTO_CHUNK_SIZE with the libiio default queue depth.
+ */
+static uint64_t tx_buffer_bytes(const app_config_t *config, const sdr_session_t *session,
+                                const char *uri, uint64_t burst_samples) {
+    if (strncmp(uri, "null", 4) == 0) {
+        return 2ULL * PLUTO_CHUNK_MAX * sizeof(int16_t);
+    }
+    if (net_sink_is_uri(uri)) {
+        return burst_samples * 2 * sizeof(int16_t);
+    }
+    if (shm_ring_is_uri(uri)) {
+        return 0;
+    }
+
+    uint32_t chunk = PLUTO_CHUNK_SIZE;
+    uint32_t buffers = 0;
+    tx_tune_result_t cached;
+    char path[256] = "";
+    if (session->pluto.initialized && session->pluto.backend == PLUTO_BACKEND_IIO) {
+        chunk = session->pluto.chunk_size;
+        buffers = session->pluto.kernel_buffers;
+    } else if (tx_cache_file(config, path, sizeof(path)) &&
+               tx_tune_cache_load(path, uri, &cached)) {
+        chunk = cached.chunk_size;
+        buffers = cached.kernel_buffers;
+    }
+    if (buffers == 0) buffers = PLUTO_KERNEL_BUFFERS_DEFAULT;
+    return (uint64_t)chunk * buffers * 2 * sizeof(int16_t);
+}
+
+/**
+ * @brief Estimate the peak accounted memory of the configuration
+ * @param config Application configuration (fan-out devices already added)
+ * @param est Output: breakdown
+ *
+ * Every distinct beacon is rendered at once and held until the push; up to
+ * one render per pool thread also holds the modulator output while it is
+ * resampled. Sizes are the buffer bounds, not the burst length.
+ */
+static void estimate_memory(const app_config_t *config, mem_estimate_t *est) {
+    uint32_t serials[FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS];
+    memset(est, 0, sizeof(*est));
+    est->beacons = collect_serials(config, serials);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t threads = config->render_threads ? config->render_threads : (cpus > 0 ? (uint32_t)cpus : 1);
+    est->renders = (config->profile || est->beacons < 2) ? 1 :
+                   (threads < est->beacons ? threads : est->beacons);
+
+    uint64_t modulated = (uint64_t)OQPSK_TOTAL_SAMPLES * sizeof(float complex);
+    uint64_t samples = OQPSK_TOTAL_SAMPLES;
+    uint64_t scratch = 2ULL * PRN_FRAME_CHIPS;
+    if (config->output_rate != OQPSK_SAMPLE_RATE) {
+        samples = ((uint64_t)OQPSK_TOTAL_SAMPLES * config->output_rate + OQPSK_SAMPLE_RATE - 1) /
+                  OQPSK_SAMPLE_RATE;
+        scratch += modulated;
+    }
+    est->bursts = est->beacons * samples * sizeof(float complex);
+    est->render = est->renders * scratch;
+
+    if (!config->file_mode && config->num_devices > 0) {
+        for (uint32_t d = 0; d < fanout.num_devices; d++) {
+            est->tx += tx_buffer_bytes(config, &fanout.devices[d].session,
+                                       fanout.devices[d].uri, samples);
+        }
+    } else if (!config->file_mode) {
+        est->tx = tx_buffer_bytes(config, &radio, config->pluto_uri, samples);
+    }
+    est->total = est->bursts + est->render + est->tx + MEM_ESTIMATE_SLACK;
+}
+
+/**
+ * @brief Fail fast if the configuration cannot fit the memory budget
+ * @param config Application configuration
+ * @return 0 if it fits (budget armed for the allocator), -1 otherwise
+ */
+static int check_memory_budget(const app_config_t *config) {
+    if (!config->mem_budget) return 0;
+
+    mem_estimate_t est;
+    estimate_memory(config, &est);
+    printf("Memory estimate: %.1f MiB of %.1f MiB budget\n",
+           est.total / MEM_MIB, config->mem_budget / MEM_MIB);
+    printf("  Bursts:     %6.1f MiB (%u beacon(s) at %u Hz)\n",
+           est.bursts / MEM_MIB, est.beacons, config->output_rate);
+    printf("  Render:     %6.1f MiB (%u concurrent)\n", est.render / MEM_MIB, est.renders);
+    printf("  TX buffers: %6.1f MiB\n", est.tx / MEM_MIB);
+    printf("  Other:      %6.1f MiB\n", MEM_ESTIMATE_SLACK / MEM_MIB);
+
+    if (est.total > config->mem_budget) {
+        fprintf(stderr, "Configuration needs %.1f MiB, over the %.1f MiB memory budget "
+                "(lower -r, fewer beacons or -j)\n",
+                est.total / MEM_MIB, config->mem_budget / MEM_MIB);
+        return -1;
+    }
+    mem_set_budget(config->mem_budget);
+    return 0;
+}
+
+// =============================================================================
+// EVENT LOOP
+// =============================================================================
+
+// Daemon state (owned by the event loop thread)
+typedef struct {
+    app_config_t config;            // Live configuration (GPS / control updates)
+    tx_job_t job;                   // Burst being rendered/transmitted by the worker
+    render_lead_t lead;             // Render time estimate (render start = deadline - lead)
+    double lead_sec;                // Lead applied to next_deadline
+    event_loop_t loop;
+    event_worker_t worker;          // Render + transmit worker
+    int timer_fd;                   // Burst deadline timer
+    int signal_fd;                  // SIGINT/SIGTERM/SIGUSR1
+    control_socket_t control;
+    gps_input_t gps;
+    struct timespec last_dispatch;  // Deadline of the current/last burst
+    struct timespec next_deadline;  // Next burst deadline (CLOCK_MONOTONIC)
+    uint32_t tx_count;
+    uint32_t missed_deadlines;      // Bursts pushed after their deadline
+    uint8_t burst_pending;          // Render start reached while the worker was busy
+    uint8_t job_delayed;            // Current job dispatched late (worker was busy)
+    uint8_t stopping;               // Shutdown requested, waiting for worker
+    uint8_t tuning;                 // Worker runs a TX calibration, not a burst
+    int exit_code;
+    time_t start_time;
+} daemon_state_t;
+
+static daemon_state_t daemon_state;
+
+static double timespec_diff_sec(const struct timespec *a, const struct timespec *b) {
+    return (a->tv_sec - b->tv_sec) + (a->tv_nsec - b->tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Worker job: render one burst from the config snapshot, transmit at its deadline
+ */
+static int transmit_job(void *arg) {
+    tx_job_t *job = (tx_job_t *)arg;
+    const app_config_t *config = &job->config;
+
+    // Counters are bound to the calling thread: open them on the worker
+    if (config->profile && !prof) {
+        perf_profile_init(&profiler);
+        prof = &profiler;
+    }
+    if (prof) {
+        perf_profile_reset(prof);
+    }
+
+    TRACE_THREAD_NAME("render worker");
+    TRACE_BEGIN("burst");
+    mem_burst_begin();
+    int result = (config->num_devices > 0 && !config->file_mode) ?
+                 transmit_fanout(job) : transmit_beacon(job);
+
+    uint64_t peak_rss = mem_burst_end();
+    if (peak_rss) {
+        printf("  Peak RSS: %.1f MiB\n", peak_rss / MEM_MIB);
+    }
+    TRACE_END("burst");
+
+    if (prof) {
+        perf_profile_print(prof);
+    }
+    return result;
+}
+
+static void request_stop(daemon_state_t *state) {
+    state->stopping = 1;
+    if (state->worker.busy) {
+        printf("Waiting for current burst to complete...\n");
+    } else {
+        event_loop_stop(&state->loop);
+    }
+}
+
+static uint64_t lead_key(const app_config_t *config) {
+    uint32_t serials[FANOUT_MAX_DEVICES * FANOUT_MAX_BEACONS];
+    return render_lead_key(config->output_rate, collect_serials(config, serials));
+}
+
+/**
+ * @brief Set the next burst deadline, arm the timer for its render start
+ * @param state Daemon state
+ * @param deadline First RF sample due (CLOCK_MONOTONIC)
+ */
+static void schedule_next(daemon_state_t *state, const struct timespec *deadline) {
+    state->next_deadline = *deadline;
+
+    // Render just in time: deadline - (predicted render time + margin)
+    state->lead_sec = 0.0;
+    if (!state->config.file_mode) {
+        state->lead_sec = render_lead_get(&state->lead, lead_key(&state->config));
+        if (state->config.tx_interval_sec > 0 && state->lead_sec > state->config.tx_interval_sec) {
+            state->lead_sec = state->config.tx_interval_sec;
+        }
+    }
+    struct timespec render_start = *deadline;
+    event_timespec_add(&render_start, -state->lead_sec);
+    if (render_start.tv_sec < 0) {
+        render_start = (struct timespec) { 0, 0 };
+    }
+
+    if (event_timer_arm(state->timer_fd, &render_start) < 0) {
+        state->exit_code = 1;
+        request_stop(state);
+    }
+}
+
+/**
+ * @brief Sum radio link statistics (single session or all fan-out devices)
+ * @param config Application configuration
+ * @param total Output: summed statistics
+ * @param radios Output: number of radios
+ * @return Number of radios currently connected
+ */
+static uint32_t radio_stats(const app_config_t *config, sdr_session_stats_t *total, uint32_t *radios) {
+    memset(total, 0, sizeof(*total));
+    *radios = 0;
+    if (config->file_mode) return 0;
+
+    uint32_t up = 0;
+    uint32_t count = config->num_devices > 0 ? fanout.num_devices : 1;
+    for (uint32_t d = 0; d < count; d++) {
+        sdr_session_t *session = config->num_devices > 0 ? &fanout.devices[d].session : &radio;
+        sdr_session_stats_t stats;
+        sdr_session_get_stats(session, &stats);
+        total->bursts += stats.bursts;
+        total->missed += stats.missed;
+        total->disconnects += stats.disconnects;
+        total->reconnects += stats.reconnects;
+        total->attempts += stats.attempts;
+        total->downtime_sec += stats.downtime_sec;
+        up += sdr_session_is_up(session);
+    }
+    *radios = count;
+    return up;
+}
+
+static void print_status(const daemon_state_t *state, FILE *out) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sdr_session_stats_t link;
+    uint32_t radios;
+    uint32_t up = radio_stats(&state->config, &link, &radios);
+
+    fprintf(out, "\nDaemon status:\n");
+    fprintf(out, "  Transmissions:    %u\n", state->tx_count);
+    fprintf(out, "  Missed deadlines: %u\n", state->missed_deadlines);
+    fprintf(out, "  Uptime:           %ld seconds\n", (long)(time(NULL) - state->start_time));
+    fprintf(out, "  Worker:           %s\n", state->worker.busy ? "busy" : "idle");
+    if (radios > 0) {
+        fprintf(out, "  Radio link:       %u/%u up, %llu bursts missed, %u drops, "
+                "%u reconnects, %.1f s down\n", up, radios,
+                (unsigned long long)link.missed, link.disconnects, link.reconnects,
+                link.downtime_sec);
+    }
+    fprintf(out, "  Interval:         %u seconds\n", state->config.tx_interval_sec);
+    fprintf(out, "  Next burst in:    %.3f seconds (render lead %.3f s)\n",
+            timespec_diff_sec(&state->next_deadline, &now), state->lead_sec);
+    render_lead_print(&state->lead, out);
+    fprintf(out, "  Position:         %.6f, %.6f, %u m\n",
+            state->config.latitude, state->config.longitude, state->config.altitude);
+    if (state->gps.fd >= 0) {
+        fprintf(out, "  GPS:              %u sentences, %u fixes, %u checksum errors, "
+                "%u overlong lines\n", state->gps.sentences, state->gps.fixes,
+                state->gps.checksum_errors, state->gps.overlong);
+    }
+    if (journal.map) {
+        fprintf(out, "  Journal:          %llu records in %s\n",
+                (unsigned long long)journal.count, journal.path);
+    }
+    mem_print_report(out);
+}
+
+static void dispatch_burst(daemon_state_t *state) {
+    state->tx_count++;
+    time_t current_time = time(NULL);
+    printf("\n╔═════════════════════════════════════════════════╗\n");
+    printf("║ Transmission #%u                                \n", state->tx_count);
+    printf("║ Time: %s", ctime(&current_time));
+    printf("║ Uptime: %ld seconds                             \n", current_time - state->start_time);
+    printf("╚═════════════════════════════════════════════════╝\n");
+
+    // The worker renders from a private snapshot: GPS and control updates
+    // only affect the next burst
+    memset(&state->job, 0, sizeof(state->job));
+    state->job.config = state->config;
+    state->job.deadline = state->next_deadline;
+    state->job.cycle = state->tx_count;
+    event_worker_submit(&state->worker, transmit_job, &state->job);
+}
+
+/**
+ * @brief Render the burst due at next_deadline, schedule the following one
+ * @param state Daemon state
+ * @param delayed Render start was delayed by the previous burst
+ */
+static void start_burst(daemon_state_t *state, uint8_t delayed) {
+    state->last_dispatch = state->next_deadline;
+    state->job_delayed = delayed;
+    dispatch_burst(state);
+
+    // Absolute deadlines: the interval does not drift with render time
+    if (!state->config.file_mode) {
+        struct timespec next = state->last_dispatch;
+        event_timespec_add(&next, state->config.tx_interval_sec);
+        schedule_next(state, &next);
+    }
+}
+
+/**
+ * @brief Account the render time and deadline lateness of a completed burst
+ * @param state Daemon state
+ */
+static void update_render_lead(daemon_state_t *state) {
+    const tx_job_t *job = &state->job;
+
+    if (!job->reused) {
+        render_lead_update(&state->lead, lead_key(&job->config), job->render_sec);
+    }
+    if (job->lateness_sec > 0.001) {
+        state->missed_deadlines++;
+        fprintf(stderr, "Deadline missed by %.3f s (render %.3f s)\n",
+                job->lateness_sec, job->render_sec);
+    }
+
+    // A late render start (busy worker) says nothing about the margin
+    if (!state->job_delayed) {
+        render_lead_feedback(&state->lead, job->lateness_sec);
+    }
+
+    printf("Render %.3f s, RF start %+.3f s from deadline, margin %.3f s\n",
+           job->render_sec, job->lateness_sec, state->lead.margin);
+}
+
+static void on_timer(int fd, uint32_t events, void *user) {
+    daemon_state_t *state = (daemon_state_t *)user;
+    (void)events;
+
+    event_timer_ack(fd);
+    TRACE_INSTANT("deadline");
+    if (state->stopping) return;
+
+    // Previous burst still running: render this one as soon as it completes
+    if (state->worker.busy) {
+        if (state->tuning) {
+            fprintf(stderr, "Render start reached during TX calibration\n");
+        } else {
+            fprintf(stderr, "Render start reached while burst #%u is still running\n",
+                    state->tx_count);
+        }
+        state->burst_pending = 1;
+        return;
+    }
+
+    start_burst(state, 0);
+}
+
+static void on_worker_done(int fd, uint32_t events, void *user) {
+    daemon_state_t *state = (daemon_state_t *)user;
+    (void)fd;
+    (void)events;
+
+    int tx_result = event_worker_collect(&state->worker);
+
+    // Calibration done: resume the schedule (a delayed burst renders now)
+    if (state->tuning) {
+        state->tuning = 0;
+        if (state->stopping) {
+            event_loop_stop(&state->loop);
+        } else if (state->burst_pending) {
+            state->burst_pending = 0;
+            start_burst(state, 1);
+        }
+        return;
+    }
+
+    if (tx_result < 0) {
+        fprintf(stderr, "Transmission failed, stopping...\n");
+        state->exit_code = 1;
+        event_loop_stop(&state->loop);
+        return;
+    }
+
+    // Increment transmission count for rotating field
+    t018_increment_transmission_count();
+
+    if (!state->config.file_mode) {
+        update_render_lead(state);
+    }
+
+    // In file mode, generate only one frame then exit
+    if (state->config.file_mode) {
+        printf("\n✓ File mode: Single frame generated, exiting...\n");
+        event_loop_stop(&state->loop);
+        return;
+    }
+
+    if (state->config.max_transmissions && state->tx_count >= state->config.max_transmissions) {
+        printf("\n✓ %u transmissions done, exiting...\n", state->tx_count);
+        event_loop_stop(&state->loop);
+        return;
+    }
+
+    if (state->stopping) {
+        event_loop_stop(&state->loop);
+        return;
+    }
+
+    // Deadline kept: render now, transmit on time if there is still room
+    if (state->burst_pending) {
+        state->burst_pending = 0;
+        start_burst(state, 1);
+        return;
+    }
+
+    // Re-arm the next render start with the updated estimate
+    schedule_next(state, &state->next_deadline);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    printf("\nNext transmission in %.1f seconds (render starts %.3f s before)...\n",
+           timespec_diff_sec(&state->next_deadline, &now), state->lead_sec);
+}
+
+static void on_signal(int fd, uint32_t events, void *user) {
+    daemon_state_t *state = (daemon_state_t *)user;
+    struct signalfd_siginfo info;
+    (void)events;
+
+    while (read(fd, &info, sizeof(info)) == sizeof(info)) {
+        if (info.ssi_signo == SIGUSR1) {
+            print_status(state, stdout);
+        } else {
+            printf("\n\nShutdown signal received...\n");
+            request_stop(state);
+        }
+    }
+}
+
+static void on_gps(int fd, uint32_t events, void *user) {
+    daemon_state_t *state = (daemon_state_t *)user;
+    (void)events;
+
+    int new_fixes = gps_input_read(&state->gps);
+    if (new_fixes < 0) {
+        printf("GPS input closed (%u fixes received, %u overlong lines dropped)\n",
+               state->gps.fixes, state->gps.overlong);
+        event_loop_remove(&state->loop, fd);
+        gps_input_close(&state->gps);
+        return;
+    }
+
+    if (new_fixes > 0) {
+        const gps_fix_t *fix = &state->gps.fix;
+        if (state->gps.fixes == (uint32_t)new_fixes) {
+            printf("✓ GPS fix: %.6f, %.6f, %.0f m (%u satellites)\n",
+                   fix->latitude, fix->longitude, fix->altitude, fix->satellites);
+        }
+        state->config.latitude = fix->latitude;
+        state->config.longitude = fix->longitude;
+        state->config.altitude = (fix->altitude > 0.0) ? (uint16_t)(fix->altitude + 0.5) : 0;
+    }
+}
+
+static void handle_command(daemon_state_t *state, control_client_t *client, const char *line) {
+    char cmd[32] = "";
+    double a = 0.0, b = 0.0, c = 0.0;
+    int args = sscanf(line, "%31s %lf %lf %lf", cmd, &a, &b, &c) - 1;
+
+    if (strcmp(cmd, "status") == 0) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        sdr_session_stats_t link;
+        uint32_t radios;
+        uint32_t up = radio_stats(&state->config, &link, &radios);
+        uint64_t mem_peak = 0, rss = 0;
+        for (int s = 0; s < MEM_SUBSYS_COUNT; s++) {
+            mem_subsys_stats_t mem;
+            mem_get_stats((mem_subsys_t)s, &mem);
+            mem_peak += mem.peak;
+        }
+        mem_read_rss(&rss, NULL);
+        control_reply(client, "OK tx=%u missed=%u worker=%s radios_up=%u/%u "
+                      "bursts_missed=%llu reconnects=%u interval=%u next=%.3f lead=%.3f "
+                      "lat=%.6f lon=%.6f alt=%u gps_fixes=%u mem_peak_mib=%.1f rss_mib=%.1f\n",
+                      state->tx_count, state->missed_deadlines,
+                      state->worker.busy ? "busy" : "idle",
+                      up, radios, (unsigned long long)link.missed, link.reconnects,
+                      state->config.tx_interval_sec,
+                      timespec_diff_sec(&state->next_deadline, &now), state->lead_sec,
+                      state->config.latitude, state->config.longitude,
+                      state->config.altitude, state->gps.fixes,
+                      mem_peak / MEM_MIB, rss / MEM_MIB);
+    } else if (strcmp(cmd, "tx") == 0) {
+        // Transmit as soon as rendered, following deadlines restart from there
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        event_timespec_add(&now, render_lead_get(&state->lead, lead_key(&state->config)));
+        schedule_next(state, &now);
+        control_reply(client, "OK\n");
+    } else if (strcmp(cmd, "interval") == 0 && args >= 1 && a >= 1.0) {
+        state->config.tx_interval_sec = (uint32_t)a;
+        struct timespec next = state->last_dispatch;
+        event_timespec_add(&next, state->config.tx_interval_sec);
+        schedule_next(state, &next);
+        control_reply(client, "OK interval=%u\n", state->config.tx_interval_sec);
+    } else if (strcmp(cmd, "pos") == 0 && args >= 2 &&
+               a >= -90.0 && a <= 90.0 && b >= -180.0 && b <= 180.0) {
+        state->config.latitude = a;
+        state->config.longitude = b;
+        if (args >= 3) {
+            state->config.altitude = (c > 0.0) ? (uint16_t)(c + 0.5) : 0;
+        }
+        control_reply(client, "OK\n");
+    } else if (strcmp(cmd, "tune") == 0) {
+        // Runs on the worker between bursts: it owns the radios there
+        if (state->config.file_mode) {
+            control_reply(client, "ERR no radio in file mode\n");
+        } else if (state->worker.busy) {
+            control_reply(client, "ERR busy, retry after the current burst\n");
+        } else {
+            memset(&state->job, 0, sizeof(state->job));
+            state->job.config = state->config;
+            state->tuning = 1;
+            event_worker_submit(&state->worker, tune_job, &state->job.config);
+            control_reply(client, "OK calibrating (results on the console)\n");
+        }
+    } else if (strcmp(cmd, "stop") == 0) {
+        control_reply(client, "OK\n");
+        printf("\n\nStop requested on control socket...\n");
+        request_stop(state);
+    } else if (strcmp(cmd, "help") == 0) {
+        control_reply(client, "OK commands: status | tx | interval <sec> | "
+                      "pos <lat> <lon> [alt] | tune | stop\n");
+    } else if (cmd[0]) {
+        control_reply(client, "ERR unknown command: %s\n", line);
+    }
+}
+
+static void on_control_client(int fd, uint32_t events, void *user) {
+    control_client_t *client = (control_client_t *)user;
+    char line[CONTROL_LINE_MAX];
+    (void)events;
+
+    int closed = control_client_read(client);
+    while (control_client_next_line(client, line, sizeof(line))) {
+        handle_command(&daemon_state, client, line);
+    }
+
+    if (closed < 0) {
+        event_loop_remove(&daemon_state.loop, fd);
+        control_client_close(client);
+    }
+}
+
+static void on_control_accept(int fd, uint32_t events, void *user) {
+    daemon_state_t *state = (daemon_state_t *)user;
+    control_client_t *client;
+    (void)fd;
+    (void)events;
+
+    while ((client = control_socket_accept(&state->control)) != NULL) {
+        if (event_loop_add(&state->loop, client->fd, EPOLLIN, on_control_client, client) < 0) {
+            control_client_close(client);
+        }
+    }
+}
+
+/**
+ * @brief Set up timer, signals, worker and optional inputs on the event loop
+ * @param state Daemon state (config already set)
+ * @return 0 on success, -1 on error
+ */
+static int daemon_setup(daemon_state_t *state) {
+    const int signals[] = { SIGINT, SIGTERM, SIGUSR1 };
+
+    // Nothing opened yet: cleanup must not close descriptor 0
+    state->loop.epoll_fd = -1;
+    state->worker.done_fd = -1;
+    state->timer_fd = -1;
+    state->control.listen_fd = -1;
+    state->gps.fd = -1;
+    journal.fd = -1;
+
+    render_lead_init(&state->lead);
+
+    // Signals are blocked before any thread is created (worker, fan-out)
+    state->signal_fd = event_signal_create(signals, 3);
+    if (state->signal_fd < 0 || event_loop_init(&state->loop) < 0) {
+        return -1;
+    }
+
+    state->timer_fd = event_timer_create();
+    if (state->timer_fd < 0 || event_worker_start(&state->worker) < 0) {
+        return -1;
+    }
+
+    if (event_loop_add(&state->loop, state->signal_fd, EPOLLIN, on_signal, state) < 0 ||
+        event_loop_add(&state->loop, state->timer_fd, EPOLLIN, on_timer, state) < 0 ||
+        event_loop_add(&state->loop, state->worker.done_fd, EPOLLIN, on_worker_done, state) < 0) {
+        return -1;
+    }
+
+    if (state->config.control_path[0]) {
+        if (control_socket_open(&state->control, state->config.control_path) < 0 ||
+            event_loop_add(&state->loop, state->control.listen_fd, EPOLLIN,
+                           on_control_accept, state) < 0) {
+            return -1;
+        }
+    }
+
+    if (state->config.journal_path[0] && !state->config.file_mode) {
+        if (tx_journal_open(&journal, state->config.journal_path, 0) < 0) {
+            return -1;
+        }
+    }
+
+    if (state->config.gps_path[0]) {
+        if (gps_input_open(&state->gps, state->config.gps_path) < 0) {
+            return -1;
+        }
+        if (event_loop_add(&state->loop, state->gps.fd, EPOLLIN, on_gps, state) < 0) {
+            if (errno != EPERM) {
+                return -1;
+            }
+            // Regular file (not pollable): replay it once, keep the last fix
+            on_gps(state->gps.fd, EPOLLIN, state);
+            printf("✓ GPS replay: %u sentences, %u fixes, %u checksum errors, %u overlong lines\n",
+                   state->gps.sentences, state->gps.fixes, state->gps.checksum_errors,
+                   state->gps.overlong);
+        }
+    }
+
+    return 0;
+}
+
+static void daemon_cleanup(daemon_state_t *state) {
+    event_worker_stop(&state->worker);
+    control_socket_close(&state->control);
+    gps_input_close(&state->gps);
+    tx_journal_close(&journal);
+    if (state->timer_fd >= 0) close(state->timer_fd);
+    if (state->signal_fd >= 0) close(state->signal_fd);
+    event_loop_cleanup(&state->loop);
+}
+
+// =============================================================================
+// STARTUP TASKS
+// =============================================================================
+
+static int startup_tables(void *arg) {
+    (void)arg;
     t018_init();
 
-    // Verify PRN generator
     printf("Verifying PRN generator...\n");
     if (!prn_verify_table_2_2()) {
         fprintf(stderr, "PRN verification failed!\n");
-        return 1;
+        return -1;
     }
+    return 0;
+}
 
-    // Initialize PlutoSDR (skip in file mode)
-    if (!config.file_mode) {
+static int startup_radio(void *arg) {
+    const app_config_t *config = (const app_config_t *)arg;
+    TRACE_THREAD_NAME("startup radio");
+    TRACE_BEGIN("radio connect");
+
+    int result = 0;
+    if (config->num_devices > 0) {
+        printf("Initializing fan-out devices...\n");
+        if (fanout_start(&fanout, config->frequency, config->tx_gain_db, config->output_rate) < 0) {
+            fprintf(stderr, "Fan-out initialization failed\n");
+            result = -1;
+        }
+        for (uint32_t d = 0; result == 0 && d < fanout.num_devices; d++) {
+            setup_tx_buffers(config, &fanout.devices[d].session, config->tune_tx);
+            if (config->fault_every) {
+                sdr_session_set_fault(&fanout.devices[d].session,
+                                      config->fault_every, config->fault_attempts);
+            }
+        }
+    } else {
         printf("Initializing PlutoSDR...\n");
-        if (pluto_init(&pluto_ctx, config.pluto_uri) < 0) {
+        if (sdr_session_open(&radio, config->pluto_uri, config->frequency, config->tx_gain_db,
+                             config->output_rate) < 0) {
             fprintf(stderr, "PlutoSDR initialization failed\n");
-            return 1;
+            result = -1;
+        } else {
+            pluto_print_info(&radio.pluto);
+            setup_tx_buffers(config, &radio, config->tune_tx);
+            if (config->fault_every) {
+                sdr_session_set_fault(&radio, config->fault_every, config->fault_attempts);
+            }
         }
+    }
+    if (result == 0 && config->fault_every) {
+        printf("⚠ Fault injection: link drop every %u bursts, %u failed reconnects\n",
+               config->fault_every, config->fault_attempts);
+    }
+
+    TRACE_END("radio connect");
+    return result;
+}
+
+static int startup_first_frame(void *arg) {
+    const app_config_t *config = (const app_config_t *)arg;
+    TRACE_THREAD_NAME("startup render");
+    TRACE_BEGIN("first frame render");
+    int result = prerender_bursts(config);
+    TRACE_END("first frame render");
+    return result;
+}
+
+// =============================================================================
+// MAIN APPLICATION
+// =============================================================================
+
+int main(int argc, char *argv[]) {
+    daemon_state_t *state = &daemon_state;
+    app_config_t *config = &state->config;
+    process_start = startup_now();
+
+    printf("╔═══════════════════════════════════════════════════════════╗\n");
+    printf("║ COSPAS-SARSAT T.018 (2nd Generation) Beacon Transmitter  ║\n");
+    printf("║ Platform: Odroid-C4 + ADALM-PLUTO                        ║\n");
+    printf("╚═══════════════════════════════════════════════════════════╝\n\n");
+
+    // Parse command line arguments
+    if (parse_args(argc, argv, config) < 0) {
+        return 1;
+    }
+    // Stage counters follow the calling thread only: under --profile the
+    // pool has no workers and every parallel loop runs inline
+    task_pool_configure_default(config->profile ? 1 : config->render_threads, config->pin_cpus);
 
-        pluto_print_info(&pluto_ctx);
+    print_config(config);
 
-        // Configure TX
-        printf("Configuring TX...\n");
-        if (pluto_configure_tx(&pluto_ctx, config.frequency, config.tx_gain_db,
-                              PLUTO_SAMPLE_RATE) < 0) {
-            fprintf(stderr, "TX configuration failed\n");
-            pluto_cleanup(&pluto_ctx);
+    if (config->trace_path[0]) {
+        if (trace_start(config->trace_path) < 0) {
             return 1;
         }
+        TRACE_THREAD_NAME("event loop");
+    }
+
+    // Event loop: signals, burst timer, worker, control socket, GPS
+    if (daemon_setup(state) < 0) {
+        fprintf(stderr, "Event loop initialization failed\n");
+        daemon_cleanup(state);
+        return 1;
+    }
+
+    // Fan-out device specs are parsed up front: the render task reads the serials
+    if (!config->file_mode && config->num_devices > 0) {
+        fanout_init(&fanout);
+        for (uint32_t d = 0; d < config->num_devices; d++) {
+            if (fanout_add_device(&fanout, config->device_specs[d], config->serial_number) < 0) {
+                daemon_cleanup(state);
+                return 1;
+            }
+        }
+    }
+
+    if (check_memory_budget(config) < 0) {
+        daemon_cleanup(state);
+        return 1;
+    }
+
+    // Radio connection overlaps table setup and the first render
+    printf("--- Initialization ---\n");
+    startup_plan_t plan;
+    startup_init(&plan, process_start);
+    int tables_task = startup_add(&plan, "protocol tables", startup_tables, NULL, 0);
+    int radio_task = -1;
+    int render_task = -1;
+    if (!config->file_mode) {
+        radio_task = startup_add(&plan, "radio connect", startup_radio, config, 0);
+        render_task = startup_add(&plan, "first frame render", startup_first_frame, config,
+                                  1u << tables_task);
     } else {
         printf("File output mode - skipping PlutoSDR initialization\n");
     }
 
+    int startup_result = startup_run(&plan, !config->serial_init);
+    startup_print(&plan);
+    printf("  Startup %s: %.3f s\n", config->serial_init ? "(serial)" : "(parallel)",
+           startup_now() - process_start);
+    if (startup_result < 0) {
+        fprintf(stderr, "Initialization failed\n");
+        if (startup_succeeded(&plan, radio_task)) {
+            if (config->num_devices > 0) {
+                fanout_stop(&fanout);
+            } else {
+                sdr_session_close(&radio);
+            }
+        }
+        free_prerendered();
+        startup_free(&plan);
+        daemon_cleanup(state);
+        return 1;
+    }
+
+    // The startup render seeds the render time estimate
+    if (render_task >= 0) {
+        const startup_task_t *task = &plan.tasks[render_task];
+        render_lead_update(&state->lead, lead_key(config), task->end_sec - task->start_sec);
+    }
+    startup_free(&plan);
+
     // Main transmission loop
     printf("\n╔═══════════════════════════════════════════╗\n");
-    if (config.file_mode) {
+    if (config->file_mode) {
         printf("║ File Generation Mode                     ║\n");
         printf("║ Press Ctrl+C to stop                     ║\n");
     } else {
@@ -333,40 +1848,15 @@ int main(int argc, char *argv[]) {
     }
     printf("╚═══════════════════════════════════════════╝\n");
 
-    uint32_t tx_count = 0;
-    time_t start_time = time(NULL);
-
-    while (running) {
-        tx_count++;
-        time_t current_time = time(NULL);
-        printf("\n╔═════════════════════════════════════════════════╗\n");
-        printf("║ Transmission #%u                                \n", tx_count);
-        printf("║ Time: %s", ctime(&current_time));
-        printf("║ Uptime: %ld seconds                             \n", current_time - start_time);
-        printf("╚═════════════════════════════════════════════════╝\n");
-
-        // Transmit beacon
-        if (transmit_beacon(&config) < 0) {
-            fprintf(stderr, "Transmission failed, stopping...\n");
-            break;
-        }
-
-        // Increment transmission count for rotating field
-        t018_increment_transmission_count();
+    state->start_time = time(NULL);
 
-        // In file mode, generate only one frame then exit
-        if (config.file_mode) {
-            printf("\n✓ File mode: Single frame generated, exiting...\n");
-            break;
-        }
+    // First burst immediately, then every tx_interval_sec
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    schedule_next(state, &now);
 
-        // Wait for next transmission
-        if (running) {
-            printf("\nWaiting %u seconds for next transmission...\n", config.tx_interval_sec);
-            for (uint32_t i = 0; i < config.tx_interval_sec && running; i++) {
-                sleep(1);
-            }
-        }
+    if (event_loop_run(&state->loop) < 0) {
+        state->exit_code = 1;
     }
 
     // Cleanup
@@ -374,14 +1864,46 @@ int main(int argc, char *argv[]) {
     printf("║ Shutting Down                            ║\n");
     printf("╚═══════════════════════════════════════════╝\n");
 
-    if (!config.file_mode) {
-        pluto_cleanup(&pluto_ctx);
+    daemon_cleanup(state);
+
+    if (prof) {
+        perf_profile_cleanup(prof);
+    }
+
+    sdr_session_stats_t link;
+    uint32_t radios;
+    radio_stats(config, &link, &radios);
+
+    if (!config->file_mode && config->num_devices > 0) {
+        fanout_print_metrics(&fanout);
+        fanout_stop(&fanout);
+    } else if (!config->file_mode) {
+        sdr_session_close(&radio);
+    }
+
+    free_prerendered();
+
+    if (config->trace_path[0]) {
+        trace_stop();
     }
 
     printf("\nTransmission Statistics:\n");
-    printf("  Total transmissions: %u\n", tx_count);
-    printf("  Total runtime: %ld seconds\n", time(NULL) - start_time);
+    printf("  Total transmissions: %u\n", state->tx_count);
+    printf("  Missed deadlines: %u\n", state->missed_deadlines);
+    if (first_rf_sec >= 0.0) {
+        printf("  Time to first RF sample: %.3f s\n", first_rf_sec);
+    }
+    if (!config->file_mode) {
+        render_lead_print(&state->lead, stdout);
+    }
+    if (radios > 0) {
+        printf("  Bursts missed (radio offline): %llu\n", (unsigned long long)link.missed);
+        printf("  Radio link: %u drops, %u reconnects (%u attempts), %.1f s down\n",
+               link.disconnects, link.reconnects, link.attempts, link.downtime_sec);
+    }
+    printf("  Total runtime: %ld seconds\n", time(NULL) - state->start_time);
+    mem_print_report(stdout);
 
     printf("\n✓ Shutdown complete\n");
-    return 0;
+    return state->exit_code;
 }
@@ -0,0 +1,252 @@
+/**
+ * @file mem_account.c
+ * @brief Memory accounting implementation
+ *
+ * Each block carries a max_align_t-sized header (size, subsystem, magic)
+ * in front of the memory handed out. Counters are atomics: the render
+ * tasks allocate from every pool worker.
+ */
+
+#include "mem_account.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#define MEM_MAGIC           0x4d454d41u     // "MEMA"
+#define MEM_MAGIC_FREED     0x66726565u     // "free" (double free check)
+
+typedef union {
+    struct {
+        size_t size;
+        uint32_t subsys;
+        uint32_t magic;
+    } h;
+    max_align_t align;
+} mem_header_t;
+
+static const char *subsys_names[MEM_SUBSYS_COUNT] = {
+    "burst", "modulator", "resampler", "tx", "pool"
+};
+
+static _Atomic uint64_t current[MEM_SUBSYS_COUNT];
+static _Atomic uint64_t peak[MEM_SUBSYS_COUNT];
+static _Atomic uint64_t allocs[MEM_SUBSYS_COUNT];
+static _Atomic uint64_t total_current;
+static _Atomic uint64_t total_peak;
+static _Atomic uint64_t budget;
+static _Atomic uint64_t refused;            // Allocations over budget
+
+// Per-burst RSS (worker thread only)
+static uint64_t bursts;
+static uint64_t burst_peak_last;
+static uint64_t burst_peak_max;
+static int hwm_reset = -1;                  // clear_refs usable: -1 unknown, 0 no, 1 yes
+
+// =============================================================================
+// COUNTERS
+// =============================================================================
+
+static void raise_peak(_Atomic uint64_t *mark, uint64_t value) {
+    uint64_t seen = atomic_load_explicit(mark, memory_order_relaxed);
+    while (value > seen &&
+           !atomic_compare_exchange_weak_explicit(mark, &seen, value,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+static int charge(mem_subsys_t subsys, uint64_t bytes) {
+    uint64_t total = atomic_fetch_add(&total_current, bytes) + bytes;
+    uint64_t limit = atomic_load_explicit(&budget, memory_order_relaxed);
+    if (limit && total > limit) {
+        atomic_fetch_sub(&total_current, bytes);
+        atomic_fetch_add(&refused, 1);
+        fprintf(stderr, "Memory budget exceeded: %s needs %.1f MiB, %.1f of %.1f MiB in use\n",
+                subsys_names[subsys], bytes / MEM_MIB, (total - bytes) / MEM_MIB,
+                limit / MEM_MIB);
+        return -1;
+    }
+    raise_peak(&total_peak, total);
+    raise_peak(&peak[subsys], atomic_fetch_add(&current[subsys], bytes) + bytes);
+    return 0;
+}
+
+static void uncharge(mem_subsys_t subsys, uint64_t bytes) {
+    atomic_fetch_sub(&current[subsys], bytes);
+    atomic_fetch_sub(&total_current, bytes);
+}
+
+// =============================================================================
+// ALLOCATOR
+// =============================================================================
+
+static void *finish(mem_header_t *hdr, mem_subsys_t subsys, size_t size) {
+    hdr->h.size = size;
+    hdr->h.subsys = subsys;
+    hdr->h.magic = MEM_MAGIC;
+    atomic_fetch_add_explicit(&allocs[subsys], 1, memory_order_relaxed);
+    return hdr + 1;
+}
+
+static mem_header_t *header_of(void *ptr) {
+    mem_header_t *hdr = (mem_header_t *)ptr - 1;
+    if (hdr->h.magic != MEM_MAGIC || hdr->h.subsys >= MEM_SUBSYS_COUNT) {
+        fprintf(stderr, "mem_account: %p was not allocated by mem_alloc (or freed twice)\n", ptr);
+        abort();
+    }
+    return hdr;
+}
+
+void *mem_alloc(mem_subsys_t subsys, size_t size) {
+    if (size > SIZE_MAX - sizeof(mem_header_t) || charge(subsys, size) < 0) {
+        return NULL;
+    }
+    mem_header_t *hdr = malloc(sizeof(mem_header_t) + size);
+    if (!hdr) {
+        uncharge(subsys, size);
+        return NULL;
+    }
+    return finish(hdr, subsys, size);
+}
+
+void *mem_calloc(mem_subsys_t subsys, size_t count, size_t size) {
+    if (size && count > (SIZE_MAX - sizeof(mem_header_t)) / size) {
+        return NULL;
+    }
+    size_t bytes = count * size;
+    if (charge(subsys, bytes) < 0) {
+        return NULL;
+    }
+    mem_header_t *hdr = calloc(1, sizeof(mem_header_t) + bytes);
+    if (!hdr) {
+        uncharge(subsys, bytes);
+        return NULL;
+    }
+    return finish(hdr, subsys, bytes);
+}
+
+void *mem_realloc(mem_subsys_t subsys, void *ptr, size_t size) {
+    if (!ptr) {
+        return mem_alloc(subsys, size);
+    }
+    mem_header_t *hdr = header_of(ptr);
+    size_t old = hdr->h.size;
+    subsys = (mem_subsys_t)hdr->h.subsys;
+    if (size > SIZE_MAX - sizeof(mem_header_t) ||
+        (size > old && charge(subsys, size - old) < 0)) {
+        return NULL;
+    }
+
+    mem_header_t *grown = realloc(hdr, sizeof(mem_header_t) + size);
+    if (!grown) {
+        if (size > old) uncharge(subsys, size - old);
+        return NULL;
+    }
+    if (size < old) uncharge(subsys, old - size);
+    grown->h.size = size;
+    return grown + 1;
+}
+
+void mem_free(void *ptr) {
+    if (!ptr) return;
+    mem_header_t *hdr = header_of(ptr);
+    uncharge((mem_subsys_t)hdr->h.subsys, hdr->h.size);
+    hdr->h.magic = MEM_MAGIC_FREED;
+    free(hdr);
+}
+
+void mem_set_budget(uint64_t bytes) {
+    atomic_store(&budget, bytes);
+}
+
+uint64_t mem_get_budget(void) {
+    return atomic_load(&budget);
+}
+
+void mem_get_stats(mem_subsys_t subsys, mem_subsys_stats_t *stats) {
+    stats->current = atomic_load(&current[subsys]);
+    stats->peak = atomic_load(&peak[subsys]);
+    stats->allocs = atomic_load(&allocs[subsys]);
+}
+
+// =============================================================================
+// RESIDENT SET SIZE
+// =============================================================================
+
+int mem_read_rss(uint64_t *rss, uint64_t *hwm) {
+    FILE *f = fopen("/proc/self/status", "r");
+    if (!f) return -1;
+
+    char line[128];
+    unsigned long long kb;
+    int found = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "VmRSS: %llu kB", &kb) == 1) {
+            *rss = kb * 1024ULL;
+            found |= 1;
+        } else if (hwm && sscanf(line, "VmHWM: %llu kB", &kb) == 1) {
+            *hwm = kb * 1024ULL;
+            found |= 2;
+        }
+    }
+    fclose(f);
+    return (found & 1) ? 0 : -1;
+}
+
+void mem_burst_begin(void) {
+    if (hwm_reset == 0) return;
+
+    // "5" resets the peak RSS to the current RSS (Linux >= 4.0)
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    hwm_reset = f && fputs("5", f) >= 0;
+    if (f && fclose(f) != 0) hwm_reset = 0;
+}
+
+uint64_t mem_burst_end(void) {
+    uint64_t rss = 0, hwm = 0;
+    if (mem_read_rss(&rss, &hwm) < 0) return 0;
+
+    // Without the reset the peak covers the whole run: fall back to the RSS now
+    uint64_t burst_peak = (hwm_reset == 1 && hwm) ? hwm : rss;
+    bursts++;
+    burst_peak_last = burst_peak;
+    if (burst_peak > burst_peak_max) burst_peak_max = burst_peak;
+    return burst_peak;
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+void mem_print_report(FILE *out) {
+    fprintf(out, "  Memory (accounted allocations):\n");
+    fprintf(out, "    %-10s %10s %10s %8s\n", "Subsystem", "Current", "Peak", "Allocs");
+    uint64_t total_allocs = 0;
+    for (int s = 0; s < MEM_SUBSYS_COUNT; s++) {
+        mem_subsys_stats_t stats;
+        mem_get_stats((mem_subsys_t)s, &stats);
+        total_allocs += stats.allocs;
+        fprintf(out, "    %-10s %6.1f MiB %6.1f MiB %8llu\n", subsys_names[s],
+                stats.current / MEM_MIB, stats.peak / MEM_MIB, (unsigned long long)stats.allocs);
+    }
+    fprintf(out, "    %-10s %6.1f MiB %6.1f MiB %8llu\n", "total",
+            atomic_load(&total_current) / MEM_MIB, atomic_load(&total_peak) / MEM_MIB,
+            (unsigned long long)total_allocs);
+
+    uint64_t rss = 0, hwm = 0;
+    if (mem_read_rss(&rss, &hwm) == 0) {
+        fprintf(out, "    RSS %.1f MiB", rss / MEM_MIB);
+        if (bursts) {
+            fprintf(out, ", burst peak %.1f MiB (last), %.1f MiB (max of %llu)",
+                    burst_peak_last / MEM_MIB, burst_peak_max / MEM_MIB,
+                    (unsigned long long)bursts);
+        }
+        fprintf(out, "\n");
+    }
+
+    uint64_t limit = atomic_load(&budget);
+    if (limit) {
+        fprintf(out, "    Budget %.1f MiB, %llu allocation(s) refused\n",
+                limit / MEM_MIB, (unsigned long long)atomic_load(&refused));
+    }
+}
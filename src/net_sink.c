@@ -0,0 +1,378 @@
+/**
+ * @file net_sink.c
+ * @brief Network I/Q sink implementation
+ *
+ * Headers and payload go out as two iovecs per packet: the payload is never
+ * copied into a staging buffer. UDP packets are queued NET_SINK_BATCH at a
+ * time per sendmmsg() call; TCP frames use MSG_ZEROCOPY when SO_ZEROCOPY is
+ * accepted, and the burst call waits for the completions before returning
+ * (the caller's buffer must not change while the kernel still reads it).
+ *
+ * Header layout (little endian, 32 bytes):
+ *   "SGNS", u16 version, u16 flags, u32 seq, u32 burst, u64 sample index,
+ *   u32 sample rate, u16 samples, u16 0
+ */
+
+#define _GNU_SOURCE                 // sendmmsg()
+
+#include "net_sink.h"
+#include "mem_account.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/errqueue.h>
+
+// =============================================================================
+// HEADERS
+// =============================================================================
+
+static void put_le16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t get_le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void net_header_encode(uint8_t *p, const net_packet_header_t *h) {
+    memcpy(p, NET_SINK_MAGIC, 4);
+    put_le16(p + 4, NET_SINK_VERSION);
+    put_le16(p + 6, h->flags);
+    put_le32(p + 8, h->seq);
+    put_le32(p + 12, h->burst);
+    put_le32(p + 16, (uint32_t)h->sample_index);
+    put_le32(p + 20, (uint32_t)(h->sample_index >> 32));
+    put_le32(p + 24, h->sample_rate);
+    put_le16(p + 28, h->samples);
+    put_le16(p + 30, 0);
+}
+
+int net_header_decode(const uint8_t *p, net_packet_header_t *h) {
+    if (memcmp(p, NET_SINK_MAGIC, 4) != 0 || get_le16(p + 4) != NET_SINK_VERSION) {
+        return -1;
+    }
+    h->flags = get_le16(p + 6);
+    h->seq = get_le32(p + 8);
+    h->burst = get_le32(p + 12);
+    h->sample_index = (uint64_t)get_le32(p + 16) | ((uint64_t)get_le32(p + 20) << 32);
+    h->sample_rate = get_le32(p + 24);
+    h->samples = get_le16(p + 28);
+    return h->samples <= NET_SINK_MAX_SAMPLES ? 0 : -1;
+}
+
+// =============================================================================
+// CONNECTION
+// =============================================================================
+
+int net_sink_is_uri(const char *uri) {
+    return uri && (strncasecmp(uri, "tcp:", 4) == 0 || strncasecmp(uri, "udp:", 4) == 0);
+}
+
+static int parse_uri(const char *uri, net_proto_t *proto, char *host, size_t host_size,
+                     char *port, size_t port_size) {
+    // tcp:host[:port], udp:[v6addr][:port]
+    if (!net_sink_is_uri(uri)) return -1;
+    *proto = strncasecmp(uri, "udp:", 4) == 0 ? NET_SINK_UDP : NET_SINK_TCP;
+
+    const char *h = uri + 4;
+    const char *p;
+    size_t len;
+    if (*h == '[') {
+        const char *end = strchr(h, ']');
+        if (!end) return -1;
+        h++;
+        len = (size_t)(end - h);
+        p = end[1] == ':' ? end + 2 : NULL;
+    } else {
+        const char *colon = strrchr(h, ':');
+        len = colon ? (size_t)(colon - h) : strlen(h);
+        p = colon ? colon + 1 : NULL;
+    }
+    if (len == 0 || len >= host_size) return -1;
+    memcpy(host, h, len);
+    host[len] = '\0';
+    if (p && *p) {
+        snprintf(port, port_size, "%s", p);
+    } else {
+        snprintf(port, port_size, "%d", NET_SINK_DEFAULT_PORT);
+    }
+    return 0;
+}
+
+int net_sink_open(net_sink_t *sink, const char *uri, uint32_t sample_rate) {
+    memset(sink, 0, sizeof(net_sink_t));
+    sink->fd = -1;
+    sink->sample_rate = sample_rate;
+
+    char host[256], port[16];
+    if (parse_uri(uri, &sink->proto, host, sizeof(host), port, sizeof(port)) < 0) {
+        fprintf(stderr, "Invalid network sink URI: %s (tcp:host[:port] or udp:host[:port])\n", uri);
+        return -1;
+    }
+    sink->pace = sink->proto == NET_SINK_UDP ? NET_SINK_UDP_PACE : 0.0;
+
+    struct addrinfo hints = {
+        .ai_family = AF_UNSPEC,
+        .ai_socktype = sink->proto == NET_SINK_UDP ? SOCK_DGRAM : SOCK_STREAM
+    };
+    struct addrinfo *res = NULL;
+    int err = getaddrinfo(host, port, &hints, &res);
+    if (err != 0) {
+        fprintf(stderr, "Cannot resolve %s: %s\n", host, gai_strerror(err));
+        return -1;
+    }
+
+    for (struct addrinfo *ai = res; ai; ai = ai->ai_next) {
+        sink->fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (sink->fd < 0) continue;
+        // UDP: connect() fixes the peer so sendmmsg() needs no address
+        if (connect(sink->fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+        close(sink->fd);
+        sink->fd = -1;
+    }
+    freeaddrinfo(res);
+
+    if (sink->fd < 0) {
+        fprintf(stderr, "Cannot connect to %s:%s (%s): %s\n", host, port,
+                sink->proto == NET_SINK_UDP ? "udp" : "tcp", strerror(errno));
+        return -1;
+    }
+
+    if (sink->proto == NET_SINK_TCP) {
+        int one = 1;
+        setsockopt(sink->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+        if (setsockopt(sink->fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0) {
+            sink->zerocopy = 1;
+        }
+#endif
+    } else {
+        int sndbuf = 4 * 1024 * 1024;
+        setsockopt(sink->fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+    }
+
+    printf("✓ Network sink: %s:%s over %s%s\n", host, port,
+           sink->proto == NET_SINK_UDP ? "UDP (sendmmsg)" : "TCP",
+           sink->zerocopy ? " (MSG_ZEROCOPY)" : "");
+    return 0;
+}
+
+// =============================================================================
+// SENDING
+// =============================================================================
+
+static int reserve_headers(net_sink_t *sink, uint32_t packets) {
+    if (packets <= sink->header_capacity) return 0;
+    uint8_t *headers = mem_realloc(MEM_TX, sink->headers, (size_t)packets * NET_SINK_HEADER_SIZE);
+    if (!headers) {
+        fprintf(stderr, "Failed to allocate packet headers\n");
+        return -1;
+    }
+    sink->headers = headers;
+    sink->header_capacity = packets;
+    return 0;
+}
+
+static void pace(const net_sink_t *sink, const struct timespec *start, uint64_t samples) {
+    // Sleep until `samples` are due at pace × real time
+    if (sink->pace <= 0.0 || sink->sample_rate == 0) return;
+    double due = samples / (sink->sample_rate * sink->pace);
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double elapsed = (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) * 1e-9;
+    if (due > elapsed) {
+        double wait = due - elapsed;
+        struct timespec ts = { (time_t)wait, (long)((wait - (time_t)wait) * 1e9) };
+        nanosleep(&ts, NULL);
+    }
+}
+
+static int send_udp(net_sink_t *sink, const int16_t *iq, uint32_t packets, uint32_t samples) {
+    struct mmsghdr msgs[NET_SINK_BATCH];
+    struct iovec iov[NET_SINK_BATCH][2];
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (uint32_t first = 0; first < packets; ) {
+        uint32_t batch = packets - first < NET_SINK_BATCH ? packets - first : NET_SINK_BATCH;
+        for (uint32_t i = 0; i < batch; i++) {
+            uint32_t pkt = first + i;
+            uint32_t offset = pkt * NET_SINK_UDP_SAMPLES;
+            uint32_t n = samples - offset < NET_SINK_UDP_SAMPLES ? samples - offset : NET_SINK_UDP_SAMPLES;
+            iov[i][0] = (struct iovec) { &sink->headers[(size_t)pkt * NET_SINK_HEADER_SIZE], NET_SINK_HEADER_SIZE };
+            iov[i][1] = (struct iovec) { (void *)&iq[2 * (size_t)offset], (size_t)n * 4 };
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_iov = iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 2;
+        }
+
+        int sent = sendmmsg(sink->fd, msgs, batch, 0);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno != ECONNREFUSED && errno != ENOBUFS && errno != EAGAIN) {
+                fprintf(stderr, "UDP send failed: %s\n", strerror(errno));
+                return -1;
+            }
+            // No listener (ICMP refused) or full queue: the datagram is lost
+            sink->packets_dropped++;
+            sent = 1;
+        } else {
+            for (int i = 0; i < sent; i++) {
+                sink->bytes_sent += msgs[i].msg_len;
+            }
+            sink->packets_sent += (uint64_t)sent;
+        }
+        first += (uint32_t)sent;
+
+        uint32_t done = first * NET_SINK_UDP_SAMPLES;
+        pace(sink, &start, done < samples ? done : samples);
+    }
+    return 0;
+}
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+static int reap_zerocopy(net_sink_t *sink) {
+    // Completions arrive on the error queue as [ee_info, ee_data] ranges
+    while (sink->zc_completed != sink->zc_issued) {
+        struct pollfd pfd = { .fd = sink->fd, .events = 0 };
+        int ready = poll(&pfd, 1, NET_SINK_ZC_TIMEOUT_MS);
+        if (ready <= 0) {
+            if (ready < 0 && errno == EINTR) continue;
+            fprintf(stderr, "⚠ Zero-copy completions missing, falling back to copied sends\n");
+            sink->zerocopy = 0;
+            return -1;
+        }
+
+        char control[128];
+        struct msghdr msg = { .msg_control = control, .msg_controllen = sizeof(control) };
+        if (recvmsg(sink->fd, &msg, MSG_ERRQUEUE) < 0) {
+            if (errno == EAGAIN || errno == EINTR) continue;
+            fprintf(stderr, "Zero-copy completion read failed: %s\n", strerror(errno));
+            return -1;
+        }
+        for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            struct sock_extended_err *ee = (struct sock_extended_err *)CMSG_DATA(cm);
+            if (ee->ee_errno == 0 && ee->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+                sink->zc_completed += ee->ee_data - ee->ee_info + 1;
+            }
+        }
+    }
+    return 0;
+}
+#endif
+
+static int send_tcp(net_sink_t *sink, const int16_t *iq, uint32_t packets, uint32_t samples) {
+    for (uint32_t pkt = 0; pkt < packets; pkt++) {
+        uint32_t offset = pkt * NET_SINK_TCP_SAMPLES;
+        uint32_t n = samples - offset < NET_SINK_TCP_SAMPLES ? samples - offset : NET_SINK_TCP_SAMPLES;
+        struct iovec iov[2] = {
+            { &sink->headers[(size_t)pkt * NET_SINK_HEADER_SIZE], NET_SINK_HEADER_SIZE },
+            { (void *)&iq[2 * (size_t)offset], (size_t)n * 4 }
+        };
+        struct msghdr msg = { .msg_iov = iov, .msg_iovlen = 2 };
+
+        int flags = MSG_NOSIGNAL;
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+        if (sink->zerocopy) flags |= MSG_ZEROCOPY;
+#endif
+        size_t left = NET_SINK_HEADER_SIZE + (size_t)n * 4;
+        while (left > 0) {
+            ssize_t sent = sendmsg(sink->fd, &msg, flags);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                fprintf(stderr, "TCP send failed: %s\n", strerror(errno));
+                return -1;
+            }
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+            if (flags & MSG_ZEROCOPY) sink->zc_issued++;
+#endif
+            sink->bytes_sent += (uint64_t)sent;
+            left -= (size_t)sent;
+
+            // Partial send: skip what went out
+            while (sent > 0 && msg.msg_iovlen > 0) {
+                if ((size_t)sent >= msg.msg_iov[0].iov_len) {
+                    sent -= (ssize_t)msg.msg_iov[0].iov_len;
+                    msg.msg_iov++;
+                    msg.msg_iovlen--;
+                } else {
+                    msg.msg_iov[0].iov_base = (uint8_t *)msg.msg_iov[0].iov_base + sent;
+                    msg.msg_iov[0].iov_len -= (size_t)sent;
+                    sent = 0;
+                }
+            }
+        }
+        sink->packets_sent++;
+    }
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    if (sink->zerocopy && reap_zerocopy(sink) < 0) {
+        return sink->zerocopy ? -1 : 0;
+    }
+#endif
+    return 0;
+}
+
+int net_sink_send_burst(net_sink_t *sink, const int16_t *iq, uint32_t samples) {
+    if (sink->fd < 0 || samples == 0) {
+        fprintf(stderr, "Invalid parameters for network send\n");
+        return -1;
+    }
+
+    uint32_t per_packet = sink->proto == NET_SINK_UDP ? NET_SINK_UDP_SAMPLES : NET_SINK_TCP_SAMPLES;
+    uint32_t packets = (samples + per_packet - 1) / per_packet;
+    if (reserve_headers(sink, packets) < 0) {
+        return -1;
+    }
+
+    // All headers first: they must stay valid while zero-copy sends are pending
+    for (uint32_t pkt = 0; pkt < packets; pkt++) {
+        uint32_t offset = pkt * per_packet;
+        net_packet_header_t h = {
+            .flags = (uint16_t)((pkt == 0 ? NET_FLAG_BURST_START : 0) |
+                                (pkt == packets - 1 ? NET_FLAG_BURST_END : 0)),
+            .seq = sink->seq + pkt,
+            .burst = sink->burst,
+            .sample_index = sink->sample_index + offset,
+            .sample_rate = sink->sample_rate,
+            .samples = (uint16_t)(samples - offset < per_packet ? samples - offset : per_packet)
+        };
+        net_header_encode(&sink->headers[(size_t)pkt * NET_SINK_HEADER_SIZE], &h);
+    }
+
+    int ret = sink->proto == NET_SINK_UDP ? send_udp(sink, iq, packets, samples)
+                                          : send_tcp(sink, iq, packets, samples);
+    sink->seq += packets;
+    sink->burst++;
+    sink->sample_index += samples;
+    return ret < 0 ? -1 : (int)samples;
+}
+
+void net_sink_close(net_sink_t *sink) {
+    if (sink->fd >= 0) {
+        close(sink->fd);
+        sink->fd = -1;
+    }
+    mem_free(sink->headers);
+    sink->headers = NULL;
+    sink->header_capacity = 0;
+}
@@ -15,10 +15,13 @@
 #include "oqpsk_modulator.h"
 #include "prn_generator.h"
 #include "rrc_filter.h"
+#include "task_pool.h"
+#include "mem_account.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <pthread.h>
 
 // =============================================================================
 // CONSTANTS
@@ -26,11 +29,26 @@
 
 #define PREAMBLE_BITS       50      // T.018 preamble duration
 #define FRAME_TOTAL_BITS    300     // Preamble (50) + Data (250)
+#define SHAPE_GRAIN_CHIPS   1200    // Chips per pulse shaping task (32 tasks per frame)
+#define VERIFY_CHUNKS       32      // Verification partial results per burst
+
+// Half-sine pulse sin(π×n/SPS), shared read-only by all modulators
+static float half_sine_pulse[OQPSK_SAMPLES_PER_CHIP];
+static pthread_once_t pulse_once = PTHREAD_ONCE_INIT;
+
+// Concurrent renders share the debug chip dump file
+static pthread_mutex_t chip_dump_lock = PTHREAD_MUTEX_INITIALIZER;
 
 // =============================================================================
 // HELPER FUNCTIONS
 // =============================================================================
 
+static void build_pulse_table(void) {
+    for (int s = 0; s < OQPSK_SAMPLES_PER_CHIP; s++) {
+        half_sine_pulse[s] = sinf(M_PI * (float)s / (float)OQPSK_SAMPLES_PER_CHIP);
+    }
+}
+
 static float interpolate_chip(float prev_chip, float curr_chip, float fraction) {
     // Linear interpolation between chips
     return prev_chip + (curr_chip - prev_chip) * fraction;
@@ -137,6 +155,43 @@ uint32_t oqpsk_modulate_bit(uint8_t bit,
     return sample_idx;
 }
 
+// Chip range shaped by one task
+typedef struct {
+    const int8_t *i_prn;
+    const int8_t *q_prn;
+    float complex *iq_samples;
+    float normalization;
+    float complex rotation;
+} shape_ctx_t;
+
+/**
+ * @brief Shape the samples of chips [begin, end)
+ *
+ * Sample n carries the I pulse of chip n/SPS and the Q pulse of chip
+ * (n + SPS/2)/SPS (Q delayed by Tc/2). Each sample is computed with the
+ * same operations, in the same order, as the former channel-by-channel
+ * passes, so the output is bit-identical for any split.
+ */
+static void shape_chips(void *arg, uint32_t begin, uint32_t end) {
+    const shape_ctx_t *ctx = (const shape_ctx_t *)arg;
+    const uint32_t half = OQPSK_SAMPLES_PER_CHIP / 2;
+
+    for (uint32_t n = begin * OQPSK_SAMPLES_PER_CHIP; n < end * OQPSK_SAMPLES_PER_CHIP; n++) {
+        float complex v = 0.0f + I * 0.0f;
+        v += (float)ctx->i_prn[n / OQPSK_SAMPLES_PER_CHIP] *
+             half_sine_pulse[n % OQPSK_SAMPLES_PER_CHIP];
+
+        uint32_t q_chip = (n + half) / OQPSK_SAMPLES_PER_CHIP;
+        if (q_chip < PRN_FRAME_CHIPS) {
+            v += I * (float)ctx->q_prn[q_chip] * half_sine_pulse[(n + half) % OQPSK_SAMPLES_PER_CHIP];
+        }
+
+        v *= ctx->normalization;
+        v *= ctx->rotation;
+        ctx->iq_samples[n] = v;
+    }
+}
+
 uint32_t oqpsk_modulate_frame(const uint8_t *frame_bits,
                               float complex *iq_samples) {
     // Build complete transmission frame (50 preamble + 250 data)
@@ -156,37 +211,20 @@ uint32_t oqpsk_modulate_frame(const uint8_t *frame_bits,
 
     printf("Modulating T.018 frame (300 bits → 150 I + 150 Q)...\n");
 
-    // Initialize PRN generator
-    prn_state_t prn_state;
-    prn_init(&prn_state, 0);  // Normal mode
-
-    // Generate complete PRN sequences (150 bits × 256 chips = 38,400 chips each)
-    int8_t *i_prn = malloc(38400 * sizeof(int8_t));
-    int8_t *q_prn = malloc(38400 * sizeof(int8_t));
+    // Copy shared PRN tables (150 bits × 256 chips = 38,400 chips each)
+    int8_t *i_prn = mem_alloc(MEM_MODULATOR, PRN_FRAME_CHIPS * sizeof(int8_t));
+    int8_t *q_prn = mem_alloc(MEM_MODULATOR, PRN_FRAME_CHIPS * sizeof(int8_t));
 
     if (!i_prn || !q_prn) {
         fprintf(stderr, "Failed to allocate PRN buffers\n");
-        free(i_prn);
-        free(q_prn);
+        mem_free(i_prn);
+        mem_free(q_prn);
         return 0;
     }
 
-    // Generate I-channel PRN (38,400 chips)
-    int8_t i_chunk[PRN_CHIPS_PER_BIT];
-    for (int bit = 0; bit < 150; bit++) {
-        prn_generate_i(&prn_state, i_chunk);
-        memcpy(&i_prn[bit * PRN_CHIPS_PER_BIT], i_chunk, PRN_CHIPS_PER_BIT);
-    }
-
-    // Reset PRN state for Q channel
-    prn_init(&prn_state, 0);
-
-    // Generate Q-channel PRN (38,400 chips)
-    int8_t q_chunk[PRN_CHIPS_PER_BIT];
-    for (int bit = 0; bit < 150; bit++) {
-        prn_generate_q(&prn_state, q_chunk);
-        memcpy(&q_prn[bit * PRN_CHIPS_PER_BIT], q_chunk, PRN_CHIPS_PER_BIT);
-    }
+    memcpy(i_prn, prn_get_frame_table(0, 0), PRN_FRAME_CHIPS);  // Normal mode, I
+    memcpy(q_prn, prn_get_frame_table(0, 1), PRN_FRAME_CHIPS);  // Normal mode, Q
+    pthread_once(&pulse_once, build_pulse_table);
 
     // Apply DSSS spreading: XOR data bits with PRN
     // MATLAB/T.018 convention: bit=1 → INVERT PRN, bit=0 → KEEP PRN
@@ -203,6 +241,7 @@ uint32_t oqpsk_modulate_frame(const uint8_t *frame_bits,
     printf("  PRN sequences generated: 38,400 chips each (I and Q)\n");
 
     // DEBUG: Dump chips after spreading (before interpolation)
+    pthread_mutex_lock(&chip_dump_lock);
     FILE *chip_dump = fopen("chips_after_spreading.bin", "wb");
     if (chip_dump) {
         // Format: interleaved I/Q chips as int8_t
@@ -213,6 +252,7 @@ uint32_t oqpsk_modulate_frame(const uint8_t *frame_bits,
         fclose(chip_dump);
         printf("  [DEBUG] Chips dumped to chips_after_spreading.bin (76,800 bytes)\n");
     }
+    pthread_mutex_unlock(&chip_dump_lock);
 
     // Generate I/Q samples with OQPSK (Q delayed by Tc/2)
     // OQPSK: Q channel is delayed by half a chip period (Tc/2)
@@ -220,75 +260,28 @@ uint32_t oqpsk_modulate_frame(const uint8_t *frame_bits,
     int q_delay_samples = OQPSK_SAMPLES_PER_CHIP / 2;  // 8 samples for SPS=16
     uint32_t total_samples = 38400 * OQPSK_SAMPLES_PER_CHIP;  // Exact: 614,400 samples
 
-    // Initialize all samples to zero
-    for (uint32_t i = 0; i < total_samples; i++) {
-        iq_samples[i] = 0.0f + I * 0.0f;
-    }
-
     printf("  Applying half-sine pulse shaping (MATLAB compatible)...\n");
 
-    // Generate I-channel with half-sine pulse shaping (no delay)
-    for (int chip_idx = 0; chip_idx < 38400; chip_idx++) {
-        float chip_val = (float)i_prn[chip_idx];
-        int start_sample = chip_idx * OQPSK_SAMPLES_PER_CHIP;
-
-        // Apply half-sine pulse: sin(π×n/SPS) for n = 0..SPS-1
-        for (int s = 0; s < OQPSK_SAMPLES_PER_CHIP; s++) {
-            float pulse_val = sinf(M_PI * (float)s / (float)OQPSK_SAMPLES_PER_CHIP);
-            iq_samples[start_sample + s] += chip_val * pulse_val;
-        }
-
-        // Progress indicator every 5000 chips
-        if ((chip_idx + 1) % 5000 == 0) {
-            printf("  I-channel: %d/38400 chips (samples: %u)\n",
-                   chip_idx + 1, start_sample + OQPSK_SAMPLES_PER_CHIP);
-        }
-    }
-
-    // Generate Q-channel with half-sine pulse shaping (delayed by Tc/2)
-    for (int chip_idx = 0; chip_idx < 38400; chip_idx++) {
-        float chip_val = (float)q_prn[chip_idx];
-        int start_sample = chip_idx * OQPSK_SAMPLES_PER_CHIP - q_delay_samples;
-
-        // Apply half-sine pulse: sin(π×n/SPS) for n = 0..SPS-1
-        for (int s = 0; s < OQPSK_SAMPLES_PER_CHIP; s++) {
-            int sample_idx = start_sample + s;
-            if (sample_idx >= 0 && sample_idx < total_samples) {
-                float pulse_val = sinf(M_PI * (float)s / (float)OQPSK_SAMPLES_PER_CHIP);
-                iq_samples[sample_idx] += I * chip_val * pulse_val;
-            }
-        }
-
-        // Progress indicator every 5000 chips
-        if ((chip_idx + 1) % 5000 == 0) {
-            printf("  Q-channel: %d/38400 chips\n", chip_idx + 1);
-        }
-    }
+    // Chip ranges are independent: shaping, normalization and rotation run
+    // as one pass per range on the shared task pool
+    shape_ctx_t shape = {
+        .i_prn = i_prn,
+        .q_prn = q_prn,
+        .iq_samples = iq_samples,
+        .normalization = 1.0f / sqrtf(2.0f),
+        .rotation = cexpf(I * M_PI / 4.0f),
+    };
+    task_pool_parallel_for(task_pool_default(), 0, PRN_FRAME_CHIPS, SHAPE_GRAIN_CHIPS,
+                           shape_chips, &shape);
 
     printf("  ✓ Half-sine pulse shaping applied\n");
     printf("  [DEBUG] Total samples generated: %u (OQPSK with Tc/2=%d samples delay)\n",
            total_samples, q_delay_samples);
-
-    // Normalize amplitude to match demodulator AGC expectations
-    // Signal has amplitude √2 (I=±1, Q=±1) → power = 2.0
-    // Demodulator AGC normalizes to power = 1.0 → amplitude = 1.0
-    // Divide by √2 to get amplitude = 1.0 (power = 1.0)
-    float normalization = 1.0f / sqrtf(2.0f);
-    for (uint32_t i = 0; i < total_samples; i++) {
-        iq_samples[i] *= normalization;
-    }
     printf("  [NORM] Signal normalized by 1/√2 for AGC compatibility (power=1.0)\n");
-
-    // Apply π/4 QPSK rotation (required by T.018 demodulator)
-    // Multiply by exp(jπ/4) = (1+j)/√2 = 0.7071 + j0.7071
-    float complex rotation = cexpf(I * M_PI / 4.0f);
-    for (uint32_t i = 0; i < total_samples; i++) {
-        iq_samples[i] *= rotation;
-    }
     printf("  [ROT] π/4 rotation applied for OQPSK constellation\n");
 
-    free(i_prn);
-    free(q_prn);
+    mem_free(i_prn);
+    mem_free(q_prn);
 
     printf("✓ Modulation complete: %u samples generated\n", total_samples);
 
@@ -327,28 +320,87 @@ uint32_t oqpsk_modulate_frame(const uint8_t *frame_bits,
 // VERIFICATION
 // =============================================================================
 
+// Per-chunk verification results
+typedef struct {
+    const float complex *iq_samples;
+    uint32_t num_samples;
+    float max_i[VERIFY_CHUNKS], min_i[VERIFY_CHUNKS];
+    float max_q[VERIFY_CHUNKS], min_q[VERIFY_CHUNKS];
+    float power[VERIFY_CHUNKS];             // Sum of |x|² over the chunk
+    uint32_t invalid[VERIFY_CHUNKS];        // First NaN/Inf index (num_samples = none)
+} verify_ctx_t;
+
+static void verify_chunks(void *arg, uint32_t begin, uint32_t end) {
+    verify_ctx_t *ctx = (verify_ctx_t *)arg;
+    uint32_t chunk_len = (ctx->num_samples + VERIFY_CHUNKS - 1) / VERIFY_CHUNKS;
+
+    for (uint32_t c = begin; c < end; c++) {
+        float max_i = 0.0f, max_q = 0.0f;
+        float min_i = 0.0f, min_q = 0.0f;
+        float power = 0.0f;
+        uint32_t invalid = ctx->num_samples;
+        uint32_t first = c * chunk_len;
+        uint32_t last = (first + chunk_len < ctx->num_samples) ? first + chunk_len : ctx->num_samples;
+
+        for (uint32_t i = first; i < last; i++) {
+            float i_val = crealf(ctx->iq_samples[i]);
+            float q_val = cimagf(ctx->iq_samples[i]);
+
+            if (i_val > max_i) max_i = i_val;
+            if (i_val < min_i) min_i = i_val;
+            if (q_val > max_q) max_q = q_val;
+            if (q_val < min_q) min_q = q_val;
+            power += (i_val * i_val + q_val * q_val);
+
+            if (isnan(i_val) || isnan(q_val) || isinf(i_val) || isinf(q_val)) {
+                invalid = i;
+                break;
+            }
+        }
+        ctx->max_i[c] = max_i;
+        ctx->min_i[c] = min_i;
+        ctx->max_q[c] = max_q;
+        ctx->min_q[c] = min_q;
+        ctx->power[c] = power;
+        ctx->invalid[c] = invalid;
+    }
+}
+
 uint8_t oqpsk_verify_output(const float complex *iq_samples, uint32_t num_samples) {
     printf("Verifying OQPSK output...\n");
 
+    // Range, validity and power in one pass over fixed chunks; partial
+    // results are combined in chunk order, independent of the thread count
+    verify_ctx_t *ctx = mem_alloc(MEM_MODULATOR, sizeof(verify_ctx_t));
+    if (!ctx) {
+        fprintf(stderr, "Failed to allocate verification state\n");
+        return 0;
+    }
+    ctx->iq_samples = iq_samples;
+    ctx->num_samples = num_samples;
+    task_pool_parallel_for(task_pool_default(), 0, VERIFY_CHUNKS, 1, verify_chunks, ctx);
+
     // Check for valid range (I and Q should be ±1 with interpolation)
     float max_i = 0.0f, max_q = 0.0f;
     float min_i = 0.0f, min_q = 0.0f;
+    float avg_power = 0.0f;
 
-    for (uint32_t i = 0; i < num_samples; i++) {
-        float i_val = crealf(iq_samples[i]);
-        float q_val = cimagf(iq_samples[i]);
-
-        if (i_val > max_i) max_i = i_val;
-        if (i_val < min_i) min_i = i_val;
-        if (q_val > max_q) max_q = q_val;
-        if (q_val < min_q) min_q = q_val;
-
+    for (uint32_t c = 0; c < VERIFY_CHUNKS; c++) {
         // Check for invalid values
-        if (isnan(i_val) || isnan(q_val) || isinf(i_val) || isinf(q_val)) {
-            printf("✗ Invalid sample at index %u: I=%f, Q=%f\n", i, i_val, q_val);
+        if (ctx->invalid[c] < num_samples) {
+            uint32_t i = ctx->invalid[c];
+            printf("✗ Invalid sample at index %u: I=%f, Q=%f\n", i,
+                   crealf(iq_samples[i]), cimagf(iq_samples[i]));
+            mem_free(ctx);
             return 0;
         }
+        if (ctx->max_i[c] > max_i) max_i = ctx->max_i[c];
+        if (ctx->min_i[c] < min_i) min_i = ctx->min_i[c];
+        if (ctx->max_q[c] > max_q) max_q = ctx->max_q[c];
+        if (ctx->min_q[c] < min_q) min_q = ctx->min_q[c];
+        avg_power += ctx->power[c];
     }
+    mem_free(ctx);
 
     printf("  I range: [%.3f, %.3f]\n", min_i, max_i);
     printf("  Q range: [%.3f, %.3f]\n", min_q, max_q);
@@ -359,13 +411,7 @@ uint8_t oqpsk_verify_output(const float complex *iq_samples, uint32_t num_sample
         return 0;
     }
 
-    // Calculate average power
-    float avg_power = 0.0f;
-    for (uint32_t i = 0; i < num_samples; i++) {
-        float i_val = crealf(iq_samples[i]);
-        float q_val = cimagf(iq_samples[i]);
-        avg_power += (i_val * i_val + q_val * q_val);
-    }
+    // Average power
     avg_power /= num_samples;
 
     printf("  Average power: %.3f\n", avg_power);
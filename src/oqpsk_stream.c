@@ -0,0 +1,243 @@
+/**
+ * @file oqpsk_stream.c
+ * @brief Static-memory, integer-only streaming OQPSK modulator implementation
+ *
+ * Per sample: one table row per half chip (copied as a run of up to 32
+ * samples), one LFSR step per chip and channel. Nothing here needs an FPU,
+ * a heap or libc, so the file builds unchanged for Cortex-M and the host.
+ */
+
+#include "oqpsk_stream.h"
+#include "prn_generator.h"
+
+#define HALF_CHIP           (OQPSK_STREAM_SPS / 2)  // Q channel delay (Tc/2)
+#define LFSR_MASK           0x7FFFFF
+
+// =============================================================================
+// SAMPLE TABLES
+// =============================================================================
+// Interleaved I/Q of the float waveform (half-sine pulses, 1/√2, π/4
+// rotation) truncated like pluto_convert_ci16(), indexed by chip logic
+// values (1 = -1). Do not edit: regenerate with tools/oqpsk_stream_test -g.
+
+// BEGIN GENERATED TABLES
+static const int16_t q11_table[2][2][OQPSK_STREAM_SPS][2] = {
+    {
+        { // I chip +1, Q chip +1
+            { -1023,  1023}, {  -972,  1072}, {  -918,  1118}, {  -862,  1162}, {  -804,  1203}, {  -744,  1241}, {  -682,  1276}, {  -618,  1308},
+            {  -553,  1337}, {  -487,  1362}, {  -420,  1385}, {  -351,  1404}, {  -282,  1419}, {  -212,  1431}, {  -141,  1440}, {   -71,  1445},
+            {     0,  1447}, {    71,  1445}, {   141,  1440}, {   212,  1431}, {   282,  1419}, {   351,  1404}, {   420,  1385}, {   487,  1362},
+            {   553,  1337}, {   618,  1308}, {   682,  1276}, {   744,  1241}, {   804,  1203}, {   862,  1162}, {   918,  1118}, {   972,  1072},
+            {  1023,  1023}, {   972,  1072}, {   918,  1118}, {   862,  1162}, {   804,  1203}, {   744,  1241}, {   682,  1276}, {   618,  1308},
+            {   553,  1337}, {   487,  1362}, {   420,  1385}, {   351,  1404}, {   282,  1419}, {   212,  1431}, {   141,  1440}, {    71,  1445},
+            {     0,  1447}, {   -71,  1445}, {  -141,  1440}, {  -212,  1431}, {  -282,  1419}, {  -351,  1404}, {  -420,  1385}, {  -487,  1362},
+            {  -553,  1337}, {  -618,  1308}, {  -682,  1276}, {  -744,  1241}, {  -804,  1203}, {  -862,  1162}, {  -918,  1118}, {  -972,  1072}
+        },
+        { // I chip +1, Q chip -1
+            {  1023, -1023}, {  1072,  -972}, {  1118,  -918}, {  1162,  -862}, {  1203,  -804}, {  1241,  -744}, {  1276,  -682}, {  1308,  -618},
+            {  1337,  -553}, {  1362,  -487}, {  1385,  -420}, {  1404,  -351}, {  1419,  -282}, {  1431,  -212}, {  1440,  -141}, {  1445,   -71},
+            {  1447,     0}, {  1445,    71}, {  1440,   141}, {  1431,   212}, {  1419,   282}, {  1404,   351}, {  1385,   420}, {  1362,   487},
+            {  1337,   553}, {  1308,   618}, {  1276,   682}, {  1241,   744}, {  1203,   804}, {  1162,   862}, {  1118,   918}, {  1072,   972},
+            {  1023,  1023}, {  1072,   972}, {  1118,   918}, {  1162,   862}, {  1203,   804}, {  1241,   744}, {  1276,   682}, {  1308,   618},
+            {  1337,   553}, {  1362,   487}, {  1385,   420}, {  1404,   351}, {  1419,   282}, {  1431,   212}, {  1440,   141}, {  1445,    71},
+            {  1447,     0}, {  1445,   -71}, {  1440,  -141}, {  1431,  -212}, {  1419,  -282}, {  1404,  -351}, {  1385,  -420}, {  1362,  -487},
+            {  1337,  -553}, {  1308,  -618}, {  1276,  -682}, {  1241,  -744}, {  1203,  -804}, {  1162,  -862}, {  1118,  -918}, {  1072,  -972}
+        }
+    },
+    {
+        { // I chip -1, Q chip +1
+            { -1023,  1023}, { -1072,   972}, { -1118,   918}, { -1162,   862}, { -1203,   804}, { -1241,   744}, { -1276,   682}, { -1308,   618},
+            { -1337,   553}, { -1362,   487}, { -1385,   420}, { -1404,   351}, { -1419,   282}, { -1431,   212}, { -1440,   141}, { -1445,    71},
+            { -1447,     0}, { -1445,   -71}, { -1440,  -141}, { -1431,  -212}, { -1419,  -282}, { -1404,  -351}, { -1385,  -420}, { -1362,  -487},
+            { -1337,  -553}, { -1308,  -618}, { -1276,  -682}, { -1241,  -744}, { -1203,  -804}, { -1162,  -862}, { -1118,  -918}, { -1072,  -972},
+            { -1023, -1023}, { -1072,  -972}, { -1118,  -918}, { -1162,  -862}, { -1203,  -804}, { -1241,  -744}, { -1276,  -682}, { -1308,  -618},
+            { -1337,  -553}, { -1362,  -487}, { -1385,  -420}, { -1404,  -351}, { -1419,  -282}, { -1431,  -212}, { -1440,  -141}, { -1445,   -71},
+            { -1447,     0}, { -1445,    71}, { -1440,   141}, { -1431,   212}, { -1419,   282}, { -1404,   351}, { -1385,   420}, { -1362,   487},
+            { -1337,   553}, { -1308,   618}, { -1276,   682}, { -1241,   744}, { -1203,   804}, { -1162,   862}, { -1118,   918}, { -1072,   972}
+        },
+        { // I chip -1, Q chip -1
+            {  1023, -1023}, {   972, -1072}, {   918, -1118}, {   862, -1162}, {   804, -1203}, {   744, -1241}, {   682, -1276}, {   618, -1308},
+            {   553, -1337}, {   487, -1362}, {   420, -1385}, {   351, -1404}, {   282, -1419}, {   212, -1431}, {   141, -1440}, {    71, -1445},
+            {     0, -1447}, {   -71, -1445}, {  -141, -1440}, {  -212, -1431}, {  -282, -1419}, {  -351, -1404}, {  -420, -1385}, {  -487, -1362},
+            {  -553, -1337}, {  -618, -1308}, {  -682, -1276}, {  -744, -1241}, {  -804, -1203}, {  -862, -1162}, {  -918, -1118}, {  -972, -1072},
+            { -1023, -1023}, {  -972, -1072}, {  -918, -1118}, {  -862, -1162}, {  -804, -1203}, {  -744, -1241}, {  -682, -1276}, {  -618, -1308},
+            {  -553, -1337}, {  -487, -1362}, {  -420, -1385}, {  -351, -1404}, {  -282, -1419}, {  -212, -1431}, {  -141, -1440}, {   -71, -1445},
+            {     0, -1447}, {    71, -1445}, {   141, -1440}, {   212, -1431}, {   282, -1419}, {   351, -1404}, {   420, -1385}, {   487, -1362},
+            {   553, -1337}, {   618, -1308}, {   682, -1276}, {   744, -1241}, {   804, -1203}, {   862, -1162}, {   918, -1118}, {   972, -1072}
+        }
+    }
+};
+static const int16_t q11_tail[2][HALF_CHIP][2] = {
+    { // I chip +1
+        {  1023,  1023}, {  1022,  1022}, {  1018,  1018}, {  1012,  1012}, {  1003,  1003}, {   992,   992}, {   979,   979}, {   963,   963},
+        {   945,   945}, {   925,   925}, {   902,   902}, {   877,   877}, {   851,   851}, {   822,   822}, {   791,   791}, {   758,   758},
+        {   723,   723}, {   687,   687}, {   649,   649}, {   609,   609}, {   568,   568}, {   526,   526}, {   482,   482}, {   437,   437},
+        {   391,   391}, {   344,   344}, {   297,   297}, {   248,   248}, {   199,   199}, {   150,   150}, {   100,   100}, {    50,    50}
+    },
+    { // I chip -1
+        { -1023, -1023}, { -1022, -1022}, { -1018, -1018}, { -1012, -1012}, { -1003, -1003}, {  -992,  -992}, {  -979,  -979}, {  -963,  -963},
+        {  -945,  -945}, {  -925,  -925}, {  -902,  -902}, {  -877,  -877}, {  -851,  -851}, {  -822,  -822}, {  -791,  -791}, {  -758,  -758},
+        {  -723,  -723}, {  -687,  -687}, {  -649,  -649}, {  -609,  -609}, {  -568,  -568}, {  -526,  -526}, {  -482,  -482}, {  -437,  -437},
+        {  -391,  -391}, {  -344,  -344}, {  -297,  -297}, {  -248,  -248}, {  -199,  -199}, {  -150,  -150}, {  -100,  -100}, {   -50,   -50}
+    }
+};
+static const int16_t q15_table[2][2][OQPSK_STREAM_SPS][2] = {
+    {
+        { // I chip +1, Q chip +1
+            {-16383, 16383}, {-15559, 17167}, {-14698, 17910}, {-13802, 18610}, {-12872, 19264}, {-11911, 19873}, {-10922, 20433}, { -9906, 20945},
+            { -8866, 21406}, { -7805, 21815}, { -6725, 22172}, { -5629, 22475}, { -4520, 22724}, { -3399, 22918}, { -2271, 23058}, { -1136, 23141},
+            {     0, 23169}, {  1136, 23141}, {  2271, 23058}, {  3399, 22918}, {  4520, 22724}, {  5629, 22475}, {  6725, 22172}, {  7805, 21815},
+            {  8866, 21406}, {  9906, 20945}, { 10922, 20433}, { 11911, 19873}, { 12872, 19264}, { 13802, 18610}, { 14698, 17910}, { 15559, 17167},
+            { 16383, 16383}, { 15559, 17167}, { 14698, 17910}, { 13802, 18610}, { 12872, 19264}, { 11911, 19873}, { 10922, 20433}, {  9906, 20945},
+            {  8866, 21406}, {  7805, 21815}, {  6725, 22172}, {  5629, 22475}, {  4520, 22724}, {  3399, 22918}, {  2271, 23058}, {  1136, 23141},
+            {     0, 23169}, { -1136, 23141}, { -2271, 23058}, { -3399, 22918}, { -4520, 22724}, { -5629, 22475}, { -6725, 22172}, { -7805, 21815},
+            { -8866, 21406}, { -9906, 20945}, {-10922, 20433}, {-11911, 19873}, {-12872, 19264}, {-13802, 18610}, {-14698, 17910}, {-15559, 17167}
+        },
+        { // I chip +1, Q chip -1
+            { 16383,-16383}, { 17167,-15559}, { 17910,-14698}, { 18610,-13802}, { 19264,-12872}, { 19873,-11911}, { 20433,-10922}, { 20945, -9906},
+            { 21406, -8866}, { 21815, -7805}, { 22172, -6725}, { 22475, -5629}, { 22724, -4520}, { 22918, -3399}, { 23058, -2271}, { 23141, -1136},
+            { 23169,     0}, { 23141,  1136}, { 23058,  2271}, { 22918,  3399}, { 22724,  4520}, { 22475,  5629}, { 22172,  6725}, { 21815,  7805},
+            { 21406,  8866}, { 20945,  9906}, { 20433, 10922}, { 19873, 11911}, { 19264, 12872}, { 18610, 13802}, { 17910, 14698}, { 17167, 15559},
+            { 16383, 16383}, { 17167, 15559}, { 17910, 14698}, { 18610, 13802}, { 19264, 12872}, { 19873, 11911}, { 20433, 10922}, { 20945,  9906},
+            { 21406,  8866}, { 21815,  7805}, { 22172,  6725}, { 22475,  5629}, { 22724,  4520}, { 22918,  3399}, { 23058,  2271}, { 23141,  1136},
+            { 23169,     0}, { 23141, -1136}, { 23058, -2271}, { 22918, -3399}, { 22724, -4520}, { 22475, -5629}, { 22172, -6725}, { 21815, -7805},
+            { 21406, -8866}, { 20945, -9906}, { 20433,-10922}, { 19873,-11911}, { 19264,-12872}, { 18610,-13802}, { 17910,-14698}, { 17167,-15559}
+        }
+    },
+    {
+        { // I chip -1, Q chip +1
+            {-16383, 16383}, {-17167, 15559}, {-17910, 14698}, {-18610, 13802}, {-19264, 12872}, {-19873, 11911}, {-20433, 10922}, {-20945,  9906},
+            {-21406,  8866}, {-21815,  7805}, {-22172,  6725}, {-22475,  5629}, {-22724,  4520}, {-22918,  3399}, {-23058,  2271}, {-23141,  1136},
+            {-23169,     0}, {-23141, -1136}, {-23058, -2271}, {-22918, -3399}, {-22724, -4520}, {-22475, -5629}, {-22172, -6725}, {-21815, -7805},
+            {-21406, -8866}, {-20945, -9906}, {-20433,-10922}, {-19873,-11911}, {-19264,-12872}, {-18610,-13802}, {-17910,-14698}, {-17167,-15559},
+            {-16383,-16383}, {-17167,-15559}, {-17910,-14698}, {-18610,-13802}, {-19264,-12872}, {-19873,-11911}, {-20433,-10922}, {-20945, -9906},
+            {-21406, -8866}, {-21815, -7805}, {-22172, -6725}, {-22475, -5629}, {-22724, -4520}, {-22918, -3399}, {-23058, -2271}, {-23141, -1136},
+            {-23169,     0}, {-23141,  1136}, {-23058,  2271}, {-22918,  3399}, {-22724,  4520}, {-22475,  5629}, {-22172,  6725}, {-21815,  7805},
+            {-21406,  8866}, {-20945,  9906}, {-20433, 10922}, {-19873, 11911}, {-19264, 12872}, {-18610, 13802}, {-17910, 14698}, {-17167, 15559}
+        },
+        { // I chip -1, Q chip -1
+            { 16383,-16383}, { 15559,-17167}, { 14698,-17910}, { 13802,-18610}, { 12872,-19264}, { 11911,-19873}, { 10922,-20433}, {  9906,-20945},
+            {  8866,-21406}, {  7805,-21815}, {  6725,-22172}, {  5629,-22475}, {  4520,-22724}, {  3399,-22918}, {  2271,-23058}, {  1136,-23141},
+            {     0,-23169}, { -1136,-23141}, { -2271,-23058}, { -3399,-22918}, { -4520,-22724}, { -5629,-22475}, { -6725,-22172}, { -7805,-21815},
+            { -8866,-21406}, { -9906,-20945}, {-10922,-20433}, {-11911,-19873}, {-12872,-19264}, {-13802,-18610}, {-14698,-17910}, {-15559,-17167},
+            {-16383,-16383}, {-15559,-17167}, {-14698,-17910}, {-13802,-18610}, {-12872,-19264}, {-11911,-19873}, {-10922,-20433}, { -9906,-20945},
+            { -8866,-21406}, { -7805,-21815}, { -6725,-22172}, { -5629,-22475}, { -4520,-22724}, { -3399,-22918}, { -2271,-23058}, { -1136,-23141},
+            {     0,-23169}, {  1136,-23141}, {  2271,-23058}, {  3399,-22918}, {  4520,-22724}, {  5629,-22475}, {  6725,-22172}, {  7805,-21815},
+            {  8866,-21406}, {  9906,-20945}, { 10922,-20433}, { 11911,-19873}, { 12872,-19264}, { 13802,-18610}, { 14698,-17910}, { 15559,-17167}
+        }
+    }
+};
+static const int16_t q15_tail[2][HALF_CHIP][2] = {
+    { // I chip +1
+        { 16383, 16383}, { 16363, 16363}, { 16304, 16304}, { 16206, 16206}, { 16068, 16068}, { 15892, 15892}, { 15678, 15678}, { 15425, 15425},
+        { 15136, 15136}, { 14810, 14810}, { 14448, 14448}, { 14052, 14052}, { 13622, 13622}, { 13159, 13159}, { 12664, 12664}, { 12139, 12139},
+        { 11584, 11584}, { 11002, 11002}, { 10393, 10393}, {  9759,  9759}, {  9102,  9102}, {  8422,  8422}, {  7723,  7723}, {  7004,  7004},
+        {  6269,  6269}, {  5519,  5519}, {  4755,  4755}, {  3980,  3980}, {  3196,  3196}, {  2403,  2403}, {  1605,  1605}, {   803,   803}
+    },
+    { // I chip -1
+        {-16383,-16383}, {-16363,-16363}, {-16304,-16304}, {-16206,-16206}, {-16068,-16068}, {-15892,-15892}, {-15678,-15678}, {-15425,-15425},
+        {-15136,-15136}, {-14810,-14810}, {-14448,-14448}, {-14052,-14052}, {-13622,-13622}, {-13159,-13159}, {-12664,-12664}, {-12139,-12139},
+        {-11584,-11584}, {-11002,-11002}, {-10393,-10393}, { -9759, -9759}, { -9102, -9102}, { -8422, -8422}, { -7723, -7723}, { -7004, -7004},
+        { -6269, -6269}, { -5519, -5519}, { -4755, -4755}, { -3980, -3980}, { -3196, -3196}, { -2403, -2403}, { -1605, -1605}, {  -803,  -803}
+    }
+};
+// END GENERATED TABLES
+
+const int16_t (*oqpsk_stream_table(oqpsk_stream_format_t format,
+                                   const int16_t (**tail)[HALF_CHIP][2]))[2][OQPSK_STREAM_SPS][2] {
+    *tail = (format == OQPSK_STREAM_Q15) ? q15_tail : q11_tail;
+    return (format == OQPSK_STREAM_Q15) ? q15_table : q11_table;
+}
+
+// =============================================================================
+// CHIP GENERATION
+// =============================================================================
+
+static inline uint8_t tx_bit(const oqpsk_stream_t *s, uint32_t index) {
+    return (s->tx_bits[index >> 3] >> (7 - (index & 7))) & 1;
+}
+
+// Next chip of one channel: LFSR output X0 (logic 1 = -1) inverted by the
+// data bit, then one LFSR step (x^23 + x^18 + 1, as prn_generator.c)
+static inline uint8_t next_chip(const oqpsk_stream_t *s, uint32_t *lfsr,
+                                uint32_t chip, uint32_t channel) {
+    uint8_t logic = (uint8_t)((*lfsr & 1) ^ tx_bit(s, 2 * (chip / PRN_CHIPS_PER_BIT) + channel));
+    uint32_t feedback = (*lfsr ^ (*lfsr >> 18)) & 1;
+    *lfsr = ((*lfsr >> 1) | (feedback << 22)) & LFSR_MASK;
+    return logic;
+}
+
+// =============================================================================
+// STREAMING
+// =============================================================================
+
+void oqpsk_stream_init(oqpsk_stream_t *s, const uint8_t *frame_bits,
+                       uint8_t prn_mode, oqpsk_stream_format_t format) {
+    // Preamble zeros, then the first 250 frame bits (odd → I, even → Q)
+    for (uint32_t i = 0; i < OQPSK_STREAM_FRAME_BYTES; i++) {
+        s->tx_bits[i] = 0;
+    }
+    for (uint32_t i = 0; i < OQPSK_STREAM_TX_BITS - OQPSK_STREAM_PREAMBLE_BITS; i++) {
+        if (frame_bits[i]) {
+            uint32_t index = OQPSK_STREAM_PREAMBLE_BITS + i;
+            s->tx_bits[index >> 3] |= (uint8_t)(0x80 >> (index & 7));
+        }
+    }
+
+    s->lfsr_i = prn_mode ? PRN_INIT_TEST_I : PRN_INIT_NORMAL_I;
+    s->lfsr_q = prn_mode ? PRN_INIT_TEST_Q : PRN_INIT_NORMAL_Q;
+    s->sample = 0;
+    s->next_i = 0;
+    s->next_q = 0;
+    s->format = (uint8_t)format;
+
+    // Q chip 0 covers samples 0..31; I chip 0 is loaded at sample 0
+    s->chip_i = 0;
+    s->chip_q = next_chip(s, &s->lfsr_q, s->next_q++, 1);
+}
+
+uint32_t oqpsk_stream_read(oqpsk_stream_t *s, int16_t *buf, uint32_t max_samples) {
+    const int16_t (*tail)[HALF_CHIP][2];
+    const int16_t (*table)[2][OQPSK_STREAM_SPS][2] = oqpsk_stream_table((oqpsk_stream_format_t)s->format, &tail);
+    uint32_t done = 0;
+
+    while (done < max_samples && s->sample < OQPSK_STREAM_SAMPLES) {
+        uint32_t phase = s->sample % OQPSK_STREAM_SPS;
+
+        // Chip boundaries: I at phase 0, Q half a chip later
+        if (phase == 0) {
+            s->chip_i = next_chip(s, &s->lfsr_i, s->next_i++, 0);
+        } else if (phase == HALF_CHIP) {
+            s->chip_q = (s->next_q < OQPSK_STREAM_CHIPS) ? next_chip(s, &s->lfsr_q, s->next_q++, 1)
+                                                         : OQPSK_STREAM_NO_CHIP;
+        }
+
+        // Both chips hold until the next boundary
+        uint32_t run = HALF_CHIP - phase % HALF_CHIP;
+        if (run > max_samples - done) run = max_samples - done;
+
+        const int16_t *src = (s->chip_q == OQPSK_STREAM_NO_CHIP) ? tail[s->chip_i][phase - HALF_CHIP]
+                                                                 : table[s->chip_i][s->chip_q][phase];
+        int16_t *dst = &buf[2 * done];
+        for (uint32_t k = 0; k < 2 * run; k++) {
+            dst[k] = src[k];
+        }
+
+        s->sample += run;
+        done += run;
+    }
+
+    return done;
+}
+
+int oqpsk_stream_run(oqpsk_stream_t *s, int16_t *buf, uint32_t chunk_samples,
+                     oqpsk_stream_sink_t sink, void *ctx) {
+    if (chunk_samples == 0) return -1;
+
+    uint32_t n;
+    while ((n = oqpsk_stream_read(s, buf, chunk_samples)) > 0) {
+        int rc = sink(ctx, buf, n);
+        if (rc != 0) return rc;
+    }
+    return 0;
+}
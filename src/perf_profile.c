@@ -0,0 +1,222 @@
+/**
+ * @file perf_profile.c
+ * @brief perf_event_open stage profiler implementation
+ *
+ * The group runs continuously; each stage takes a snapshot at begin and
+ * accumulates the difference at end. Reading the whole group in one read()
+ * keeps the counters consistent with each other. When the kernel
+ * multiplexes the group (more events than PMU counters) values are scaled
+ * by time_enabled / time_running.
+ */
+
+#include "perf_profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static const struct {
+    uint64_t config;
+    const char *name;
+} perf_events[PERF_EV_COUNT] = {
+    [PERF_EV_CYCLES]        = { PERF_COUNT_HW_CPU_CYCLES,          "cycles" },
+    [PERF_EV_INSTRUCTIONS]  = { PERF_COUNT_HW_INSTRUCTIONS,        "instructions" },
+    [PERF_EV_CACHE_REFS]    = { PERF_COUNT_HW_CACHE_REFERENCES,    "cache-references" },
+    [PERF_EV_CACHE_MISSES]  = { PERF_COUNT_HW_CACHE_MISSES,        "cache-misses" },
+    [PERF_EV_BRANCHES]      = { PERF_COUNT_HW_BRANCH_INSTRUCTIONS, "branches" },
+    [PERF_EV_BRANCH_MISSES] = { PERF_COUNT_HW_BRANCH_MISSES,       "branch-misses" },
+};
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static double monotonic_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int open_event(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;        // Allowed with perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Calling thread, any CPU
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static void read_sample(const perf_profile_t *prof, perf_sample_t *sample) {
+    memset(sample, 0, sizeof(perf_sample_t));
+    sample->wall_sec = monotonic_sec();
+
+    if (!prof->available) return;
+
+    // { nr, time_enabled, time_running, value[nr] }
+    uint64_t buf[3 + PERF_EV_COUNT];
+    if (read(prof->fds[PERF_EV_CYCLES], buf, sizeof(buf)) < (ssize_t)(3 * sizeof(uint64_t))) {
+        return;
+    }
+
+    // Scale for multiplexing
+    double scale = (buf[2] > 0) ? (double)buf[1] / (double)buf[2] : 1.0;
+    for (int e = 0; e < PERF_EV_COUNT; e++) {
+        if (prof->group_index[e] >= 0 && (uint64_t)prof->group_index[e] < buf[0]) {
+            sample->values[e] = (uint64_t)(buf[3 + prof->group_index[e]] * scale);
+        }
+    }
+}
+
+// =============================================================================
+// INITIALIZATION
+// =============================================================================
+
+int perf_profile_init(perf_profile_t *prof) {
+    memset(prof, 0, sizeof(perf_profile_t));
+    prof->current = -1;
+    for (int e = 0; e < PERF_EV_COUNT; e++) {
+        prof->fds[e] = -1;
+        prof->group_index[e] = -1;
+    }
+
+    prof->fds[PERF_EV_CYCLES] = open_event(perf_events[PERF_EV_CYCLES].config, -1);
+    if (prof->fds[PERF_EV_CYCLES] < 0) {
+        int err = errno;
+        int paranoid = -1;
+        FILE *f = fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+        if (f) {
+            if (fscanf(f, "%d", &paranoid) != 1) paranoid = -1;
+            fclose(f);
+        }
+        printf("⚠ Hardware counters unavailable (%s, perf_event_paranoid=%d): "
+               "profiling wall-clock time only\n", strerror(err), paranoid);
+        return 0;
+    }
+    prof->group_index[PERF_EV_CYCLES] = 0;
+    prof->group_size = 1;
+    prof->available = 1;
+
+    // Members the PMU does not support are reported as n/a
+    for (int e = PERF_EV_CYCLES + 1; e < PERF_EV_COUNT; e++) {
+        prof->fds[e] = open_event(perf_events[e].config, prof->fds[PERF_EV_CYCLES]);
+        if (prof->fds[e] < 0) {
+            printf("⚠ Counter %s unavailable: %s\n", perf_events[e].name, strerror(errno));
+            continue;
+        }
+        prof->group_index[e] = (int)prof->group_size++;
+    }
+
+    printf("✓ Hardware counters: %u/%d events in group\n", prof->group_size, PERF_EV_COUNT);
+    return 0;
+}
+
+void perf_profile_reset(perf_profile_t *prof) {
+    memset(prof->stages, 0, sizeof(prof->stages));
+    prof->num_stages = 0;
+    prof->current = -1;
+}
+
+void perf_profile_cleanup(perf_profile_t *prof) {
+    for (int e = 0; e < PERF_EV_COUNT; e++) {
+        if (prof->fds[e] >= 0) {
+            close(prof->fds[e]);
+            prof->fds[e] = -1;
+        }
+    }
+    prof->available = 0;
+}
+
+// =============================================================================
+// MEASUREMENT
+// =============================================================================
+
+void perf_profile_begin(perf_profile_t *prof, const char *stage) {
+    if (!prof) return;
+
+    int index = -1;
+    for (uint32_t s = 0; s < prof->num_stages; s++) {
+        if (strcmp(prof->stages[s].name, stage) == 0) {
+            index = (int)s;
+            break;
+        }
+    }
+    if (index < 0) {
+        if (prof->num_stages >= PROFILE_MAX_STAGES) return;
+        index = (int)prof->num_stages++;
+        prof->stages[index].name = stage;
+    }
+
+    prof->current = index;
+    read_sample(prof, &prof->start);
+}
+
+void perf_profile_end(perf_profile_t *prof) {
+    if (!prof || prof->current < 0) return;
+
+    perf_sample_t now;
+    read_sample(prof, &now);
+
+    profile_stage_t *st = &prof->stages[prof->current];
+    for (int e = 0; e < PERF_EV_COUNT; e++) {
+        st->values[e] += now.values[e] - prof->start.values[e];
+    }
+    st->wall_ms += (now.wall_sec - prof->start.wall_sec) * 1000.0;
+    st->calls++;
+    prof->current = -1;
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+static void print_count(const perf_profile_t *prof, const profile_stage_t *st, int e) {
+    if (prof->group_index[e] < 0) {
+        printf(" %10s", "n/a");
+    } else {
+        printf(" %10.2f", st->values[e] / 1e6);
+    }
+}
+
+static void print_ratio(const perf_profile_t *prof, const profile_stage_t *st,
+                        int num, int den, double mult, const char *fmt) {
+    if (prof->group_index[num] < 0 || prof->group_index[den] < 0 || st->values[den] == 0) {
+        printf(" %7s", "n/a");
+    } else {
+        printf(fmt, mult * st->values[num] / st->values[den]);
+    }
+}
+
+void perf_profile_print(const perf_profile_t *prof) {
+    printf("\nStage profile (counts in millions, user space only):\n");
+    printf("  %-16s %9s %10s %10s %7s %10s %7s %10s %7s\n",
+           "Stage", "Wall (ms)", "Cycles", "Instr", "IPC",
+           "Cache miss", "Miss %", "Br miss", "Miss %");
+
+    for (uint32_t s = 0; s < prof->num_stages; s++) {
+        const profile_stage_t *st = &prof->stages[s];
+        printf("  %-16s %9.2f", st->name, st->wall_ms);
+        if (!prof->available) {
+            printf(" %10s %10s %7s %10s %7s %10s %7s\n", "-", "-", "-", "-", "-", "-", "-");
+            continue;
+        }
+        print_count(prof, st, PERF_EV_CYCLES);
+        print_count(prof, st, PERF_EV_INSTRUCTIONS);
+        print_ratio(prof, st, PERF_EV_INSTRUCTIONS, PERF_EV_CYCLES, 1.0, " %7.2f");
+        print_count(prof, st, PERF_EV_CACHE_MISSES);
+        print_ratio(prof, st, PERF_EV_CACHE_MISSES, PERF_EV_CACHE_REFS, 100.0, " %6.2f%%");
+        print_count(prof, st, PERF_EV_BRANCH_MISSES);
+        print_ratio(prof, st, PERF_EV_BRANCH_MISSES, PERF_EV_BRANCHES, 100.0, " %6.2f%%");
+        printf("\n");
+    }
+}
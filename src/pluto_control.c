@@ -12,12 +12,16 @@
  */
 
 #include "pluto_control.h"
+#include "trace.h"
+#include "mem_account.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <math.h>
 #include <time.h>
 
+
 // =============================================================================
 // HELPER FUNCTIONS
 // =============================================================================
@@ -38,6 +42,43 @@ static int set_channel_attr_longlong(struct iio_channel *chn, const char *attr,
     return ret;
 }
 
+static double monotonic_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Push timing: the first `warmup` pushes only fill the kernel queue
+typedef struct {
+    uint32_t warmup;
+    uint32_t index;
+    double sum;
+    double sum_sq;
+} push_timer_t;
+
+static void push_timer_start(pluto_ctx_t *ctx, push_timer_t *timer, uint32_t warmup) {
+    memset(timer, 0, sizeof(*timer));
+    memset(&ctx->push_stats, 0, sizeof(ctx->push_stats));
+    timer->warmup = warmup;
+}
+
+static void push_timer_add(pluto_ctx_t *ctx, push_timer_t *timer, double sec, uint32_t samples) {
+    if (timer->index++ < timer->warmup) return;
+
+    pluto_push_stats_t *stats = &ctx->push_stats;
+    stats->pushes++;
+    stats->samples += samples;
+    stats->elapsed_sec += sec;
+    timer->sum += sec;
+    timer->sum_sq += sec * sec;
+    if (sec * 1e3 > stats->max_ms) stats->max_ms = sec * 1e3;
+
+    double mean = timer->sum / stats->pushes;
+    double var = timer->sum_sq / stats->pushes - mean * mean;
+    stats->mean_ms = mean * 1e3;
+    stats->stddev_ms = var > 0.0 ? sqrt(var) * 1e3 : 0.0;
+}
+
 /* Unused - reserved for future use
 static int set_device_attr_longlong(struct iio_device *dev, const char *attr, long long val) {
     int ret = iio_device_attr_write_longlong(dev, attr, val);
@@ -60,6 +101,42 @@ int pluto_init(pluto_ctx_t *ctx, const char *uri) {
 
     memset(ctx, 0, sizeof(pluto_ctx_t));
 
+    // Null backend: no hardware, TX path exercised up to the buffer push
+    if (uri && strncmp(uri, "null", 4) == 0) {
+        ctx->backend = PLUTO_BACKEND_NULL;
+        ctx->chunk_size = PLUTO_CHUNK_SIZE;
+        ctx->null_buf = mem_alloc(MEM_TX, 2 * PLUTO_CHUNK_SIZE * sizeof(int16_t));
+        if (!ctx->null_buf) {
+            fprintf(stderr, "Failed to allocate null backend buffer\n");
+            return -1;
+        }
+        ctx->initialized = 1;
+        printf("✓ Null TX backend initialized (samples discarded)\n");
+        return 0;
+    }
+
+    // Network sink: remote receiver instead of a radio
+    if (net_sink_is_uri(uri)) {
+        ctx->backend = PLUTO_BACKEND_NET;
+        if (net_sink_open(&ctx->net, uri, 0) < 0) {
+            return -1;
+        }
+        ctx->initialized = 1;
+        return 0;
+    }
+
+    // Shared-memory ring: local decoders read the samples in place
+    if (shm_ring_is_uri(uri)) {
+        ctx->backend = PLUTO_BACKEND_SHM;
+        if (shm_ring_create(&ctx->shm, uri + 4, SHM_RING_DEFAULT_SAMPLES, PLUTO_SAMPLE_RATE) < 0) {
+            return -1;
+        }
+        ctx->initialized = 1;
+        return 0;
+    }
+
+    ctx->chunk_size = PLUTO_CHUNK_SIZE;
+
     // Create IIO context
     if (uri) {
         ctx->ctx = iio_create_context_from_uri(uri);
@@ -108,7 +185,26 @@ int pluto_configure_tx(pluto_ctx_t *ctx,
                       uint64_t frequency,
                       int32_t gain_db,
                       uint32_t sample_rate) {
-    if (!ctx || !ctx->ctx || !ctx->initialized) {
+    if (!ctx || !ctx->initialized) {
+        fprintf(stderr, "PlutoSDR not initialized\n");
+        return -1;
+    }
+
+    if (ctx->backend != PLUTO_BACKEND_IIO) {
+        static const char *names[] = { "IIO", "Null", "Network", "Shared memory" };
+        ctx->frequency = frequency;
+        ctx->gain_db = gain_db;
+        ctx->sample_rate = sample_rate;
+        ctx->net.sample_rate = sample_rate;
+        if (ctx->backend == PLUTO_BACKEND_SHM) {
+            shm_ring_set_format(&ctx->shm, sample_rate, frequency);
+        }
+        printf("✓ %s TX configured: %.3f MHz, %d dB, %u Hz\n",
+               names[ctx->backend], frequency / 1e6, gain_db, sample_rate);
+        return 0;
+    }
+
+    if (!ctx->ctx) {
         fprintf(stderr, "PlutoSDR not initialized\n");
         return -1;
     }
@@ -144,6 +240,7 @@ int pluto_configure_tx(pluto_ctx_t *ctx,
     if (set_channel_attr_longlong(tx_chan, "sampling_frequency", sample_rate) < 0) {
         return -1;
     }
+    ctx->sample_rate = sample_rate;
 
     // Set TX hardware gain (PlutoSDR uses attenuation: negative dB)
     // Range: -89.75 dB to 0 dB (in millidB: -89750 to 0)
@@ -176,34 +273,174 @@ int pluto_configure_tx(pluto_ctx_t *ctx,
 // TRANSMISSION FUNCTIONS
 // =============================================================================
 
+void pluto_convert_ci16(const float complex *iq_samples,
+                        int16_t *buf,
+                        uint32_t num_samples) {
+    // PlutoSDR expects interleaved I/Q: [I0, Q0, I1, Q1, ...]
+    // Range: -2048 to +2047 (12-bit DAC)
+    for (uint32_t i = 0; i < num_samples; i++) {
+        float i_val = crealf(iq_samples[i]);
+        float q_val = cimagf(iq_samples[i]);
+
+        // Scale float ±1.0 to int16 ±2047
+        int16_t i_sample = (int16_t)(i_val * 2047.0f);
+        int16_t q_sample = (int16_t)(q_val * 2047.0f);
+
+        // Clamp to valid range
+        if (i_sample > 2047) i_sample = 2047;
+        if (i_sample < -2048) i_sample = -2048;
+        if (q_sample > 2047) q_sample = 2047;
+        if (q_sample < -2048) q_sample = -2048;
+
+        buf[2*i]     = i_sample;  // I
+        buf[2*i + 1] = q_sample;  // Q
+    }
+}
+
+static int null_transmit_iq(pluto_ctx_t *ctx,
+                            const float complex *iq_samples,
+                            uint32_t num_samples) {
+    uint32_t total_sent = 0;
+    push_timer_t timer;
+    push_timer_start(ctx, &timer, 0);
+
+    // Same chunking and conversion as the libiio path, push is a no-op
+    while (total_sent < num_samples) {
+        uint32_t chunk_samples = (num_samples - total_sent > ctx->chunk_size) ?
+                                 ctx->chunk_size : (num_samples - total_sent);
+        double t0 = monotonic_sec();
+        TRACE_BEGIN("convert ci16");
+        pluto_convert_ci16(&iq_samples[total_sent], ctx->null_buf, chunk_samples);
+        TRACE_END("convert ci16");
+        push_timer_add(ctx, &timer, monotonic_sec() - t0, chunk_samples);
+        total_sent += chunk_samples;
+    }
+
+    if (!ctx->quiet) {
+        printf("✓ Null backend consumed %u I/Q samples\n", total_sent);
+    }
+    return total_sent;
+}
+
+static int net_transmit_iq(pluto_ctx_t *ctx,
+                           const float complex *iq_samples,
+                           uint32_t num_samples) {
+    // Whole burst converted once: the sink sends straight from this buffer
+    if (num_samples > ctx->net_capacity) {
+        int16_t *buf = mem_realloc(MEM_TX, ctx->net_buf, (size_t)num_samples * 2 * sizeof(int16_t));
+        if (!buf) {
+            fprintf(stderr, "Failed to allocate network burst buffer\n");
+            return -1;
+        }
+        ctx->net_buf = buf;
+        ctx->net_capacity = num_samples;
+    }
+
+    TRACE_BEGIN("convert ci16");
+    pluto_convert_ci16(iq_samples, ctx->net_buf, num_samples);
+    TRACE_END("convert ci16");
+
+    TRACE_BEGIN("net send");
+    int sent = net_sink_send_burst(&ctx->net, ctx->net_buf, num_samples);
+    TRACE_END("net send");
+    if (sent < 0) {
+        return -1;
+    }
+
+    printf("✓ Streamed %u I/Q samples (burst %u, %llu packets sent, %llu dropped)\n",
+           num_samples, ctx->net.burst - 1, (unsigned long long)ctx->net.packets_sent,
+           (unsigned long long)ctx->net.packets_dropped);
+    return sent;
+}
+
+static int shm_transmit_iq(pluto_ctx_t *ctx,
+                           const float complex *iq_samples,
+                           uint32_t num_samples) {
+    // Idle air since the previous burst, as a radio would send it: readers
+    // see separate bursts, not one carrier (at most half a ring)
+    double now = monotonic_sec();
+    TRACE_BEGIN("shm write");
+    if (ctx->shm_air_end > 0.0 && now > ctx->shm_air_end) {
+        double gap = (now - ctx->shm_air_end) * ctx->sample_rate;
+        double gap_max = (double)(ctx->shm.hdr->capacity / 2);
+        if (shm_ring_write_silence(&ctx->shm, (uint32_t)(gap < gap_max ? gap : gap_max)) < 0) {
+            TRACE_END("shm write");
+            return -1;
+        }
+    }
+
+    // cf32 as rendered: no conversion, one copy into the mapped ring
+    int written = shm_ring_write_burst(&ctx->shm, iq_samples, num_samples);
+    TRACE_END("shm write");
+    if (written < 0) {
+        return -1;
+    }
+    ctx->shm_air_end = (now > ctx->shm_air_end ? now : ctx->shm_air_end) +
+                       (double)num_samples / ctx->sample_rate;
+
+    shm_ring_header_t *hdr = ctx->shm.hdr;
+    printf("✓ Wrote %u I/Q samples to /dev/shm%s (burst %llu, %llu samples in stream)\n",
+           num_samples, ctx->shm.path,
+           (unsigned long long)atomic_load(&hdr->marker_count) - 1,
+           (unsigned long long)atomic_load(&hdr->head));
+    return written;
+}
+
 int pluto_transmit_iq(pluto_ctx_t *ctx,
                      const float complex *iq_samples,
                      uint32_t num_samples) {
-    if (!ctx || !ctx->tx_dev || !iq_samples || num_samples == 0) {
+    if (!ctx || !iq_samples || num_samples == 0) {
+        fprintf(stderr, "Invalid parameters for transmission\n");
+        return -1;
+    }
+
+    if (ctx->backend == PLUTO_BACKEND_NULL) {
+        return null_transmit_iq(ctx, iq_samples, num_samples);
+    }
+    if (ctx->backend == PLUTO_BACKEND_NET) {
+        return net_transmit_iq(ctx, iq_samples, num_samples);
+    }
+    if (ctx->backend == PLUTO_BACKEND_SHM) {
+        return shm_transmit_iq(ctx, iq_samples, num_samples);
+    }
+
+    if (!ctx->tx_dev) {
         fprintf(stderr, "Invalid parameters for transmission\n");
         return -1;
     }
 
-    // Transmit in chunks to avoid buffer overflow
-    // PlutoSDR buffer size limit is typically 64k-256k samples
-    const uint32_t CHUNK_SIZE = 65536;  // 64k samples per chunk
+    // One buffer per burst, pushed chunk by chunk: the kernel queues up to
+    // kernel_buffers chunks ahead of the DAC (see tx_tune for the sizes)
+    const uint32_t CHUNK_SIZE = ctx->chunk_size;
+    uint32_t buffer_samples = num_samples < CHUNK_SIZE ? num_samples : CHUNK_SIZE;
     uint32_t total_sent = 0;
 
-    printf("Transmitting %u samples in chunks of %u...\n", num_samples, CHUNK_SIZE);
+    if (!ctx->quiet) {
+        printf("Transmitting %u samples in chunks of %u...\n", num_samples, CHUNK_SIZE);
+    }
+
+    if (ctx->kernel_buffers &&
+        iio_device_set_kernel_buffers_count(ctx->tx_dev, ctx->kernel_buffers) < 0) {
+        fprintf(stderr, "⚠ Cannot set %u kernel buffers, using the driver default\n",
+                ctx->kernel_buffers);
+    }
+
+    ctx->tx_buf = iio_device_create_buffer(ctx->tx_dev, buffer_samples, 0);
+    if (!ctx->tx_buf) {
+        fprintf(stderr, "Failed to create TX buffer (%u samples)\n", buffer_samples);
+        return -1;
+    }
+
+    push_timer_t timer;
+    push_timer_start(ctx, &timer,
+                     ctx->kernel_buffers ? ctx->kernel_buffers : PLUTO_KERNEL_BUFFERS_DEFAULT);
 
     while (total_sent < num_samples) {
         // Calculate chunk size (last chunk may be smaller)
         uint32_t chunk_samples = (num_samples - total_sent > CHUNK_SIZE) ?
                                  CHUNK_SIZE : (num_samples - total_sent);
 
-        // Create TX buffer for this chunk
-        ctx->tx_buf = iio_device_create_buffer(ctx->tx_dev, chunk_samples, 0);
-        if (!ctx->tx_buf) {
-            fprintf(stderr, "Failed to create TX buffer for chunk at sample %u\n", total_sent);
-            return -1;
-        }
-
-        // Get buffer pointer
+        // Get buffer pointer (next free block after each push)
         int16_t *buf = (int16_t *)iio_buffer_start(ctx->tx_buf);
         if (!buf) {
             fprintf(stderr, "Failed to get buffer pointer for chunk at sample %u\n", total_sent);
@@ -213,28 +450,17 @@ int pluto_transmit_iq(pluto_ctx_t *ctx,
         }
 
         // Convert float complex to int16 I/Q samples for this chunk
-        // PlutoSDR expects interleaved I/Q: [I0, Q0, I1, Q1, ...]
-        // Range: -2048 to +2047 (12-bit DAC)
-        for (uint32_t i = 0; i < chunk_samples; i++) {
-            float i_val = crealf(iq_samples[total_sent + i]);
-            float q_val = cimagf(iq_samples[total_sent + i]);
-
-            // Scale float ±1.0 to int16 ±2047
-            int16_t i_sample = (int16_t)(i_val * 2047.0f);
-            int16_t q_sample = (int16_t)(q_val * 2047.0f);
-
-            // Clamp to valid range
-            if (i_sample > 2047) i_sample = 2047;
-            if (i_sample < -2048) i_sample = -2048;
-            if (q_sample > 2047) q_sample = 2047;
-            if (q_sample < -2048) q_sample = -2048;
-
-            buf[2*i]     = i_sample;  // I
-            buf[2*i + 1] = q_sample;  // Q
-        }
+        TRACE_BEGIN("convert ci16");
+        pluto_convert_ci16(&iq_samples[total_sent], buf, chunk_samples);
+        TRACE_END("convert ci16");
 
         // Push buffer to PlutoSDR
-        ssize_t nbytes_tx = iio_buffer_push(ctx->tx_buf);
+        double t0 = monotonic_sec();
+        TRACE_BEGIN("iio_buffer_push");
+        ssize_t nbytes_tx = (chunk_samples == buffer_samples) ?
+                            iio_buffer_push(ctx->tx_buf) :
+                            iio_buffer_push_partial(ctx->tx_buf, chunk_samples);
+        TRACE_END("iio_buffer_push");
         if (nbytes_tx < 0) {
             fprintf(stderr, "TX buffer push failed for chunk at sample %u: %s\n",
                     total_sent, strerror(-nbytes_tx));
@@ -242,30 +468,65 @@ int pluto_transmit_iq(pluto_ctx_t *ctx,
             ctx->tx_buf = NULL;
             return -1;
         }
-
-        // Cleanup buffer
-        iio_buffer_destroy(ctx->tx_buf);
-        ctx->tx_buf = NULL;
+        push_timer_add(ctx, &timer, monotonic_sec() - t0, chunk_samples);
 
         total_sent += chunk_samples;
 
         // Progress indicator every ~500k samples
-        if (total_sent % 500000 < CHUNK_SIZE) {
+        if (!ctx->quiet && total_sent % 500000 < CHUNK_SIZE) {
             printf("  Transmitted %u/%u samples (%.1f%%)\n",
                    total_sent, num_samples, (total_sent * 100.0f) / num_samples);
         }
     }
 
-    printf("✓ Transmitted %u I/Q samples total\n", total_sent);
+    // Cleanup buffer
+    iio_buffer_destroy(ctx->tx_buf);
+    ctx->tx_buf = NULL;
+
+    if (!ctx->quiet) {
+        printf("✓ Transmitted %u I/Q samples total\n", total_sent);
+    }
 
     return total_sent;
 }
 
+int pluto_set_tx_buffers(pluto_ctx_t *ctx, uint32_t chunk_size, uint32_t kernel_buffers) {
+    if (!ctx || !ctx->initialized) {
+        fprintf(stderr, "PlutoSDR not initialized\n");
+        return -1;
+    }
+    if (chunk_size < PLUTO_CHUNK_MIN || chunk_size > PLUTO_CHUNK_MAX ||
+        kernel_buffers > PLUTO_KERNEL_BUFFERS_MAX) {
+        fprintf(stderr, "Invalid TX buffers: %u samples × %u (chunk %d-%d, at most %d buffers)\n",
+                chunk_size, kernel_buffers, PLUTO_CHUNK_MIN, PLUTO_CHUNK_MAX,
+                PLUTO_KERNEL_BUFFERS_MAX);
+        return -1;
+    }
+
+    if (ctx->backend == PLUTO_BACKEND_NULL && chunk_size > ctx->chunk_size) {
+        int16_t *buf = mem_realloc(MEM_TX, ctx->null_buf, 2 * (size_t)chunk_size * sizeof(int16_t));
+        if (!buf) {
+            fprintf(stderr, "Failed to allocate null backend buffer\n");
+            return -1;
+        }
+        ctx->null_buf = buf;
+    }
+    ctx->chunk_size = chunk_size;
+    ctx->kernel_buffers = kernel_buffers;
+    return 0;
+}
+
 // =============================================================================
 // TX ENABLE/DISABLE
 // =============================================================================
 
 int pluto_enable_tx(pluto_ctx_t *ctx, uint8_t enable) {
+    if (ctx && ctx->backend != PLUTO_BACKEND_IIO && ctx->initialized) {
+        static const char *names[] = { "iio", "null", "network", "shared memory" };
+        printf("TX %s (%s backend)\n", enable ? "enabled" : "disabled", names[ctx->backend]);
+        return 0;
+    }
+
     if (!ctx || !ctx->ctx || !ctx->initialized) {
         fprintf(stderr, "PlutoSDR not initialized\n");
         return -1;
@@ -315,6 +576,19 @@ void pluto_cleanup(pluto_ctx_t *ctx) {
         ctx->ctx = NULL;
     }
 
+    mem_free(ctx->null_buf);
+    ctx->null_buf = NULL;
+
+    if (ctx->backend == PLUTO_BACKEND_NET) {
+        net_sink_close(&ctx->net);
+    }
+    if (ctx->backend == PLUTO_BACKEND_SHM) {
+        shm_ring_close(&ctx->shm);
+    }
+    mem_free(ctx->net_buf);
+    ctx->net_buf = NULL;
+    ctx->net_capacity = 0;
+
     ctx->initialized = 0;
     printf("PlutoSDR cleaned up\n");
 }
@@ -324,6 +598,21 @@ void pluto_cleanup(pluto_ctx_t *ctx) {
 // =============================================================================
 
 void pluto_print_info(const pluto_ctx_t *ctx) {
+    if (ctx && ctx->backend == PLUTO_BACKEND_NULL && ctx->initialized) {
+        printf("\nNull TX backend (no hardware, samples discarded)\n\n");
+        return;
+    }
+    if (ctx && ctx->backend == PLUTO_BACKEND_NET && ctx->initialized) {
+        printf("\nNetwork TX backend (%s, ci16 stream)\n\n",
+               ctx->net.proto == NET_SINK_UDP ? "UDP" : "TCP");
+        return;
+    }
+    if (ctx && ctx->backend == PLUTO_BACKEND_SHM && ctx->initialized) {
+        printf("\nShared memory TX backend (/dev/shm%s, %llu-sample cf32 ring)\n\n",
+               ctx->shm.path, (unsigned long long)ctx->shm.hdr->capacity);
+        return;
+    }
+
     if (!ctx || !ctx->ctx) {
         printf("PlutoSDR: Not connected\n");
         return;
@@ -357,6 +646,9 @@ void pluto_print_info(const pluto_ctx_t *ctx) {
 // =============================================================================
 
 uint8_t pluto_is_connected(const pluto_ctx_t *ctx) {
+    if (ctx && ctx->backend != PLUTO_BACKEND_IIO) {
+        return ctx->initialized;
+    }
     return (ctx && ctx->ctx && ctx->initialized);
 }
 
@@ -422,7 +714,14 @@ static int create_sigmf_meta(const char *base_filename, uint32_t num_samples, ui
     fprintf(fp, "        \"core:datatype\": \"cf32_le\",\n");
     fprintf(fp, "        \"core:sample_rate\": %u,\n", sample_rate);
     fprintf(fp, "        \"core:version\": \"1.0.0\",\n");
-    fprintf(fp, "        \"core:description\": \"COSPAS-SARSAT T.018 2nd generation beacon test frame with OQPSK modulation, DSSS spreading (256 chips/bit), half-sine pulse shaping, SPS=%u\",\n", sample_rate / 38400);
+    // Integer SPS as before for the chip-aligned rates, decimals for the others
+    char sps[32];
+    if (sample_rate % 38400 == 0) {
+        snprintf(sps, sizeof(sps), "%u", sample_rate / 38400);
+    } else {
+        snprintf(sps, sizeof(sps), "%.2f", sample_rate / 38400.0);
+    }
+    fprintf(fp, "        \"core:description\": \"COSPAS-SARSAT T.018 2nd generation beacon test frame with OQPSK modulation, DSSS spreading (256 chips/bit), half-sine pulse shaping, SPS=%s\",\n", sps);
     fprintf(fp, "        \"core:author\": \"SARSAT_SGB Generator\",\n");
     fprintf(fp, "        \"core:hw\": \"Software generated (baseband)\"\n");
     fprintf(fp, "    },\n");
@@ -10,6 +10,11 @@
 #include "prn_generator.h"
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
+
+// Shared frame tables [mode][channel] (read-only after first use)
+static int8_t frame_tables[2][2][PRN_FRAME_CHIPS];
+static pthread_once_t frame_tables_once = PTHREAD_ONCE_INIT;
 
 void prn_init(prn_state_t *state, uint8_t mode) {
     if (mode == 0) {
@@ -64,6 +69,92 @@ void prn_generate_q(prn_state_t *state, int8_t *sequence) {
     state->lfsr_q = lfsr;
 }
 
+static void build_frame_tables(void) {
+    for (uint8_t mode = 0; mode < 2; mode++) {
+        prn_state_t state;
+
+        // I and Q tables each start from a freshly initialized generator
+        prn_init(&state, mode);
+        for (int bit = 0; bit < PRN_FRAME_BITS; bit++) {
+            prn_generate_i(&state, &frame_tables[mode][0][bit * PRN_CHIPS_PER_BIT]);
+        }
+
+        prn_init(&state, mode);
+        for (int bit = 0; bit < PRN_FRAME_BITS; bit++) {
+            prn_generate_q(&state, &frame_tables[mode][1][bit * PRN_CHIPS_PER_BIT]);
+        }
+    }
+}
+
+const int8_t *prn_get_frame_table(uint8_t mode, uint8_t channel) {
+    pthread_once(&frame_tables_once, build_frame_tables);
+    return frame_tables[mode ? 1 : 0][channel ? 1 : 0];
+}
+
+// =============================================================================
+// JUMP-AHEAD / PACKED GENERATION
+// =============================================================================
+
+// Product of two polynomials of degree < 23, reduced mod PRN_POLYNOMIAL
+static uint32_t poly_mulmod(uint32_t a, uint32_t b) {
+    uint64_t p = 0;
+    for (int i = 0; i < PRN_LFSR_LENGTH; i++) {
+        if ((b >> i) & 1) p ^= (uint64_t)a << i;
+    }
+    for (int d = 2 * PRN_LFSR_LENGTH - 2; d >= PRN_LFSR_LENGTH; d--) {
+        if ((p >> d) & 1) p ^= (uint64_t)PRN_POLYNOMIAL << (d - PRN_LFSR_LENGTH);
+    }
+    return (uint32_t)p;
+}
+
+uint32_t prn_jump(uint32_t lfsr, uint64_t steps) {
+    // The register holds the next 23 chips: state(n) = s[n..n+22]. With
+    // x^steps = Σ c_i x^i (mod p), s[steps+j] = ⊕ c_i s[i+j].
+    uint32_t c = 1;
+    uint32_t x = 2;
+    for (uint64_t e = steps % PRN_PERIOD; e; e >>= 1) {
+        if (e & 1) c = poly_mulmod(c, x);
+        x = poly_mulmod(x, x);
+    }
+
+    // s[0..44]
+    uint64_t seq = lfsr & 0x7FFFFF;
+    for (int n = PRN_LFSR_LENGTH; n < 2 * PRN_LFSR_LENGTH - 1; n++) {
+        seq |= (((seq >> (n - PRN_LFSR_LENGTH)) ^ (seq >> (n - 5))) & 1) << n;
+    }
+
+    uint32_t out = 0;
+    for (int i = 0; i < PRN_LFSR_LENGTH; i++) {
+        if ((c >> i) & 1) out ^= (uint32_t)(seq >> i) & 0x7FFFFF;
+    }
+    return out;
+}
+
+uint32_t prn_generate_packed(uint32_t lfsr, uint64_t *words, uint32_t num_words) {
+    uint32_t head = num_words < 6 ? num_words : 6;
+
+    // Bit-serial for the first 6 words (368-chip history)
+    uint32_t state = lfsr;
+    for (uint32_t w = 0; w < head; w++) {
+        uint64_t word = 0;
+        for (int i = 0; i < 64; i++) {
+            word |= (uint64_t)(state & 1) << i;
+            uint32_t feedback = (state ^ (state >> 18)) & 1;
+            state = ((state >> 1) | (feedback << 22)) & 0x7FFFFF;
+        }
+        words[w] = word;
+    }
+
+    // s[n] = s[n-368] ⊕ s[n-80]: chip 64w - 368 is bit 16 of word w-6,
+    // chip 64w - 80 is bit 48 of word w-2
+    for (uint32_t w = 6; w < num_words; w++) {
+        words[w] = ((words[w - 6] >> 16) | (words[w - 5] << 48)) ^
+                   ((words[w - 2] >> 48) | (words[w - 1] << 16));
+    }
+
+    return num_words <= 6 ? state : prn_jump(lfsr, (uint64_t)num_words * 64);
+}
+
 uint8_t prn_verify_table_2_2(void) {
     // T.018 Table 2.2 reference (Normal I, first 64 chips)
     // Hex: 8000 0108 4212 84A1
@@ -0,0 +1,121 @@
+/**
+ * @file render_lead.c
+ * @brief Adaptive render lead implementation
+ *
+ * The quantile is tracked by stochastic approximation: each sample moves
+ * the estimate up by step·q when above it and down by step·(1 - q)
+ * otherwise, which is balanced when a fraction 1 - q of the samples lies
+ * above. The step follows the spread of the samples (EWMA absolute
+ * deviation), so the estimate settles within a few bursts.
+ */
+
+#include "render_lead.h"
+#include <string.h>
+
+// Late by less than this: scheduling jitter, not a miss
+#define LEAD_LATE_TOLERANCE_SEC 0.001
+
+static const lead_stats_t *find_config(const render_lead_t *lead, uint64_t key) {
+    for (uint32_t i = 0; i < lead->num_configs; i++) {
+        if (lead->configs[i].key == key) return &lead->configs[i];
+    }
+    return NULL;
+}
+
+void render_lead_init(render_lead_t *lead) {
+    memset(lead, 0, sizeof(render_lead_t));
+    lead->margin = LEAD_MARGIN_MIN_SEC;
+}
+
+uint64_t render_lead_key(uint32_t output_rate, uint32_t bursts) {
+    return ((uint64_t)bursts << 32) | output_rate;
+}
+
+double render_lead_predict(const render_lead_t *lead, uint64_t key) {
+    const lead_stats_t *stats = find_config(lead, key);
+    if (!stats || stats->samples == 0) {
+        return LEAD_DEFAULT_SEC;
+    }
+    if (stats->samples < LEAD_WARMUP_SAMPLES) {
+        return stats->max;
+    }
+    return stats->quantile > stats->ewma ? stats->quantile : stats->ewma;
+}
+
+double render_lead_get(const render_lead_t *lead, uint64_t key) {
+    return render_lead_predict(lead, key) + lead->margin;
+}
+
+void render_lead_update(render_lead_t *lead, uint64_t key, double render_sec) {
+    lead_stats_t *stats = (lead_stats_t *)find_config(lead, key);
+    if (!stats) {
+        if (lead->num_configs < LEAD_MAX_CONFIGS) {
+            stats = &lead->configs[lead->num_configs++];
+        } else {
+            stats = &lead->configs[lead->next_evict];
+            lead->next_evict = (lead->next_evict + 1) % LEAD_MAX_CONFIGS;
+        }
+        memset(stats, 0, sizeof(lead_stats_t));
+        stats->key = key;
+    }
+
+    if (stats->samples == 0) {
+        stats->ewma = render_sec;
+        stats->quantile = render_sec;
+        stats->abs_dev = render_sec * 0.1;
+    } else {
+        double dev = render_sec - stats->ewma;
+        stats->ewma += LEAD_EWMA_ALPHA * dev;
+        stats->abs_dev += LEAD_EWMA_ALPHA * ((dev < 0 ? -dev : dev) - stats->abs_dev);
+
+        double step = 2.0 * stats->abs_dev;
+        if (render_sec > stats->quantile) {
+            stats->quantile += step * LEAD_QUANTILE;
+        } else {
+            stats->quantile -= step * (1.0 - LEAD_QUANTILE);
+        }
+    }
+    if (render_sec > stats->max) {
+        stats->max = render_sec;
+    }
+
+    // The stochastic step can overshoot on a stable distribution: a p95
+    // above the largest render seen is never right
+    if (stats->quantile > stats->max) {
+        stats->quantile = stats->max;
+    } else if (stats->quantile < 0.0) {
+        stats->quantile = 0.0;
+    }
+    stats->samples++;
+}
+
+void render_lead_feedback(render_lead_t *lead, double lateness_sec) {
+    if (lateness_sec > LEAD_LATE_TOLERANCE_SEC) {
+        lead->late++;
+        if (lateness_sec > lead->worst_late) {
+            lead->worst_late = lateness_sec;
+        }
+        lead->margin += LEAD_MARGIN_GAIN * lateness_sec;
+        if (lead->margin > LEAD_MARGIN_MAX_SEC) {
+            lead->margin = LEAD_MARGIN_MAX_SEC;
+        }
+        return;
+    }
+
+    lead->on_time++;
+    lead->margin *= LEAD_MARGIN_DECAY;
+    if (lead->margin < LEAD_MARGIN_MIN_SEC) {
+        lead->margin = LEAD_MARGIN_MIN_SEC;
+    }
+}
+
+void render_lead_print(const render_lead_t *lead, FILE *out) {
+    fprintf(out, "  Render lead:      margin %.3f s, %u on time, %u late (worst %.3f s)\n",
+            lead->margin, lead->on_time, lead->late, lead->worst_late);
+    for (uint32_t i = 0; i < lead->num_configs; i++) {
+        const lead_stats_t *stats = &lead->configs[i];
+        fprintf(out, "    %u Hz x%u: %u renders, mean %.3f s, p95 %.3f s, max %.3f s\n",
+                (uint32_t)(stats->key & 0xFFFFFFFFu), (uint32_t)(stats->key >> 32),
+                stats->samples, stats->ewma, stats->quantile, stats->max);
+    }
+}
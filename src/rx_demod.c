@@ -0,0 +1,465 @@
+/**
+ * @file rx_demod.c
+ * @brief Burst demodulator implementation
+ *
+ * Signal model (see oqpsk_modulator.c): at RX_SPS samples per chip the I
+ * chip k occupies samples [4k, 4k+4) and the Q chip k [4k-2, 4k+2), both
+ * half-sine shaped. After the matched filter, despreading the I chips at
+ * tau + 4k and the Q chips at tau + 4k - 2 gives zI ≈ A·e^jφ·dI and
+ * zQ ≈ j·A·e^jφ·dQ, so zI - j·zQ combines both channels coherently.
+ */
+
+#include "rx_demod.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define ACQ_SEGMENTS        (RX_ACQ_CHIPS / RX_ACQ_SEGMENT)
+#define PREAMBLE_CHIPS      ((OQPSK_PREAMBLE_BITS / 2) * PRN_CHIPS_PER_BIT)  // 6400 per channel
+#define Q_OFFSET            (RX_SPS / 2)
+
+// Acquisition hypothesis
+typedef struct {
+    float metric;
+    uint32_t tau;
+    uint8_t mode;
+    double freq_hz;
+} acq_result_t;
+
+// =============================================================================
+// INITIALIZATION
+// =============================================================================
+
+int rx_demod_init(rx_demod_t *dm, uint32_t max_capture) {
+    memset(dm, 0, sizeof(rx_demod_t));
+
+    if (fft_plan_init(&dm->plan, RX_ACQ_FFT) < 0) {
+        return -1;
+    }
+
+    dm->fft_buf = malloc(RX_ACQ_FFT * sizeof(float complex));
+    dm->filtered = malloc((size_t)max_capture * sizeof(float complex));
+    if (!dm->fft_buf || !dm->filtered) {
+        fprintf(stderr, "Failed to allocate demodulator buffers\n");
+        rx_demod_free(dm);
+        return -1;
+    }
+    dm->capacity = max_capture;
+    return 0;
+}
+
+void rx_demod_free(rx_demod_t *dm) {
+    fft_plan_free(&dm->plan);
+    free(dm->fft_buf);
+    free(dm->filtered);
+    dm->fft_buf = NULL;
+    dm->filtered = NULL;
+}
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static void matched_filter(const float complex *x, uint32_t length, float complex *y) {
+    // Half-sine chip pulse at RX_SPS: sin(πs/4) = {0, 0.707, 1, 0.707}
+    const float h1 = 0.70710678f;
+
+    for (uint32_t n = 0; n + 3 < length; n++) {
+        y[n] = h1 * (x[n + 1] + x[n + 3]) + x[n + 2];
+    }
+    for (uint32_t n = (length > 3) ? length - 3 : 0; n < length; n++) {
+        y[n] = 0.0f;
+    }
+}
+
+static void derotate(float complex *y, uint32_t length, double freq_hz) {
+    double complex step = cexp(-I * 2.0 * M_PI * freq_hz / RX_SAMPLE_RATE);
+    double complex phasor = 1.0;
+
+    for (uint32_t n = 0; n < length; n++) {
+        y[n] *= (float complex)phasor;
+        phasor *= step;
+        if ((n & 1023) == 1023) {
+            phasor /= cabs(phasor);
+        }
+    }
+}
+
+// =============================================================================
+// STAGE 2: ACQUISITION
+// =============================================================================
+
+static float acquire_at(rx_demod_t *dm, const float complex *y, uint32_t tau,
+                        const int8_t *ci, const int8_t *cq, double *freq_hz) {
+    float complex *buf = dm->fft_buf;
+    float energy = 0.0f;
+
+    for (uint32_t s = 0; s < ACQ_SEGMENTS; s++) {
+        float complex acc = 0.0f;
+        uint32_t c = RX_ACQ_OFFSET + s * RX_ACQ_SEGMENT;
+        for (uint32_t i = 0; i < RX_ACQ_SEGMENT; i++, c++) {
+            uint32_t n = tau + RX_SPS * c;
+            acc += ci[c] * y[n] - I * (cq[c] * y[n - Q_OFFSET]);
+        }
+        buf[s] = acc;
+        energy += crealf(acc) * crealf(acc) + cimagf(acc) * cimagf(acc);
+    }
+    memset(&buf[ACQ_SEGMENTS], 0, (RX_ACQ_FFT - ACQ_SEGMENTS) * sizeof(float complex));
+
+    fft_forward(&dm->plan, buf);
+
+    uint32_t peak = 0;
+    float peak_power = 0.0f;
+    for (uint32_t k = 0; k < RX_ACQ_FFT; k++) {
+        float p = crealf(buf[k]) * crealf(buf[k]) + cimagf(buf[k]) * cimagf(buf[k]);
+        if (p > peak_power) {
+            peak_power = p;
+            peak = k;
+        }
+    }
+    if (energy <= 0.0f) return 0.0f;
+
+    if (freq_hz) {
+        // Parabolic interpolation on magnitudes
+        float m0 = cabsf(buf[(peak + RX_ACQ_FFT - 1) % RX_ACQ_FFT]);
+        float m1 = sqrtf(peak_power);
+        float m2 = cabsf(buf[(peak + 1) % RX_ACQ_FFT]);
+        float denom = m0 - 2.0f * m1 + m2;
+        double delta = (denom != 0.0f) ? 0.5 * (m0 - m2) / denom : 0.0;
+        double bin = (peak < RX_ACQ_FFT / 2) ? (double)peak : (double)peak - RX_ACQ_FFT;
+        *freq_hz = (bin + delta) * ((double)OQPSK_CHIP_RATE / RX_ACQ_SEGMENT) / RX_ACQ_FFT;
+    }
+
+    // Mean bin power equals the segment energy (Parseval)
+    return peak_power / energy;
+}
+
+static void acquire(rx_demod_t *dm, const float complex *y, uint32_t length,
+                    uint32_t search, acq_result_t *best) {
+    memset(best, 0, sizeof(acq_result_t));
+
+    uint32_t needed = RX_SPS * (RX_ACQ_OFFSET + RX_ACQ_CHIPS);
+    if (length <= needed) return;
+    if (search > length - needed) search = length - needed;
+
+    // Half-chip grid over both PRN sets, then ±1 sample around the peak
+    for (uint8_t mode = 0; mode < 2; mode++) {
+        const int8_t *ci = prn_get_frame_table(mode, 0);
+        const int8_t *cq = prn_get_frame_table(mode, 1);
+        for (uint32_t tau = 0; tau < search; tau += RX_SPS / 2) {
+            float metric = acquire_at(dm, y, tau, ci, cq, NULL);
+            if (metric > best->metric) {
+                best->metric = metric;
+                best->tau = tau;
+                best->mode = mode;
+            }
+        }
+    }
+
+    const int8_t *ci = prn_get_frame_table(best->mode, 0);
+    const int8_t *cq = prn_get_frame_table(best->mode, 1);
+    uint32_t center = best->tau;
+    float refined = 0.0f;
+    for (int d = -1; d <= 1; d++) {
+        if ((int)center + d < 0 || center + d >= search) continue;
+        double freq;
+        float metric = acquire_at(dm, y, center + d, ci, cq, &freq);
+        if (metric > refined) {
+            refined = metric;
+            best->metric = metric;
+            best->tau = center + d;
+            best->freq_hz = freq;
+        }
+    }
+}
+
+static void resolve_alias(const float complex *x, uint32_t tau, const int8_t *ci,
+                          const int8_t *cq, acq_result_t *acq) {
+    // The segment FFT only knows the carrier modulo the segment rate. Chip-rate
+    // products cannot tell the candidates apart either, so correlate the raw
+    // capture (4 samples/chip, unambiguous to ±76.8 kHz) with the half-sine
+    // preamble waveform and keep the candidate with the most energy in
+    // 16-chip coherent sums
+    static const float pulse[RX_SPS] = { 0.0f, 0.70710678f, 1.0f, 0.70710678f };
+    const double alias_hz = (double)OQPSK_CHIP_RATE / RX_ACQ_SEGMENT;
+    const uint32_t group = 16;
+    double best_energy = -1.0;
+    double best_freq = acq->freq_hz;
+
+    for (int m = -RX_ACQ_ALIASES; m <= RX_ACQ_ALIASES; m++) {
+        double freq = acq->freq_hz + m * alias_hz;
+        float complex rot[RX_SPS + Q_OFFSET];            // Offsets -Q_OFFSET..RX_SPS-1
+        for (int o = 0; o < RX_SPS + Q_OFFSET; o++) {
+            rot[o] = (float complex)cexp(-I * 2.0 * M_PI * freq * (o - Q_OFFSET) / RX_SAMPLE_RATE);
+        }
+        double complex step = cexp(-I * 2.0 * M_PI * freq * RX_SPS / RX_SAMPLE_RATE);
+        double complex phasor = cexp(-I * 2.0 * M_PI * freq * (tau + RX_SPS * RX_ACQ_OFFSET)
+                                     / RX_SAMPLE_RATE);
+        float complex acc = 0.0f;
+        double energy = 0.0;
+
+        for (uint32_t k = 0; k < RX_ACQ_CHIPS; k++) {
+            uint32_t c = RX_ACQ_OFFSET + k;
+            const float complex *xi = &x[tau + RX_SPS * c];
+            const float complex *xq = xi - Q_OFFSET;
+            float complex si = 0.0f, sq = 0.0f;
+            for (int s = 1; s < RX_SPS; s++) {
+                si += pulse[s] * xi[s] * rot[s + Q_OFFSET];
+                sq += pulse[s] * xq[s] * rot[s];
+            }
+            acc += (ci[c] * si - I * (cq[c] * sq)) * (float complex)phasor;
+            phasor *= step;
+            if ((k + 1) % group == 0) {
+                energy += crealf(acc) * crealf(acc) + cimagf(acc) * cimagf(acc);
+                acc = 0.0f;
+            }
+        }
+        if (energy > best_energy) {
+            best_energy = energy;
+            best_freq = freq;
+        }
+    }
+    acq->freq_hz = best_freq;
+}
+
+static double fine_frequency(const float complex *y, uint32_t length, uint32_t tau,
+                             const int8_t *ci, const int8_t *cq) {
+    // Phase increment between consecutive 64-chip preamble segments
+    float complex prev = 0.0f, sum = 0.0f;
+    int first = 1;
+
+    for (uint32_t c0 = RX_ACQ_OFFSET; c0 + RX_FINE_SEGMENT <= PREAMBLE_CHIPS; c0 += RX_FINE_SEGMENT) {
+        if (tau + RX_SPS * (c0 + RX_FINE_SEGMENT) >= length) break;
+        float complex seg = 0.0f;
+        for (uint32_t c = c0; c < c0 + RX_FINE_SEGMENT; c++) {
+            uint32_t n = tau + RX_SPS * c;
+            seg += ci[c] * y[n] - I * (cq[c] * y[n - Q_OFFSET]);
+        }
+        if (!first) {
+            sum += seg * conjf(prev);
+        }
+        prev = seg;
+        first = 0;
+    }
+
+    return cargf(sum) * OQPSK_CHIP_RATE / (2.0 * M_PI * RX_FINE_SEGMENT);
+}
+
+// =============================================================================
+// STAGES 3-4: DESPREADING AND OQPSK DECISIONS
+// =============================================================================
+
+static void despread_bit(const float complex *y, uint32_t length, int32_t tau, uint32_t bit,
+                         const int8_t *ci, const int8_t *cq,
+                         float complex zi[3], float complex zq[3]) {
+    // Early (tau-1), prompt, late (tau+1)
+    for (int o = 0; o < 3; o++) {
+        zi[o] = 0.0f;
+        zq[o] = 0.0f;
+    }
+
+    for (uint32_t c = bit * PRN_CHIPS_PER_BIT; c < (bit + 1) * PRN_CHIPS_PER_BIT; c++) {
+        int32_t n = tau + RX_SPS * (int32_t)c;
+        if (n - Q_OFFSET - 1 < 0) continue;
+        if (n + 1 >= (int32_t)length) break;
+        float fi = ci[c], fq = cq[c];
+        zi[0] += fi * y[n - 1];
+        zi[1] += fi * y[n];
+        zi[2] += fi * y[n + 1];
+        zq[0] += fq * y[n - Q_OFFSET - 1];
+        zq[1] += fq * y[n - Q_OFFSET];
+        zq[2] += fq * y[n - Q_OFFSET + 1];
+    }
+}
+
+static void demodulate(const float complex *y, uint32_t length, uint32_t tau0,
+                       const int8_t *ci, const int8_t *cq, rx_result_t *res) {
+    uint8_t tx_bits[OQPSK_TOTAL_BITS];
+    const uint32_t preamble_per_channel = OQPSK_PREAMBLE_BITS / 2;
+
+    int32_t tau = (int32_t)tau0;
+    float phase = 0.0f, omega = 0.0f, dll = 0.0f;
+    double sum = 0.0, sum_sq = 0.0;
+    uint32_t count = 0;
+
+    for (uint32_t b = 0; b < OQPSK_BITS_PER_CHANNEL; b++) {
+        float complex zi[3], zq[3];
+        despread_bit(y, length, tau, b, ci, cq, zi, zq);
+
+        float complex rot = cexpf(-I * phase);
+        if (b == 1) {
+            // First full preamble bit sets the initial phase
+            phase = cargf(zi[1] - I * zq[1]);
+            rot = cexpf(-I * phase);
+        }
+
+        float complex u[3], v[3];
+        for (int o = 0; o < 3; o++) {
+            u[o] = zi[o] * rot;
+            v[o] = -I * zq[o] * rot;
+        }
+
+        // Preamble bits are known zeros (PRN not inverted)
+        float di = 1.0f, dq = 1.0f;
+        if (b >= preamble_per_channel) {
+            di = (crealf(u[1]) >= 0.0f) ? 1.0f : -1.0f;
+            dq = (crealf(v[1]) >= 0.0f) ? 1.0f : -1.0f;
+            sum += di * crealf(u[1]) + dq * crealf(v[1]);
+            sum_sq += crealf(u[1]) * crealf(u[1]) + crealf(v[1]) * crealf(v[1]);
+            count += 2;
+        }
+        tx_bits[2 * b] = di < 0.0f;
+        tx_bits[2 * b + 1] = dq < 0.0f;
+
+        // Carrier PLL (second order, per bit)
+        float complex prompt = di * u[1] + dq * v[1];
+        if (b >= 1) {
+            float err = cargf(prompt);
+            omega += RX_PLL_BETA * err;
+            phase += omega + RX_PLL_ALPHA * err;
+        }
+
+        // Early/late timing in whole samples
+        float mag = cabsf(prompt);
+        if (mag > 0.0f && b >= 1) {
+            dll += (cabsf(di * u[0] + dq * v[0]) - cabsf(di * u[2] + dq * v[2])) / mag;
+            if (dll > RX_DLL_THRESHOLD) {
+                tau--;
+                res->timing_steps--;
+                dll = 0.0f;
+            } else if (dll < -RX_DLL_THRESHOLD) {
+                tau++;
+                res->timing_steps++;
+                dll = 0.0f;
+            }
+        }
+    }
+
+    memcpy(res->message, &tx_bits[OQPSK_PREAMBLE_BITS], OQPSK_MESSAGE_BITS);
+
+    // Eb/N0 from the spread of the decision statistic
+    res->ebn0_db = 0.0f;
+    if (count > 1) {
+        double mean = sum / count;
+        double var = sum_sq / count - mean * mean;
+        if (var < mean * mean * 1e-9) var = mean * mean * 1e-9;
+        res->ebn0_db = (float)(10.0 * log10(mean * mean / (2.0 * var)));
+    }
+}
+
+// =============================================================================
+// STAGES 5-6: BCH AND FIELDS
+// =============================================================================
+
+static void decode_message(rx_result_t *res) {
+    uint8_t spec[T018_DATA_BITS];
+    memcpy(spec, res->message, T018_DATA_BITS);
+    int spec_errors = t018_bch_correct(spec);
+
+    // Header layout: the last two parity bits were not transmitted
+    uint8_t header[T018_DATA_BITS];
+    int header_errors = -1;
+    for (int guess = 0; guess < 4; guess++) {
+        uint8_t cw[T018_DATA_BITS];
+        memcpy(cw, &res->message[T018_HEADER_BITS], T018_DATA_BITS - T018_HEADER_BITS);
+        cw[T018_DATA_BITS - 2] = (guess >> 1) & 1;
+        cw[T018_DATA_BITS - 1] = guess & 1;
+        uint8_t guessed[2] = { cw[T018_DATA_BITS - 2], cw[T018_DATA_BITS - 1] };
+
+        int errors = t018_bch_correct(cw);
+        if (errors < 0) continue;
+        errors -= (cw[T018_DATA_BITS - 2] != guessed[0]) + (cw[T018_DATA_BITS - 1] != guessed[1]);
+        if (header_errors < 0 || errors < header_errors) {
+            header_errors = errors;
+            memcpy(header, cw, T018_DATA_BITS);
+        }
+    }
+
+    if (spec_errors >= 0 && (header_errors < 0 || spec_errors <= header_errors)) {
+        res->layout = RX_LAYOUT_SPEC;
+        res->bch_errors = spec_errors;
+        memcpy(res->codeword, spec, T018_DATA_BITS);
+    } else if (header_errors >= 0) {
+        res->layout = RX_LAYOUT_HEADER;
+        res->bch_errors = header_errors;
+        memcpy(res->codeword, header, T018_DATA_BITS);
+    } else {
+        res->bch_errors = -1;
+        res->status = RX_STATUS_BCH_FAIL;
+        return;
+    }
+
+    t018_decode_message(res->codeword, &res->fields);
+    res->status = RX_STATUS_OK;
+}
+
+// =============================================================================
+// BURST PROCESSING
+// =============================================================================
+
+static rx_status_t synchronize(rx_demod_t *dm, const float complex *capture,
+                               const float complex *y, uint32_t length, uint32_t search,
+                               rx_result_t *result, acq_result_t *acq) {
+    acquire(dm, y, length, search, acq);
+    result->acq_metric = acq->metric;
+    if (acq->metric < RX_ACQ_THRESHOLD) {
+        return RX_STATUS_NO_SYNC;
+    }
+
+    resolve_alias(capture, acq->tau, prn_get_frame_table(acq->mode, 0),
+                  prn_get_frame_table(acq->mode, 1), acq);
+    result->mode = acq->mode;
+    result->freq_hz = acq->freq_hz;
+    result->start_sample = acq->tau;
+
+    if (dm->max_offset_hz > 0.0 && fabs(acq->freq_hz) > dm->max_offset_hz) {
+        return RX_STATUS_OFF_CHANNEL;
+    }
+    return RX_STATUS_OK;
+}
+
+rx_status_t rx_demod_acquire(rx_demod_t *dm, const float complex *capture,
+                             uint32_t length, uint32_t search, rx_result_t *result) {
+    memset(result, 0, sizeof(rx_result_t));
+    result->bch_errors = -1;
+
+    if (length > dm->capacity) length = dm->capacity;
+    matched_filter(capture, length, dm->filtered);
+
+    acq_result_t acq;
+    result->status = synchronize(dm, capture, dm->filtered, length, search, result, &acq);
+    return result->status;
+}
+
+rx_status_t rx_demod_burst(rx_demod_t *dm, const float complex *capture,
+                           uint32_t length, uint32_t search, rx_result_t *result) {
+    memset(result, 0, sizeof(rx_result_t));
+    result->bch_errors = -1;
+
+    if (length > dm->capacity) length = dm->capacity;
+    float complex *y = dm->filtered;
+    matched_filter(capture, length, y);
+
+    acq_result_t acq;
+    result->status = synchronize(dm, capture, y, length, search, result, &acq);
+    if (result->status != RX_STATUS_OK) {
+        return result->status;
+    }
+
+    const int8_t *ci = prn_get_frame_table(acq.mode, 0);
+    const int8_t *cq = prn_get_frame_table(acq.mode, 1);
+
+    derotate(y, length, acq.freq_hz);
+    double residual = fine_frequency(y, length, acq.tau, ci, cq);
+    derotate(y, length, residual);
+    result->freq_hz = acq.freq_hz + residual;
+
+    demodulate(y, length, acq.tau, ci, cq, result);
+    decode_message(result);
+    return result->status;
+}
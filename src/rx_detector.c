@@ -0,0 +1,147 @@
+/**
+ * @file rx_detector.c
+ * @brief Energy-based burst detector implementation
+ */
+
+#include "rx_detector.h"
+#include <string.h>
+#include <math.h>
+
+// =============================================================================
+// INITIALIZATION
+// =============================================================================
+
+void rx_detector_init(rx_detector_t *det, float threshold_db, uint32_t capture_len) {
+    memset(det, 0, sizeof(rx_detector_t));
+    det->threshold = powf(10.0f, threshold_db / 10.0f);
+    det->floor = RX_DETECT_FLOOR_MIN;
+    det->capture_len = capture_len;
+}
+
+// =============================================================================
+// DETECTION
+// =============================================================================
+
+static void update_floor(rx_detector_t *det, float power) {
+    if (power < det->floor) {
+        det->floor += 0.25f * (power - det->floor);
+        det->foreign = 0;
+    } else if (!det->foreign) {
+        det->floor += (power - det->floor) / RX_DETECT_FLOOR_RISE;
+    }
+    if (det->floor < RX_DETECT_FLOOR_MIN) {
+        det->floor = RX_DETECT_FLOOR_MIN;
+    }
+}
+
+static void start_capture(rx_detector_t *det, float power) {
+    det->detections++;
+    det->trigger_power = power;
+
+    if (!det->capture) {
+        det->missed++;
+        det->holdoff = 1;
+        return;
+    }
+
+    // History ring, oldest sample first (ends with the trigger block)
+    rx_capture_t *cap = det->capture;
+    uint32_t tail = RX_DETECT_PREROLL - det->history_idx;
+    memcpy(cap->samples, &det->history[det->history_idx], tail * sizeof(float complex));
+    memcpy(cap->samples + tail, det->history, det->history_idx * sizeof(float complex));
+
+    cap->length = det->capture_len;
+    cap->start_sample = (int64_t)det->sample_index - RX_DETECT_PREROLL;
+    cap->floor_power = det->floor;
+    cap->peak_power = power;
+    cap->sequence = det->detections;
+
+    det->capture_fill = RX_DETECT_PREROLL;
+    det->capturing = 1;
+}
+
+static void end_block(rx_detector_t *det) {
+    float power = det->block_power / RX_DETECT_BLOCK;
+    det->block_power = 0.0f;
+    det->block_fill = 0;
+    det->last_power = power;
+
+    if (det->capturing) {
+        if (power > det->trigger_power * det->threshold) {
+            // Triggered on noise (stream start) or a weaker signal: restart on this one
+            det->floor = det->trigger_power;
+            det->detections--;
+            start_capture(det, power);
+        } else if (power > det->capture->peak_power) {
+            det->capture->peak_power = power;
+        }
+        return;
+    }
+
+    int above = power > det->floor * det->threshold;
+    if (det->holdoff) {
+        if (!above) det->holdoff = 0;
+    } else if (above) {
+        start_capture(det, power);
+        return;
+    }
+
+    update_floor(det, power);
+}
+
+uint32_t rx_detector_process(rx_detector_t *det, const float complex *samples,
+                             uint32_t num_samples, int *complete) {
+    *complete = 0;
+
+    for (uint32_t i = 0; i < num_samples; i++) {
+        float complex x = samples[i];
+
+        if (det->capturing) {
+            det->capture->samples[det->capture_fill++] = x;
+            if (det->capture_fill == det->capture_len) {
+                det->capturing = 0;
+                det->holdoff = 1;
+                det->block_power = 0.0f;
+                det->block_fill = 0;
+                det->sample_index++;
+                *complete = 1;
+                return i + 1;
+            }
+        }
+
+        det->history[det->history_idx] = x;
+        det->history_idx = (det->history_idx + 1) % RX_DETECT_PREROLL;
+        det->block_power += crealf(x) * crealf(x) + cimagf(x) * cimagf(x);
+        det->sample_index++;
+
+        if (++det->block_fill == RX_DETECT_BLOCK) {
+            end_block(det);
+        }
+    }
+
+    return num_samples;
+}
+
+int rx_detector_flush(rx_detector_t *det) {
+    if (!det->capturing) return 0;
+
+    memset(&det->capture->samples[det->capture_fill], 0,
+           (det->capture_len - det->capture_fill) * sizeof(float complex));
+    det->capture_fill = det->capture_len;
+    det->capturing = 0;
+    return 1;
+}
+
+void rx_detector_abort(rx_detector_t *det) {
+    if (!det->capturing) return;
+
+    // What triggered is somebody else's signal: it becomes background, and a
+    // burst of our own on top of it only has to add half the threshold
+    det->capturing = 0;
+    det->capture_fill = 0;
+    float level = det->last_power / sqrtf(det->threshold);
+    if (level > det->floor) {
+        det->floor = level;
+    }
+    det->foreign = 1;
+}
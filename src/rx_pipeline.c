@@ -0,0 +1,744 @@
+/**
+ * @file rx_pipeline.c
+ * @brief Multi-threaded streaming receiver implementation
+ *
+ * All buffers are allocated up front and circulate between free and full
+ * queues, so the steady state performs no allocation. Each queue is a
+ * fixed ring of pointers protected by a mutex with two condition variables.
+ */
+
+#include "rx_pipeline.h"
+#include "rx_detector.h"
+#include "rx_demod.h"
+#include "resampler.h"
+#include "channelizer.h"
+#include "beacon_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <signal.h>
+#include <pthread.h>
+#include <time.h>
+
+#define CAPTURE_SAMPLES     (RX_DETECT_PREROLL + RX_BURST_SAMPLES + RX_CAPTURE_MARGIN)
+#define EARLY_CHECK_SAMPLES (RX_DETECT_PREROLL + RX_SPS * (RX_ACQ_OFFSET + RX_ACQ_CHIPS + 1))
+
+// Bounded pointer queue
+typedef struct {
+    void *items[RX_QUEUE_BLOCKS];
+    uint32_t head;
+    uint32_t count;
+    uint8_t closed;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+} rx_queue_t;
+
+// Source block (or channel block in channelized mode)
+typedef struct {
+    float complex *samples;                 // RX_SOURCE_BLOCK samples
+    int count;
+} rx_block_t;
+
+// Channelizer output stream and its thread (channelized mode)
+typedef struct {
+    struct rx_pipeline *pipeline;
+    uint32_t index;
+    double offset_hz;                       // Channel center relative to the tuning
+    rx_queue_t free_blocks;
+    rx_queue_t full_blocks;
+    rx_block_t blocks[RX_QUEUE_BLOCKS];
+    float complex *overrun;                 // Live: output of a block with no free buffer
+    rx_capture_t capture;                   // Decoded inline, one buffer is enough
+    rx_detector_t detector;
+} rx_channel_t;
+
+// Pipeline state shared by all threads
+typedef struct rx_pipeline {
+    const rx_pipeline_config_t *config;
+    rx_stats_t *stats;
+    pthread_mutex_t stats_lock;             // Statistics and console output
+
+    rx_queue_t free_blocks;
+    rx_queue_t full_blocks;
+    rx_queue_t free_captures;
+    rx_queue_t decode_queue;
+    rx_block_t blocks[RX_QUEUE_BLOCKS];
+    rx_capture_t captures[RX_CAPTURE_BUFFERS];
+
+    // Front-end (front-end thread only)
+    uint8_t resample;
+    resampler_state_t resampler;
+    float complex *resampled;
+    rx_detector_t detector;
+
+    // Channelized mode
+    channelizer_t channelizer;
+    rx_channel_t *channels;
+    uint32_t num_channels;
+    uint32_t channel_block;                 // Channel samples per source block (max)
+
+    // Reporting (under stats_lock)
+    uint32_t bursts;
+    beacon_index_t beacons;                 // Deduplication and per-beacon history
+
+    int error;
+} rx_pipeline_t;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+// =============================================================================
+// QUEUES
+// =============================================================================
+
+static void queue_init(rx_queue_t *q) {
+    memset(q->items, 0, sizeof(q->items));
+    q->head = 0;
+    q->count = 0;
+    q->closed = 0;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+}
+
+static void queue_destroy(rx_queue_t *q) {
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+}
+
+static int queue_push(rx_queue_t *q, void *item) {
+    pthread_mutex_lock(&q->lock);
+    while (q->count == RX_QUEUE_BLOCKS && !q->closed) {
+        pthread_cond_wait(&q->not_full, &q->lock);
+    }
+    if (q->closed) {
+        pthread_mutex_unlock(&q->lock);
+        return -1;
+    }
+    q->items[(q->head + q->count) % RX_QUEUE_BLOCKS] = item;
+    q->count++;
+    pthread_cond_signal(&q->not_empty);
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+static void *queue_pop(rx_queue_t *q, int block) {
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0 && !q->closed && block) {
+        pthread_cond_wait(&q->not_empty, &q->lock);
+    }
+    void *item = NULL;
+    if (q->count > 0) {
+        item = q->items[q->head];
+        q->head = (q->head + 1) % RX_QUEUE_BLOCKS;
+        q->count--;
+        pthread_cond_signal(&q->not_full);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return item;
+}
+
+static void queue_close(rx_queue_t *q) {
+    pthread_mutex_lock(&q->lock);
+    q->closed = 1;
+    pthread_cond_broadcast(&q->not_empty);
+    pthread_cond_broadcast(&q->not_full);
+    pthread_mutex_unlock(&q->lock);
+}
+
+// =============================================================================
+// REPORTING
+// =============================================================================
+
+static void print_hex(const uint8_t *bits, int num_bits) {
+    for (int i = 0; i < num_bits; i += 4) {
+        uint8_t nibble = 0;
+        for (int j = 0; j < 4; j++) {
+            nibble = (nibble << 1) | ((i + j < num_bits) ? bits[i + j] : 0);
+        }
+        printf("%X", nibble);
+    }
+}
+
+static void report(rx_pipeline_t *p, const rx_channel_t *chan, const rx_capture_t *cap,
+                   const rx_result_t *res) {
+    pthread_mutex_lock(&p->stats_lock);
+
+    rx_stats_t *st = p->stats;
+    double t = (cap->start_sample + res->start_sample) / (double)RX_SAMPLE_RATE;
+
+    // Copies of one burst (neighbouring channels) share the beacon ID
+    t018_beacon_id_t id;
+    beacon_event_t event = BEACON_FULL;
+    double previous = 0.0;
+    const beacon_entry_t *beacon = NULL;
+    if (res->status == RX_STATUS_OK) {
+        t018_beacon_id(res->codeword, &id);
+        beacon = beacon_index_find(&p->beacons, &id);
+        previous = beacon ? beacon->last_seen : 0.0;
+        event = beacon_index_observe(&p->beacons, &id, t, &res->fields, &beacon);
+        if (event == BEACON_DUPLICATE) {
+            st->duplicates++;
+            pthread_mutex_unlock(&p->stats_lock);
+            return;
+        }
+        if (event == BEACON_NEW) st->beacons++;
+    }
+
+    switch (res->status) {
+    case RX_STATUS_OK:
+        st->decoded++;
+        if (res->bch_errors > 0) st->corrected++;
+        break;
+    case RX_STATUS_BCH_FAIL:
+        st->bch_failed++;
+        break;
+    default:
+        st->no_sync++;                      // Also RX_STATUS_OFF_CHANNEL
+        break;
+    }
+
+    if ((res->status == RX_STATUS_NO_SYNC || res->status == RX_STATUS_OFF_CHANNEL) &&
+        !p->config->verbose) {
+        pthread_mutex_unlock(&p->stats_lock);
+        return;
+    }
+
+    float snr_db = 10.0f * log10f(cap->peak_power / cap->floor_power);
+    double offset_hz = chan ? chan->offset_hz : 0.0;
+    printf("\n[burst %u]", ++p->bursts);
+    if (chan) {
+        printf(" ch %+d (%+.1f kHz)", (int)chan->index - (int)(p->num_channels - 1) / 2,
+               offset_hz / 1000.0);
+    }
+    printf(" t=%.3f s  level=%+.1f dB", t, snr_db);
+
+    if (res->status == RX_STATUS_NO_SYNC) {
+        printf("  no preamble correlation (peak %.1f < %.1f)\n",
+               res->acq_metric, RX_ACQ_THRESHOLD);
+    } else if (res->status == RX_STATUS_OFF_CHANNEL) {
+        printf("  carrier at %+.1f Hz belongs to another channel\n",
+               offset_hz + res->freq_hz);
+    } else {
+        printf("  %s PRN  f=%+.1f Hz  Eb/N0=%.1f dB  timing %+d\n",
+               res->mode ? "self-test" : "normal", offset_hz + res->freq_hz, res->ebn0_db,
+               res->timing_steps);
+        printf("  Message: ");
+        print_hex(res->message, OQPSK_MESSAGE_BITS);
+        printf("\n");
+
+        if (res->status == RX_STATUS_OK) {
+            printf("  ✓ BCH valid (%d bit error%s corrected, %s layout)\n",
+                   res->bch_errors, res->bch_errors == 1 ? "" : "s",
+                   res->layout == RX_LAYOUT_SPEC ? "T.018" : "2-bit header");
+            t018_print_message(&res->fields);
+
+            char hex[24];
+            t018_format_beacon_id(&id, hex);
+            if (event == BEACON_NEW) {
+                printf("  Beacon ID: %s (new)\n", hex);
+            } else if (event == BEACON_REPEAT) {
+                printf("  Beacon ID: %s (burst %u, %.1f s after the previous one)\n",
+                       hex, beacon->bursts, t - previous);
+            } else {
+                printf("  Beacon ID: %s (index full, not tracked)\n", hex);
+            }
+        } else {
+            printf("  ✗ BCH uncorrectable (more than 6 bit errors)\n");
+        }
+    }
+    fflush(stdout);
+
+    pthread_mutex_unlock(&p->stats_lock);
+}
+
+// =============================================================================
+// THREADS
+// =============================================================================
+
+static void *reader_thread(void *arg) {
+    rx_pipeline_t *p = arg;
+    rx_source_t *src = p->config->source;
+    float complex *scratch = NULL;
+
+    if (src->live) {
+        scratch = malloc(RX_SOURCE_BLOCK * sizeof(float complex));
+    }
+
+    while (!stop_requested) {
+        rx_block_t *blk = queue_pop(&p->free_blocks, !src->live);
+        int n;
+
+        if (!blk) {
+            // Live overrun: keep draining the device, drop the block
+            if (!scratch || (n = rx_source_read(src, scratch)) <= 0) break;
+            pthread_mutex_lock(&p->stats_lock);
+            p->stats->dropped_blocks++;
+            pthread_mutex_unlock(&p->stats_lock);
+            continue;
+        }
+
+        n = rx_source_read(src, blk->samples);
+        if (n <= 0) {
+            if (n < 0) p->error = 1;
+            break;
+        }
+        blk->count = n;
+        queue_push(&p->full_blocks, blk);
+    }
+
+    free(scratch);
+    queue_close(&p->full_blocks);
+    return NULL;
+}
+
+static void feed_detector(rx_pipeline_t *p, const float complex *x, uint32_t n) {
+    rx_detector_t *det = &p->detector;
+    int live = p->config->source->live;
+
+    while (n > 0) {
+        if (!det->capture) {
+            det->capture = queue_pop(&p->free_captures, !live);
+        }
+
+        int complete;
+        uint32_t used = rx_detector_process(det, x, n, &complete);
+        if (complete) {
+            queue_push(&p->decode_queue, det->capture);
+            det->capture = NULL;
+        }
+        x += used;
+        n -= used;
+    }
+}
+
+static void channelize(rx_pipeline_t *p, const float complex *x, uint32_t n) {
+    float complex *out[RX_MAX_CHANNELS];
+    rx_block_t *blk[RX_MAX_CHANNELS];
+    int live = p->config->source->live;
+
+    // Channelizer writes straight into each channel's next block
+    for (uint32_t c = 0; c < p->num_channels; c++) {
+        rx_channel_t *ch = &p->channels[c];
+        blk[c] = queue_pop(&ch->free_blocks, !live);
+        out[c] = blk[c] ? blk[c]->samples : ch->overrun;
+    }
+
+    uint32_t produced = channelizer_process(&p->channelizer, x, n, out);
+
+    for (uint32_t c = 0; c < p->num_channels; c++) {
+        if (!blk[c]) {
+            pthread_mutex_lock(&p->stats_lock);
+            p->stats->dropped_blocks++;
+            pthread_mutex_unlock(&p->stats_lock);
+            continue;
+        }
+        blk[c]->count = (int)produced;
+        queue_push(&p->channels[c].full_blocks, blk[c]);
+    }
+}
+
+static void frontend_output(rx_pipeline_t *p, const float complex *x, uint32_t n) {
+    if (p->num_channels) {
+        channelize(p, x, n);
+    } else {
+        feed_detector(p, x, n);
+    }
+}
+
+static void *frontend_thread(void *arg) {
+    rx_pipeline_t *p = arg;
+    rx_block_t *blk;
+
+    while ((blk = queue_pop(&p->full_blocks, 1)) != NULL) {
+        if (p->resample) {
+            uint32_t n = resampler_process(&p->resampler, blk->samples, blk->count, p->resampled);
+            frontend_output(p, p->resampled, n);
+        } else {
+            frontend_output(p, blk->samples, blk->count);
+        }
+
+        pthread_mutex_lock(&p->stats_lock);
+        p->stats->samples += blk->count;
+        pthread_mutex_unlock(&p->stats_lock);
+
+        queue_push(&p->free_blocks, blk);
+    }
+
+    // End of stream: emit resampler tail and a burst cut by the end of input
+    if (p->resample) {
+        uint32_t n = resampler_flush(&p->resampler, p->resampled);
+        frontend_output(p, p->resampled, n);
+    }
+
+    if (p->num_channels) {
+        for (uint32_t c = 0; c < p->num_channels; c++) {
+            queue_close(&p->channels[c].full_blocks);
+        }
+        return NULL;
+    }
+
+    if (p->detector.capture && rx_detector_flush(&p->detector)) {
+        queue_push(&p->decode_queue, p->detector.capture);
+        p->detector.capture = NULL;
+    }
+
+    pthread_mutex_lock(&p->stats_lock);
+    p->stats->detections = p->detector.detections;
+    p->stats->dropped_captures = p->detector.missed;
+    pthread_mutex_unlock(&p->stats_lock);
+
+    queue_close(&p->decode_queue);
+    return NULL;
+}
+
+static void *decoder_thread(void *arg) {
+    rx_pipeline_t *p = arg;
+    rx_demod_t dm;
+    int ready = (rx_demod_init(&dm, CAPTURE_SAMPLES) == 0);
+
+    if (!ready) {
+        p->error = 1;
+    }
+
+    // Without scratch space captures are still recycled so the front-end never stalls
+    rx_capture_t *cap;
+    while ((cap = queue_pop(&p->decode_queue, 1)) != NULL) {
+        if (ready) {
+            rx_result_t res;
+            rx_demod_burst(&dm, cap->samples, cap->length, RX_DETECT_PREROLL, &res);
+            report(p, NULL, cap, &res);
+        }
+        queue_push(&p->free_captures, cap);
+    }
+
+    if (ready) {
+        rx_demod_free(&dm);
+    }
+    return NULL;
+}
+
+static void *channel_thread(void *arg) {
+    rx_channel_t *ch = arg;
+    rx_pipeline_t *p = ch->pipeline;
+    rx_detector_t *det = &ch->detector;
+    rx_demod_t dm;
+    int ready = (rx_demod_init(&dm, CAPTURE_SAMPLES) == 0);
+    rx_result_t res;
+    int64_t checked = INT64_MIN;            // start_sample of the last checked capture
+    uint32_t aborted = 0;
+
+    if (!ready) {
+        p->error = 1;
+    }
+    dm.max_offset_hz = RX_CHANNEL_SPACING / 2.0;
+
+    rx_block_t *blk;
+    while ((blk = queue_pop(&ch->full_blocks, 1)) != NULL) {
+        const float complex *x = blk->samples;
+        uint32_t n = (uint32_t)blk->count;
+
+        while (n > 0) {
+            // Neighbouring channels trigger on each other's bursts: acquire as
+            // soon as the preamble window is in, give the channel back if this
+            // burst is not ours
+            uint32_t chunk = n;
+            int check = det->capturing && ch->capture.start_sample != checked;
+            if (check && det->capture_fill < EARLY_CHECK_SAMPLES &&
+                EARLY_CHECK_SAMPLES - det->capture_fill < chunk) {
+                chunk = EARLY_CHECK_SAMPLES - det->capture_fill;
+            }
+
+            int complete;
+            uint32_t used = rx_detector_process(det, x, chunk, &complete);
+            x += used;
+            n -= used;
+
+            if (ready && det->capturing && ch->capture.start_sample != checked &&
+                det->capture_fill >= EARLY_CHECK_SAMPLES) {
+                checked = ch->capture.start_sample;
+                if (rx_demod_acquire(&dm, ch->capture.samples, det->capture_fill,
+                                     RX_DETECT_PREROLL, &res) != RX_STATUS_OK) {
+                    rx_detector_abort(det);
+                    aborted++;
+                }
+            }
+            if (complete && ready) {
+                rx_demod_burst(&dm, ch->capture.samples, ch->capture.length,
+                               RX_DETECT_PREROLL, &res);
+                report(p, ch, &ch->capture, &res);
+            }
+        }
+        queue_push(&ch->free_blocks, blk);
+    }
+
+    if (rx_detector_flush(det) && ready) {
+        rx_demod_burst(&dm, ch->capture.samples, ch->capture.length, RX_DETECT_PREROLL, &res);
+        report(p, ch, &ch->capture, &res);
+    }
+
+    pthread_mutex_lock(&p->stats_lock);
+    p->stats->detections += det->detections - aborted;
+    p->stats->foreign += aborted;
+    pthread_mutex_unlock(&p->stats_lock);
+
+    if (ready) {
+        rx_demod_free(&dm);
+    }
+    return NULL;
+}
+
+// =============================================================================
+// PIPELINE
+// =============================================================================
+
+static double clock_sec(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int channels_alloc(rx_pipeline_t *p, uint32_t max_input) {
+    uint32_t n = p->config->channels;
+    if (channelizer_init(&p->channelizer, RX_CHANNEL_FFT, RX_CHANNEL_DECIMATION,
+                         RX_CHANNEL_TAPS, RX_CHANNEL_CUTOFF, n) < 0) {
+        return -1;
+    }
+
+    p->channels = calloc(n, sizeof(rx_channel_t));
+    if (!p->channels) return -1;
+    p->num_channels = n;
+    p->channel_block = max_input / RX_CHANNEL_DECIMATION + 1;
+
+    for (uint32_t c = 0; c < n; c++) {
+        rx_channel_t *ch = &p->channels[c];
+        ch->pipeline = p;
+        ch->index = c;
+        ch->offset_hz = channelizer_offset(&p->channelizer, c, RX_CHANNEL_RATE);
+        queue_init(&ch->free_blocks);
+        queue_init(&ch->full_blocks);
+    }
+
+    for (uint32_t c = 0; c < n; c++) {
+        rx_channel_t *ch = &p->channels[c];
+        for (int i = 0; i < RX_QUEUE_BLOCKS; i++) {
+            ch->blocks[i].samples = malloc(p->channel_block * sizeof(float complex));
+            if (!ch->blocks[i].samples) return -1;
+            queue_push(&ch->free_blocks, &ch->blocks[i]);
+        }
+        ch->overrun = malloc(p->channel_block * sizeof(float complex));
+        ch->capture.samples = malloc(CAPTURE_SAMPLES * sizeof(float complex));
+        if (!ch->overrun || !ch->capture.samples) return -1;
+        rx_detector_init(&ch->detector, p->config->threshold_db, CAPTURE_SAMPLES);
+        ch->detector.capture = &ch->capture;
+    }
+    return 0;
+}
+
+static int pipeline_alloc(rx_pipeline_t *p) {
+    for (int i = 0; i < RX_QUEUE_BLOCKS; i++) {
+        p->blocks[i].samples = malloc(RX_SOURCE_BLOCK * sizeof(float complex));
+        if (!p->blocks[i].samples) return -1;
+        queue_push(&p->free_blocks, &p->blocks[i]);
+    }
+    for (int i = 0; i < RX_CAPTURE_BUFFERS && !p->config->channels; i++) {
+        p->captures[i].samples = malloc(CAPTURE_SAMPLES * sizeof(float complex));
+        if (!p->captures[i].samples) return -1;
+        queue_push(&p->free_captures, &p->captures[i]);
+    }
+
+    uint32_t rate = p->config->source->sample_rate;
+    uint32_t target = p->config->channels ? RX_CHANNEL_RATE : RX_SAMPLE_RATE;
+    uint32_t max_output = RX_SOURCE_BLOCK;
+    p->resample = (rate != target);
+    if (p->resample) {
+        if (resampler_init(&p->resampler, rate, target) < 0) return -1;
+        uint32_t max_in = RX_SOURCE_BLOCK + resampler_delay(&p->resampler);
+        max_output = resampler_max_output(&p->resampler, max_in);
+        p->resampled = malloc(max_output * sizeof(float complex));
+        if (!p->resampled) return -1;
+    }
+
+    if (p->config->channels) {
+        return channels_alloc(p, max_output);
+    }
+    return 0;
+}
+
+static void pipeline_free(rx_pipeline_t *p) {
+    for (int i = 0; i < RX_QUEUE_BLOCKS; i++) {
+        free(p->blocks[i].samples);
+    }
+    for (int i = 0; i < RX_CAPTURE_BUFFERS; i++) {
+        free(p->captures[i].samples);
+    }
+    if (p->resample) {
+        resampler_free(&p->resampler);
+    }
+    free(p->resampled);
+
+    if (p->channels) {
+        for (uint32_t c = 0; c < p->num_channels; c++) {
+            rx_channel_t *ch = &p->channels[c];
+            for (int i = 0; i < RX_QUEUE_BLOCKS; i++) {
+                free(ch->blocks[i].samples);
+            }
+            free(ch->overrun);
+            free(ch->capture.samples);
+            queue_destroy(&ch->free_blocks);
+            queue_destroy(&ch->full_blocks);
+        }
+        free(p->channels);
+        channelizer_free(&p->channelizer);
+    }
+}
+
+static void print_beacons(const beacon_index_t *idx) {
+    if (idx->count == 0) {
+        return;
+    }
+
+    printf("\nBeacons heard: %u\n", idx->count);
+    uint32_t pos = 0, listed = 0;
+    const beacon_entry_t *e;
+    while ((e = beacon_index_next(idx, &pos)) != NULL) {
+        if (listed++ == RX_BEACON_LIST) {
+            printf("  ... and %u more\n", idx->count - RX_BEACON_LIST);
+            break;
+        }
+        char hex[24];
+        t018_format_beacon_id(&e->id, hex);
+        printf("  %s  %4u burst%s  t=%.1f..%.1f s  %.4f° %.4f°\n", hex, e->bursts,
+               e->bursts == 1 ? " " : "s", e->first_seen, e->last_seen,
+               e->latitude, e->longitude);
+    }
+}
+
+int rx_pipeline_run(const rx_pipeline_config_t *config, rx_stats_t *stats) {
+    memset(stats, 0, sizeof(rx_stats_t));
+
+    rx_pipeline_t *p = calloc(1, sizeof(rx_pipeline_t));
+    if (!p) {
+        fprintf(stderr, "Failed to allocate receiver pipeline\n");
+        return -1;
+    }
+    p->config = config;
+    p->stats = stats;
+    pthread_mutex_init(&p->stats_lock, NULL);
+    queue_init(&p->free_blocks);
+    queue_init(&p->full_blocks);
+    queue_init(&p->free_captures);
+    queue_init(&p->decode_queue);
+    rx_detector_init(&p->detector, config->threshold_db, CAPTURE_SAMPLES);
+
+    int ret = 0;
+    if (beacon_index_init(&p->beacons, RX_BEACON_CAPACITY, RX_BEACON_EXPIRY,
+                          RX_DEDUP_WINDOW) < 0 || pipeline_alloc(p) < 0) {
+        fprintf(stderr, "Failed to allocate receiver buffers\n");
+        ret = -1;
+        goto out;
+    }
+
+    uint32_t workers = config->workers;
+    if (workers < 1) workers = 1;
+    if (workers > RX_MAX_WORKERS) workers = RX_MAX_WORKERS;
+
+    if (p->num_channels) {
+        printf("✓ Receiver pipeline: %u Hz → %u Hz, %u channels × %u Hz "
+               "(%+.1f..%+.1f kHz), threshold %.1f dB, one thread per channel\n",
+               config->source->sample_rate, RX_CHANNEL_RATE, p->num_channels, RX_SAMPLE_RATE,
+               p->channels[0].offset_hz / 1000.0,
+               p->channels[p->num_channels - 1].offset_hz / 1000.0, config->threshold_db);
+    } else {
+        printf("✓ Receiver pipeline: %u Hz → %u Hz (%d samples/chip), threshold %.1f dB, "
+               "%u decoder thread%s\n",
+               config->source->sample_rate, RX_SAMPLE_RATE, RX_SPS, config->threshold_db,
+               workers, workers == 1 ? "" : "s");
+    }
+
+    uint32_t span = 2 * OQPSK_CHIP_RATE + p->num_channels * RX_CHANNEL_SPACING;
+    if (p->num_channels && config->source->sample_rate < span) {
+        printf("⚠ Sample rate %u Hz is narrower than the channels (~%u Hz): "
+               "edge channels will not decode\n", config->source->sample_rate, span);
+    } else if (config->source->sample_rate < 2 * OQPSK_CHIP_RATE) {
+        printf("⚠ Sample rate %u Hz is narrower than the burst (~%d Hz): decoding unlikely\n",
+               config->source->sample_rate, 2 * OQPSK_CHIP_RATE);
+    }
+
+    double wall_start = clock_sec(CLOCK_MONOTONIC);
+    double cpu_start = clock_sec(CLOCK_PROCESS_CPUTIME_ID);
+
+    pthread_t reader, frontend, decoders[RX_MAX_WORKERS + RX_MAX_CHANNELS];
+    uint32_t started = 0;
+    pthread_create(&frontend, NULL, frontend_thread, p);
+    if (p->num_channels) {
+        for (; started < p->num_channels; started++) {
+            if (pthread_create(&decoders[started], NULL, channel_thread,
+                               &p->channels[started]) != 0) break;
+        }
+        for (uint32_t c = started; c < p->num_channels; c++) {
+            queue_close(&p->channels[c].free_blocks);       // Never block on a dead channel
+            p->error = 1;
+        }
+    } else {
+        for (; started < workers; started++) {
+            if (pthread_create(&decoders[started], NULL, decoder_thread, p) != 0) break;
+        }
+    }
+    pthread_create(&reader, NULL, reader_thread, p);
+
+    pthread_join(reader, NULL);
+    pthread_join(frontend, NULL);
+    for (uint32_t i = 0; i < started; i++) {
+        pthread_join(decoders[i], NULL);
+    }
+
+    stats->wall_sec = clock_sec(CLOCK_MONOTONIC) - wall_start;
+    stats->cpu_sec = clock_sec(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    if (p->error) ret = -1;
+    print_beacons(&p->beacons);
+
+out:
+    pipeline_free(p);
+    beacon_index_free(&p->beacons);
+    queue_destroy(&p->free_blocks);
+    queue_destroy(&p->full_blocks);
+    queue_destroy(&p->free_captures);
+    queue_destroy(&p->decode_queue);
+    pthread_mutex_destroy(&p->stats_lock);
+    free(p);
+    return ret;
+}
+
+void rx_pipeline_stop(void) {
+    stop_requested = 1;
+}
+
+void rx_pipeline_print_stats(const rx_stats_t *stats, uint32_t sample_rate) {
+    double duration = (double)stats->samples / sample_rate;
+
+    printf("\nReceiver statistics:\n");
+    printf("  Input: %llu samples (%.2f s at %u Hz)\n",
+           (unsigned long long)stats->samples, duration, sample_rate);
+    printf("  Detections: %u  Decoded: %u (%u corrected)  BCH failed: %u  No sync: %u\n",
+           stats->detections, stats->decoded, stats->corrected,
+           stats->bch_failed, stats->no_sync);
+    if (stats->beacons) {
+        printf("  Beacons: %u distinct IDs\n", stats->beacons);
+    }
+    if (stats->foreign || stats->duplicates) {
+        printf("  Channels: %u triggers on neighbouring bursts, %u messages also decoded "
+               "on a neighbouring channel\n", stats->foreign, stats->duplicates);
+    }
+    if (stats->dropped_blocks || stats->dropped_captures) {
+        printf("  ⚠ Dropped: %u input blocks, %u captures (receiver overloaded)\n",
+               stats->dropped_blocks, stats->dropped_captures);
+    }
+    if (stats->wall_sec > 0.0 && duration > 0.0) {
+        printf("  Processing: %.2f s wall, %.2f s CPU → %.1f× real time, %.1f%% of one core\n",
+               stats->wall_sec, stats->cpu_sec, duration / stats->wall_sec,
+               100.0 * stats->cpu_sec / duration);
+    }
+}
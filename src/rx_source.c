@@ -0,0 +1,520 @@
+/**
+ * @file rx_source.c
+ * @brief Receiver I/Q input implementation
+ *
+ * File sources are read block by block (no full-file buffering) so hour-long
+ * recordings stream through the receiver with constant memory. WAV files
+ * recorded from an audio demodulator (e.g. gqrx "AM/FM" output) carry the
+ * same signal on both channels; they are accepted but flagged, since a
+ * DSSS burst cannot be despread without the quadrature component.
+ */
+
+#include "rx_source.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <time.h>
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static int has_suffix(const char *s, const char *suffix) {
+    size_t ls = strlen(s), lx = strlen(suffix);
+    return ls >= lx && strcasecmp(s + ls - lx, suffix) == 0;
+}
+
+static uint32_t read_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t bytes_per_sample(rx_source_type_t type) {
+    switch (type) {
+    case RX_SOURCE_CI16:
+    case RX_SOURCE_WAV16:
+    case RX_SOURCE_SGIQ:
+        return 4;
+    default:
+        return 8;
+    }
+}
+
+static const char *json_value(const char *json, const char *key) {
+    // Minimal lookup: "key" : value (SigMF global object keys are unique)
+    const char *p = strstr(json, key);
+    if (!p) return NULL;
+    p = strchr(p + strlen(key), ':');
+    if (!p) return NULL;
+    p++;
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+    return p;
+}
+
+// =============================================================================
+// SIGMF
+// =============================================================================
+
+static int open_sigmf(rx_source_t *src, const char *base) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s.sigmf-meta", base);
+
+    FILE *meta = fopen(path, "r");
+    if (!meta) {
+        fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    char json[16384];
+    size_t len = fread(json, 1, sizeof(json) - 1, meta);
+    json[len] = '\0';
+    fclose(meta);
+
+    const char *datatype = json_value(json, "\"core:datatype\"");
+    const char *rate = json_value(json, "\"core:sample_rate\"");
+    if (!datatype || !rate) {
+        fprintf(stderr, "%s: missing core:datatype or core:sample_rate\n", path);
+        return -1;
+    }
+
+    if (strncmp(datatype, "\"cf32_le\"", 9) == 0) {
+        src->type = RX_SOURCE_CF32;
+    } else if (strncmp(datatype, "\"ci16_le\"", 9) == 0) {
+        src->type = RX_SOURCE_CI16;
+    } else {
+        fprintf(stderr, "%s: unsupported datatype (cf32_le and ci16_le only)\n", path);
+        return -1;
+    }
+    src->sample_rate = (uint32_t)strtod(rate, NULL);
+
+    snprintf(path, sizeof(path), "%s.sigmf-data", base);
+    src->file = fopen(path, "rb");
+    if (!src->file) {
+        fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    src->data_remaining = UINT64_MAX;
+
+    printf("✓ SigMF input: %s (%s, %u Hz)\n", path,
+           src->type == RX_SOURCE_CF32 ? "cf32_le" : "ci16_le", src->sample_rate);
+    return 0;
+}
+
+// =============================================================================
+// WAV
+// =============================================================================
+
+static int open_wav(rx_source_t *src, const char *path) {
+    src->file = fopen(path, "rb");
+    if (!src->file) {
+        fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    uint8_t riff[12];
+    if (fread(riff, 1, 12, src->file) != 12 ||
+        memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) {
+        fprintf(stderr, "%s: not a RIFF/WAVE file\n", path);
+        return -1;
+    }
+
+    uint16_t format = 0, channels = 0, bits = 0;
+    for (;;) {
+        uint8_t chunk[8];
+        if (fread(chunk, 1, 8, src->file) != 8) {
+            fprintf(stderr, "%s: no data chunk\n", path);
+            return -1;
+        }
+        uint32_t size = read_le32(chunk + 4);
+
+        if (memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t fmt[40] = {0};
+            uint32_t want = size < sizeof(fmt) ? size : sizeof(fmt);
+            if (fread(fmt, 1, want, src->file) != want) return -1;
+            format = read_le16(fmt);
+            channels = read_le16(fmt + 2);
+            src->sample_rate = read_le32(fmt + 4);
+            bits = read_le16(fmt + 14);
+            if (format == 0xFFFE && want >= 26) {
+                format = read_le16(fmt + 24);   // WAVE_FORMAT_EXTENSIBLE sub-format
+            }
+            if (fseek(src->file, (long)(size - want + (size & 1)), SEEK_CUR) != 0) return -1;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            src->data_remaining = size;
+            break;
+        } else if (fseek(src->file, (long)(size + (size & 1)), SEEK_CUR) != 0) {
+            return -1;
+        }
+    }
+
+    if (channels != 2) {
+        fprintf(stderr, "%s: %u channel(s), I/Q input needs 2\n", path, channels);
+        return -1;
+    }
+    if (format == 1 && bits == 16) {
+        src->type = RX_SOURCE_WAV16;
+    } else if (format == 3 && bits == 32) {
+        src->type = RX_SOURCE_WAV32F;
+    } else {
+        fprintf(stderr, "%s: unsupported WAV format %u/%u-bit (16-bit PCM or 32-bit float)\n",
+                path, format, bits);
+        return -1;
+    }
+
+    printf("✓ WAV input: %s (%u Hz, %s, %.1f s)\n", path, src->sample_rate,
+           src->type == RX_SOURCE_WAV16 ? "16-bit" : "float",
+           (double)src->data_remaining / bytes_per_sample(src->type) / src->sample_rate);
+    return 0;
+}
+
+// =============================================================================
+// BURST RECORDINGS
+// =============================================================================
+
+static int open_bursts(rx_source_t *src, const char *path, uint32_t sample_rate) {
+    if (burst_recording_load(&src->bursts, path) < 0) {
+        return -1;
+    }
+    src->type = RX_SOURCE_BURSTS;
+    src->sample_rate = sample_rate ? sample_rate : BURST_RECORD_DEFAULT_RATE;
+    src->burst_samples = burst_recording_samples(&src->bursts, src->sample_rate);
+
+    printf("✓ Burst recording: %s (%u bursts, %.1f s, synthesized at %u Hz)\n", path,
+           src->bursts.count, src->bursts.duration, src->sample_rate);
+    return 0;
+}
+
+static int open_shm(rx_source_t *src, const char *uri) {
+    if (shm_ring_open(&src->shm, uri + 4, 1) < 0) {
+        return -1;
+    }
+    src->type = RX_SOURCE_SHM;
+    src->sample_rate = atomic_load(&src->shm.hdr->sample_rate);
+    printf("✓ Reading shared memory ring /dev/shm%s (%u Hz, %llu-sample ring)\n",
+           src->shm.path, src->sample_rate, (unsigned long long)src->shm.hdr->capacity);
+    return 0;
+}
+
+static int read_shm(rx_source_t *src, float complex *out) {
+    for (;;) {
+        const float complex *samples;
+        int64_t n = shm_ring_peek(&src->shm, &samples, RX_SOURCE_BLOCK);
+        if (n < 0 || src->cancelled) {
+            return 0;                       // Producer closed the ring, or stop requested
+        }
+        if (n > 0) {
+            memcpy(out, samples, (size_t)n * sizeof(float complex));
+            shm_ring_release(&src->shm, (uint32_t)n);
+            return (int)n;
+        }
+        struct timespec ts = { 0, 1000000 };    // Idle between bursts: 1 ms poll
+        nanosleep(&ts, NULL);
+    }
+}
+
+static int read_bursts(rx_source_t *src, float complex *out) {
+    uint64_t left = src->burst_samples - src->samples_read;
+    int n = left < RX_SOURCE_BLOCK ? (int)left : RX_SOURCE_BLOCK;
+    if (n > 0) {
+        burst_recording_render(&src->bursts, src->sample_rate, src->samples_read, (uint32_t)n, out);
+    }
+    return n;
+}
+
+// =============================================================================
+// COMPRESSED RECORDINGS
+// =============================================================================
+
+static int open_sgiq(rx_source_t *src, const char *path) {
+    if (iq_reader_open(&src->iq, path) < 0) {
+        return -1;
+    }
+    src->type = RX_SOURCE_SGIQ;
+    src->sample_rate = src->iq.sample_rate;
+
+    printf("✓ Compressed ci16 input: %s (%u Hz, %.1f s, %.2f:1)\n", path, src->sample_rate,
+           src->sample_rate ? (double)src->iq.total_samples / src->sample_rate : 0.0,
+           src->iq.compressed_bytes ? (double)src->iq.total_samples * 4 / src->iq.compressed_bytes : 0.0);
+    return 0;
+}
+
+// =============================================================================
+// FILE SOURCES
+// =============================================================================
+
+int rx_source_open_file(rx_source_t *src, const char *path, uint32_t sample_rate) {
+    memset(src, 0, sizeof(rx_source_t));
+
+    int ret;
+    char base[512];
+    snprintf(base, sizeof(base), "%s", path);
+    if (has_suffix(base, ".sigmf-meta") || has_suffix(base, ".sigmf-data")) {
+        base[strlen(base) - strlen(".sigmf-meta")] = '\0';
+    }
+
+    char meta[600];
+    snprintf(meta, sizeof(meta), "%s.sigmf-meta", base);
+    FILE *probe = fopen(meta, "r");
+
+    if (shm_ring_is_uri(path)) {
+        if (probe) fclose(probe);
+        ret = open_shm(src, path);
+    } else if (probe) {
+        fclose(probe);
+        ret = open_sigmf(src, base);
+    } else if (burst_recording_is_path(path)) {
+        ret = open_bursts(src, path, sample_rate);
+    } else if (iq_codec_is_path(path)) {
+        ret = open_sgiq(src, path);
+    } else if (has_suffix(path, ".wav")) {
+        ret = open_wav(src, path);
+    } else {
+        // Raw interleaved cf32
+        src->type = RX_SOURCE_CF32;
+        src->sample_rate = sample_rate;
+        src->data_remaining = UINT64_MAX;
+        src->file = fopen(path, "rb");
+        if (!src->file) {
+            fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+            ret = -1;
+        } else if (sample_rate == 0) {
+            fprintf(stderr, "%s: raw cf32 input needs a sample rate (-s)\n", path);
+            ret = -1;
+        } else {
+            printf("✓ Raw cf32 input: %s (%u Hz)\n", path, sample_rate);
+            ret = 0;
+        }
+    }
+
+    if (ret == 0 && sample_rate != 0 && sample_rate != src->sample_rate) {
+        printf("⚠ Overriding file sample rate %u Hz with %u Hz\n", src->sample_rate, sample_rate);
+        src->sample_rate = sample_rate;
+    }
+    if (ret == 0 && src->sample_rate == 0) {
+        fprintf(stderr, "%s: invalid sample rate\n", path);
+        ret = -1;
+    }
+    if (ret == 0) {
+        src->raw = malloc((size_t)RX_SOURCE_BLOCK * bytes_per_sample(src->type));
+        if (!src->raw) {
+            fprintf(stderr, "Failed to allocate source buffer\n");
+            ret = -1;
+        }
+    }
+
+    if (ret < 0) {
+        rx_source_close(src);
+    }
+    return ret;
+}
+
+static void check_identical_channels(rx_source_t *src, const float complex *x, int n) {
+    // Leading silence is skipped: decide on the first non-zero samples
+    for (int i = 0; i < n; i++) {
+        if (crealf(x[i]) != cimagf(x[i])) {
+            src->identical_run = UINT32_MAX;
+            return;
+        }
+        if (crealf(x[i]) != 0.0f && ++src->identical_run == RX_IDENTICAL_CHECK) {
+            src->identical_iq = 1;
+            printf("⚠ Left and right channels are identical: audio recording, not I/Q "
+                   "(bursts are detected but cannot be despread)\n");
+            return;
+        }
+    }
+}
+
+static int read_file(rx_source_t *src, float complex *out) {
+    int n;
+    if (src->type == RX_SOURCE_SGIQ) {
+        n = iq_reader_read(&src->iq, (int16_t *)src->raw, RX_SOURCE_BLOCK);
+        if (n < 0) return -1;
+    } else {
+        uint32_t bps = bytes_per_sample(src->type);
+        uint64_t want = (uint64_t)RX_SOURCE_BLOCK * bps;
+        if (want > src->data_remaining) want = src->data_remaining;
+
+        size_t got = fread(src->raw, 1, want, src->file);
+        if (got < want && ferror(src->file)) {
+            fprintf(stderr, "Read error: %s\n", strerror(errno));
+            return -1;
+        }
+        n = (int)(got / bps);
+        src->data_remaining -= got;
+    }
+
+    switch (src->type) {
+    case RX_SOURCE_CF32:
+    case RX_SOURCE_WAV32F: {
+        const float *f = (const float *)src->raw;
+        for (int i = 0; i < n; i++) {
+            out[i] = f[2 * i] + I * f[2 * i + 1];
+        }
+        break;
+    }
+    default: {
+        const int16_t *s = (const int16_t *)src->raw;
+        for (int i = 0; i < n; i++) {
+            out[i] = (s[2 * i] + I * s[2 * i + 1]) * (1.0f / 32768.0f);
+        }
+        break;
+    }
+    }
+
+    if (!src->identical_iq && src->identical_run < RX_IDENTICAL_CHECK) {
+        check_identical_channels(src, out, n);
+    }
+    return n;
+}
+
+// =============================================================================
+// PLUTOSDR RX
+// =============================================================================
+
+int rx_source_open_pluto(rx_source_t *src, const char *uri, uint64_t frequency,
+                         uint32_t sample_rate, int32_t gain_db) {
+    memset(src, 0, sizeof(rx_source_t));
+    src->type = RX_SOURCE_PLUTO;
+    src->sample_rate = sample_rate;
+    src->live = 1;
+
+    if (uri) {
+        printf("Connecting to PlutoSDR at %s...\n", uri);
+        src->ctx = iio_create_context_from_uri(uri);
+    } else {
+        printf("Connecting to PlutoSDR (auto-detect)...\n");
+        src->ctx = iio_create_default_context();
+    }
+    if (!src->ctx) {
+        fprintf(stderr, "Failed to create IIO context\n");
+        return -1;
+    }
+
+    struct iio_device *phy = iio_context_find_device(src->ctx, "ad9361-phy");
+    src->rx_dev = iio_context_find_device(src->ctx, "cf-ad9361-lpc");
+    if (!phy || !src->rx_dev) {
+        fprintf(stderr, "RX devices (ad9361-phy, cf-ad9361-lpc) not found\n");
+        rx_source_close(src);
+        return -1;
+    }
+
+    struct iio_channel *rx_chan = iio_device_find_channel(phy, "voltage0", 0);
+    struct iio_channel *rx_lo = iio_device_find_channel(phy, "altvoltage0", 1);
+    if (!rx_chan || !rx_lo) {
+        fprintf(stderr, "RX channel or RX LO not found\n");
+        rx_source_close(src);
+        return -1;
+    }
+
+    int ret = iio_channel_attr_write_longlong(rx_lo, "frequency", (long long)frequency);
+    if (ret >= 0) ret = iio_channel_attr_write_longlong(rx_chan, "sampling_frequency", sample_rate);
+    if (ret >= 0) ret = iio_channel_attr_write_longlong(rx_chan, "rf_bandwidth", RX_PLUTO_BANDWIDTH);
+    if (ret >= 0) {
+        ret = (int)iio_channel_attr_write(rx_chan, "gain_control_mode",
+                                          gain_db == RX_GAIN_AGC ? "slow_attack" : "manual");
+    }
+    if (ret >= 0 && gain_db != RX_GAIN_AGC) {
+        ret = iio_channel_attr_write_longlong(rx_chan, "hardwaregain", gain_db);
+    }
+    if (ret < 0) {
+        fprintf(stderr, "Failed to configure RX: %s\n", strerror(-ret));
+        rx_source_close(src);
+        return -1;
+    }
+
+    src->rx_i = iio_device_find_channel(src->rx_dev, "voltage0", 0);
+    src->rx_q = iio_device_find_channel(src->rx_dev, "voltage1", 0);
+    if (!src->rx_i || !src->rx_q) {
+        fprintf(stderr, "Failed to get RX I/Q channels\n");
+        rx_source_close(src);
+        return -1;
+    }
+    iio_channel_enable(src->rx_i);
+    iio_channel_enable(src->rx_q);
+
+    src->rx_buf = iio_device_create_buffer(src->rx_dev, RX_SOURCE_BLOCK, 0);
+    if (!src->rx_buf) {
+        fprintf(stderr, "Failed to create RX buffer\n");
+        rx_source_close(src);
+        return -1;
+    }
+
+    printf("✓ PlutoSDR RX configured:\n");
+    printf("  Frequency: %.3f MHz\n", frequency / 1e6);
+    printf("  Sample rate: %u Hz\n", sample_rate);
+    if (gain_db == RX_GAIN_AGC) {
+        printf("  Gain: slow-attack AGC\n");
+    } else {
+        printf("  Gain: %d dB (manual)\n", gain_db);
+    }
+    return 0;
+}
+
+static int read_pluto(rx_source_t *src, float complex *out) {
+    ssize_t nbytes = iio_buffer_refill(src->rx_buf);
+    if (nbytes < 0) {
+        fprintf(stderr, "RX buffer refill failed: %s\n", strerror((int)-nbytes));
+        return -1;
+    }
+
+    // Interleaved [I0, Q0, I1, Q1, ...], 12-bit ADC in int16
+    const int16_t *buf = (const int16_t *)iio_buffer_start(src->rx_buf);
+    const int16_t *end = (const int16_t *)iio_buffer_end(src->rx_buf);
+    int n = (int)((end - buf) / 2);
+    if (n > RX_SOURCE_BLOCK) n = RX_SOURCE_BLOCK;
+
+    for (int i = 0; i < n; i++) {
+        out[i] = (buf[2 * i] + I * buf[2 * i + 1]) * (1.0f / 2048.0f);
+    }
+    return n;
+}
+
+// =============================================================================
+// COMMON
+// =============================================================================
+
+int rx_source_read(rx_source_t *src, float complex *out) {
+    int n;
+    if (src->type == RX_SOURCE_PLUTO) {
+        n = read_pluto(src, out);
+    } else if (src->type == RX_SOURCE_BURSTS) {
+        n = read_bursts(src, out);
+    } else if (src->type == RX_SOURCE_SHM) {
+        n = read_shm(src, out);
+    } else {
+        n = read_file(src, out);
+    }
+    if (n > 0) {
+        src->samples_read += (uint64_t)n;
+    }
+    return n;
+}
+
+void rx_source_cancel(rx_source_t *src) {
+    src->cancelled = 1;
+}
+
+void rx_source_close(rx_source_t *src) {
+    if (src->rx_buf) {
+        iio_buffer_destroy(src->rx_buf);
+        src->rx_buf = NULL;
+    }
+    if (src->ctx) {
+        iio_context_destroy(src->ctx);
+        src->ctx = NULL;
+    }
+    if (src->file) {
+        fclose(src->file);
+        src->file = NULL;
+    }
+    free(src->raw);
+    src->raw = NULL;
+    burst_recording_free(&src->bursts);
+    iq_reader_close(&src->iq);
+    if (src->shm.hdr) {
+        shm_ring_close(&src->shm);
+    }
+}
@@ -0,0 +1,188 @@
+/**
+ * @file sarsat_rx.c
+ * @brief COSPAS-SARSAT T.018 (2nd Generation) Beacon Receiver/Monitor
+ *
+ * Streaming receiver built on the transmitter's DSP code (PRN tables,
+ * resampler, BCH): decodes bursts from a PlutoSDR or from SigMF/WAV
+ * recordings, e.g. files written by sarsat_sgb -o.
+ */
+
+#include "rx_source.h"
+#include "rx_pipeline.h"
+#include "rx_detector.h"
+#include "pluto_control.h"
+#include "prn_generator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+typedef struct {
+    char input_path[256];                   // Recording ("" = PlutoSDR)
+    char pluto_uri[64];                     // PlutoSDR URI ("" = auto-detect)
+    uint64_t frequency;                     // RX frequency (Hz)
+    uint32_t sample_rate;                   // 0 = file metadata / PLUTO_SAMPLE_RATE
+    int32_t gain_db;                        // RX gain or RX_GAIN_AGC
+    float threshold_db;                     // Detection threshold
+    uint32_t workers;                       // Decoder threads
+    uint32_t channels;                      // Channelizer outputs (0 = off)
+    uint8_t verbose;
+} rx_config_t;
+
+static const rx_config_t default_config = {
+    .input_path = "",
+    .pluto_uri = "",
+    .frequency = PLUTO_DEFAULT_FREQ,
+    .sample_rate = 0,
+    .gain_db = RX_GAIN_AGC,
+    .threshold_db = RX_DETECT_THRESHOLD_DB,
+    .workers = 1,
+    .channels = 0,
+    .verbose = 0
+};
+
+// =============================================================================
+// SIGNAL HANDLING
+// =============================================================================
+
+static rx_source_t source;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    rx_pipeline_stop();
+    rx_source_cancel(&source);
+}
+
+// =============================================================================
+// COMMAND LINE
+// =============================================================================
+
+static void print_usage(const char *progname) {
+    printf("COSPAS-SARSAT T.018 (2nd Generation) Beacon Receiver\n");
+    printf("Usage: %s [options]\n\n", progname);
+    printf("Input (one of):\n");
+    printf("  -i <file>     Recording: .sigmf-meta/.sigmf-data (cf32_le, ci16_le),\n");
+    printf("                2-channel .wav (I/Q), raw cf32 (needs -s), .sgiq compressed\n");
+    printf("                ci16, or .sgbr burst recording (synthesized at -s, default %d)\n",
+           BURST_RECORD_DEFAULT_RATE);
+    printf("  -i shm:[name] Live shared-memory ring of sarsat_sgb -u shm: (same host)\n");
+    printf("  -u <uri>      PlutoSDR RX (default when no -i: auto-detect)\n\n");
+    printf("Options:\n");
+    printf("  -f <freq>     RX frequency in Hz (default: %d)\n", PLUTO_DEFAULT_FREQ);
+    printf("  -s <rate>     Sample rate in Hz (PlutoSDR default: %d)\n", PLUTO_SAMPLE_RATE);
+    printf("  -g <gain>     RX gain in dB (default: slow-attack AGC)\n");
+    printf("  -t <dB>       Detection threshold above noise floor (default: %.1f)\n",
+           RX_DETECT_THRESHOLD_DB);
+    printf("  -j <n>        Decoder threads (default: 1, max %d)\n", RX_MAX_WORKERS);
+    printf("  -c <n>        Channelize into n channels %d Hz apart around -f, one decoder\n"
+           "                thread each (max %d; 7 covers 406.0-406.1 MHz at -f 406050000)\n",
+           RX_CHANNEL_SPACING, RX_MAX_CHANNELS);
+    printf("  -v            Also report detections without preamble correlation\n");
+    printf("  -h            Show this help\n\n");
+    printf("Examples:\n");
+    printf("  %s -i beacon.sigmf-meta\n", progname);
+    printf("  %s -u ip:192.168.2.1 -f 406050000 -g 40\n", progname);
+    printf("  %s -u ip:192.168.2.1 -f 406050000 -c 7\n", progname);
+}
+
+static int parse_args(int argc, char *argv[], rx_config_t *config) {
+    *config = default_config;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            strncpy(config->input_path, argv[++i], sizeof(config->input_path) - 1);
+        } else if (strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+            strncpy(config->pluto_uri, argv[++i], sizeof(config->pluto_uri) - 1);
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            config->frequency = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            config->sample_rate = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            config->gain_db = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            config->threshold_db = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            config->workers = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            config->channels = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-v") == 0) {
+            config->verbose = 1;
+        } else if (strcmp(argv[i], "-h") == 0) {
+            print_usage(argv[0]);
+            return -1;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (config->workers < 1 || config->workers > RX_MAX_WORKERS) {
+        fprintf(stderr, "Decoder threads must be 1..%d\n", RX_MAX_WORKERS);
+        return -1;
+    }
+    if (config->channels > RX_MAX_CHANNELS) {
+        fprintf(stderr, "Channels must be 0..%d\n", RX_MAX_CHANNELS);
+        return -1;
+    }
+    return 0;
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char *argv[]) {
+    rx_config_t config;
+    if (parse_args(argc, argv, &config) < 0) {
+        return 1;
+    }
+
+    printf("\n");
+    printf("========================================\n");
+    printf(" COSPAS-SARSAT T.018 Beacon Receiver\n");
+    printf("========================================\n\n");
+
+    if (!prn_verify_table_2_2()) {
+        fprintf(stderr, "PRN generator verification failed\n");
+        return 1;
+    }
+
+    int ret;
+    if (config.input_path[0]) {
+        ret = rx_source_open_file(&source, config.input_path, config.sample_rate);
+    } else {
+        ret = rx_source_open_pluto(&source, config.pluto_uri[0] ? config.pluto_uri : NULL,
+                                   config.frequency,
+                                   config.sample_rate ? config.sample_rate : PLUTO_SAMPLE_RATE,
+                                   config.gain_db);
+    }
+    if (ret < 0) {
+        return 1;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = signal_handler;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    rx_pipeline_config_t pipeline = {
+        .source = &source,
+        .threshold_db = config.threshold_db,
+        .workers = config.workers,
+        .channels = config.channels,
+        .verbose = config.verbose
+    };
+
+    rx_stats_t stats;
+    ret = rx_pipeline_run(&pipeline, &stats);
+    rx_pipeline_print_stats(&stats, source.sample_rate);
+
+    rx_source_close(&source);
+    return ret < 0 ? 1 : 0;
+}
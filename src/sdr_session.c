@@ -0,0 +1,309 @@
+/**
+ * @file sdr_session.c
+ * @brief Resilient SDR session implementation
+ *
+ * Ownership of the pluto_ctx_t follows the link state: a caller (transmit,
+ * calibration, push settings) uses it while the link is up and it holds the
+ * busy flag, the reconnect thread tears it down and rebuilds it while the
+ * link is down and no caller is busy. State and flag only change under the
+ * lock, so the device is never touched by two threads at the same time.
+ */
+
+#include "sdr_session.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static double monotonic_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int connect_radio(sdr_session_t *session, uint32_t chunk_size, uint32_t kernel_buffers) {
+    if (pluto_init(&session->pluto, session->uri) < 0) {
+        return -1;
+    }
+    if (pluto_configure_tx(&session->pluto, session->frequency,
+                           session->gain_db, session->sample_rate) < 0) {
+        pluto_cleanup(&session->pluto);
+        return -1;
+    }
+    if (chunk_size && pluto_set_tx_buffers(&session->pluto, chunk_size, kernel_buffers) < 0) {
+        pluto_cleanup(&session->pluto);
+        return -1;
+    }
+    return 0;
+}
+
+// Caller holds the lock
+static void link_down(sdr_session_t *session) {
+    session->state = SDR_LINK_DOWN;
+    session->down_since = monotonic_sec();
+    session->backoff_ms = SDR_BACKOFF_MIN_MS;
+    session->stats.disconnects++;
+    pthread_cond_broadcast(&session->cond);
+}
+
+// Caller holds the lock. Waits for other users of the device; 0 with the
+// device claimed, -1 if the link is down
+static int claim_device(sdr_session_t *session) {
+    while (session->busy && session->state == SDR_LINK_UP) {
+        pthread_cond_wait(&session->cond, &session->lock);
+    }
+    if (session->state != SDR_LINK_UP) {
+        return -1;
+    }
+    session->busy = 1;
+    return 0;
+}
+
+// Caller holds the lock
+static void release_device(sdr_session_t *session) {
+    session->busy = 0;
+    pthread_cond_broadcast(&session->cond);
+}
+
+// =============================================================================
+// RECONNECT THREAD
+// =============================================================================
+
+static void *reconnect_thread(void *arg) {
+    sdr_session_t *session = (sdr_session_t *)arg;
+
+    pthread_mutex_lock(&session->lock);
+    for (;;) {
+        while (!session->stop && session->state == SDR_LINK_UP) {
+            pthread_cond_wait(&session->cond, &session->lock);
+        }
+        if (session->stop) break;
+
+        // Backoff (interrupted only by stop)
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += session->backoff_ms / 1000;
+        deadline.tv_nsec += (long)(session->backoff_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        while (!session->stop &&
+               pthread_cond_timedwait(&session->cond, &session->lock, &deadline) != ETIMEDOUT) {
+        }
+        // A caller that saw the link go down may still be using the device
+        while (!session->stop && session->busy) {
+            pthread_cond_wait(&session->cond, &session->lock);
+        }
+        if (session->stop) break;
+
+        session->stats.attempts++;
+        uint8_t inject = 0;
+        if (session->fault_pending > 0) {
+            session->fault_pending--;
+            inject = 1;
+        }
+        uint32_t chunk_size = session->chunk_size;
+        uint32_t kernel_buffers = session->kernel_buffers;
+        pthread_mutex_unlock(&session->lock);
+
+        // Link is down: the device context belongs to this thread
+        if (session->pluto.initialized) {
+            pluto_cleanup(&session->pluto);
+        }
+        printf("Reconnecting to %s...\n", session->uri);
+        int result = inject ? -1 : connect_radio(session, chunk_size, kernel_buffers);
+
+        pthread_mutex_lock(&session->lock);
+        if (result == 0) {
+            double outage = monotonic_sec() - session->down_since;
+            session->stats.downtime_sec += outage;
+            session->stats.reconnects++;
+            session->bursts_since_connect = 0;
+            session->state = SDR_LINK_UP;
+            printf("✓ [%s] Radio reconnected after %.1f s\n", session->uri, outage);
+        } else {
+            session->backoff_ms *= 2;
+            if (session->backoff_ms > SDR_BACKOFF_MAX_MS) {
+                session->backoff_ms = SDR_BACKOFF_MAX_MS;
+            }
+            fprintf(stderr, "⚠ [%s] Reconnect failed%s, next attempt in %.1f s\n",
+                    session->uri, inject ? " (injected)" : "", session->backoff_ms / 1000.0);
+        }
+    }
+    pthread_mutex_unlock(&session->lock);
+
+    return NULL;
+}
+
+// =============================================================================
+// SESSION
+// =============================================================================
+
+int sdr_session_open(sdr_session_t *session, const char *uri,
+                     uint64_t frequency, int32_t gain_db, uint32_t sample_rate) {
+    memset(session, 0, sizeof(sdr_session_t));
+    if (uri) {
+        strncpy(session->uri, uri, sizeof(session->uri) - 1);
+    }
+    session->frequency = frequency;
+    session->gain_db = gain_db;
+    session->sample_rate = sample_rate;
+
+    // A radio missing at startup is a configuration error, not an outage
+    if (connect_radio(session, 0, 0) < 0) {
+        return -1;
+    }
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&session->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&session->lock, NULL);
+
+    if (pthread_create(&session->thread, NULL, reconnect_thread, session) != 0) {
+        fprintf(stderr, "Failed to start reconnect thread for %s\n", session->uri);
+        pthread_cond_destroy(&session->cond);
+        pthread_mutex_destroy(&session->lock);
+        pluto_cleanup(&session->pluto);
+        return -1;
+    }
+    session->thread_started = 1;
+    return 0;
+}
+
+void sdr_session_set_fault(sdr_session_t *session, uint32_t every, uint32_t failed_attempts) {
+    pthread_mutex_lock(&session->lock);
+    session->fault_every = every;
+    session->fault_attempts = failed_attempts;
+    pthread_mutex_unlock(&session->lock);
+}
+
+int sdr_session_set_tx_buffers(sdr_session_t *session, uint32_t chunk_size, uint32_t kernel_buffers) {
+    pthread_mutex_lock(&session->lock);
+    int up = claim_device(session) == 0;
+    pthread_mutex_unlock(&session->lock);
+
+    // Link down: validated and applied by the reconnect
+    int result = 0;
+    if (up) {
+        result = pluto_set_tx_buffers(&session->pluto, chunk_size, kernel_buffers);
+    }
+
+    pthread_mutex_lock(&session->lock);
+    if (result == 0) {
+        session->chunk_size = chunk_size;
+        session->kernel_buffers = kernel_buffers;
+    }
+    if (up) {
+        release_device(session);
+    }
+    pthread_mutex_unlock(&session->lock);
+    return result < 0 ? -1 : 0;
+}
+
+int sdr_session_tune(sdr_session_t *session, tx_tune_result_t *best) {
+    pthread_mutex_lock(&session->lock);
+    int up = claim_device(session) == 0;
+    pthread_mutex_unlock(&session->lock);
+    if (!up) {
+        fprintf(stderr, "⚠ [%s] Radio link down, calibration skipped\n", session->uri);
+        return -1;
+    }
+
+    // Device claimed: it belongs to this thread until released
+    int result = -1;
+    if (tx_tune_supported(&session->pluto)) {
+        result = tx_tune_run(&session->pluto, best);
+    } else {
+        printf("[%s] Backend has no push settings to calibrate\n", session->uri);
+    }
+
+    pthread_mutex_lock(&session->lock);
+    if (result == TX_TUNE_PUSH_FAILED) {
+        session->fault_pending = 0;
+        link_down(session);
+        fprintf(stderr, "⚠ [%s] Radio link lost during calibration, reconnecting\n",
+                session->uri);
+    } else if (result == 0) {
+        session->chunk_size = best->chunk_size;
+        session->kernel_buffers = best->kernel_buffers;
+    }
+    release_device(session);
+    pthread_mutex_unlock(&session->lock);
+
+    return result < 0 ? -1 : 0;
+}
+
+int sdr_session_transmit(sdr_session_t *session,
+                         const float complex *iq_samples,
+                         uint32_t num_samples) {
+    pthread_mutex_lock(&session->lock);
+    if (claim_device(session) < 0) {
+        session->stats.missed++;
+        pthread_mutex_unlock(&session->lock);
+        return 0;
+    }
+    uint8_t inject = session->fault_every &&
+                     session->bursts_since_connect >= session->fault_every;
+    pthread_mutex_unlock(&session->lock);
+
+    // Device claimed: it belongs to this thread until released
+    int sent = inject ? -1 : pluto_transmit_iq(&session->pluto, iq_samples, num_samples);
+
+    pthread_mutex_lock(&session->lock);
+    if (sent < 0) {
+        session->stats.missed++;
+        session->fault_pending = inject ? session->fault_attempts : 0;
+        link_down(session);
+        fprintf(stderr, "⚠ [%s] Radio link lost%s, reconnecting in the background\n",
+                session->uri, inject ? " (injected)" : "");
+        sent = -1;
+    } else {
+        session->stats.bursts++;
+        session->bursts_since_connect++;
+    }
+    release_device(session);
+    pthread_mutex_unlock(&session->lock);
+
+    return sent;
+}
+
+int sdr_session_is_up(sdr_session_t *session) {
+    pthread_mutex_lock(&session->lock);
+    int up = session->state == SDR_LINK_UP;
+    pthread_mutex_unlock(&session->lock);
+    return up;
+}
+
+void sdr_session_get_stats(sdr_session_t *session, sdr_session_stats_t *stats) {
+    pthread_mutex_lock(&session->lock);
+    *stats = session->stats;
+    if (session->state == SDR_LINK_DOWN) {
+        stats->downtime_sec += monotonic_sec() - session->down_since;
+    }
+    pthread_mutex_unlock(&session->lock);
+}
+
+void sdr_session_close(sdr_session_t *session) {
+    if (session->thread_started) {
+        pthread_mutex_lock(&session->lock);
+        session->stop = 1;
+        pthread_cond_broadcast(&session->cond);
+        pthread_mutex_unlock(&session->lock);
+
+        pthread_join(session->thread, NULL);
+        session->thread_started = 0;
+        pthread_cond_destroy(&session->cond);
+        pthread_mutex_destroy(&session->lock);
+    }
+
+    if (session->pluto.initialized) {
+        pluto_cleanup(&session->pluto);
+    }
+}
@@ -0,0 +1,372 @@
+/**
+ * @file shm_ring.c
+ * @brief Shared-memory I/Q ring implementation
+ *
+ * Segment layout: SHM_RING_HEADER_SIZE header page, then capacity samples.
+ * The data region is mapped a second time right after the first mapping
+ * (inside one reserved address range), so sample i and sample i + capacity
+ * are the same memory and no span ever has to be split at the wrap.
+ *
+ * The producer announces the end of the span it is about to overwrite in
+ * `writing` before touching it and publishes `head` after: a reader that
+ * sees writing - capacity past the start of what it just read knows those
+ * samples changed under it.
+ */
+
+#include "shm_ring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define WAIT_POLL_NS            100000      // Producer poll while the reader frees space
+
+_Static_assert(sizeof(shm_ring_header_t) <= SHM_RING_HEADER_SIZE, "ring header exceeds its page");
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "shared ring needs lock-free 64-bit atomics");
+
+int shm_ring_is_uri(const char *uri) {
+    return uri && strncmp(uri, "shm:", 4) == 0;
+}
+
+// =============================================================================
+// MAPPING
+// =============================================================================
+
+static int make_path(shm_ring_t *ring, const char *name) {
+    if (!name || !name[0]) name = SHM_RING_DEFAULT_NAME;
+    if (name[0] == '/') name++;
+    if (!name[0] || strchr(name, '/') || strlen(name) + 2 > sizeof(ring->path)) {
+        fprintf(stderr, "Invalid shared memory ring name '%s'\n", name);
+        return -1;
+    }
+    snprintf(ring->path, sizeof(ring->path), "/%s", name);
+    return 0;
+}
+
+static int map_segment(shm_ring_t *ring, uint64_t capacity) {
+    size_t data_size = capacity * sizeof(float complex);
+    ring->map_size = SHM_RING_HEADER_SIZE + 2 * data_size;
+
+    // Reserve the whole range, then place header + data and the data alias
+    uint8_t *base = mmap(NULL, ring->map_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Failed to reserve %zu bytes for %s: %s\n",
+                ring->map_size, ring->path, strerror(errno));
+        return -1;
+    }
+    if (mmap(base, SHM_RING_HEADER_SIZE + data_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_FIXED, ring->fd, 0) == MAP_FAILED ||
+        mmap(base + SHM_RING_HEADER_SIZE + data_size, data_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_FIXED, ring->fd, SHM_RING_HEADER_SIZE) == MAP_FAILED) {
+        fprintf(stderr, "Failed to map %s: %s\n", ring->path, strerror(errno));
+        munmap(base, ring->map_size);
+        return -1;
+    }
+
+    ring->map_base = base;
+    ring->hdr = (shm_ring_header_t *)base;
+    ring->data = (float complex *)(base + SHM_RING_HEADER_SIZE);
+    ring->mask = capacity - 1;
+    return 0;
+}
+
+int shm_ring_create(shm_ring_t *ring, const char *name, uint64_t capacity, uint32_t sample_rate) {
+    memset(ring, 0, sizeof(shm_ring_t));
+    ring->fd = -1;
+    if (make_path(ring, name) < 0) {
+        return -1;
+    }
+
+    uint64_t size = SHM_RING_MIN_SAMPLES;
+    while (size < capacity) size <<= 1;
+
+    // Replace any stale segment: mapped readers keep the old one until they reopen
+    shm_unlink(ring->path);
+    ring->fd = shm_open(ring->path, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (ring->fd < 0) {
+        fprintf(stderr, "Failed to create shared memory %s: %s\n", ring->path, strerror(errno));
+        return -1;
+    }
+    if (ftruncate(ring->fd, SHM_RING_HEADER_SIZE + size * sizeof(float complex)) < 0) {
+        fprintf(stderr, "Failed to size %s: %s\n", ring->path, strerror(errno));
+        close(ring->fd);
+        ring->fd = -1;
+        shm_unlink(ring->path);
+        return -1;
+    }
+    if (map_segment(ring, size) < 0) {
+        close(ring->fd);
+        ring->fd = -1;
+        shm_unlink(ring->path);
+        return -1;
+    }
+
+    shm_ring_header_t *hdr = ring->hdr;
+    hdr->version = SHM_RING_VERSION;
+    hdr->header_size = SHM_RING_HEADER_SIZE;
+    hdr->capacity = size;
+    hdr->sample_size = sizeof(float complex);
+    atomic_store(&hdr->sample_rate, sample_rate);
+    atomic_store(&hdr->producer_pid, (uint32_t)getpid());
+    atomic_thread_fence(memory_order_release);
+    memcpy(hdr->magic, SHM_RING_MAGIC, sizeof(hdr->magic));  // Valid from here on
+
+    ring->producer = 1;
+    printf("✓ Shared memory ring /dev/shm%s: %llu samples (%.1f MiB, cf32)\n", ring->path,
+           (unsigned long long)size, size * sizeof(float complex) / 1048576.0);
+    return 0;
+}
+
+int shm_ring_open(shm_ring_t *ring, const char *name, int flow_control) {
+    memset(ring, 0, sizeof(shm_ring_t));
+    ring->fd = -1;
+    if (make_path(ring, name) < 0) {
+        return -1;
+    }
+
+    ring->fd = shm_open(ring->path, O_RDWR, 0);
+    if (ring->fd < 0) {
+        fprintf(stderr, "Cannot open shared memory %s: %s\n", ring->path, strerror(errno));
+        return -1;
+    }
+
+    shm_ring_header_t probe;
+    struct stat st;
+    if (fstat(ring->fd, &st) < 0 || st.st_size < SHM_RING_HEADER_SIZE ||
+        pread(ring->fd, &probe, sizeof(probe), 0) != (ssize_t)sizeof(probe) ||
+        memcmp(probe.magic, SHM_RING_MAGIC, sizeof(probe.magic)) != 0 ||
+        probe.version != SHM_RING_VERSION ||
+        probe.sample_size != sizeof(float complex) ||
+        probe.capacity < SHM_RING_MIN_SAMPLES || (probe.capacity & (probe.capacity - 1)) ||
+        (uint64_t)st.st_size < SHM_RING_HEADER_SIZE + probe.capacity * sizeof(float complex)) {
+        fprintf(stderr, "%s is not a SARSAT I/Q ring (or not ready yet)\n", ring->path);
+        close(ring->fd);
+        ring->fd = -1;
+        return -1;
+    }
+    if (map_segment(ring, probe.capacity) < 0) {
+        close(ring->fd);
+        ring->fd = -1;
+        return -1;
+    }
+
+    shm_ring_header_t *hdr = ring->hdr;
+    if (flow_control) {
+        uint32_t none = 0;
+        uint32_t owner = atomic_load(&hdr->reader_pid);
+        if (owner && kill((pid_t)owner, 0) < 0 && errno == ESRCH) {
+            // Previous flow-controlling reader died without detaching
+            atomic_compare_exchange_strong(&hdr->reader_pid, &owner, 0);
+        }
+        if (atomic_load(&hdr->reader_pid) == 0) {
+            // Nothing to wait for until our first release
+            atomic_store(&hdr->tail, atomic_load(&hdr->head));
+        }
+        if (!atomic_compare_exchange_strong(&hdr->reader_pid, &none, (uint32_t)getpid())) {
+            fprintf(stderr, "%s already has a flow-controlling reader (pid %u)\n", ring->path, none);
+            shm_ring_close(ring);
+            return -1;
+        }
+        ring->flow_control = 1;
+    }
+
+    ring->read_pos = atomic_load_explicit(&hdr->head, memory_order_acquire);
+    if (ring->flow_control) {
+        atomic_store(&hdr->tail, ring->read_pos);
+    }
+    ring->next_marker = atomic_load_explicit(&hdr->marker_count, memory_order_acquire);
+    return 0;
+}
+
+void shm_ring_close(shm_ring_t *ring) {
+    if (ring->hdr) {
+        if (ring->producer) {
+            atomic_store_explicit(&ring->hdr->closed, 1, memory_order_release);
+        } else if (ring->flow_control) {
+            uint32_t self = (uint32_t)getpid();
+            atomic_compare_exchange_strong(&ring->hdr->reader_pid, &self, 0);
+        }
+    }
+    if (ring->map_base) {
+        munmap(ring->map_base, ring->map_size);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    if (ring->producer) {
+        shm_unlink(ring->path);
+    }
+    ring->hdr = NULL;
+    ring->data = NULL;
+    ring->map_base = NULL;
+    ring->fd = -1;
+}
+
+// =============================================================================
+// PRODUCER
+// =============================================================================
+
+static uint64_t realtime_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void shm_ring_set_format(shm_ring_t *ring, uint32_t sample_rate, uint64_t frequency) {
+    atomic_store(&ring->hdr->sample_rate, sample_rate);
+    atomic_store(&ring->hdr->frequency, frequency);
+}
+
+void shm_ring_mark_burst(shm_ring_t *ring, uint32_t samples) {
+    shm_ring_header_t *hdr = ring->hdr;
+    uint64_t count = atomic_load_explicit(&hdr->marker_count, memory_order_relaxed);
+    shm_ring_marker_t *marker = &hdr->markers[count % SHM_RING_MARKERS];
+
+    marker->start = atomic_load_explicit(&hdr->head, memory_order_relaxed);
+    marker->time_ns = realtime_ns();
+    marker->samples = samples;
+    marker->burst = (uint32_t)count;
+    atomic_store_explicit(&hdr->marker_count, count + 1, memory_order_release);
+}
+
+// Wait for a live flow-controlling reader to make room; 0 = room, 1 = gave up
+static int wait_for_space(shm_ring_t *ring, uint64_t end) {
+    shm_ring_header_t *hdr = ring->hdr;
+    uint64_t capacity = hdr->capacity;
+    uint32_t waited_ns = 0;
+
+    for (;;) {
+        uint32_t reader = atomic_load_explicit(&hdr->reader_pid, memory_order_acquire);
+        if (reader == 0) return 0;
+        uint64_t tail = atomic_load_explicit(&hdr->tail, memory_order_acquire);
+        if (end - tail <= capacity) return 0;
+
+        if (kill((pid_t)reader, 0) < 0 && errno == ESRCH) {
+            atomic_compare_exchange_strong(&hdr->reader_pid, &reader, 0);
+            return 0;
+        }
+        if (waited_ns >= SHM_RING_WAIT_MS * 1000000u) {
+            atomic_fetch_add(&hdr->overwritten, end - tail - capacity);
+            return 1;
+        }
+        struct timespec ts = { 0, WAIT_POLL_NS };
+        nanosleep(&ts, NULL);
+        waited_ns += WAIT_POLL_NS;
+    }
+}
+
+float complex *shm_ring_reserve(shm_ring_t *ring, uint32_t samples) {
+    shm_ring_header_t *hdr = ring->hdr;
+    if (samples > hdr->capacity) {
+        fprintf(stderr, "Shared memory ring: %u samples exceed the ring (%llu)\n",
+                samples, (unsigned long long)hdr->capacity);
+        return NULL;
+    }
+
+    uint64_t head = atomic_load_explicit(&hdr->head, memory_order_relaxed);
+    wait_for_space(ring, head + samples);
+
+    // Announce the overwrite before any sample changes
+    atomic_store_explicit(&hdr->writing, head + samples, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    return &ring->data[head & ring->mask];
+}
+
+void shm_ring_commit(shm_ring_t *ring, uint32_t samples) {
+    shm_ring_header_t *hdr = ring->hdr;
+    uint64_t head = atomic_load_explicit(&hdr->head, memory_order_relaxed);
+    atomic_store_explicit(&hdr->head, head + samples, memory_order_release);
+}
+
+int shm_ring_write_burst(shm_ring_t *ring, const float complex *iq_samples, uint32_t num_samples) {
+    // Parts of half a ring keep a flow-controlled reader streaming
+    uint32_t part_max = (uint32_t)(ring->hdr->capacity / 2);
+
+    shm_ring_mark_burst(ring, num_samples);
+    for (uint32_t done = 0; done < num_samples; ) {
+        uint32_t part = num_samples - done;
+        if (part > part_max) part = part_max;
+
+        float complex *dst = shm_ring_reserve(ring, part);
+        if (!dst) return -1;
+        memcpy(dst, &iq_samples[done], part * sizeof(float complex));
+        shm_ring_commit(ring, part);
+        done += part;
+    }
+    return (int)num_samples;
+}
+
+int shm_ring_write_silence(shm_ring_t *ring, uint32_t samples) {
+    float complex *dst = shm_ring_reserve(ring, samples);
+    if (!dst) return -1;
+    memset(dst, 0, samples * sizeof(float complex));
+    shm_ring_commit(ring, samples);
+    return (int)samples;
+}
+
+// =============================================================================
+// READER
+// =============================================================================
+
+int64_t shm_ring_peek(shm_ring_t *ring, const float complex **samples, uint32_t max) {
+    shm_ring_header_t *hdr = ring->hdr;
+    uint64_t head = atomic_load_explicit(&hdr->head, memory_order_acquire);
+
+    if (head - ring->read_pos > hdr->capacity) {
+        uint64_t oldest = head - hdr->capacity;
+        ring->overruns += oldest - ring->read_pos;
+        ring->read_pos = oldest;
+    }
+
+    uint64_t available = head - ring->read_pos;
+    if (available == 0) {
+        if (atomic_load_explicit(&hdr->closed, memory_order_acquire) &&
+            atomic_load_explicit(&hdr->head, memory_order_acquire) == ring->read_pos) {
+            return -1;
+        }
+        return 0;
+    }
+    if (available > max) available = max;
+    *samples = &ring->data[ring->read_pos & ring->mask];
+    return (int64_t)available;
+}
+
+int shm_ring_release(shm_ring_t *ring, uint32_t samples) {
+    shm_ring_header_t *hdr = ring->hdr;
+
+    // Samples from read_pos on were untouched if no overwrite reached them
+    atomic_thread_fence(memory_order_seq_cst);
+    uint64_t writing = atomic_load_explicit(&hdr->writing, memory_order_relaxed);
+    int damaged = writing > ring->read_pos + hdr->capacity;
+
+    ring->read_pos += samples;
+    ring->samples_read += samples;
+    if (ring->flow_control) {
+        atomic_store_explicit(&hdr->tail, ring->read_pos, memory_order_release);
+    }
+    return damaged;
+}
+
+int shm_ring_next_marker(shm_ring_t *ring, shm_ring_marker_t *marker) {
+    shm_ring_header_t *hdr = ring->hdr;
+    uint64_t count = atomic_load_explicit(&hdr->marker_count, memory_order_acquire);
+
+    if (count - ring->next_marker > SHM_RING_MARKERS) {
+        ring->next_marker = count - SHM_RING_MARKERS;
+    }
+    while (ring->next_marker < count) {
+        *marker = hdr->markers[ring->next_marker % SHM_RING_MARKERS];
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t now = atomic_load_explicit(&hdr->marker_count, memory_order_acquire);
+        ring->next_marker++;
+        // Slot reused while copying: that marker is gone, try the next one
+        if (now - (ring->next_marker - 1) <= SHM_RING_MARKERS) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file startup.c
+ * @brief Parallel startup orchestrator implementation
+ */
+
+#include "startup.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    startup_plan_t *plan;
+    uint32_t index;
+} task_ref_t;
+
+double startup_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void startup_init(startup_plan_t *plan, double t0) {
+    memset(plan, 0, sizeof(startup_plan_t));
+    plan->t0 = t0;
+    pthread_mutex_init(&plan->lock, NULL);
+    pthread_cond_init(&plan->cond, NULL);
+}
+
+int startup_add(startup_plan_t *plan, const char *name, startup_fn_t fn, void *arg, uint32_t deps) {
+    if (plan->num_tasks >= STARTUP_MAX_TASKS) {
+        fprintf(stderr, "Too many startup tasks (max %d)\n", STARTUP_MAX_TASKS);
+        return -1;
+    }
+    startup_task_t *task = &plan->tasks[plan->num_tasks];
+    task->name = name;
+    task->fn = fn;
+    task->arg = arg;
+    task->deps = deps;
+    task->state = STARTUP_PENDING;
+    return (int)plan->num_tasks++;
+}
+
+// =============================================================================
+// EXECUTION
+// =============================================================================
+
+// Caller holds the lock. 1 = ready, 0 = wait, -1 = a dependency failed
+static int deps_ready(const startup_plan_t *plan, const startup_task_t *task) {
+    int ready = 1;
+    for (uint32_t d = 0; d < plan->num_tasks; d++) {
+        if (!(task->deps & (1u << d))) continue;
+        startup_state_t state = plan->tasks[d].state;
+        if (state == STARTUP_FAILED || state == STARTUP_SKIPPED) return -1;
+        if (state != STARTUP_DONE) ready = 0;
+    }
+    return ready;
+}
+
+static void run_task(startup_plan_t *plan, startup_task_t *task) {
+    pthread_mutex_lock(&plan->lock);
+    int ready;
+    while ((ready = deps_ready(plan, task)) == 0) {
+        pthread_cond_wait(&plan->cond, &plan->lock);
+    }
+    if (ready < 0) {
+        task->state = STARTUP_SKIPPED;
+        pthread_cond_broadcast(&plan->cond);
+        pthread_mutex_unlock(&plan->lock);
+        return;
+    }
+    task->state = STARTUP_RUNNING;
+    task->start_sec = startup_now() - plan->t0;
+    pthread_mutex_unlock(&plan->lock);
+
+    int result = task->fn(task->arg);
+
+    pthread_mutex_lock(&plan->lock);
+    task->end_sec = startup_now() - plan->t0;
+    task->state = (result < 0) ? STARTUP_FAILED : STARTUP_DONE;
+    pthread_cond_broadcast(&plan->cond);
+    pthread_mutex_unlock(&plan->lock);
+}
+
+static void *task_thread(void *arg) {
+    task_ref_t *ref = (task_ref_t *)arg;
+    run_task(ref->plan, &ref->plan->tasks[ref->index]);
+    return NULL;
+}
+
+int startup_run(startup_plan_t *plan, int parallel) {
+    task_ref_t refs[STARTUP_MAX_TASKS];
+    uint8_t started[STARTUP_MAX_TASKS] = {0};
+
+    for (uint32_t i = 0; i < plan->num_tasks; i++) {
+        // Dependencies must point backwards: serial order is always valid
+        if (plan->tasks[i].deps >> i) {
+            fprintf(stderr, "Startup task '%s' depends on a later task\n", plan->tasks[i].name);
+            return -1;
+        }
+    }
+
+    for (uint32_t i = 0; i < plan->num_tasks; i++) {
+        refs[i].plan = plan;
+        refs[i].index = i;
+        if (parallel && pthread_create(&plan->tasks[i].thread, NULL, task_thread, &refs[i]) == 0) {
+            started[i] = 1;
+        } else {
+            // Serial mode, or no thread available: run in place
+            run_task(plan, &plan->tasks[i]);
+        }
+    }
+
+    int result = 0;
+    for (uint32_t i = 0; i < plan->num_tasks; i++) {
+        if (started[i]) {
+            pthread_join(plan->tasks[i].thread, NULL);
+        }
+        if (plan->tasks[i].state != STARTUP_DONE) {
+            result = -1;
+        }
+    }
+    return result;
+}
+
+int startup_succeeded(const startup_plan_t *plan, int index) {
+    return index >= 0 && (uint32_t)index < plan->num_tasks &&
+           plan->tasks[index].state == STARTUP_DONE;
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+void startup_print(const startup_plan_t *plan) {
+    static const char *state_names[] = { "pending", "running", "ok", "FAILED", "skipped" };
+
+    printf("\nStartup timeline (seconds since process start):\n");
+    printf("  %-20s %8s %8s %8s  %s\n", "Task", "Start", "End", "Time", "Result");
+    for (uint32_t i = 0; i < plan->num_tasks; i++) {
+        const startup_task_t *task = &plan->tasks[i];
+        if (task->state == STARTUP_SKIPPED) {
+            printf("  %-20s %8s %8s %8s  %s\n", task->name, "-", "-", "-", state_names[task->state]);
+            continue;
+        }
+        printf("  %-20s %8.3f %8.3f %8.3f  %s\n", task->name, task->start_sec, task->end_sec,
+               task->end_sec - task->start_sec, state_names[task->state]);
+    }
+}
+
+void startup_free(startup_plan_t *plan) {
+    pthread_cond_destroy(&plan->cond);
+    pthread_mutex_destroy(&plan->lock);
+}
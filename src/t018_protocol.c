@@ -18,6 +18,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include <math.h>
+#include <pthread.h>
 
 // =============================================================================
 // GALOIS FIELD TABLES (GF(2^6) for BCH)
@@ -27,6 +28,18 @@ static uint8_t gf_exp[512];        // Exponential table (double size for modulo)
 static uint8_t gf_log[64];         // Logarithm table
 static uint8_t gf_initialized = 0;
 
+// GF(2^8) tables for BCH(250,202) decoding (primitive x^8+x^4+x^3+x^2+1:
+// g(x) has roots α^1..α^12, i.e. corrects up to 6 errors)
+#define GF256_PRIMITIVE     0x11D
+#define BCH_T               6
+static uint8_t gf256_exp[512];
+static uint8_t gf256_log[256];
+static pthread_once_t gf256_once = PTHREAD_ONCE_INIT;
+
+// Byte-wise BCH remainder table (packed decoder)
+static uint64_t bch_table[256];
+static pthread_once_t bch_table_once = PTHREAD_ONCE_INIT;
+
 // Generator polynomial coefficients for BCH(250,202,6)
 static const uint8_t generator_poly[] = {
     1, 59, 13, 104, 189, 68, 209, 30, 8, 163, 65, 41, 229, 98, 50, 36, 59,
@@ -174,6 +187,132 @@ uint8_t t018_verify_bch(const uint8_t *frame_bits) {
     return (received_bch == computed_bch);
 }
 
+// =============================================================================
+// BCH DECODING (syndromes, Berlekamp-Massey, Chien search)
+// =============================================================================
+
+static void init_gf256(void) {
+    uint16_t x = 1;
+    for (int i = 0; i < 255; i++) {
+        gf256_exp[i] = (uint8_t)x;
+        gf256_log[x] = (uint8_t)i;
+        x <<= 1;
+        if (x & 0x100) {
+            x ^= GF256_PRIMITIVE;
+        }
+    }
+    for (int i = 255; i < 512; i++) {
+        gf256_exp[i] = gf256_exp[i - 255];
+    }
+}
+
+static int codeword_valid(const uint8_t *codeword) {
+    uint64_t received = 0;
+    for (int i = 0; i < BCH_PARITY_BITS; i++) {
+        received = (received << 1) | codeword[BCH_INFO_BITS + i];
+    }
+    return received == compute_bch_250_202(codeword);
+}
+
+static inline uint8_t gf256_mul(uint8_t a, uint8_t b) {
+    if (a == 0 || b == 0) return 0;
+    return gf256_exp[gf256_log[a] + gf256_log[b]];
+}
+
+static inline uint8_t gf256_div(uint8_t a, uint8_t b) {
+    if (a == 0) return 0;
+    return gf256_exp[gf256_log[a] + 255 - gf256_log[b]];
+}
+
+int t018_bch_correct(uint8_t *codeword) {
+    pthread_once(&gf256_once, init_gf256);
+
+    // Bit j carries x^(249-j); S_k = r(α^k), k = 1..2t
+    uint8_t syndrome[2 * BCH_T + 1] = {0};
+    int nonzero = 0;
+    for (int j = 0; j < T018_DATA_BITS; j++) {
+        if (!codeword[j]) continue;
+        int power = T018_DATA_BITS - 1 - j;
+        for (int k = 1; k <= 2 * BCH_T; k++) {
+            syndrome[k] ^= gf256_exp[(k * power) % 255];
+        }
+    }
+    for (int k = 1; k <= 2 * BCH_T; k++) {
+        nonzero |= syndrome[k];
+    }
+    if (!nonzero) return 0;
+
+    // Berlekamp-Massey: error locator Λ(x)
+    uint8_t lambda[2 * BCH_T + 1] = {1};
+    uint8_t prev[2 * BCH_T + 1] = {1};
+    uint8_t prev_disc = 1;
+    int order = 0;
+    int shift = 1;
+
+    for (int n = 0; n < 2 * BCH_T; n++) {
+        uint8_t disc = syndrome[n + 1];
+        for (int i = 1; i <= order; i++) {
+            disc ^= gf256_mul(lambda[i], syndrome[n + 1 - i]);
+        }
+
+        if (disc == 0) {
+            shift++;
+            continue;
+        }
+
+        uint8_t saved[2 * BCH_T + 1];
+        memcpy(saved, lambda, sizeof(saved));
+        uint8_t scale = gf256_div(disc, prev_disc);
+        for (int i = 0; i + shift <= 2 * BCH_T; i++) {
+            lambda[i + shift] ^= gf256_mul(scale, prev[i]);
+        }
+
+        if (2 * order <= n) {
+            order = n + 1 - order;
+            memcpy(prev, saved, sizeof(prev));
+            prev_disc = disc;
+            shift = 1;
+        } else {
+            shift++;
+        }
+    }
+
+    if (order > BCH_T) return -1;
+
+    // Chien search over the 250 used positions (shortened code)
+    int positions[BCH_T];
+    int found = 0;
+    for (int power = 0; power < T018_DATA_BITS; power++) {
+        uint8_t sum = 0;
+        for (int i = 0; i <= order; i++) {
+            if (lambda[i]) {
+                // Λ(α^-power)
+                int exponent = (gf256_log[lambda[i]] - (i * power) % 255 + 255) % 255;
+                sum ^= gf256_exp[exponent];
+            }
+        }
+        if (sum == 0) {
+            if (found == BCH_T) return -1;
+            positions[found++] = T018_DATA_BITS - 1 - power;
+        }
+    }
+
+    // Roots outside the shortened codeword mean more than t errors
+    if (found != order) return -1;
+
+    for (int e = 0; e < found; e++) {
+        codeword[positions[e]] ^= 1;
+    }
+
+    if (!codeword_valid(codeword)) {
+        for (int e = 0; e < found; e++) {
+            codeword[positions[e]] ^= 1;
+        }
+        return -1;
+    }
+    return found;
+}
+
 // =============================================================================
 // HELPER FUNCTIONS
 // =============================================================================
@@ -184,6 +323,86 @@ static void write_bits(uint8_t *bit_array, int start_pos, int num_bits, uint64_t
     }
 }
 
+static uint64_t read_bits(const uint8_t *bit_array, int start_pos, int num_bits) {
+    uint64_t value = 0;
+    for (int i = 0; i < num_bits; i++) {
+        value = (value << 1) | (bit_array[start_pos + i] & 1);
+    }
+    return value;
+}
+
+// =============================================================================
+// FIELD CODEC (shared by t018_build_frame() and t018_decode_message())
+// =============================================================================
+
+const t018_field_desc_t t018_field_layout[T018_FIELD_COUNT] = {
+    [T018_FIELD_TAC]           = { "tac",           0,   16 },
+    [T018_FIELD_SERIAL]        = { "serial",        16,  14 },
+    [T018_FIELD_COUNTRY]       = { "country",       30,  10 },
+    [T018_FIELD_HOMING]        = { "homing",        40,  1 },
+    [T018_FIELD_RLS]           = { "rls",           41,  1 },
+    [T018_FIELD_TEST]          = { "test",          42,  1 },
+    [T018_FIELD_LATITUDE]      = { "latitude",      43,  23 },
+    [T018_FIELD_LONGITUDE]     = { "longitude",     66,  24 },
+    [T018_FIELD_VESSEL_TYPE]   = { "vessel_type",   90,  3 },
+    [T018_FIELD_VESSEL_ID]     = { "vessel_id",     93,  30 },
+    [T018_FIELD_AIS_ID]        = { "ais_id",        123, 14 },
+    [T018_FIELD_BEACON_TYPE]   = { "beacon_type",   137, 3 },
+    [T018_FIELD_SPARE]         = { "spare",         140, 14 },
+    [T018_FIELD_ROTATING_ID]   = { "rotating_id",   154, 4 },
+    [T018_FIELD_ROTATING_DATA] = { "rotating_data", 158, 44 },
+};
+
+void t018_pack_fields(const t018_fields_t *fields, uint8_t *info_bits) {
+    for (int f = 0; f < T018_FIELD_COUNT; f++) {
+        const t018_field_desc_t *d = &t018_field_layout[f];
+        write_bits(info_bits, d->offset, d->width, fields->value[f]);
+    }
+}
+
+void t018_unpack_fields(const uint8_t *info_bits, t018_fields_t *fields) {
+    for (int f = 0; f < T018_FIELD_COUNT; f++) {
+        const t018_field_desc_t *d = &t018_field_layout[f];
+        fields->value[f] = read_bits(info_bits, d->offset, d->width);
+    }
+}
+
+void t018_unpack_fields_packed(const uint8_t *bytes, uint32_t bit_offset, t018_fields_t *fields) {
+    for (int f = 0; f < T018_FIELD_COUNT; f++) {
+        const t018_field_desc_t *d = &t018_field_layout[f];
+        fields->value[f] = t018_read_packed(bytes, bit_offset + d->offset, d->width);
+    }
+}
+
+static void build_bch_table(void) {
+    // Remainder of (byte · x^48) mod g(x), MSB first
+    for (uint32_t byte = 0; byte < 256; byte++) {
+        uint64_t r = (uint64_t)byte << 40;
+        for (int k = 0; k < 8; k++) {
+            r = (r & (1ULL << 47)) ? ((r << 1) ^ BCH_GENERATOR_POLY) : (r << 1);
+        }
+        bch_table[byte] = r & 0xFFFFFFFFFFFFULL;
+    }
+}
+
+uint64_t t018_bch_parity_packed(const uint8_t *bytes, uint32_t bit_offset) {
+    pthread_once(&bch_table_once, build_bch_table);
+
+    // 25 whole bytes through the table, the last 2 bits one at a time
+    uint64_t r = 0;
+    for (int k = 0; k < BCH_INFO_BITS / 8; k++) {
+        uint8_t byte = (uint8_t)t018_read_packed(bytes, bit_offset + 8 * k, 8);
+        r = ((r << 8) ^ bch_table[((r >> 40) ^ byte) & 0xFF]) & 0xFFFFFFFFFFFFULL;
+    }
+    for (int k = BCH_INFO_BITS / 8 * 8; k < BCH_INFO_BITS; k++) {
+        uint64_t bit = t018_read_packed(bytes, bit_offset + k, 1);
+        uint64_t top = ((r >> 47) ^ bit) & 1;
+        r = (r << 1) & 0xFFFFFFFFFFFFULL;
+        if (top) r ^= BCH_GENERATOR_POLY & 0xFFFFFFFFFFFFULL;
+    }
+    return r;
+}
+
 static uint8_t lfsr_8bit(uint8_t state) {
     // 8-bit LFSR for rotating field generation
     uint8_t feedback = ((state >> 0) ^ (state >> 2) ^ (state >> 3) ^ (state >> 4)) & 1;
@@ -231,9 +450,10 @@ static uint32_t encode_time_value(uint8_t day, uint8_t hour, uint8_t minute) {
 // ROTATING FIELD IMPLEMENTATION
 // =============================================================================
 
-static void set_rotating_field(uint8_t *info_bits, rotating_field_type_t rf_type) {
-    // Set rotating field type identifier (4 bits) at position 154
-    write_bits(info_bits, 154, 4, rf_type);
+static uint64_t rotating_field_data(rotating_field_type_t rf_type) {
+    // 44 content bits after the 4-bit identifier (T.018 bits 159-202)
+    uint8_t data[44];
+    memset(data, 0, sizeof(data));
 
     switch (rf_type) {
     case RF_TYPE_G008:
@@ -243,19 +463,19 @@ static void set_rotating_field(uint8_t *info_bits, rotating_field_type_t rf_type
             uint16_t last_pos_minutes = get_time_since_last_location_minutes();
             uint16_t altitude_code = altitude_to_code(beacon_config.position.altitude);
 
-            write_bits(info_bits, 158, 6, elapsed_hours);         // T.018 bits 159-164
-            write_bits(info_bits, 164, 11, last_pos_minutes);     // T.018 bits 165-175
-            write_bits(info_bits, 175, 10, altitude_code);        // T.018 bits 176-185
+            write_bits(data, 0, 6, elapsed_hours);        // T.018 bits 159-164
+            write_bits(data, 6, 11, last_pos_minutes);    // T.018 bits 165-175
+            write_bits(data, 17, 10, altitude_code);      // T.018 bits 176-185
 
             // For Test Mode: Generate dynamic rotating field (bits 186-202)
             if (beacon_config.test_mode) {
                 uint8_t lfsr_state = elt_state.transmission_count & 0xFF;
                 for (int i = 0; i < 17; i++) {  // 17 bits (T.018 bits 186-202)
                     lfsr_state = lfsr_8bit(lfsr_state);
-                    info_bits[185 + i] = lfsr_state & 0x01;
+                    data[27 + i] = lfsr_state & 0x01;
                 }
             } else {
-                write_bits(info_bits, 185, 17, 0);  // Exercise mode: spare bits
+                write_bits(data, 27, 17, 0);  // Exercise mode: spare bits
             }
         }
         break;
@@ -268,9 +488,9 @@ static void set_rotating_field(uint8_t *info_bits, rotating_field_type_t rf_type
             uint32_t time_value = encode_time_value(tm_info->tm_mday, tm_info->tm_hour, tm_info->tm_min);
             uint16_t altitude_code = altitude_to_code(beacon_config.position.altitude);
 
-            write_bits(info_bits, 158, 16, time_value);
-            write_bits(info_bits, 174, 10, altitude_code);
-            write_bits(info_bits, 184, 18, 0);  // Spare bits
+            write_bits(data, 0, 16, time_value);
+            write_bits(data, 16, 10, altitude_code);
+            write_bits(data, 26, 18, 0);  // Spare bits
         }
         break;
 
@@ -280,8 +500,8 @@ static void set_rotating_field(uint8_t *info_bits, rotating_field_type_t rf_type
             uint8_t rls_provider = 0;   // Galileo
             uint64_t rls_data = 0;       // Placeholder
 
-            write_bits(info_bits, 158, 8, rls_provider);
-            write_bits(info_bits, 166, 36, rls_data);
+            write_bits(data, 0, 8, rls_provider);
+            write_bits(data, 8, 36, rls_data);
         }
         break;
 
@@ -290,12 +510,13 @@ static void set_rotating_field(uint8_t *info_bits, rotating_field_type_t rf_type
         {
             uint8_t deactivation_method = 0;  // Manual deactivation
 
-            write_bits(info_bits, 158, 2, deactivation_method);
+            write_bits(data, 0, 2, deactivation_method);
             // Fixed bits - all 42 bits set to 1 (T.018 spec)
-            write_bits(info_bits, 160, 42, 0x3FFFFFFFFFFULL);
+            write_bits(data, 2, 42, 0x3FFFFFFFFFFULL);
         }
         break;
     }
+    return read_bits(data, 0, 44);
 }
 
 // =============================================================================
@@ -355,44 +576,32 @@ void t018_build_frame(const beacon_config_t *config, uint8_t *frame_bits) {
     // BUILD 202-BIT INFORMATION FIELD
     // =============================================================================
 
-    uint8_t info_bits[T018_INFO_BITS];
-    memset(info_bits, 0, T018_INFO_BITS);
-
-    int bit_pos = 0;
+    t018_fields_t fields;
+    memset(&fields, 0, sizeof(fields));
 
     // Bits 1-16: TAC (16 bits)
-    uint16_t tac = beacon_config.test_mode ? 9999 : beacon_config.tac_number;
-    write_bits(info_bits, bit_pos, 16, tac);
-    bit_pos += 16;
+    fields.value[T018_FIELD_TAC] = beacon_config.test_mode ? 9999 : beacon_config.tac_number;
 
     // Bits 17-30: Serial number (14 bits)
-    uint16_t serial = beacon_config.serial_number & 0x3FFF;
-    write_bits(info_bits, bit_pos, 14, serial);
-    bit_pos += 14;
+    fields.value[T018_FIELD_SERIAL] = beacon_config.serial_number;
 
     // Bits 31-40: Country code (10 bits)
-    uint16_t country = beacon_config.country_code & 0x3FF;
-    write_bits(info_bits, bit_pos, 10, country);
-    bit_pos += 10;
+    fields.value[T018_FIELD_COUNTRY] = beacon_config.country_code;
 
     // Bit 41: Homing device status (0 = not equipped/disabled)
-    info_bits[bit_pos++] = 0;
+    fields.value[T018_FIELD_HOMING] = 0;
 
     // Bit 42: RLS capability (1 = enabled)
-    info_bits[bit_pos++] = 1;
+    fields.value[T018_FIELD_RLS] = 1;
 
     // Bit 43: Test protocol flag
-    info_bits[bit_pos++] = beacon_config.test_mode ? 1 : 0;
+    fields.value[T018_FIELD_TEST] = beacon_config.test_mode ? 1 : 0;
 
-    // Bits 44-66: Latitude (23 bits) per T.018 Appendix C
+    // Bits 44-66: Latitude (23 bits), bits 67-90: Longitude (24 bits) per T.018 Appendix C
     uint8_t gps_encoded[47];
     t018_encode_position(&beacon_config.position, gps_encoded);
-    memcpy(&info_bits[bit_pos], gps_encoded, 23);
-    bit_pos += 23;
-
-    // Bits 67-90: Longitude (24 bits)
-    memcpy(&info_bits[bit_pos], &gps_encoded[23], 24);
-    bit_pos += 24;
+    fields.value[T018_FIELD_LATITUDE] = read_bits(gps_encoded, 0, 23);
+    fields.value[T018_FIELD_LONGITUDE] = read_bits(gps_encoded, 23, 24);
 
     // Bits 91-93: Vessel ID type (3 bits)
     uint8_t vessel_id_type = 0;
@@ -408,8 +617,7 @@ void t018_build_frame(const beacon_config_t *config, uint8_t *frame_bits) {
         vessel_id_type = 0;  // No vessel ID (000)
         break;
     }
-    write_bits(info_bits, bit_pos, 3, vessel_id_type);
-    bit_pos += 3;
+    fields.value[T018_FIELD_VESSEL_TYPE] = vessel_id_type;
 
     // Bits 94-123: Vessel ID (30 bits)
     // For EPIRB: MMSI, for ELT: 24-bit address, for PLB: spare
@@ -417,28 +625,27 @@ void t018_build_frame(const beacon_config_t *config, uint8_t *frame_bits) {
     if (beacon_config.type == BEACON_TYPE_EPIRB) {
         vessel_id = 227006600;  // Example French MMSI
     }
-    write_bits(info_bits, bit_pos, 30, vessel_id & 0x3FFFFFFF);
-    bit_pos += 30;
+    fields.value[T018_FIELD_VESSEL_ID] = vessel_id;
 
     // Bits 124-137: EPIRB-AIS System Identity (14 bits) - spare
-    write_bits(info_bits, bit_pos, 14, 0);
-    bit_pos += 14;
+    fields.value[T018_FIELD_AIS_ID] = 0;
 
     // Bits 138-140: Beacon type (3 bits)
-    write_bits(info_bits, bit_pos, 3, beacon_config.type);
-    bit_pos += 3;
+    fields.value[T018_FIELD_BEACON_TYPE] = beacon_config.type;
 
-    // Bits 141-154: Spare bits (14 bits)
-    uint16_t spare_bits = 0x3FFF;  // All 1s
-    write_bits(info_bits, bit_pos, 14, spare_bits);
-    bit_pos += 14;
+    // Bits 141-154: Spare bits (14 bits), all 1s
+    fields.value[T018_FIELD_SPARE] = 0x3FFF;
 
-    // Bits 155-202: Rotating Field (48 bits)
+    // Bits 155-202: Rotating Field (4-bit identifier + 44 bits)
     rotating_field_type_t rf_type = RF_TYPE_G008;  // Default
     if (beacon_config.type == BEACON_TYPE_ELT_DT) {
         rf_type = RF_TYPE_ELTDT;
     }
-    set_rotating_field(info_bits, rf_type);
+    fields.value[T018_FIELD_ROTATING_ID] = rf_type;
+    fields.value[T018_FIELD_ROTATING_DATA] = rotating_field_data(rf_type);
+
+    uint8_t info_bits[T018_INFO_BITS];
+    t018_pack_fields(&fields, info_bits);
 
     // =============================================================================
     // BUILD COMPLETE 252-BIT FRAME
@@ -458,6 +665,117 @@ void t018_build_frame(const beacon_config_t *config, uint8_t *frame_bits) {
     }
 }
 
+// =============================================================================
+// FRAME DECODING
+// =============================================================================
+
+static double decode_coordinate(uint64_t code, int degree_bits) {
+    // Inverse of t018_encode_position(): sign, degrees, 15-bit fraction
+    double degrees = (double)((code >> 15) & ((1u << degree_bits) - 1));
+    double value = degrees + (code & 0x7FFF) / 32768.0;
+    return (code >> (15 + degree_bits)) ? -value : value;
+}
+
+void t018_fields_to_message(const t018_fields_t *fields, t018_message_t *msg) {
+    const uint64_t *v = fields->value;
+    memset(msg, 0, sizeof(t018_message_t));
+
+    msg->tac_number = (uint16_t)v[T018_FIELD_TAC];
+    msg->serial_number = (uint16_t)v[T018_FIELD_SERIAL];
+    msg->country_code = (uint16_t)v[T018_FIELD_COUNTRY];
+    msg->homing = (uint8_t)v[T018_FIELD_HOMING];
+    msg->rls = (uint8_t)v[T018_FIELD_RLS];
+    msg->test_protocol = (uint8_t)v[T018_FIELD_TEST];
+
+    msg->position.latitude = decode_coordinate(v[T018_FIELD_LATITUDE], 7);
+    msg->position.longitude = decode_coordinate(v[T018_FIELD_LONGITUDE], 8);
+    msg->position.valid = 1;
+
+    msg->vessel_id_type = (uint8_t)v[T018_FIELD_VESSEL_TYPE];
+    msg->vessel_id = (uint32_t)v[T018_FIELD_VESSEL_ID];
+    msg->ais_id = (uint16_t)v[T018_FIELD_AIS_ID];
+    msg->beacon_type = (uint8_t)v[T018_FIELD_BEACON_TYPE];
+    msg->spare = (uint16_t)v[T018_FIELD_SPARE];
+    msg->rotating_field = (uint8_t)v[T018_FIELD_ROTATING_ID];
+    msg->rotating_data = v[T018_FIELD_ROTATING_DATA];
+}
+
+void t018_message_to_fields(const t018_message_t *msg, t018_fields_t *fields) {
+    uint64_t *v = fields->value;
+    uint8_t gps_encoded[47];
+
+    t018_encode_position(&msg->position, gps_encoded);
+    v[T018_FIELD_TAC] = msg->tac_number;
+    v[T018_FIELD_SERIAL] = msg->serial_number;
+    v[T018_FIELD_COUNTRY] = msg->country_code;
+    v[T018_FIELD_HOMING] = msg->homing;
+    v[T018_FIELD_RLS] = msg->rls;
+    v[T018_FIELD_TEST] = msg->test_protocol;
+    v[T018_FIELD_LATITUDE] = read_bits(gps_encoded, 0, 23);
+    v[T018_FIELD_LONGITUDE] = read_bits(gps_encoded, 23, 24);
+    v[T018_FIELD_VESSEL_TYPE] = msg->vessel_id_type;
+    v[T018_FIELD_VESSEL_ID] = msg->vessel_id;
+    v[T018_FIELD_AIS_ID] = msg->ais_id;
+    v[T018_FIELD_BEACON_TYPE] = msg->beacon_type;
+    v[T018_FIELD_SPARE] = msg->spare;
+    v[T018_FIELD_ROTATING_ID] = msg->rotating_field;
+    v[T018_FIELD_ROTATING_DATA] = msg->rotating_data;
+}
+
+void t018_decode_message(const uint8_t *info_bits, t018_message_t *msg) {
+    t018_fields_t fields;
+    t018_unpack_fields(info_bits, &fields);
+    t018_fields_to_message(&fields, msg);
+}
+
+void t018_encode_message(const t018_message_t *msg, uint8_t *info_bits) {
+    t018_fields_t fields;
+    t018_message_to_fields(msg, &fields);
+    t018_pack_fields(&fields, info_bits);
+}
+
+void t018_print_message(const t018_message_t *msg) {
+    static const char *beacon_names[] = { "EPIRB", "PLB", "ELT", "ELT-DT" };
+    static const char *rotating_names[] = { "G.008", "ELT-DT", "RLS", "Cancel" };
+
+    printf("  TAC: %u  Serial: %u  Country (MID): %u%s\n",
+           msg->tac_number, msg->serial_number, msg->country_code,
+           msg->test_protocol ? "  [TEST]" : "");
+    printf("  Beacon type: %s  Homing: %u  RLS: %u\n",
+           msg->beacon_type < 4 ? beacon_names[msg->beacon_type] : "unknown",
+           msg->homing, msg->rls);
+    printf("  Position: %.5f°%c %.5f°%c\n",
+           fabs(msg->position.latitude), msg->position.latitude < 0 ? 'S' : 'N',
+           fabs(msg->position.longitude), msg->position.longitude < 0 ? 'W' : 'E');
+    printf("  Vessel ID: type %u, %u\n", msg->vessel_id_type, msg->vessel_id);
+    printf("  Rotating field: %s (%u), data %011llX\n",
+           msg->rotating_field < 4 ? rotating_names[msg->rotating_field] : "unknown",
+           msg->rotating_field, (unsigned long long)msg->rotating_data);
+}
+
+void t018_beacon_id_from_fields(const t018_fields_t *fields, t018_beacon_id_t *id) {
+    const uint64_t *v = fields->value;
+
+    // '1' | MID (10) | '101' | TAC (16) | serial (14) | test (1) | vessel ID type (3)
+    id->hi = (1ULL << 47) | (v[T018_FIELD_COUNTRY] << 37) | (0x5ULL << 34) |
+             (v[T018_FIELD_TAC] << 18) | (v[T018_FIELD_SERIAL] << 4) |
+             (v[T018_FIELD_TEST] << 3) | v[T018_FIELD_VESSEL_TYPE];
+
+    // Vessel ID (30) and EPIRB-AIS identity (14): T.018 bits 94-137
+    id->lo = (v[T018_FIELD_VESSEL_ID] << 14) | v[T018_FIELD_AIS_ID];
+}
+
+void t018_beacon_id(const uint8_t *info_bits, t018_beacon_id_t *id) {
+    t018_fields_t fields;
+    t018_unpack_fields(info_bits, &fields);
+    t018_beacon_id_from_fields(&fields, id);
+}
+
+void t018_format_beacon_id(const t018_beacon_id_t *id, char *hex) {
+    snprintf(hex, 24, "%012llX%011llX",
+             (unsigned long long)id->hi, (unsigned long long)id->lo);
+}
+
 // =============================================================================
 // ELT SEQUENCE MANAGEMENT
 // =============================================================================
@@ -0,0 +1,367 @@
+/**
+ * @file task_pool.c
+ * @brief Work-stealing task pool implementation
+ *
+ * Deques are small mutex-protected ring buffers: tasks here are coarse
+ * (thousands of chips or a whole frame), so a lock per push/pop costs
+ * nothing measurable and keeps the code obviously correct. Threads outside
+ * the pool push to an extra shared deque that workers steal from.
+ */
+
+#define _GNU_SOURCE                 // pthread_setaffinity_np()
+
+#include "task_pool.h"
+#include "mem_account.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#define WAIT_SPINS              64          // Yields before sleeping in task_pool_wait()
+#define WAIT_SLEEP_NS           50000       // Sleep between checks afterwards
+
+// Calling thread's pool and deque (workers only)
+static __thread task_pool_t *tls_pool = NULL;
+static __thread uint32_t tls_index = 0;
+
+// =============================================================================
+// DEQUE
+// =============================================================================
+
+static int deque_init(task_deque_t *dq) {
+    memset(dq, 0, sizeof(task_deque_t));
+    dq->tasks = mem_alloc(MEM_POOL, TASK_DEQUE_INITIAL * sizeof(task_t));
+    if (!dq->tasks) return -1;
+    dq->capacity = TASK_DEQUE_INITIAL;
+    pthread_mutex_init(&dq->lock, NULL);
+    return 0;
+}
+
+static void deque_free(task_deque_t *dq) {
+    if (!dq->tasks) return;
+    pthread_mutex_destroy(&dq->lock);
+    mem_free(dq->tasks);
+    dq->tasks = NULL;
+}
+
+static int deque_push_bottom(task_deque_t *dq, const task_t *task) {
+    pthread_mutex_lock(&dq->lock);
+    if (dq->count == dq->capacity) {
+        task_t *grown = mem_alloc(MEM_POOL, 2 * dq->capacity * sizeof(task_t));
+        if (!grown) {
+            pthread_mutex_unlock(&dq->lock);
+            return -1;
+        }
+        for (uint32_t i = 0; i < dq->count; i++) {
+            grown[i] = dq->tasks[(dq->top + i) % dq->capacity];
+        }
+        mem_free(dq->tasks);
+        dq->tasks = grown;
+        dq->top = 0;
+        dq->capacity *= 2;
+    }
+    dq->tasks[(dq->top + dq->count) % dq->capacity] = *task;
+    dq->count++;
+    pthread_mutex_unlock(&dq->lock);
+    return 0;
+}
+
+static int deque_pop_bottom(task_deque_t *dq, task_t *task) {
+    pthread_mutex_lock(&dq->lock);
+    int found = dq->count > 0;
+    if (found) {
+        dq->count--;
+        *task = dq->tasks[(dq->top + dq->count) % dq->capacity];
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+static int deque_steal_top(task_deque_t *dq, task_t *task) {
+    pthread_mutex_lock(&dq->lock);
+    int found = dq->count > 0;
+    if (found) {
+        *task = dq->tasks[dq->top];
+        dq->top = (dq->top + 1) % dq->capacity;
+        dq->count--;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+// =============================================================================
+// SCHEDULING
+// =============================================================================
+
+static uint32_t self_index(const task_pool_t *pool) {
+    return (tls_pool == pool) ? tls_index : pool->num_workers;
+}
+
+// Own deque first (newest task), then steal the oldest task of another
+static int find_task(task_pool_t *pool, uint32_t self, task_t *task) {
+    if (atomic_load_explicit(&pool->queued, memory_order_acquire) == 0) {
+        return 0;
+    }
+
+    uint32_t n = pool->num_workers + 1;
+    if (deque_pop_bottom(&pool->deques[self], task)) {
+        atomic_fetch_sub(&pool->queued, 1);
+        return 1;
+    }
+    for (uint32_t k = 1; k < n; k++) {
+        uint32_t victim = (self + k) % n;
+        if (deque_steal_top(&pool->deques[victim], task)) {
+            atomic_fetch_sub(&pool->queued, 1);
+            atomic_fetch_add_explicit(&pool->stats[self].stolen, 1, memory_order_relaxed);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void run_task(task_pool_t *pool, uint32_t self, const task_t *task) {
+    task->fn(task->arg);
+    atomic_fetch_add_explicit(&pool->stats[self].executed, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&task->group->pending, 1, memory_order_release);
+}
+
+static void *worker_thread(void *arg) {
+    task_worker_t *worker = (task_worker_t *)arg;
+    task_pool_t *pool = worker->pool;
+    tls_pool = pool;
+    tls_index = worker->index;
+
+    for (;;) {
+        task_t task;
+        if (find_task(pool, worker->index, &task)) {
+            run_task(pool, worker->index, &task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->idle_lock);
+        while (!pool->stop && atomic_load(&pool->queued) == 0) {
+            pthread_cond_wait(&pool->idle_cond, &pool->idle_lock);
+        }
+        int stop = pool->stop;
+        pthread_mutex_unlock(&pool->idle_lock);
+        if (stop) break;
+    }
+    return NULL;
+}
+
+// =============================================================================
+// POOL
+// =============================================================================
+
+int task_pool_init(task_pool_t *pool, uint32_t threads, int pin_cpus) {
+    memset(pool, 0, sizeof(task_pool_t));
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+    if (threads == 0) threads = (uint32_t)cpus;
+    if (threads > TASK_POOL_MAX_THREADS) threads = TASK_POOL_MAX_THREADS;
+
+    pool->num_threads = threads;
+    pool->num_workers = threads - 1;
+    pthread_mutex_init(&pool->idle_lock, NULL);
+    pthread_cond_init(&pool->idle_cond, NULL);
+
+    pool->deques = mem_calloc(MEM_POOL, pool->num_workers + 1, sizeof(task_deque_t));
+    pool->stats = mem_calloc(MEM_POOL, pool->num_workers + 1, sizeof(task_worker_stats_t));
+    pool->workers = mem_calloc(MEM_POOL, pool->num_workers ? pool->num_workers : 1, sizeof(task_worker_t));
+    if (!pool->deques || !pool->stats || !pool->workers) {
+        fprintf(stderr, "Failed to allocate task pool\n");
+        task_pool_destroy(pool);
+        return -1;
+    }
+    for (uint32_t i = 0; i <= pool->num_workers; i++) {
+        if (deque_init(&pool->deques[i]) < 0) {
+            fprintf(stderr, "Failed to allocate task deque\n");
+            task_pool_destroy(pool);
+            return -1;
+        }
+    }
+
+    for (uint32_t i = 0; i < pool->num_workers; i++) {
+        task_worker_t *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i;
+        if (pthread_create(&worker->thread, NULL, worker_thread, worker) != 0) {
+            fprintf(stderr, "Failed to start task worker %u\n", i);
+            pool->num_workers = i;
+            task_pool_destroy(pool);
+            return -1;
+        }
+
+        if (pin_cpus) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(i % (uint32_t)cpus, &set);
+            if (pthread_setaffinity_np(worker->thread, sizeof(set), &set) == 0) {
+                pool->pinned = 1;
+            }
+        }
+    }
+    return 0;
+}
+
+void task_pool_destroy(task_pool_t *pool) {
+    pthread_mutex_lock(&pool->idle_lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->idle_cond);
+    pthread_mutex_unlock(&pool->idle_lock);
+
+    for (uint32_t i = 0; pool->workers && i < pool->num_workers; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (uint32_t i = 0; pool->deques && i <= pool->num_workers; i++) {
+        deque_free(&pool->deques[i]);
+    }
+    mem_free(pool->deques);
+    mem_free(pool->stats);
+    mem_free(pool->workers);
+    pool->deques = NULL;
+    pool->stats = NULL;
+    pool->workers = NULL;
+    pthread_cond_destroy(&pool->idle_cond);
+    pthread_mutex_destroy(&pool->idle_lock);
+}
+
+// =============================================================================
+// TASK GROUPS
+// =============================================================================
+
+void task_group_init(task_group_t *group) {
+    atomic_init(&group->pending, 0);
+}
+
+void task_pool_spawn(task_pool_t *pool, task_group_t *group, task_fn_t fn, void *arg) {
+    task_t task = { fn, arg, group };
+    atomic_fetch_add(&group->pending, 1);
+
+    if (deque_push_bottom(&pool->deques[self_index(pool)], &task) < 0) {
+        // Out of memory: run it now rather than lose it
+        run_task(pool, self_index(pool), &task);
+        return;
+    }
+    atomic_fetch_add_explicit(&pool->queued, 1, memory_order_release);
+
+    if (pool->num_workers > 0) {
+        pthread_mutex_lock(&pool->idle_lock);
+        pthread_cond_signal(&pool->idle_cond);
+        pthread_mutex_unlock(&pool->idle_lock);
+    }
+}
+
+void task_pool_wait(task_pool_t *pool, task_group_t *group) {
+    uint32_t self = self_index(pool);
+    uint32_t idle = 0;
+
+    while (atomic_load_explicit(&group->pending, memory_order_acquire) > 0) {
+        task_t task;
+        if (find_task(pool, self, &task)) {
+            run_task(pool, self, &task);
+            idle = 0;
+        } else if (++idle < WAIT_SPINS) {
+            sched_yield();
+        } else {
+            // Remaining tasks are running on other threads
+            struct timespec ts = { 0, WAIT_SLEEP_NS };
+            nanosleep(&ts, NULL);
+        }
+    }
+}
+
+// =============================================================================
+// PARALLEL FOR
+// =============================================================================
+
+typedef struct {
+    task_range_fn_t fn;
+    void *ctx;
+    uint32_t begin;
+    uint32_t end;
+} range_task_t;
+
+static void range_task(void *arg) {
+    range_task_t *rt = (range_task_t *)arg;
+    rt->fn(rt->ctx, rt->begin, rt->end);
+}
+
+void task_pool_parallel_for(task_pool_t *pool, uint32_t begin, uint32_t end, uint32_t grain,
+                            task_range_fn_t fn, void *ctx) {
+    if (end <= begin) return;
+
+    uint32_t total = end - begin;
+    if (grain == 0) {
+        uint32_t chunks = 4 * (pool ? pool->num_threads : 1);
+        grain = (total + chunks - 1) / chunks;
+    }
+    uint32_t num_chunks = (total + grain - 1) / grain;
+
+    range_task_t *tasks = NULL;
+    if (pool && pool->num_threads > 1 && num_chunks > 1) {
+        tasks = mem_alloc(MEM_POOL, num_chunks * sizeof(range_task_t));
+    }
+    if (!tasks) {
+        // Same chunking inline: results do not depend on the pool
+        for (uint32_t b = begin; b < end; b += grain) {
+            fn(ctx, b, (end - b > grain) ? b + grain : end);
+        }
+        return;
+    }
+
+    task_group_t group;
+    task_group_init(&group);
+    for (uint32_t c = 0; c < num_chunks; c++) {
+        uint32_t b = begin + c * grain;
+        tasks[c] = (range_task_t) { fn, ctx, b, (end - b > grain) ? b + grain : end };
+        task_pool_spawn(pool, &group, range_task, &tasks[c]);
+    }
+    task_pool_wait(pool, &group);
+    mem_free(tasks);
+}
+
+// =============================================================================
+// PROCESS-WIDE POOL
+// =============================================================================
+
+static task_pool_t default_pool;
+static pthread_once_t default_once = PTHREAD_ONCE_INIT;
+static uint32_t default_threads = 0;
+static int default_pin = 0;
+static int default_ok = 0;
+static task_pool_t *_Atomic default_override = NULL;
+
+static void start_default_pool(void) {
+    default_ok = task_pool_init(&default_pool, default_threads, default_pin) == 0;
+}
+
+void task_pool_configure_default(uint32_t threads, int pin_cpus) {
+    default_threads = threads;
+    default_pin = pin_cpus;
+}
+
+void task_pool_set_default(task_pool_t *pool) {
+    atomic_store(&default_override, pool);
+}
+
+task_pool_t *task_pool_default(void) {
+    task_pool_t *pool = atomic_load(&default_override);
+    if (pool) return pool;
+
+    pthread_once(&default_once, start_default_pool);
+    return default_ok ? &default_pool : NULL;
+}
+
+void task_pool_print_stats(const task_pool_t *pool) {
+    printf("Task pool: %u thread(s)%s\n", pool->num_threads, pool->pinned ? ", pinned" : "");
+    for (uint32_t i = 0; i <= pool->num_workers; i++) {
+        printf("  %-8s %2u: %10llu tasks, %8llu stolen\n",
+               i < pool->num_workers ? "worker" : "callers", i,
+               (unsigned long long)atomic_load(&pool->stats[i].executed),
+               (unsigned long long)atomic_load(&pool->stats[i].stolen));
+    }
+}
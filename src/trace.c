@@ -0,0 +1,177 @@
+/**
+ * @file trace.c
+ * @brief Per-thread lock-free trace buffers and Chrome JSON export
+ *
+ * A thread allocates its buffer on its first event and pushes it onto a
+ * global singly-linked list with a compare-and-swap. Only the owner thread
+ * writes events; the event count is published with release semantics so
+ * trace_stop() sees complete records. Full buffers drop events (counted).
+ */
+
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+// Trace event (24 bytes)
+typedef struct {
+    uint64_t ts_ns;                         // CLOCK_MONOTONIC
+    const char *name;
+    char phase;
+} trace_record_t;
+
+// Per-thread buffer
+typedef struct trace_buffer {
+    struct trace_buffer *next;
+    int tid;
+    char thread_name[TRACE_THREAD_NAME_LEN];
+    _Atomic uint32_t count;
+    uint32_t dropped;
+    trace_record_t events[TRACE_BUFFER_EVENTS];
+} trace_buffer_t;
+
+static _Atomic int trace_enabled = 0;
+static _Atomic(trace_buffer_t *) trace_buffers = NULL;
+static __thread trace_buffer_t *tls_buffer = NULL;
+static char trace_path[256];
+static uint64_t trace_origin_ns;
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static trace_buffer_t *register_thread(void) {
+    trace_buffer_t *buf = calloc(1, sizeof(trace_buffer_t));
+    if (!buf) return NULL;
+
+    buf->tid = (int)syscall(SYS_gettid);
+    snprintf(buf->thread_name, sizeof(buf->thread_name), "thread %d", buf->tid);
+
+    // Lock-free push
+    trace_buffer_t *head = atomic_load(&trace_buffers);
+    do {
+        buf->next = head;
+    } while (!atomic_compare_exchange_weak(&trace_buffers, &head, buf));
+
+    tls_buffer = buf;
+    return buf;
+}
+
+static void write_json_string(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s >= 0x20) fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+void trace_event(const char *name, char phase) {
+    if (!atomic_load_explicit(&trace_enabled, memory_order_relaxed)) return;
+
+    trace_buffer_t *buf = tls_buffer ? tls_buffer : register_thread();
+    if (!buf) return;
+
+    uint32_t n = atomic_load_explicit(&buf->count, memory_order_relaxed);
+    if (n >= TRACE_BUFFER_EVENTS) {
+        buf->dropped++;
+        return;
+    }
+
+    trace_record_t *ev = &buf->events[n];
+    ev->ts_ns = now_ns();
+    ev->name = name;
+    ev->phase = phase;
+    atomic_store_explicit(&buf->count, n + 1, memory_order_release);
+}
+
+void trace_thread_name(const char *name) {
+    if (!atomic_load_explicit(&trace_enabled, memory_order_relaxed)) return;
+
+    trace_buffer_t *buf = tls_buffer ? tls_buffer : register_thread();
+    if (buf) {
+        snprintf(buf->thread_name, sizeof(buf->thread_name), "%s", name);
+    }
+}
+
+// =============================================================================
+// CONTROL & EXPORT
+// =============================================================================
+
+int trace_start(const char *path) {
+#ifndef SGB_TRACE
+    fprintf(stderr, "Tracing not compiled in (build with: make trace)\n");
+    (void)path;
+    return -1;
+#else
+    snprintf(trace_path, sizeof(trace_path), "%s", path);
+    trace_origin_ns = now_ns();
+    atomic_store(&trace_enabled, 1);
+    printf("✓ Tracing to %s\n", trace_path);
+    return 0;
+#endif
+}
+
+int trace_stop(void) {
+    if (!atomic_exchange(&trace_enabled, 0)) return -1;
+
+    FILE *f = fopen(trace_path, "w");
+    if (!f) {
+        fprintf(stderr, "Cannot write trace file %s\n", trace_path);
+        return -1;
+    }
+
+    int pid = (int)getpid();
+    int written = 0;
+    uint32_t dropped = 0;
+    const char *sep = "\n";
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (trace_buffer_t *buf = atomic_load(&trace_buffers); buf; buf = buf->next) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                "\"args\":{\"name\":", sep, pid, buf->tid);
+        write_json_string(f, buf->thread_name);
+        fprintf(f, "}}");
+        sep = ",\n";
+
+        uint32_t count = atomic_load_explicit(&buf->count, memory_order_acquire);
+        for (uint32_t i = 0; i < count; i++) {
+            const trace_record_t *ev = &buf->events[i];
+            uint64_t rel = (ev->ts_ns > trace_origin_ns) ? ev->ts_ns - trace_origin_ns : 0;
+
+            fprintf(f, "%s{\"name\":", sep);
+            write_json_string(f, ev->name);
+            // Timestamps in microseconds (fractional part keeps ns resolution)
+            fprintf(f, ",\"ph\":\"%c\",\"ts\":%llu.%03llu,\"pid\":%d,\"tid\":%d%s}",
+                    ev->phase,
+                    (unsigned long long)(rel / 1000), (unsigned long long)(rel % 1000),
+                    pid, buf->tid,
+                    ev->phase == 'i' ? ",\"s\":\"t\"" : "");
+            written++;
+        }
+        dropped += buf->dropped;
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+
+    printf("✓ Trace written: %s (%d events", trace_path, written);
+    if (dropped) {
+        printf(", %u dropped: buffers full", dropped);
+    }
+    printf(")\n");
+    return written;
+}
@@ -0,0 +1,275 @@
+/**
+ * @file tx_fanout.c
+ * @brief Multi-radio fan-out implementation
+ *
+ * Each device owns a TX thread that sleeps on start_cond until the main
+ * thread publishes a new cycle (cycle counter), pushes every burst of its
+ * beacon set through its own sdr_session_t, then reports completion on
+ * done_cond. Burst buffers are owned by the caller and only read here.
+ */
+
+#include "tx_fanout.h"
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// =============================================================================
+// HELPER FUNCTIONS
+// =============================================================================
+
+static double monotonic_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// =============================================================================
+// DEVICE THREAD
+// =============================================================================
+
+static void *device_thread(void *arg) {
+    tx_device_t *dev = (tx_device_t *)arg;
+    tx_fanout_t *fanout = dev->fanout;
+    uint64_t seen_cycle = 0;
+
+    TRACE_THREAD_NAME(dev->uri);
+    pthread_mutex_lock(&fanout->lock);
+    for (;;) {
+        while (!fanout->stop && fanout->cycle == seen_cycle) {
+            pthread_cond_wait(&fanout->start_cond, &fanout->lock);
+        }
+        if (fanout->stop) break;
+        seen_cycle = fanout->cycle;
+        pthread_mutex_unlock(&fanout->lock);
+
+        // Push the beacon set (no lock held: devices run in parallel)
+        double cycle_start = monotonic_sec();
+        uint8_t failed = 0;
+
+        for (uint32_t b = 0; b < dev->num_beacons; b++) {
+            const fanout_burst_t *burst = dev->bursts[b];
+            if (!burst) continue;
+
+            double t0 = monotonic_sec();
+            TRACE_BEGIN("device push");
+            int sent = sdr_session_transmit(&dev->session, burst->iq_samples, burst->num_samples);
+            TRACE_END("device push");
+            dev->metrics.busy_sec += monotonic_sec() - t0;
+
+            if (sent < 0) {
+                dev->outcome[b] = TX_JOURNAL_FAILED;
+                dev->metrics.failures++;
+                failed = 1;
+                fprintf(stderr, "[%s] Burst for serial %u failed\n", dev->uri, burst->serial_number);
+                continue;
+            }
+            if (sent == 0) {
+                dev->outcome[b] = TX_JOURNAL_OFFLINE;
+                dev->metrics.missed++;
+                continue;
+            }
+            dev->outcome[b] = TX_JOURNAL_SENT;
+            dev->metrics.bursts++;
+            dev->metrics.samples += (uint64_t)sent;
+        }
+
+        double cycle_ms = (monotonic_sec() - cycle_start) * 1000.0;
+        dev->metrics.last_cycle_ms = cycle_ms;
+        if (cycle_ms > dev->metrics.max_cycle_ms) {
+            dev->metrics.max_cycle_ms = cycle_ms;
+        }
+
+        pthread_mutex_lock(&fanout->lock);
+        if (failed) fanout->cycle_failures++;
+        if (--fanout->pending == 0) {
+            pthread_cond_signal(&fanout->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&fanout->lock);
+
+    return NULL;
+}
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+void fanout_init(tx_fanout_t *fanout) {
+    memset(fanout, 0, sizeof(tx_fanout_t));
+    pthread_mutex_init(&fanout->lock, NULL);
+    pthread_cond_init(&fanout->start_cond, NULL);
+    pthread_cond_init(&fanout->done_cond, NULL);
+}
+
+int fanout_add_device(tx_fanout_t *fanout, const char *spec, uint32_t default_serial) {
+    if (fanout->num_devices >= FANOUT_MAX_DEVICES) {
+        fprintf(stderr, "Too many devices (max %d)\n", FANOUT_MAX_DEVICES);
+        return -1;
+    }
+
+    tx_device_t *dev = &fanout->devices[fanout->num_devices];
+    memset(dev, 0, sizeof(tx_device_t));
+    dev->fanout = fanout;
+
+    // URI up to '@' (URIs themselves contain ':')
+    const char *at = strchr(spec, '@');
+    size_t uri_len = at ? (size_t)(at - spec) : strlen(spec);
+    if (uri_len == 0 || uri_len >= sizeof(dev->uri)) {
+        fprintf(stderr, "Invalid device URI in '%s'\n", spec);
+        return -1;
+    }
+    memcpy(dev->uri, spec, uri_len);
+    dev->uri[uri_len] = '\0';
+
+    // Beacon set: comma-separated serial numbers
+    if (at) {
+        const char *p = at + 1;
+        while (*p) {
+            char *end;
+            unsigned long serial = strtoul(p, &end, 10);
+            if (end == p || dev->num_beacons >= FANOUT_MAX_BEACONS) {
+                fprintf(stderr, "Invalid beacon set in '%s' (max %d serials)\n",
+                        spec, FANOUT_MAX_BEACONS);
+                return -1;
+            }
+            dev->serials[dev->num_beacons++] = (uint32_t)serial;
+            p = (*end == ',') ? end + 1 : end;
+            if (*end && *end != ',') {
+                fprintf(stderr, "Invalid beacon set in '%s'\n", spec);
+                return -1;
+            }
+        }
+    }
+    if (dev->num_beacons == 0) {
+        dev->serials[dev->num_beacons++] = default_serial;
+    }
+
+    fanout->num_devices++;
+    return 0;
+}
+
+int fanout_start(tx_fanout_t *fanout, uint64_t frequency, int32_t gain_db, uint32_t sample_rate) {
+    for (uint32_t d = 0; d < fanout->num_devices; d++) {
+        tx_device_t *dev = &fanout->devices[d];
+
+        printf("Initializing device %u (%s)...\n", d, dev->uri);
+        if (sdr_session_open(&dev->session, dev->uri, frequency, gain_db, sample_rate) < 0) {
+            fprintf(stderr, "Device %u (%s) initialization failed\n", d, dev->uri);
+            fanout_stop(fanout);
+            return -1;
+        }
+
+        if (pthread_create(&dev->thread, NULL, device_thread, dev) != 0) {
+            fprintf(stderr, "Failed to start TX thread for device %u\n", d);
+            fanout_stop(fanout);
+            return -1;
+        }
+        dev->thread_started = 1;
+    }
+
+    printf("✓ Fan-out started: %u device(s)\n", fanout->num_devices);
+    return 0;
+}
+
+// =============================================================================
+// TRANSMISSION
+// =============================================================================
+
+int fanout_transmit(tx_fanout_t *fanout, const fanout_burst_t *bursts, uint32_t num_bursts) {
+    // Resolve each device's beacon set against the rendered bursts
+    for (uint32_t d = 0; d < fanout->num_devices; d++) {
+        tx_device_t *dev = &fanout->devices[d];
+        for (uint32_t b = 0; b < dev->num_beacons; b++) {
+            dev->bursts[b] = NULL;
+            for (uint32_t k = 0; k < num_bursts; k++) {
+                if (bursts[k].serial_number == dev->serials[b]) {
+                    dev->bursts[b] = &bursts[k];
+                    break;
+                }
+            }
+            if (!dev->bursts[b]) {
+                fprintf(stderr, "No burst rendered for serial %u (device %s)\n",
+                        dev->serials[b], dev->uri);
+                return -1;
+            }
+        }
+    }
+
+    pthread_mutex_lock(&fanout->lock);
+    fanout->pending = fanout->num_devices;
+    fanout->cycle_failures = 0;
+    fanout->cycle++;
+    pthread_cond_broadcast(&fanout->start_cond);
+
+    while (fanout->pending > 0) {
+        pthread_cond_wait(&fanout->done_cond, &fanout->lock);
+    }
+    int failures = (int)fanout->cycle_failures;
+    pthread_mutex_unlock(&fanout->lock);
+
+    return failures;
+}
+
+uint16_t fanout_burst_outcome(const tx_fanout_t *fanout, uint32_t serial, uint16_t *devices) {
+    uint16_t flags = 0;
+    *devices = 0;
+    for (uint32_t d = 0; d < fanout->num_devices; d++) {
+        const tx_device_t *dev = &fanout->devices[d];
+        for (uint32_t b = 0; b < dev->num_beacons; b++) {
+            if (dev->serials[b] != serial) continue;
+            flags |= dev->outcome[b];
+            if (dev->outcome[b] == TX_JOURNAL_SENT) (*devices)++;
+            break;
+        }
+    }
+    return flags;
+}
+
+// =============================================================================
+// METRICS
+// =============================================================================
+
+void fanout_print_metrics(tx_fanout_t *fanout) {
+    pthread_mutex_lock(&fanout->lock);
+
+    printf("\nFan-out metrics:\n");
+    printf("  %-3s %-24s %7s %6s %6s %12s %10s %10s %10s\n",
+           "Dev", "URI", "Bursts", "Fail", "Miss", "Samples", "Busy (s)", "MS/s", "Max (ms)");
+    for (uint32_t d = 0; d < fanout->num_devices; d++) {
+        const tx_device_t *dev = &fanout->devices[d];
+        const fanout_metrics_t *m = &dev->metrics;
+        double msps = (m->busy_sec > 0.0) ? m->samples / m->busy_sec / 1e6 : 0.0;
+
+        printf("  %-3u %-24s %7llu %6llu %6llu %12llu %10.3f %10.2f %10.1f\n",
+               d, dev->uri,
+               (unsigned long long)m->bursts,
+               (unsigned long long)m->failures,
+               (unsigned long long)m->missed,
+               (unsigned long long)m->samples,
+               m->busy_sec, msps, m->max_cycle_ms);
+    }
+
+    pthread_mutex_unlock(&fanout->lock);
+}
+
+// =============================================================================
+// CLEANUP
+// =============================================================================
+
+void fanout_stop(tx_fanout_t *fanout) {
+    pthread_mutex_lock(&fanout->lock);
+    fanout->stop = 1;
+    pthread_cond_broadcast(&fanout->start_cond);
+    pthread_mutex_unlock(&fanout->lock);
+
+    for (uint32_t d = 0; d < fanout->num_devices; d++) {
+        tx_device_t *dev = &fanout->devices[d];
+        if (dev->thread_started) {
+            pthread_join(dev->thread, NULL);
+            dev->thread_started = 0;
+        }
+        sdr_session_close(&dev->session);
+    }
+}
@@ -0,0 +1,300 @@
+/**
+ * @file tx_journal.c
+ * @brief Append-only binary transmission journal implementation
+ *
+ * Space is reserved with posix_fallocate() before it is mapped: a store
+ * into the mapping never needs a block allocation, so a full disk shows up
+ * as an error when the journal opens or grows, not as SIGBUS on the worker.
+ */
+
+#define _GNU_SOURCE                 // mremap()
+
+#include "tx_journal.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static inline tx_journal_header_t *header(const tx_journal_t *j) {
+    return (tx_journal_header_t *)j->map;
+}
+
+static inline tx_journal_record_t *record(const tx_journal_t *j, uint64_t index) {
+    return (tx_journal_record_t *)(j->map + TX_JOURNAL_HEADER_SIZE) + index;
+}
+
+static inline size_t file_size(uint64_t records) {
+    return TX_JOURNAL_HEADER_SIZE + records * TX_JOURNAL_RECORD_SIZE;
+}
+
+// Header count, then every record already stored past it
+static void find_end(tx_journal_t *j) {
+    uint64_t count = header(j)->count;
+    if (count > j->capacity) count = j->capacity;
+    while (count < j->capacity &&
+           __atomic_load_n(&record(j, count)->seq, __ATOMIC_ACQUIRE) != 0) {
+        count++;
+    }
+    j->count = count;
+}
+
+static int check_header(const tx_journal_t *j) {
+    const tx_journal_header_t *hdr = header(j);
+    if (memcmp(hdr->magic, TX_JOURNAL_MAGIC, sizeof(hdr->magic)) != 0 ||
+        hdr->record_size != TX_JOURNAL_RECORD_SIZE) {
+        fprintf(stderr, "%s is not a transmission journal\n", j->path);
+        return -1;
+    }
+    if (hdr->version != TX_JOURNAL_VERSION) {
+        fprintf(stderr, "%s: journal version %u not supported\n", j->path, hdr->version);
+        return -1;
+    }
+    return 0;
+}
+
+static int map_file(tx_journal_t *j, size_t size) {
+    int prot = j->writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    j->map = mmap(NULL, size, prot, MAP_SHARED, j->fd, 0);
+    if (j->map == MAP_FAILED) {
+        j->map = NULL;
+        fprintf(stderr, "Failed to map %s: %s\n", j->path, strerror(errno));
+        return -1;
+    }
+    j->map_size = size;
+    j->capacity = (size - TX_JOURNAL_HEADER_SIZE) / TX_JOURNAL_RECORD_SIZE;
+    return 0;
+}
+
+// =============================================================================
+// OPEN / CLOSE
+// =============================================================================
+
+int tx_journal_open(tx_journal_t *j, const char *path, uint64_t records) {
+    memset(j, 0, sizeof(tx_journal_t));
+    j->fd = -1;
+    snprintf(j->path, sizeof(j->path), "%s", path);
+    j->writable = 1;
+    if (records == 0) records = TX_JOURNAL_DEFAULT_RECORDS;
+
+    j->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (j->fd < 0) {
+        fprintf(stderr, "Failed to open journal %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(j->fd, &st) < 0) {
+        fprintf(stderr, "Failed to stat %s: %s\n", path, strerror(errno));
+        tx_journal_close(j);
+        return -1;
+    }
+
+    uint8_t created = (st.st_size == 0);
+    if (created) {
+        int err = posix_fallocate(j->fd, 0, (off_t)file_size(records));
+        if (err != 0) {
+            fprintf(stderr, "Failed to preallocate %s: %s\n", path, strerror(err));
+            tx_journal_close(j);
+            return -1;
+        }
+    } else if ((size_t)st.st_size < file_size(1)) {
+        fprintf(stderr, "%s is not a transmission journal\n", path);
+        tx_journal_close(j);
+        return -1;
+    }
+
+    if (map_file(j, created ? file_size(records) : (size_t)st.st_size) < 0) {
+        tx_journal_close(j);
+        return -1;
+    }
+
+    tx_journal_header_t *hdr = header(j);
+    if (created) {
+        struct timespec utc;
+        clock_gettime(CLOCK_REALTIME, &utc);
+        hdr->version = TX_JOURNAL_VERSION;
+        hdr->record_size = TX_JOURNAL_RECORD_SIZE;
+        hdr->capacity = j->capacity;
+        hdr->created_utc_ns = (int64_t)utc.tv_sec * 1000000000LL + utc.tv_nsec;
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        memcpy(hdr->magic, TX_JOURNAL_MAGIC, sizeof(hdr->magic));  // Valid from here on
+        msync(j->map, TX_JOURNAL_HEADER_SIZE, MS_SYNC);
+    } else if (check_header(j) < 0) {
+        tx_journal_close(j);
+        return -1;
+    }
+
+    find_end(j);
+    j->synced = j->count;
+    j->last_sync = now_seconds();
+
+    printf("✓ Transmission journal %s: %llu records, room for %llu (%.1f MiB)\n", path,
+           (unsigned long long)j->count, (unsigned long long)(j->capacity - j->count),
+           j->map_size / 1048576.0);
+    return 0;
+}
+
+int tx_journal_open_read(tx_journal_t *j, const char *path) {
+    memset(j, 0, sizeof(tx_journal_t));
+    j->fd = -1;
+    snprintf(j->path, sizeof(j->path), "%s", path);
+
+    j->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (j->fd < 0) {
+        fprintf(stderr, "Cannot open journal %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(j->fd, &st) < 0 || (size_t)st.st_size < file_size(1)) {
+        fprintf(stderr, "%s is not a transmission journal\n", path);
+        tx_journal_close(j);
+        return -1;
+    }
+    if (map_file(j, (size_t)st.st_size) < 0 || check_header(j) < 0) {
+        tx_journal_close(j);
+        return -1;
+    }
+
+    // One pass front to back
+    madvise(j->map, j->map_size, MADV_SEQUENTIAL);
+    find_end(j);
+    return 0;
+}
+
+void tx_journal_close(tx_journal_t *j) {
+    if (j->map) {
+        if (j->writable) {
+            tx_journal_sync(j);
+        }
+        munmap(j->map, j->map_size);
+        j->map = NULL;
+    }
+    if (j->fd >= 0) {
+        close(j->fd);
+    }
+    j->fd = -1;
+}
+
+// =============================================================================
+// APPEND
+// =============================================================================
+
+// Double the preallocated space (rare: TX_JOURNAL_DEFAULT_RECORDS bursts)
+static int grow(tx_journal_t *j) {
+    uint64_t records = j->capacity * 2;
+    size_t size = file_size(records);
+
+    int err = posix_fallocate(j->fd, 0, (off_t)size);
+    if (err != 0) {
+        fprintf(stderr, "Journal %s full, cannot grow: %s\n", j->path, strerror(err));
+        return -1;
+    }
+    void *map = mremap(j->map, j->map_size, size, MREMAP_MAYMOVE);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "Journal %s full, cannot remap: %s\n", j->path, strerror(errno));
+        return -1;
+    }
+
+    j->map = map;
+    j->map_size = size;
+    j->capacity = records;
+    header(j)->capacity = records;
+    return 0;
+}
+
+int tx_journal_append(tx_journal_t *j, tx_journal_record_t *rec) {
+    if (!j->map || !j->writable) return -1;
+    if (j->count == j->capacity && grow(j) < 0) {
+        return -1;
+    }
+
+    // Body first, then seq: readers never see a partial record
+    tx_journal_record_t *slot = record(j, j->count);
+    rec->seq = j->count + 1;
+    memcpy((uint8_t *)slot + sizeof(slot->seq), (const uint8_t *)rec + sizeof(rec->seq),
+           sizeof(*rec) - sizeof(rec->seq));
+    __atomic_store_n(&slot->seq, rec->seq, __ATOMIC_RELEASE);
+    j->count++;
+    __atomic_store_n(&header(j)->count, j->count, __ATOMIC_RELEASE);
+
+    // Start writeback now; wait for it only every TX_JOURNAL_SYNC_SEC
+    long page = sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)slot & ~(uintptr_t)(page - 1);
+    msync((void *)start, (uintptr_t)(slot + 1) - start, MS_ASYNC);
+    if (now_seconds() - j->last_sync >= TX_JOURNAL_SYNC_SEC) {
+        tx_journal_sync(j);
+    }
+    return 0;
+}
+
+void tx_journal_sync(tx_journal_t *j) {
+    if (!j->map || !j->writable) return;
+
+    if (j->count > j->synced) {
+        long page = sysconf(_SC_PAGESIZE);
+        uintptr_t start = (uintptr_t)record(j, j->synced) & ~(uintptr_t)(page - 1);
+        uintptr_t end = (uintptr_t)record(j, j->count);
+        msync((void *)start, end - start, MS_SYNC);
+    }
+    msync(j->map, TX_JOURNAL_HEADER_SIZE, MS_SYNC);
+    j->synced = j->count;
+    j->last_sync = now_seconds();
+}
+
+// =============================================================================
+// RECORD HELPERS
+// =============================================================================
+
+void tx_journal_pack_frame(const uint8_t *frame_bits, uint8_t *packed) {
+    memset(packed, 0, TX_JOURNAL_FRAME_BYTES);
+    for (int i = 0; i < 252; i++) {
+        if (frame_bits[i]) packed[i >> 3] |= (uint8_t)(0x80 >> (i & 7));
+    }
+}
+
+#define HASH_P1     0x9E3779B185EBCA87ULL
+#define HASH_P2     0xC2B2AE3D27D4EB4FULL
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t tx_journal_hash(const void *data, size_t bytes) {
+    // Four independent multiply-rotate lanes over 32-byte blocks (~10 GB/s)
+    const uint8_t *p = (const uint8_t *)data;
+    uint64_t lane[4] = { HASH_P1, HASH_P2, ~HASH_P1, ~HASH_P2 };
+    size_t blocks = bytes / 32;
+
+    for (size_t b = 0; b < blocks; b++, p += 32) {
+        for (int l = 0; l < 4; l++) {
+            uint64_t w;
+            memcpy(&w, p + 8 * l, sizeof(w));
+            lane[l] = rotl64(lane[l] + w * HASH_P2, 31) * HASH_P1;
+        }
+    }
+
+    uint64_t h = bytes * HASH_P1;
+    for (int l = 0; l < 4; l++) {
+        h = rotl64(h ^ lane[l], 27) * HASH_P1 + HASH_P2;
+    }
+    for (size_t i = 0; i < bytes % 32; i++) {
+        h = (h ^ p[i]) * HASH_P1;
+    }
+
+    // Final avalanche
+    h ^= h >> 33;
+    h *= HASH_P2;
+    h ^= h >> 29;
+    return h;
+}
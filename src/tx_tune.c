@@ -0,0 +1,294 @@
+/**
+ * @file tx_tune.c
+ * @brief TX push calibration and per-URI cache
+ *
+ * Each candidate pushes enough silence to fill the kernel queue and then
+ * time at least TX_TUNE_MIN_PUSHES pushes against the DAC. The cache is a
+ * text file, one line per URI:
+ *   <uri> <chunk> <kernel buffers> <samples/s> <jitter ms> <max push ms> <unix time>
+ */
+
+#include "tx_tune.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define CACHE_LINE_MAX              320
+
+static const uint32_t chunk_candidates[] = { 16384, 32768, 65536, 131072, 262144 };
+static const uint32_t iio_buffer_candidates[] = { 2, 4, 8 };
+static const uint32_t null_buffer_candidates[] = { 0 };
+
+#define NUM_CHUNKS  (sizeof(chunk_candidates) / sizeof(chunk_candidates[0]))
+
+// =============================================================================
+// CALIBRATION
+// =============================================================================
+
+int tx_tune_supported(const pluto_ctx_t *ctx) {
+    return ctx && (ctx->backend == PLUTO_BACKEND_IIO || ctx->backend == PLUTO_BACKEND_NULL);
+}
+
+// Samples pushed for one candidate: queue fill plus the timed pushes
+static uint32_t candidate_samples(const pluto_ctx_t *ctx, uint32_t chunk, uint32_t buffers) {
+    uint32_t queued = (ctx->backend == PLUTO_BACKEND_IIO) ?
+                      (buffers ? buffers : PLUTO_KERNEL_BUFFERS_DEFAULT) : 0;
+    uint32_t samples = (queued + TX_TUNE_MIN_PUSHES) * chunk;
+    uint32_t minimum = (uint32_t)(TX_TUNE_SECONDS * ctx->sample_rate);
+    return samples > minimum ? samples : minimum;
+}
+
+static uint64_t buffered_samples(const tx_tune_result_t *r) {
+    uint32_t buffers = r->kernel_buffers ? r->kernel_buffers : 1;
+    return (uint64_t)r->chunk_size * buffers;
+}
+
+// Keeps up with the DAC, with time to spare at the slowest push
+static int usable(const pluto_ctx_t *ctx, const tx_tune_result_t *r) {
+    if (r->throughput < TX_TUNE_REALTIME_MIN * ctx->sample_rate) return 0;
+    if (ctx->backend != PLUTO_BACKEND_IIO) return 1;
+    double queued_ms = buffered_samples(r) * 1e3 / ctx->sample_rate;
+    return queued_ms - r->max_push_ms >= TX_TUNE_HEADROOM_MS;
+}
+
+int tx_tune_run(pluto_ctx_t *ctx, tx_tune_result_t *best) {
+    if (!tx_tune_supported(ctx) || !ctx->initialized || ctx->sample_rate == 0) {
+        fprintf(stderr, "TX calibration needs a configured IIO or null backend\n");
+        return -1;
+    }
+
+    const uint32_t *buffer_list = iio_buffer_candidates;
+    uint32_t num_buffers = sizeof(iio_buffer_candidates) / sizeof(iio_buffer_candidates[0]);
+    if (ctx->backend == PLUTO_BACKEND_NULL) {
+        buffer_list = null_buffer_candidates;
+        num_buffers = 1;
+    }
+
+    uint32_t max_samples = 0;
+    for (uint32_t c = 0; c < NUM_CHUNKS; c++) {
+        for (uint32_t b = 0; b < num_buffers; b++) {
+            uint32_t n = candidate_samples(ctx, chunk_candidates[c], buffer_list[b]);
+            if (n > max_samples) max_samples = n;
+        }
+    }
+    float complex *silence = calloc(max_samples, sizeof(float complex));
+    if (!silence) {
+        fprintf(stderr, "Failed to allocate calibration buffer\n");
+        return -1;
+    }
+
+    tx_tune_result_t results[NUM_CHUNKS * 3];
+    uint32_t num_results = 0;
+    uint32_t saved_chunk = ctx->chunk_size;
+    uint32_t saved_buffers = ctx->kernel_buffers;
+    int result = 0;
+
+    printf("TX push calibration (%u Hz, silence):\n", ctx->sample_rate);
+    printf("  %8s %8s %12s %11s %11s\n", "Chunk", "Buffers", "Throughput", "Jitter", "Max push");
+
+    ctx->quiet = 1;
+    for (uint32_t c = 0; c < NUM_CHUNKS && result == 0; c++) {
+        for (uint32_t b = 0; b < num_buffers; b++) {
+            uint32_t chunk = chunk_candidates[c];
+            uint32_t buffers = buffer_list[b];
+            if (pluto_set_tx_buffers(ctx, chunk, buffers) < 0 ||
+                pluto_transmit_iq(ctx, silence, candidate_samples(ctx, chunk, buffers)) < 0) {
+                result = TX_TUNE_PUSH_FAILED;
+                break;
+            }
+
+            const pluto_push_stats_t *stats = &ctx->push_stats;
+            tx_tune_result_t *r = &results[num_results++];
+            r->chunk_size = chunk;
+            r->kernel_buffers = buffers;
+            r->throughput = stats->elapsed_sec > 0.0 ? stats->samples / stats->elapsed_sec : 0.0;
+            r->jitter_ms = stats->stddev_ms;
+            r->max_push_ms = stats->max_ms;
+
+            char buffers_str[16] = "-";
+            if (buffers) snprintf(buffers_str, sizeof(buffers_str), "%u", buffers);
+            const char *note = "";
+            if (r->throughput < TX_TUNE_REALTIME_MIN * ctx->sample_rate) {
+                note = "  (too slow)";
+            } else if (!usable(ctx, r)) {
+                note = "  (no headroom)";
+            }
+            printf("  %8u %8s %10.2f×RT %8.3f ms %8.2f ms%s\n", chunk, buffers_str,
+                   r->throughput / ctx->sample_rate, r->jitter_ms, r->max_push_ms, note);
+        }
+    }
+    ctx->quiet = 0;
+    free(silence);
+
+    // Steadiest usable candidate; near-equal ones: least buffering
+    double best_jitter = -1.0;
+    for (uint32_t i = 0; result == 0 && i < num_results; i++) {
+        if (!usable(ctx, &results[i])) continue;
+        if (best_jitter < 0.0 || results[i].jitter_ms < best_jitter) {
+            best_jitter = results[i].jitter_ms;
+        }
+    }
+    if (result == 0 && best_jitter < 0.0) {
+        fprintf(stderr, "⚠ No chunk size sustains %u Hz with headroom\n", ctx->sample_rate);
+        result = -1;
+    }
+
+    const tx_tune_result_t *chosen = NULL;
+    if (result == 0) {
+        double limit = best_jitter * TX_TUNE_JITTER_TOL;
+        if (limit < best_jitter + TX_TUNE_JITTER_FLOOR_MS) {
+            limit = best_jitter + TX_TUNE_JITTER_FLOOR_MS;
+        }
+        for (uint32_t i = 0; i < num_results; i++) {
+            const tx_tune_result_t *r = &results[i];
+            if (!usable(ctx, r) || r->jitter_ms > limit) {
+                continue;
+            }
+            if (!chosen || buffered_samples(r) < buffered_samples(chosen) ||
+                (buffered_samples(r) == buffered_samples(chosen) && r->jitter_ms < chosen->jitter_ms)) {
+                chosen = r;
+            }
+        }
+    }
+
+    if (!chosen) {
+        pluto_set_tx_buffers(ctx, saved_chunk, saved_buffers);
+        return result < 0 ? result : -1;
+    }
+
+    *best = *chosen;
+    pluto_set_tx_buffers(ctx, best->chunk_size, best->kernel_buffers);
+    printf("✓ TX buffers: %u-sample chunks", best->chunk_size);
+    if (best->kernel_buffers) printf(" × %u kernel buffers", best->kernel_buffers);
+    printf(" (jitter %.3f ms, %.2f× real time)\n", best->jitter_ms,
+           best->throughput / ctx->sample_rate);
+    return 0;
+}
+
+// =============================================================================
+// CACHE FILE
+// =============================================================================
+
+int tx_tune_cache_path(char *path, size_t size) {
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    int n;
+    if (xdg && xdg[0]) {
+        n = snprintf(path, size, "%s/%s", xdg, TX_TUNE_CACHE_NAME);
+    } else if (home && home[0]) {
+        n = snprintf(path, size, "%s/.cache/%s", home, TX_TUNE_CACHE_NAME);
+    } else {
+        return -1;
+    }
+    return (n > 0 && (size_t)n < size) ? 0 : -1;
+}
+
+static int parse_line(const char *line, char *uri, size_t uri_size, tx_tune_result_t *r) {
+    char fmt[32];
+    snprintf(fmt, sizeof(fmt), "%%%zus %%u %%u %%lf %%lf %%lf", uri_size - 1);
+    memset(r, 0, sizeof(*r));
+    if (line[0] == '#' ||
+        sscanf(line, fmt, uri, &r->chunk_size, &r->kernel_buffers,
+               &r->throughput, &r->jitter_ms, &r->max_push_ms) != 6) {
+        return 0;
+    }
+    return r->chunk_size >= PLUTO_CHUNK_MIN && r->chunk_size <= PLUTO_CHUNK_MAX &&
+           r->kernel_buffers <= PLUTO_KERNEL_BUFFERS_MAX;
+}
+
+int tx_tune_cache_load(const char *path, const char *uri, tx_tune_result_t *result) {
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+
+    char line[CACHE_LINE_MAX];
+    char entry_uri[256];
+    tx_tune_result_t entry;
+    int found = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (parse_line(line, entry_uri, sizeof(entry_uri), &entry) &&
+            strcmp(entry_uri, uri) == 0) {
+            *result = entry;
+            found = 1;                      // Last entry wins
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+// mkdir -p of the directory part of path
+static int make_parents(const char *path) {
+    char dir[512];
+    snprintf(dir, sizeof(dir), "%s", path);
+    for (char *p = dir + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(dir, 0755) < 0 && errno != EEXIST) {
+            fprintf(stderr, "Cannot create %s: %s\n", dir, strerror(errno));
+            return -1;
+        }
+        *p = '/';
+    }
+    return 0;
+}
+
+int tx_tune_cache_store(const char *path, const char *uri, const tx_tune_result_t *result) {
+    if (strchr(uri, ' ') || strlen(uri) >= 256) {
+        fprintf(stderr, "URI cannot be cached: %s\n", uri);
+        return -1;
+    }
+
+    // Keep the other URIs (most recent last), drop the oldest beyond the limit
+    char (*keep)[CACHE_LINE_MAX] = calloc(TX_TUNE_CACHE_ENTRIES, CACHE_LINE_MAX);
+    if (!keep) {
+        fprintf(stderr, "Failed to allocate cache entries\n");
+        return -1;
+    }
+    uint32_t num_keep = 0;
+    FILE *f = fopen(path, "r");
+    if (f) {
+        char line[CACHE_LINE_MAX];
+        char entry_uri[256];
+        tx_tune_result_t entry;
+        while (fgets(line, sizeof(line), f)) {
+            if (!parse_line(line, entry_uri, sizeof(entry_uri), &entry) ||
+                strcmp(entry_uri, uri) == 0) {
+                continue;
+            }
+            if (num_keep == TX_TUNE_CACHE_ENTRIES - 1) {
+                memmove(keep[0], keep[1], (size_t)(num_keep - 1) * CACHE_LINE_MAX);
+                num_keep--;
+            }
+            snprintf(keep[num_keep++], CACHE_LINE_MAX, "%s", line);
+        }
+        fclose(f);
+    }
+
+    // Write a temporary file and rename: readers never see a partial cache
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    if (make_parents(path) < 0 || !(f = fopen(tmp, "w"))) {
+        fprintf(stderr, "Cannot write TX calibration cache %s\n", path);
+        free(keep);
+        return -1;
+    }
+    fprintf(f, "# sarsat_sgb TX calibration: uri chunk kernel_buffers samples/s "
+               "jitter_ms max_push_ms unix_time\n");
+    for (uint32_t i = 0; i < num_keep; i++) {
+        fputs(keep[i], f);
+    }
+    fprintf(f, "%s %u %u %.0f %.4f %.3f %lld\n", uri, result->chunk_size,
+            result->kernel_buffers, result->throughput, result->jitter_ms,
+            result->max_push_ms, (long long)time(NULL));
+    free(keep);
+
+    if (fclose(f) != 0 || rename(tmp, path) < 0) {
+        fprintf(stderr, "Cannot write TX calibration cache %s: %s\n", path, strerror(errno));
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+}
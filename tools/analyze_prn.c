@@ -0,0 +1,456 @@
+/**
+ * @file analyze_prn.c
+ * @brief Exhaustive PRN period and correlation-property analysis
+ *
+ * verify_prn checks the first 64 chips of each sequence; this tool checks
+ * the properties the despreader relies on, over the whole code:
+ * - Maximal length: x^(2^23-1) = 1 and x^((2^23-1)/q) != 1 mod the
+ *   feedback polynomial, then a walk of the full period (first return,
+ *   balance, run distribution, packed engine against the bit-serial LFSR)
+ * - Where the four Table 2.2 initial states sit in the m-sequence and
+ *   whether their 38400-chip frame segments overlap
+ * - Full-period autocorrelation (two-valued: -1 off-peak) for the first
+ *   shifts
+ * - Partial correlation of every 256-chip bit window against every chip
+ *   offset of the same frame (autocorrelation), the other channel (I/Q
+ *   cross-correlation) and the other PRN mode
+ *
+ * Correlations use the packed sequences (prn_generate_packed()) and the
+ * XOR/popcount despreader, so the whole run takes about a second.
+ *
+ * Usage: ./analyze_prn [-s shifts] [-l limit] [-v]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+#include "../include/despread.h"
+
+#define PERIOD_WORDS        (PRN_PERIOD / DESPREAD_WORD_CHIPS)          // Whole words in a period
+#define PERIOD_TAIL         (PRN_PERIOD % DESPREAD_WORD_CHIPS)          // 63 chips left over
+#define DEFAULT_SHIFTS      4096                                        // Full-period shifts checked
+#define HISTOGRAM_BINS      (PRN_CHIPS_PER_BIT / 16 + 1)                // |R| in steps of 16
+#define NUM_SEQUENCES       4
+
+typedef struct {
+    uint32_t shifts;        // Full-period autocorrelation shifts
+    int32_t limit;          // Fail if a partial correlation exceeds this (0 = report only)
+    int verbose;            // Per-bit maxima
+} options_t;
+
+typedef struct {
+    const char *name;
+    uint32_t init;
+    uint8_t mode;
+    uint8_t channel;
+} sequence_t;
+
+static const sequence_t sequences[NUM_SEQUENCES] = {
+    { "Normal I",    PRN_INIT_NORMAL_I, 0, 0 },
+    { "Normal Q",    PRN_INIT_NORMAL_Q, 0, 1 },
+    { "Self-test I", PRN_INIT_TEST_I,   1, 0 },
+    { "Self-test Q", PRN_INIT_TEST_Q,   1, 1 }
+};
+
+// Partial correlation statistics of one sequence pair
+typedef struct {
+    int32_t max;                        // Largest |R| off the main peak
+    uint32_t max_bit;                   // Bit window of the maximum
+    int32_t max_lag;                    // Chip lag of the maximum
+    int32_t bit_max[PRN_FRAME_BITS];    // Largest |R| per bit window
+    double sum_sq;                      // Σ R² (RMS)
+    uint64_t count;
+    uint64_t histogram[HISTOGRAM_BINS];
+} partial_stats_t;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline uint32_t chip_at(const uint64_t *words, uint64_t i) {
+    return (uint32_t)(words[i / DESPREAD_WORD_CHIPS] >> (i % DESPREAD_WORD_CHIPS)) & 1;
+}
+
+static inline uint64_t read_word(const uint64_t *words, uint64_t chip) {
+    uint64_t w = chip / DESPREAD_WORD_CHIPS;
+    uint32_t s = chip % DESPREAD_WORD_CHIPS;
+    return s ? (words[w] >> s) | (words[w + 1] << (DESPREAD_WORD_CHIPS - s)) : words[w];
+}
+
+// =============================================================================
+// MAXIMAL LENGTH
+// =============================================================================
+
+static int check_primitive(void) {
+    // The order of x divides 2^23-1; it is maximal if no proper divisor works
+    uint32_t n = PRN_PERIOD;
+    int ok = prn_jump(1, PRN_PERIOD) == 1;
+
+    printf("  2^23-1 = %u =", PRN_PERIOD);
+    for (uint32_t q = 2, rest = n; rest > 1; q++) {
+        if (rest % q) continue;
+        printf(" %u", q);
+        while (rest % q == 0) rest /= q;
+        if (prn_jump(1, n / q) == 1) {
+            ok = 0;
+        }
+    }
+    printf("\n");
+    printf("%s x^23 + x^18 + 1 %s (order of x = 2^23-1)\n",
+           ok ? "✓" : "⚠", ok ? "primitive" : "NOT primitive");
+    return ok ? 0 : -1;
+}
+
+static int walk_period(const uint64_t *packed, uint64_t phases[NUM_SEQUENCES]) {
+    // Bit-serial LFSR from Normal I over one period against the packed engine
+    uint32_t lfsr = PRN_INIT_NORMAL_I;
+    uint64_t first_return = 0;
+    uint64_t mismatches = 0;
+    uint64_t ones = 0;
+    uint64_t runs[2][PRN_LFSR_LENGTH + 1] = { { 0 } };
+    uint32_t run = 0;
+    uint32_t prev = chip_at(packed, PRN_PERIOD - 1);
+    uint64_t start = 0;
+    int failed = 0;
+
+    for (int k = 0; k < NUM_SEQUENCES; k++) {
+        phases[k] = UINT64_MAX;
+    }
+
+    // Runs are counted cyclically: start at the first change of value
+    while (chip_at(packed, start) == prev) {
+        prev = chip_at(packed, start++);
+    }
+
+    for (uint64_t n = 0; n < PRN_PERIOD; n++) {
+        for (int k = 0; k < NUM_SEQUENCES; k++) {
+            if (lfsr == sequences[k].init && phases[k] == UINT64_MAX) phases[k] = n;
+        }
+        if (n && lfsr == PRN_INIT_NORMAL_I && !first_return) {
+            first_return = n;
+        }
+
+        uint32_t chip = lfsr & 1;
+        mismatches += chip != chip_at(packed, n);
+        ones += chip;
+
+        uint32_t feedback = (lfsr ^ (lfsr >> 18)) & 1;
+        lfsr = ((lfsr >> 1) | (feedback << 22)) & 0x7FFFFF;
+    }
+    if (!first_return && lfsr == PRN_INIT_NORMAL_I) {
+        first_return = PRN_PERIOD;
+    }
+
+    for (uint64_t n = start; n < start + PRN_PERIOD; n++) {
+        uint32_t chip = chip_at(packed, n % PRN_PERIOD);
+        run++;
+        if (chip_at(packed, (n + 1) % PRN_PERIOD) != chip) {
+            runs[chip][run <= PRN_LFSR_LENGTH ? run : 0]++;
+            run = 0;
+        }
+    }
+
+    printf("%s Period: state returns after %llu chips\n",
+           first_return == PRN_PERIOD ? "✓" : "⚠", (unsigned long long)first_return);
+    failed |= first_return != PRN_PERIOD;
+
+    printf("%s Packed engine: %llu mismatches over the period\n",
+           mismatches ? "⚠" : "✓", (unsigned long long)mismatches);
+    failed |= mismatches != 0;
+
+    // m-sequence: 2^22 ones, 2^22 - 1 zeros
+    int balanced = ones == (PRN_PERIOD + 1) / 2;
+    printf("%s Balance: %llu ones, %llu zeros\n", balanced ? "✓" : "⚠",
+           (unsigned long long)ones, (unsigned long long)(PRN_PERIOD - ones));
+    failed |= !balanced;
+
+    // Runs of length k < 22: 2^(21-k) of each value; one run of 22 zeros, one of 23 ones
+    int runs_ok = runs[0][0] == 0 && runs[1][0] == 0;
+    for (int k = 1; k <= PRN_LFSR_LENGTH; k++) {
+        uint64_t zeros = k < PRN_LFSR_LENGTH - 1 ? 1ull << (PRN_LFSR_LENGTH - 2 - k) : k == PRN_LFSR_LENGTH - 1;
+        uint64_t ones_k = k < PRN_LFSR_LENGTH - 1 ? 1ull << (PRN_LFSR_LENGTH - 2 - k) : k == PRN_LFSR_LENGTH;
+        runs_ok &= runs[0][k] == zeros && runs[1][k] == ones_k;
+    }
+    printf("%s Runs: %llu/%llu of length 1, %llu/%llu of 2, longest %u zeros and %u ones\n",
+           runs_ok ? "✓" : "⚠",
+           (unsigned long long)runs[0][1], (unsigned long long)runs[1][1],
+           (unsigned long long)runs[0][2], (unsigned long long)runs[1][2],
+           PRN_LFSR_LENGTH - 1, PRN_LFSR_LENGTH);
+    failed |= !runs_ok;
+
+    return failed ? -1 : 0;
+}
+
+static int check_segments(const uint64_t phases[NUM_SEQUENCES]) {
+    // Each sequence uses chips [phase, phase + 38400) of the m-sequence
+    int failed = 0;
+
+    printf("\nFrame segments (phase from Normal I):\n");
+    for (int k = 0; k < NUM_SEQUENCES; k++) {
+        uint32_t jumped = prn_jump(PRN_INIT_NORMAL_I, phases[k]);
+        printf("  %-12s 0x%06X  phase %7llu%s\n", sequences[k].name, sequences[k].init,
+               (unsigned long long)phases[k], jumped == sequences[k].init ? "" : "  (jump mismatch)");
+        failed |= phases[k] == UINT64_MAX || jumped != sequences[k].init;
+    }
+
+    uint64_t min_gap = UINT64_MAX;
+    int a_min = 0, b_min = 0;
+    for (int a = 0; a < NUM_SEQUENCES; a++) {
+        for (int b = 0; b < NUM_SEQUENCES; b++) {
+            if (a == b) continue;
+            // Chips from the start of a to the start of b, going forward
+            uint64_t gap = (phases[b] + PRN_PERIOD - phases[a]) % PRN_PERIOD;
+            if (gap < min_gap) {
+                min_gap = gap;
+                a_min = a;
+                b_min = b;
+            }
+        }
+    }
+
+    int disjoint = min_gap >= PRN_FRAME_CHIPS;
+    printf("%s Segments %s: closest %s → %s, %llu chips apart (frame %u)\n",
+           disjoint ? "✓" : "⚠", disjoint ? "disjoint" : "OVERLAP",
+           sequences[a_min].name, sequences[b_min].name,
+           (unsigned long long)min_gap, PRN_FRAME_CHIPS);
+    return failed || !disjoint ? -1 : 0;
+}
+
+// =============================================================================
+// FULL-PERIOD AUTOCORRELATION
+// =============================================================================
+
+static int check_autocorrelation(const uint64_t *packed, uint32_t shifts) {
+    // R(τ) over one period; packed holds the period followed by its continuation
+    uint32_t bad = 0;
+    int32_t worst = -1;
+    uint32_t worst_shift = 0;
+
+    for (uint32_t t = 1; t <= shifts; t++) {
+        int32_t r = despread_xor_at(packed, t, packed, PERIOD_WORDS);
+        uint64_t tail = (read_word(packed, (uint64_t)t + PERIOD_WORDS * DESPREAD_WORD_CHIPS) ^
+                         packed[PERIOD_WORDS]) & ((1ull << PERIOD_TAIL) - 1);
+        r += PERIOD_TAIL - 2 * (int32_t)despread_popcount64(tail);
+        if (r != -1) {
+            bad++;
+            if (abs(r) > abs(worst)) {
+                worst = r;
+                worst_shift = t;
+            }
+        }
+    }
+
+    if (bad) {
+        printf("⚠ Full-period autocorrelation: %u of %u shifts != -1 (R(%u) = %d)\n",
+               bad, shifts, worst_shift, worst);
+        return -1;
+    }
+    printf("✓ Full-period autocorrelation: R(τ) = -1 for τ = 1..%u\n", shifts);
+    return 0;
+}
+
+// =============================================================================
+// PARTIAL CORRELATION (256-CHIP WINDOWS)
+// =============================================================================
+
+static void partial_correlation(const uint64_t *ref, const uint64_t *rx, int same,
+                                partial_stats_t *st) {
+    // Window b of ref (bit b) against every chip offset of rx within the frame
+    memset(st, 0, sizeof(partial_stats_t));
+
+    for (uint32_t b = 0; b < PRN_FRAME_BITS; b++) {
+        const uint64_t *window = ref + b * DESPREAD_BIT_WORDS;
+        uint32_t own = b * PRN_CHIPS_PER_BIT;
+
+        for (uint32_t o = 0; o <= PRN_FRAME_CHIPS - PRN_CHIPS_PER_BIT; o++) {
+            if (same && o == own) continue;
+            int32_t r = despread_xor_at(rx, o, window, DESPREAD_BIT_WORDS);
+            int32_t m = abs(r);
+
+            st->sum_sq += (double)r * r;
+            st->count++;
+            st->histogram[m / 16]++;
+            if (m > st->bit_max[b]) st->bit_max[b] = m;
+            if (m > st->max) {
+                st->max = m;
+                st->max_bit = b;
+                st->max_lag = (int32_t)o - (int32_t)own;
+            }
+        }
+    }
+}
+
+static void print_partial(const char *name, const partial_stats_t *st, int verbose) {
+    double rms = sqrt(st->sum_sq / (double)st->count);
+    uint64_t above = 0;
+    for (int k = 64 / 16; k < HISTOGRAM_BINS; k++) {
+        above += st->histogram[k];
+    }
+
+    printf("  %-26s max %3d (%6.1f dB) bit %3u lag %+6d  rms %5.2f  |R|>=64: %llu\n",
+           name, st->max, 20.0 * log10((double)st->max / PRN_CHIPS_PER_BIT),
+           st->max_bit, st->max_lag, rms, (unsigned long long)above);
+
+    if (verbose) {
+        for (uint32_t b = 0; b < PRN_FRAME_BITS; b++) {
+            printf("%s%3d", b % 25 ? " " : "    ", st->bit_max[b]);
+            if (b % 25 == 24) printf("\n");
+        }
+    }
+}
+
+static int check_partial(uint64_t frames[NUM_SEQUENCES][DESPREAD_FRAME_WORDS + 1],
+                         const options_t *opt) {
+    static const struct {
+        const char *name;
+        int ref;
+        int rx;
+    } pairs[] = {
+        { "Normal I auto",            0, 0 },
+        { "Normal Q auto",            1, 1 },
+        { "Self-test I auto",         2, 2 },
+        { "Self-test Q auto",         3, 3 },
+        { "Normal I/Q cross",         0, 1 },
+        { "Self-test I/Q cross",      2, 3 },
+        { "Normal/Self-test I cross", 0, 2 },
+        { "Normal/Self-test Q cross", 1, 3 }
+    };
+    partial_stats_t *st = malloc(sizeof(partial_stats_t));
+    int32_t worst = 0;
+
+    if (!st) {
+        fprintf(stderr, "Failed to allocate statistics\n");
+        return -1;
+    }
+
+    printf("\nPartial correlation, 256-chip bit windows × %u offsets (random code: rms 16):\n",
+           PRN_FRAME_CHIPS - PRN_CHIPS_PER_BIT + 1);
+    for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        partial_correlation(frames[pairs[p].ref], frames[pairs[p].rx],
+                            pairs[p].ref == pairs[p].rx, st);
+        print_partial(pairs[p].name, st, opt->verbose);
+        if (st->max > worst) worst = st->max;
+    }
+    free(st);
+
+    // Same-window I/Q correlation over the whole frame (what the demodulator sees)
+    for (int m = 0; m < 2; m++) {
+        int32_t r = despread_xor(frames[2 * m], frames[2 * m + 1], DESPREAD_FRAME_WORDS);
+        printf("  %-26s aligned frame R = %d (%.1f dB)\n",
+               m ? "Self-test I·Q" : "Normal I·Q", r,
+               20.0 * log10(fabs((double)r) / PRN_FRAME_CHIPS + 1e-12));
+    }
+
+    if (opt->limit > 0) {
+        int ok = worst <= opt->limit;
+        printf("%s Largest partial correlation %d (limit %d)\n", ok ? "✓" : "⚠", worst, opt->limit);
+        return ok ? 0 : -1;
+    }
+    return 0;
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options]\n\n", prog);
+    printf("Checks period and correlation properties of the T.018 PRN sequences\n\n");
+    printf("Options:\n");
+    printf("  -s <shifts>  Full-period autocorrelation shifts (default %u, max %u)\n",
+           DEFAULT_SHIFTS, PRN_PERIOD - 1);
+    printf("  -l <limit>   Fail if a partial correlation exceeds this (chips out of 256)\n");
+    printf("  -v           Print the largest partial correlation of every bit window\n");
+    printf("  -h           Show this help\n");
+}
+
+int main(int argc, char *argv[]) {
+    options_t opt = { .shifts = DEFAULT_SHIFTS };
+    int c;
+
+    while ((c = getopt(argc, argv, "s:l:vh")) != -1) {
+        switch (c) {
+            case 's':
+                opt.shifts = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'l':
+                opt.limit = (int32_t)strtol(optarg, NULL, 10);
+                break;
+            case 'v':
+                opt.verbose = 1;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (opt.shifts >= PRN_PERIOD) {
+        opt.shifts = PRN_PERIOD - 1;
+    }
+
+    printf("========================================\n");
+    printf("T.018 PRN Analysis (x^23 + x^18 + 1)\n");
+    printf("========================================\n\n");
+
+    // One period plus enough continuation for every shift (+1 word for funnel reads)
+    uint64_t total_chips = (uint64_t)PRN_PERIOD + opt.shifts + 2 * DESPREAD_WORD_CHIPS;
+    uint32_t total_words = (uint32_t)((total_chips + DESPREAD_WORD_CHIPS - 1) / DESPREAD_WORD_CHIPS);
+    uint64_t *packed = malloc((size_t)total_words * sizeof(uint64_t));
+    if (!packed) {
+        fprintf(stderr, "Failed to allocate %u words\n", total_words);
+        return 1;
+    }
+
+    int failed = 0;
+    double t0 = now_sec();
+    prn_generate_packed(PRN_INIT_NORMAL_I, packed, total_words);
+    double t_gen = now_sec() - t0;
+
+    failed |= check_primitive() < 0;
+
+    uint64_t phases[NUM_SEQUENCES];
+    t0 = now_sec();
+    failed |= walk_period(packed, phases) < 0;
+    double t_walk = now_sec() - t0;
+
+    failed |= check_segments(phases) < 0;
+
+    printf("\n");
+    t0 = now_sec();
+    failed |= check_autocorrelation(packed, opt.shifts) < 0;
+    double t_auto = now_sec() - t0;
+    free(packed);
+
+    // Frame sequences, one spare word for unaligned windows at the end
+    static uint64_t frames[NUM_SEQUENCES][DESPREAD_FRAME_WORDS + 1];
+    for (int k = 0; k < NUM_SEQUENCES; k++) {
+        prn_generate_packed(sequences[k].init, frames[k], DESPREAD_FRAME_WORDS);
+        if (memcmp(frames[k], despread_prn_words(sequences[k].mode, sequences[k].channel),
+                   DESPREAD_FRAME_WORDS * sizeof(uint64_t)) != 0) {
+            printf("⚠ %s: packed frame differs from the despreader table\n", sequences[k].name);
+            failed = 1;
+        }
+    }
+
+    t0 = now_sec();
+    failed |= check_partial(frames, &opt) < 0;
+    double t_partial = now_sec() - t0;
+
+    printf("\nTimings: packed period %.1f ms, walk %.1f ms, %u full-period shifts %.1f ms, "
+           "partial correlations %.1f ms\n",
+           t_gen * 1e3, t_walk * 1e3, opt.shifts, t_auto * 1e3, t_partial * 1e3);
+    printf("\n%s PRN analysis %s\n", failed ? "⚠" : "✓", failed ? "FAILED" : "passed");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file bench_pool.c
+ * @brief Task pool scaling benchmark on the real render path
+ *
+ * For 1..N threads, times on the shared task pool:
+ * - modulate: one T.018 frame (pulse shaping parallel over chip ranges)
+ * - verify:   range/power check of one burst (parallel reduction)
+ * - frames:   a batch of frames, one task per frame (nested parallel-for)
+ *
+ * Every thread count must produce the same samples as one thread.
+ *
+ * Usage: ./bench_pool [-j max_threads] [-r repeats] [-f frames] [-a]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <complex.h>
+#include "../include/oqpsk_modulator.h"
+#include "../include/task_pool.h"
+
+#define DATA_BITS           250         // Frame bits passed to the modulator
+
+typedef struct {
+    const uint8_t *bits;
+    float complex *iq;
+} frame_task_t;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// The modules report progress on stdout: silence it while timing
+static int quiet_begin(void) {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    }
+    return saved;
+}
+
+static void quiet_end(int saved) {
+    fflush(stdout);
+    if (saved >= 0) {
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+    }
+}
+
+static void frame_task(void *arg) {
+    frame_task_t *task = (frame_task_t *)arg;
+    oqpsk_modulate_frame(task->bits, task->iq);
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  -j <n>   Maximum threads (default: online CPUs, at least 4)\n");
+    printf("  -r <n>   Repeats per measurement, best kept (default: 3)\n");
+    printf("  -f <n>   Frames in the batch test (default: 8)\n");
+    printf("  -a       Pin workers to CPUs\n");
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char *argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t max_threads = cpus > 4 ? (uint32_t)cpus : 4;
+    uint32_t repeats = 3;
+    uint32_t num_frames = 8;
+    int pin = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "j:r:f:ah")) != -1) {
+        switch (opt) {
+            case 'j': max_threads = atoi(optarg); break;
+            case 'r': repeats = atoi(optarg); break;
+            case 'f': num_frames = atoi(optarg); break;
+            case 'a': pin = 1; break;
+            default:
+                print_usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (max_threads < 1 || max_threads > TASK_POOL_MAX_THREADS || repeats < 1 || num_frames < 1) {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    // Pseudo-random frames (LCG): identical on every run
+    uint8_t *bits = malloc((size_t)num_frames * DATA_BITS);
+    float complex *reference = malloc(OQPSK_TOTAL_SAMPLES * sizeof(float complex));
+    float complex *iq = malloc((size_t)num_frames * OQPSK_TOTAL_SAMPLES * sizeof(float complex));
+    frame_task_t *tasks = malloc(num_frames * sizeof(frame_task_t));
+    if (!bits || !reference || !iq || !tasks) {
+        fprintf(stderr, "Failed to allocate %u frames\n", num_frames);
+        return 1;
+    }
+    uint32_t lcg = 12345;
+    for (uint32_t i = 0; i < num_frames * DATA_BITS; i++) {
+        lcg = lcg * 1103515245u + 12345u;
+        bits[i] = (lcg >> 16) & 1;
+    }
+
+    printf("Task pool scaling: %ld online CPU(s), 1-%u threads, best of %u%s\n",
+           cpus, max_threads, repeats, pin ? ", pinned" : "");
+    printf("  %-7s %12s %8s %12s %8s %12s %8s  %s\n", "Threads", "modulate ms", "speedup",
+           "verify ms", "speedup", "frames/s", "speedup", "output");
+
+    double base_mod = 0.0, base_verify = 0.0, base_rate = 0.0;
+    int failed = 0;
+
+    for (uint32_t threads = 1; threads <= max_threads; threads++) {
+        task_pool_t pool;
+        if (task_pool_init(&pool, threads, pin) < 0) {
+            return 1;
+        }
+        task_pool_set_default(&pool);
+
+        double best_mod = 1e9, best_verify = 1e9, best_batch = 1e9;
+        int saved = quiet_begin();
+        for (uint32_t r = 0; r < repeats; r++) {
+            double t0 = now_sec();
+            oqpsk_modulate_frame(bits, iq);
+            double t1 = now_sec();
+            oqpsk_verify_output(iq, OQPSK_TOTAL_SAMPLES);
+            double t2 = now_sec();
+
+            task_group_t group;
+            task_group_init(&group);
+            for (uint32_t f = 0; f < num_frames; f++) {
+                tasks[f].bits = &bits[f * DATA_BITS];
+                tasks[f].iq = &iq[(size_t)f * OQPSK_TOTAL_SAMPLES];
+                task_pool_spawn(&pool, &group, frame_task, &tasks[f]);
+            }
+            task_pool_wait(&pool, &group);
+            double t3 = now_sec();
+
+            if (t1 - t0 < best_mod) best_mod = t1 - t0;
+            if (t2 - t1 < best_verify) best_verify = t2 - t1;
+            if (t3 - t2 < best_batch) best_batch = t3 - t2;
+        }
+        quiet_end(saved);
+
+        // Frame 0 of the batch is the same frame as the single modulation
+        const char *output = "reference";
+        if (threads == 1) {
+            memcpy(reference, iq, OQPSK_TOTAL_SAMPLES * sizeof(float complex));
+        } else if (memcmp(reference, iq, OQPSK_TOTAL_SAMPLES * sizeof(float complex)) == 0) {
+            output = "identical";
+        } else {
+            output = "DIFFERENT";
+            failed = 1;
+        }
+
+        double rate = num_frames / best_batch;
+        if (threads == 1) {
+            base_mod = best_mod;
+            base_verify = best_verify;
+            base_rate = rate;
+        }
+        printf("  %-7u %12.1f %7.2fx %12.1f %7.2fx %12.2f %7.2fx  %s\n", threads,
+               best_mod * 1e3, base_mod / best_mod, best_verify * 1e3, base_verify / best_verify,
+               rate, rate / base_rate, output);
+
+        if (threads == max_threads) {
+            task_pool_print_stats(&pool);
+        }
+        task_pool_set_default(NULL);
+        task_pool_destroy(&pool);
+    }
+
+    free(bits);
+    free(reference);
+    free(iq);
+    free(tasks);
+
+    if (failed) {
+        printf("⚠ Output depends on the thread count\n");
+        return 1;
+    }
+    printf("✓ Output identical for every thread count\n");
+    return 0;
+}
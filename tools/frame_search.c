@@ -0,0 +1,454 @@
+/**
+ * @file frame_search.c
+ * @brief T.018 frame search in packed demodulated bit logs
+ *
+ * Maps each log read-only and searches it with the bit-parallel sync
+ * matcher (src/bit_search.c): every bit alignment, both polarities, sync
+ * bit errors tolerated, BCH check and beacon ID decoding of the candidates
+ * on the task pool. One CSV line per frame, in stream order:
+ * bit offset, sync errors, polarity, layout, BCH status, number of equally
+ * likely alignments also reported, 23 HEX ID and the 63-hex-digit frame
+ * (readable by decode_frames, see -F).
+ *
+ * -B builds a synthetic log (random bits, frames behind 50-bit preambles
+ * with bit errors and random polarity) and checks that every frame is found
+ * at its offset, with the search throughput.
+ *
+ * Usage: ./frame_search [-p bits] [-e errors] [-N] [-L] [-c] [-a] [-F] [-q]
+ *                       [-j threads] [-B MiB] [file ...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/bit_search.h"
+#include "../include/task_pool.h"
+
+#define PREAMBLE_BITS           50                  // OQPSK_PREAMBLE_BITS
+#define BENCH_FRAME_SPACING     (64 * 1024)         // Mean bits between synthetic frames
+#define BENCH_SYNC_ERRORS       2                   // Preamble bit errors per synthetic frame
+#define BENCH_MESSAGE_ERRORS    3                   // Message bit errors (corrected with -c)
+#define BENCH_EDGE_BITS         8                   // Sync and message ends kept error-free
+#define OUTPUT_LINE             160
+
+typedef enum {
+    OUTPUT_CSV = 0,
+    OUTPUT_FRAMES,                                  // 63 hex digits per line
+    OUTPUT_NONE                                     // Statistics only
+} output_mode_t;
+
+typedef struct {
+    output_mode_t mode;
+} output_ctx_t;
+
+// Synthetic log contents for -B
+typedef struct {
+    uint64_t bit_offset;                            // First message bit
+    uint32_t serial;
+    uint8_t inverted;
+    uint8_t found;
+    bit_search_layout_t layout;
+} bench_frame_t;
+
+typedef struct {
+    bench_frame_t *frames;
+    uint32_t count;
+    uint32_t next;
+    uint32_t found;
+    uint32_t alternatives;                          // Other alignments reported with a frame
+    uint32_t wrong;
+} bench_ctx_t;
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static inline uint64_t rng_next(void) {
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// =============================================================================
+// OUTPUT
+// =============================================================================
+
+static char *put_hex(char *p, uint64_t v, int digits) {
+    static const char hex[] = "0123456789ABCDEF";
+    for (int d = digits - 1; d >= 0; d--) {
+        *p++ = hex[(v >> (4 * d)) & 0xF];
+    }
+    return p;
+}
+
+static char *put_frame(char *p, const uint8_t *frame) {
+    // 252 bits → 63 hex digits
+    for (int i = 0; i < 63; i++) {
+        uint8_t b = frame[i / 2];
+        p = put_hex(p, (i & 1) ? (b & 0xF) : (b >> 4), 1);
+    }
+    return p;
+}
+
+static void print_hit(void *ctx, const bit_search_hit_t *hit) {
+    output_ctx_t *out = (output_ctx_t *)ctx;
+    char line[OUTPUT_LINE];
+    char *p = line;
+
+    if (out->mode == OUTPUT_NONE) return;
+    if (out->mode == OUTPUT_FRAMES) {
+        if (hit->bch_errors < 0) return;
+        p = put_frame(p, hit->frame);
+        *p++ = '\n';
+        fwrite(line, 1, (size_t)(p - line), stdout);
+        return;
+    }
+
+    p += snprintf(p, 48, "%llu,%u,%c,%s,", (unsigned long long)hit->bit_offset,
+                  hit->sync_errors, hit->inverted ? '-' : '+',
+                  hit->layout == BIT_SEARCH_LAYOUT_HEADER ? "header" : "t018");
+    if (hit->bch_errors < 0) {
+        p += snprintf(p, 16, "fail,0,,");
+    } else {
+        p += hit->bch_errors ? snprintf(p, 16, "corrected:%d,", hit->bch_errors)
+                             : snprintf(p, 16, "ok,");
+        p += snprintf(p, 12, "%u,", hit->alternatives);
+        p = put_hex(p, hit->id.hi, 12);
+        p = put_hex(p, hit->id.lo, 11);
+        *p++ = ',';
+    }
+    p = put_frame(p, hit->frame);
+    *p++ = '\n';
+    fwrite(line, 1, (size_t)(p - line), stdout);
+}
+
+static void print_stats(const char *name, const bit_search_stats_t *st, double sec) {
+    fprintf(stderr, "%s %s: %llu frames (%llu corrected, %llu ambiguous), %llu sync matches, "
+            "%llu BCH failures, %llu duplicates\n",
+            st->frames ? "✓" : "⚠", name,
+            (unsigned long long)st->frames, (unsigned long long)st->corrected,
+            (unsigned long long)st->ambiguous,
+            (unsigned long long)st->candidates, (unsigned long long)st->failed,
+            (unsigned long long)st->duplicates);
+    if (sec > 0.0) {
+        fprintf(stderr, "  %.1f MB in %.3f s: %.1f MB/s, %.2f Gbit alignments/s\n",
+                st->bits / 8e6, sec, st->bits / 8e6 / sec, st->bits / sec / 1e9);
+    }
+}
+
+// =============================================================================
+// LOG FILES
+// =============================================================================
+
+static int search_file(const char *path, const bit_search_config_t *cfg, output_ctx_t *out,
+                       bit_search_stats_t *total) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        fprintf(stderr, "Failed to stat %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    bit_search_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    int ret = 0;
+    double t0 = now_seconds();
+
+    if (st.st_size > 0) {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "Failed to map %s: %s\n", path, strerror(errno));
+            close(fd);
+            return -1;
+        }
+        madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+        ret = bit_search_scan(cfg, map, (uint64_t)st.st_size, print_hit, out, &stats);
+        munmap(map, (size_t)st.st_size);
+    }
+    close(fd);
+
+    fflush(stdout);
+    print_stats(path, &stats, now_seconds() - t0);
+
+    total->bits += stats.bits;
+    total->candidates += stats.candidates;
+    total->frames += stats.frames;
+    total->ambiguous += stats.ambiguous;
+    total->corrected += stats.corrected;
+    total->failed += stats.failed;
+    total->duplicates += stats.duplicates;
+    return ret;
+}
+
+// =============================================================================
+// BENCHMARK (-B)
+// =============================================================================
+
+static inline void put_bit(uint8_t *log, uint64_t bit, uint8_t value) {
+    uint8_t mask = (uint8_t)(0x80 >> (bit & 7));
+    log[bit >> 3] = value ? (log[bit >> 3] | mask) : (log[bit >> 3] & (uint8_t)~mask);
+}
+
+static uint8_t reverse_byte(uint8_t b) {
+    b = (uint8_t)((b >> 4) | (b << 4));
+    b = (uint8_t)(((b & 0xCC) >> 2) | ((b & 0x33) << 2));
+    return (uint8_t)(((b & 0xAA) >> 1) | ((b & 0x55) << 1));
+}
+
+static void flip_bits(uint8_t *log, uint64_t first, uint32_t length, uint32_t count) {
+    for (uint32_t e = 0; e < count; e++) {
+        uint64_t bit = first + rng_next() % length;
+        log[bit >> 3] ^= (uint8_t)(0x80 >> (bit & 7));
+    }
+}
+
+static void bench_check(void *ctx, const bit_search_hit_t *hit) {
+    bench_ctx_t *b = (bench_ctx_t *)ctx;
+    if (hit->bch_errors < 0) return;
+
+    // Frames entirely before this hit (missed ones are reported below)
+    while (b->next < b->count &&
+           b->frames[b->next].bit_offset + BIT_SEARCH_WINDOW_BITS <= hit->bit_offset) {
+        b->next++;
+    }
+
+    t018_fields_t fields;
+    uint8_t padded[BIT_SEARCH_FRAME_BYTES + 8] = { 0 };
+    memcpy(padded, hit->frame, BIT_SEARCH_FRAME_BYTES);
+    t018_unpack_fields_packed(padded, T018_HEADER_BITS, &fields);
+
+    // A header-layout frame whose two following bits happen to match the
+    // last parity bits also checks in the T.018 layout, two bits later
+    bench_frame_t *f = (b->next < b->count) ? &b->frames[b->next] : NULL;
+    int aligned = f && (f->bit_offset == hit->bit_offset ||
+                        (f->layout == BIT_SEARCH_LAYOUT_HEADER &&
+                         hit->layout == BIT_SEARCH_LAYOUT_SPEC &&
+                         f->bit_offset + T018_HEADER_BITS == hit->bit_offset));
+    if (aligned && f->inverted == hit->inverted && fields.value[T018_FIELD_SERIAL] == f->serial) {
+        if (!f->found) b->found++;
+        f->found = 1;
+    } else if (hit->alternatives) {
+        b->alternatives++;
+    } else {
+        b->wrong++;
+    }
+}
+
+static int run_benchmark(uint32_t mib, const bit_search_config_t *cfg) {
+    if (cfg->pattern != 0 || cfg->length > PREAMBLE_BITS) {
+        fprintf(stderr, "Benchmark frames need the preamble sync (up to %d zeros)\n", PREAMBLE_BITS);
+        return -1;
+    }
+    uint32_t sync_errors = cfg->max_errors < BENCH_SYNC_ERRORS ? cfg->max_errors : BENCH_SYNC_ERRORS;
+    uint64_t bytes = (uint64_t)mib << 20;
+    uint64_t bits = bytes * 8;
+    uint8_t *log = malloc(bytes);
+    uint32_t max_frames = (uint32_t)(bits / (BENCH_FRAME_SPACING / 2)) + 1;   // Closest spacing
+    bench_frame_t *frames = calloc(max_frames, sizeof(bench_frame_t));
+    if (!log || !frames) {
+        fprintf(stderr, "Failed to allocate %u MiB benchmark log\n", mib);
+        free(log);
+        free(frames);
+        return -1;
+    }
+
+    printf("Building %u MiB synthetic log...\n", mib);
+    fflush(stdout);
+    for (uint64_t i = 0; i < bytes; i += 8) {
+        uint64_t r = rng_next();
+        memcpy(log + i, &r, 8);
+    }
+
+    // Frames alternate between both message layouts, random polarity (-N: normal)
+    uint32_t count = 0;
+    const uint32_t burst = PREAMBLE_BITS + T018_DATA_BITS;
+    uint64_t bit = rng_next() % BENCH_FRAME_SPACING;
+    while (bit + burst < bits) {
+        beacon_config_t bc = {
+            .type = BEACON_TYPE_EPIRB,
+            .country_code = 227,
+            .tac_number = 10001,
+            .serial_number = (uint32_t)(rng_next() % 16384),
+            .test_mode = 0,
+            .position = { .latitude = 43.2, .longitude = 5.4, .valid = 1 }
+        };
+        uint8_t frame_bits[T018_FRAME_BITS];
+        t018_build_frame(&bc, frame_bits);
+
+        bench_frame_t *f = &frames[count++];
+        f->bit_offset = bit + PREAMBLE_BITS;
+        f->serial = bc.serial_number;
+        f->inverted = cfg->inverted ? (uint8_t)(rng_next() & 1) : 0;
+        f->layout = (count & 1) ? BIT_SEARCH_LAYOUT_HEADER : BIT_SEARCH_LAYOUT_SPEC;
+        const uint8_t *message = (f->layout == BIT_SEARCH_LAYOUT_HEADER) ?
+                                 frame_bits : &frame_bits[T018_HEADER_BITS];
+
+        for (uint32_t i = 0; i < burst; i++) {
+            uint8_t value = (i < PREAMBLE_BITS) ? 0 : message[i - PREAMBLE_BITS];
+            put_bit(log, bit + i, value ^ f->inverted);
+        }
+        // Sync errors off the sync ends too: an error in the first (last) k
+        // bits is shifted out by the alignment k bits later (earlier), which
+        // then matches the sync better and is rightly reported instead
+        uint32_t edge = (cfg->length > 4 * BENCH_EDGE_BITS) ? BENCH_EDGE_BITS : 0;
+        flip_bits(log, bit + PREAMBLE_BITS - cfg->length + edge, cfg->length - 2 * edge, sync_errors);
+        if (cfg->correct) {
+            // Errors at the message ends can make a shifted alignment decode
+            // with fewer corrections than the true one
+            flip_bits(log, f->bit_offset + BENCH_EDGE_BITS, T018_DATA_BITS - 2 * BENCH_EDGE_BITS,
+                      BENCH_MESSAGE_ERRORS);
+        }
+
+        bit += burst + BENCH_FRAME_SPACING / 2 + rng_next() % BENCH_FRAME_SPACING;
+    }
+    if (cfg->lsb_first) {
+        // Same stream, first bit of each byte in bit 0
+        for (uint64_t i = 0; i < bytes; i++) log[i] = reverse_byte(log[i]);
+    }
+    printf("  %u frames, %u sync errors each%s\n", count, sync_errors,
+           cfg->correct ? ", 3 message errors each" : "");
+    fflush(stdout);
+
+    bench_ctx_t b = { .frames = frames, .count = count };
+    bit_search_stats_t stats;
+    double t0 = now_seconds();
+    int ret = bit_search_scan(cfg, log, bytes, bench_check, &b, &stats);
+    double sec = now_seconds() - t0;
+
+    print_stats("synthetic log", &stats, sec);
+    if (ret == 0 && (b.found != count || b.wrong)) {
+        fprintf(stderr, "✗ %u of %u frames found, %u unexpected\n", b.found, count, b.wrong);
+        ret = -1;
+    } else if (ret == 0) {
+        printf("✓ All %u frames found at their offset (%u equally likely alignments also reported)\n",
+               count, b.alternatives);
+        printf("  %.2f s per GiB\n", sec * 1024.0 / mib);
+    }
+
+    free(log);
+    free(frames);
+    return ret;
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options] file ...\n\n", prog);
+    printf("Searches packed demodulated bits (8 per byte) for T.018 frames\n\n");
+    printf("Options:\n");
+    printf("  -p <bits>   Sync pattern, '0'/'1' up to %d bits (default: %d preamble zeros)\n",
+           BIT_SEARCH_MAX_PATTERN, BIT_SEARCH_DEFAULT_SYNC);
+    printf("  -e <n>      Sync bit errors accepted (default: %d)\n", BIT_SEARCH_DEFAULT_ERRORS);
+    printf("  -N          Normal polarity only (default: complemented sync too)\n");
+    printf("  -L          First bit in bit 0 of each byte (default: bit 7)\n");
+    printf("  -c          Correct up to 6 bit errors when the parity check fails\n");
+    printf("              (slow, and about 1 random window in 400 then decodes)\n");
+    printf("  -a          Also report sync matches failing BCH\n");
+    printf("  -F          Write decoded frames only (63 hex digits, for decode_frames)\n");
+    printf("  -q          Statistics only\n");
+    printf("  -j <n>      Search threads (default: online CPUs)\n");
+    printf("  -B <MiB>    Benchmark on a synthetic log with embedded frames\n");
+    printf("  -h          Show this help\n\n");
+    printf("Output: bit_offset,sync_errors,polarity,layout,bch,alternatives,id,frame\n");
+    printf("        (bit_offset = first message bit, layout = t018 or header,\n");
+    printf("         alternatives = other equally likely alignments reported)\n");
+}
+
+int main(int argc, char *argv[]) {
+    bit_search_config_t cfg;
+    output_ctx_t out = { .mode = OUTPUT_CSV };
+    uint32_t bench_mib = 0;
+    uint32_t threads = 0;
+    int c;
+
+    bit_search_default_config(&cfg);
+
+    while ((c = getopt(argc, argv, "p:e:NLcaFqj:B:h")) != -1) {
+        switch (c) {
+            case 'p':
+                if (bit_search_parse_pattern(optarg, &cfg) < 0) {
+                    fprintf(stderr, "Invalid sync pattern: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'e':
+                cfg.max_errors = (uint32_t)atoi(optarg);
+                break;
+            case 'N':
+                cfg.inverted = 0;
+                break;
+            case 'L':
+                cfg.lsb_first = 1;
+                break;
+            case 'c':
+                cfg.correct = 1;
+                break;
+            case 'a':
+                cfg.keep_failed = 1;
+                break;
+            case 'F':
+                out.mode = OUTPUT_FRAMES;
+                break;
+            case 'q':
+                out.mode = OUTPUT_NONE;
+                break;
+            case 'j':
+                threads = (uint32_t)atoi(optarg);
+                break;
+            case 'B':
+                bench_mib = (uint32_t)atoi(optarg);
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    task_pool_configure_default(threads, 0);
+
+    if (bench_mib > 0) {
+        return run_benchmark(bench_mib, &cfg) < 0 ? 1 : 0;
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    bit_search_stats_t total;
+    memset(&total, 0, sizeof(total));
+    int ret = 0;
+    for (int i = optind; i < argc; i++) {
+        if (search_file(argv[i], &cfg, &out, &total) < 0) {
+            ret = -1;
+        }
+    }
+    if (argc - optind > 1) {
+        print_stats("total", &total, 0.0);
+    }
+
+    if (ret < 0) return 1;
+    return total.frames ? 0 : 2;
+}
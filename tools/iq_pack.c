@@ -0,0 +1,463 @@
+/**
+ * @file iq_pack.c
+ * @brief Compress, decompress and benchmark ci16 I/Q recordings (.sgiq)
+ *
+ * - pack:   SigMF ci16_le or raw ci16 → .sgiq, blocks compressed in parallel
+ *           (-c decodes every block again and compares)
+ * - unpack: .sgiq → SigMF ci16_le
+ * - bench:  decompression throughput, one reader then -j parallel decoders,
+ *           against the recording's own sample rate
+ *
+ * sarsat_rx replays .sgiq files directly (-i capture.sgiq).
+ *
+ * Usage: ./iq_pack pack|unpack|bench <input> [output] [options]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/iq_codec.h"
+
+#define MAX_THREADS         64
+#define BLOCKS_PER_THREAD   4           // Blocks per thread and batch (pack)
+
+typedef struct {
+    uint32_t sample_rate;
+    uint32_t block_samples;
+    int threads;
+    int check;
+} options_t;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int has_suffix(const char *s, const char *suffix) {
+    size_t ls = strlen(s), lx = strlen(suffix);
+    return ls >= lx && strcasecmp(s + ls - lx, suffix) == 0;
+}
+
+static void strip_sigmf(const char *path, char *base, size_t size) {
+    snprintf(base, size, "%s", path);
+    if (has_suffix(base, ".sigmf-meta") || has_suffix(base, ".sigmf-data")) {
+        base[strlen(base) - strlen(".sigmf-meta")] = '\0';
+    }
+}
+
+static FILE *open_input(const char *path, uint32_t *sample_rate) {
+    // SigMF ci16_le (rate from the metadata) or raw ci16
+    char base[512], meta_path[600], data_path[600];
+    strip_sigmf(path, base, sizeof(base));
+    snprintf(meta_path, sizeof(meta_path), "%s.sigmf-meta", base);
+    snprintf(data_path, sizeof(data_path), "%s.sigmf-data", base);
+
+    FILE *meta = fopen(meta_path, "r");
+    if (!meta) {
+        if (*sample_rate == 0) {
+            fprintf(stderr, "%s: raw ci16 input needs a sample rate (-r)\n", path);
+            return NULL;
+        }
+        FILE *f = fopen(path, "rb");
+        if (!f) fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return f;
+    }
+
+    char json[16384];
+    size_t len = fread(json, 1, sizeof(json) - 1, meta);
+    json[len] = '\0';
+    fclose(meta);
+
+    if (!strstr(json, "\"ci16_le\"")) {
+        fprintf(stderr, "%s: only ci16_le recordings compress losslessly\n", meta_path);
+        return NULL;
+    }
+    const char *rate = strstr(json, "\"core:sample_rate\"");
+    if (rate && *sample_rate == 0) {
+        rate = strchr(rate + strlen("\"core:sample_rate\""), ':');
+        *sample_rate = rate ? (uint32_t)strtod(rate + 1, NULL) : 0;
+    }
+    if (*sample_rate == 0) {
+        fprintf(stderr, "%s: missing core:sample_rate\n", meta_path);
+        return NULL;
+    }
+
+    FILE *f = fopen(data_path, "rb");
+    if (!f) fprintf(stderr, "Cannot open %s: %s\n", data_path, strerror(errno));
+    return f;
+}
+
+// =============================================================================
+// PACK
+// =============================================================================
+
+typedef struct {
+    const int16_t *iq;                  // Batch samples
+    uint32_t first_block;               // Blocks [first_block, end_block) of the batch
+    uint32_t end_block;
+    uint32_t block_samples;
+    const uint32_t *samples;            // Per block
+    uint8_t **payload;                  // Per block
+    uint32_t *bytes;                    // Per block
+    int check;
+    int failed;
+} pack_job_t;
+
+static void *pack_worker(void *arg) {
+    pack_job_t *job = (pack_job_t *)arg;
+    int16_t *check = job->check ? malloc((size_t)job->block_samples * 2 * sizeof(int16_t)) : NULL;
+
+    for (uint32_t b = job->first_block; b < job->end_block; b++) {
+        const int16_t *iq = &job->iq[(size_t)b * job->block_samples * 2];
+        job->bytes[b] = iq_block_encode(iq, job->samples[b], job->payload[b]);
+
+        if (job->check) {
+            if (!check || iq_block_decode(job->payload[b], job->bytes[b], job->samples[b], check) < 0 ||
+                memcmp(check, iq, (size_t)job->samples[b] * 2 * sizeof(int16_t)) != 0) {
+                job->failed = 1;
+            }
+        }
+    }
+    free(check);
+    return NULL;
+}
+
+static int pack(const char *in_path, const char *out_path, const options_t *opt) {
+    uint32_t sample_rate = opt->sample_rate;
+    FILE *in = open_input(in_path, &sample_rate);
+    if (!in) return -1;
+
+    iq_writer_t w;
+    if (iq_writer_open(&w, out_path, sample_rate, opt->block_samples) < 0) {
+        fclose(in);
+        return -1;
+    }
+
+    uint32_t bs = w.block_samples;
+    uint32_t batch_blocks = (uint32_t)opt->threads * BLOCKS_PER_THREAD;
+    int16_t *iq = malloc((size_t)batch_blocks * bs * 2 * sizeof(int16_t));
+    uint32_t *samples = calloc(batch_blocks, sizeof(uint32_t));
+    uint32_t *bytes = calloc(batch_blocks, sizeof(uint32_t));
+    uint8_t **payload = calloc(batch_blocks, sizeof(uint8_t *));
+    int ret = (iq && samples && bytes && payload) ? 0 : -1;
+    for (uint32_t b = 0; ret == 0 && b < batch_blocks; b++) {
+        payload[b] = malloc(IQ_CODEC_MAX_PAYLOAD(bs));
+        if (!payload[b]) ret = -1;
+    }
+    if (ret < 0) fprintf(stderr, "Failed to allocate compression buffers\n");
+
+    double t0 = now_sec();
+    while (ret == 0) {
+        size_t got = fread(iq, 2 * sizeof(int16_t), (size_t)batch_blocks * bs, in);
+        if (got == 0) break;
+
+        uint32_t blocks = (uint32_t)((got + bs - 1) / bs);
+        for (uint32_t b = 0; b < blocks; b++) {
+            samples[b] = (uint32_t)(got - (size_t)b * bs < bs ? got - (size_t)b * bs : bs);
+        }
+
+        // Contiguous block ranges per thread
+        pthread_t threads[MAX_THREADS];
+        pack_job_t jobs[MAX_THREADS];
+        int nthreads = 0;
+        for (uint32_t b = 0; b < blocks; b += BLOCKS_PER_THREAD) {
+            jobs[nthreads] = (pack_job_t) {
+                .iq = iq, .first_block = b,
+                .end_block = b + BLOCKS_PER_THREAD < blocks ? b + BLOCKS_PER_THREAD : blocks,
+                .block_samples = bs, .samples = samples, .payload = payload,
+                .bytes = bytes, .check = opt->check
+            };
+            pthread_create(&threads[nthreads], NULL, pack_worker, &jobs[nthreads]);
+            nthreads++;
+        }
+        for (int t = 0; t < nthreads; t++) {
+            pthread_join(threads[t], NULL);
+            if (jobs[t].failed) {
+                fprintf(stderr, "Round-trip check failed near sample %llu\n",
+                        (unsigned long long)(w.total_samples + (uint64_t)jobs[t].first_block * bs));
+                ret = -1;
+            }
+        }
+
+        for (uint32_t b = 0; ret == 0 && b < blocks; b++) {
+            ret = iq_writer_add_block(&w, payload[b], bytes[b], samples[b]);
+        }
+        if (got < (size_t)batch_blocks * bs) break;
+    }
+    double elapsed = now_sec() - t0;
+
+    if (ret == 0 && ferror(in)) {
+        fprintf(stderr, "Read error: %s\n", strerror(errno));
+        ret = -1;
+    }
+    uint64_t total = w.total_samples;
+    uint32_t block_count = w.block_count;
+    if (iq_writer_close(&w) < 0) ret = -1;
+
+    if (ret == 0) {
+        uint64_t raw = total * 4;
+        uint64_t packed = w.bytes_written;
+        printf("✓ %s: %llu samples at %u Hz, %u blocks\n", out_path,
+               (unsigned long long)total, sample_rate, block_count);
+        printf("  %.1f MB → %.1f MB (%.2f:1, %.2f bits/sample) in %.2f s, %.1f Msamples/s on %d thread%s%s\n",
+               raw / 1e6, packed / 1e6, packed ? (double)raw / packed : 0.0,
+               total ? packed * 8.0 / total : 0.0, elapsed, total / elapsed / 1e6,
+               opt->threads, opt->threads == 1 ? "" : "s", opt->check ? ", round trip checked" : "");
+    }
+
+    for (uint32_t b = 0; payload && b < batch_blocks; b++) free(payload[b]);
+    free(payload);
+    free(bytes);
+    free(samples);
+    free(iq);
+    fclose(in);
+    return ret;
+}
+
+// =============================================================================
+// UNPACK
+// =============================================================================
+
+static int unpack(const char *in_path, const char *out_path) {
+    iq_reader_t r;
+    if (iq_reader_open(&r, in_path) < 0) return -1;
+
+    char base[512], path[600];
+    strip_sigmf(out_path, base, sizeof(base));
+
+    snprintf(path, sizeof(path), "%s.sigmf-data", base);
+    FILE *data = fopen(path, "wb");
+    int16_t *iq = malloc((size_t)r.block_samples * 2 * sizeof(int16_t));
+    if (!data || !iq) {
+        fprintf(stderr, "Cannot create %s: %s\n", path, strerror(errno));
+        if (data) fclose(data);
+        free(iq);
+        iq_reader_close(&r);
+        return -1;
+    }
+
+    int ret = 0, n;
+    uint64_t total = 0;
+    while ((n = iq_reader_read(&r, iq, r.block_samples)) > 0) {
+        if (fwrite(iq, 2 * sizeof(int16_t), (size_t)n, data) != (size_t)n) {
+            fprintf(stderr, "Write error: %s\n", strerror(errno));
+            ret = -1;
+            break;
+        }
+        total += (uint64_t)n;
+    }
+    if (n < 0) ret = -1;
+    if (fclose(data) != 0) ret = -1;
+    free(iq);
+
+    snprintf(path, sizeof(path), "%s.sigmf-meta", base);
+    FILE *meta = ret == 0 ? fopen(path, "w") : NULL;
+    if (meta) {
+        fprintf(meta, "{\n");
+        fprintf(meta, "    \"global\": {\n");
+        fprintf(meta, "        \"core:datatype\": \"ci16_le\",\n");
+        fprintf(meta, "        \"core:sample_rate\": %u,\n", r.sample_rate);
+        fprintf(meta, "        \"core:version\": \"1.0.0\",\n");
+        fprintf(meta, "        \"core:description\": \"Decompressed from %s\"\n", in_path);
+        fprintf(meta, "    },\n");
+        fprintf(meta, "    \"captures\": [\n");
+        fprintf(meta, "        { \"core:sample_start\": 0 }\n");
+        fprintf(meta, "    ],\n");
+        fprintf(meta, "    \"annotations\": []\n");
+        fprintf(meta, "}\n");
+        fclose(meta);
+        printf("✓ %s.sigmf-data: %llu samples at %u Hz\n", base, (unsigned long long)total,
+               r.sample_rate);
+    } else if (ret == 0) {
+        fprintf(stderr, "Cannot create %s: %s\n", path, strerror(errno));
+        ret = -1;
+    }
+
+    iq_reader_close(&r);
+    return ret;
+}
+
+// =============================================================================
+// BENCH
+// =============================================================================
+
+typedef struct {
+    const char *path;
+    int thread;
+    int threads;
+    uint64_t samples;
+    int failed;
+} bench_job_t;
+
+static void *bench_worker(void *arg) {
+    // Own reader per thread: blocks thread, thread + threads, ...
+    bench_job_t *job = (bench_job_t *)arg;
+    iq_reader_t r;
+    if (iq_reader_open(&r, job->path) < 0) {
+        job->failed = 1;
+        return NULL;
+    }
+    uint8_t *payload = malloc(IQ_CODEC_MAX_PAYLOAD(r.block_samples));
+    int16_t *iq = malloc((size_t)r.block_samples * 2 * sizeof(int16_t));
+
+    for (uint32_t b = (uint32_t)job->thread; payload && iq && b < r.block_count; b += (uint32_t)job->threads) {
+        uint32_t bytes, samples;
+        if (iq_reader_get_block(&r, b, payload, &bytes, &samples) < 0 ||
+            iq_block_decode(payload, bytes, samples, iq) < 0) {
+            job->failed = 1;
+            break;
+        }
+        job->samples += samples;
+    }
+    if (!payload || !iq) job->failed = 1;
+
+    free(iq);
+    free(payload);
+    iq_reader_close(&r);
+    return NULL;
+}
+
+static int bench(const char *path, const options_t *opt) {
+    iq_reader_t r;
+    if (iq_reader_open(&r, path) < 0) return -1;
+
+    printf("%s: %llu samples at %u Hz, %u blocks of %u, %.2f:1\n", path,
+           (unsigned long long)r.total_samples, r.sample_rate, r.block_count, r.block_samples,
+           r.compressed_bytes ? (double)r.total_samples * 4 / r.compressed_bytes : 0.0);
+
+    // Sequential reader, as used for replay
+    int16_t *iq = malloc((size_t)r.block_samples * 2 * sizeof(int16_t));
+    if (!iq) {
+        iq_reader_close(&r);
+        return -1;
+    }
+    double t0 = now_sec();
+    uint64_t total = 0;
+    int n;
+    while ((n = iq_reader_read(&r, iq, r.block_samples)) > 0) total += (uint64_t)n;
+    double elapsed = now_sec() - t0;
+    free(iq);
+    double rate = r.sample_rate;
+    iq_reader_close(&r);
+    if (n < 0) return -1;
+
+    printf("  1 reader:    %8.1f Msamples/s (%.0f× real time)\n",
+           total / elapsed / 1e6, rate > 0 ? total / elapsed / rate : 0.0);
+
+    if (opt->threads > 1) {
+        pthread_t threads[MAX_THREADS];
+        bench_job_t jobs[MAX_THREADS];
+        t0 = now_sec();
+        for (int t = 0; t < opt->threads; t++) {
+            jobs[t] = (bench_job_t) { .path = path, .thread = t, .threads = opt->threads };
+            pthread_create(&threads[t], NULL, bench_worker, &jobs[t]);
+        }
+        uint64_t decoded = 0;
+        int failed = 0;
+        for (int t = 0; t < opt->threads; t++) {
+            pthread_join(threads[t], NULL);
+            decoded += jobs[t].samples;
+            failed |= jobs[t].failed;
+        }
+        elapsed = now_sec() - t0;
+        if (failed) {
+            fprintf(stderr, "Parallel decode failed\n");
+            return -1;
+        }
+        printf("  %2d threads:  %8.1f Msamples/s (%.0f× real time)\n", opt->threads,
+               decoded / elapsed / 1e6, rate > 0 ? decoded / elapsed / rate : 0.0);
+    }
+    return 0;
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void usage(const char *prog) {
+    printf("Usage: %s pack <input> <output.sgiq> [-r rate] [-b block] [-j threads] [-c]\n", prog);
+    printf("       %s unpack <input.sgiq> <output base>\n", prog);
+    printf("       %s bench <input.sgiq> [-j threads]\n\n", prog);
+    printf("  <input>       SigMF ci16_le (.sigmf-meta/.sigmf-data/base) or raw ci16\n");
+    printf("  -r <rate>     Sample rate of raw input (Hz)\n");
+    printf("  -b <samples>  Samples per block (default %d)\n", IQ_CODEC_DEFAULT_BLOCK);
+    printf("  -j <threads>  Parallel encoders/decoders (default: online CPUs, max %d)\n", MAX_THREADS);
+    printf("  -c            Decode every block again and compare\n");
+}
+
+int main(int argc, char *argv[]) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    options_t opt = {
+        .threads = cpus > 0 ? (int)(cpus < MAX_THREADS ? cpus : MAX_THREADS) : 1
+    };
+
+    if (argc < 3) {
+        usage(argv[0]);
+        return 1;
+    }
+    const char *command = argv[1];
+    const char *in = argv[2];
+    const char *out = NULL;
+
+    // Options follow the command and its operands
+    optind = 3;
+    if (strcmp(command, "pack") == 0 || strcmp(command, "unpack") == 0) {
+        if (argc < 4) {
+            usage(argv[0]);
+            return 1;
+        }
+        out = argv[3];
+        optind = 4;
+    }
+
+    int c;
+    while ((c = getopt(argc, argv, "r:b:j:ch")) != -1) {
+        switch (c) {
+            case 'r':
+                opt.sample_rate = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'b':
+                opt.block_samples = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                opt.threads = atoi(optarg);
+                if (opt.threads < 1 || opt.threads > MAX_THREADS) {
+                    fprintf(stderr, "Threads must be 1-%d\n", MAX_THREADS);
+                    return 1;
+                }
+                break;
+            case 'c':
+                opt.check = 1;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    int ret;
+    if (strcmp(command, "pack") == 0) {
+        ret = pack(in, out, &opt);
+    } else if (strcmp(command, "unpack") == 0) {
+        ret = unpack(in, out);
+    } else if (strcmp(command, "bench") == 0) {
+        ret = bench(in, &opt);
+    } else {
+        usage(argv[0]);
+        return 1;
+    }
+    return ret < 0 ? 1 : 0;
+}
@@ -0,0 +1,436 @@
+/**
+ * @file net_iq_rx.c
+ * @brief Receive network I/Q streams (tcp:/udp: TX backends) and check them
+ *
+ * Listens for a sarsat_sgb network sink, follows sequence numbers, sample
+ * indices and burst markers, and reports loss, reordering and throughput:
+ * - TCP: accepts one connection, reads until the sender closes
+ * - UDP: recvmmsg() batches, ends after -n bursts or 2 s without packets
+ * - -o saves the samples (.sgiq compressed, otherwise raw ci16)
+ * - -b runs a loopback benchmark: a sender thread streams synthetic 1 s
+ *   bursts through the same sink code as fast as the -x pace allows
+ *
+ * Usage: ./net_iq_rx [-u] [-p port] [-n bursts] [-o file] [-b bursts] [-x pace]
+ */
+
+#define _GNU_SOURCE                 // recvmmsg()
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "../include/net_sink.h"
+#include "../include/iq_codec.h"
+
+#define BENCH_SAMPLES       2457600     // Synthetic burst (1 s at 2.4576 MHz)
+#define BENCH_RATE          2457600
+#define UDP_SLOT            (NET_SINK_HEADER_SIZE + NET_SINK_UDP_SAMPLES * 4)
+#define UDP_IDLE_MS         2000        // End of a UDP stream
+#define MAX_PACKET          (NET_SINK_HEADER_SIZE + NET_SINK_MAX_SAMPLES * 4)
+
+typedef struct {
+    int udp;
+    uint16_t port;
+    uint32_t max_bursts;                // 0 = until the stream ends
+    const char *output;
+    uint32_t bench_bursts;              // Loopback benchmark
+    double pace;                        // Benchmark sender pace (× real time, 0 = unpaced)
+    int pace_set;
+    int verbose;
+} options_t;
+
+// Stream state and statistics
+typedef struct {
+    uint64_t packets;
+    uint64_t samples;
+    uint64_t bytes;
+    uint64_t lost_packets;              // Sequence gaps
+    uint64_t reordered;
+    uint64_t bad_packets;
+    uint32_t bursts_started;
+    uint32_t bursts_completed;
+    uint32_t sample_rate;
+    uint32_t next_seq;
+    uint64_t burst_samples;             // Current burst so far
+    int have_seq;
+    double first_time;
+    double last_time;
+
+    iq_writer_t sgiq;
+    FILE *raw;
+    int writer_open;
+} stream_t;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// =============================================================================
+// PACKET HANDLING
+// =============================================================================
+
+static int save_samples(stream_t *st, const options_t *opt, const int16_t *iq, uint32_t n) {
+    if (!opt->output) return 0;
+    if (!st->writer_open) {
+        size_t len = strlen(opt->output);
+        if (len > 5 && strcmp(opt->output + len - 5, ".sgiq") == 0) {
+            if (iq_writer_open(&st->sgiq, opt->output, st->sample_rate, 0) < 0) return -1;
+        } else {
+            st->raw = fopen(opt->output, "wb");
+            if (!st->raw) {
+                fprintf(stderr, "Cannot create %s: %s\n", opt->output, strerror(errno));
+                return -1;
+            }
+        }
+        st->writer_open = 1;
+    }
+    if (st->raw) {
+        return fwrite(iq, 4, n, st->raw) == n ? 0 : -1;
+    }
+    return iq_writer_write(&st->sgiq, iq, n);
+}
+
+static int handle_packet(stream_t *st, const options_t *opt, const uint8_t *pkt, size_t len) {
+    net_packet_header_t h;
+    if (len < NET_SINK_HEADER_SIZE || net_header_decode(pkt, &h) < 0 ||
+        len != NET_SINK_HEADER_SIZE + (size_t)h.samples * 4) {
+        st->bad_packets++;
+        return 0;
+    }
+
+    double t = now_sec();
+    if (st->packets == 0) st->first_time = t;
+    st->last_time = t;
+    st->packets++;
+    st->samples += h.samples;
+    st->bytes += len;
+    st->sample_rate = h.sample_rate;
+
+    // Sequence: gaps are lost packets, older numbers arrived late
+    if (st->have_seq && h.seq != st->next_seq) {
+        if ((int32_t)(h.seq - st->next_seq) > 0) {
+            st->lost_packets += h.seq - st->next_seq;
+        } else {
+            st->reordered++;
+        }
+    }
+    if (!st->have_seq || (int32_t)(h.seq - st->next_seq) >= 0) {
+        st->next_seq = h.seq + 1;
+    }
+    st->have_seq = 1;
+
+    if (h.flags & NET_FLAG_BURST_START) {
+        st->bursts_started++;
+        st->burst_samples = 0;
+        if (opt->verbose) {
+            printf("  burst %u start: sample %llu\n", h.burst, (unsigned long long)h.sample_index);
+        }
+    }
+    st->burst_samples += h.samples;
+    if (h.flags & NET_FLAG_BURST_END) {
+        st->bursts_completed++;
+        printf("  burst %u: %llu samples (%.3f s at %u Hz)\n", h.burst,
+               (unsigned long long)st->burst_samples,
+               h.sample_rate ? (double)st->burst_samples / h.sample_rate : 0.0, h.sample_rate);
+    }
+
+    return save_samples(st, opt, (const int16_t *)(pkt + NET_SINK_HEADER_SIZE), h.samples);
+}
+
+static int done(const stream_t *st, const options_t *opt) {
+    return opt->max_bursts && st->bursts_completed >= opt->max_bursts;
+}
+
+// =============================================================================
+// TRANSPORTS
+// =============================================================================
+
+static int recv_all(int fd, uint8_t *buf, size_t len) {
+    // 1 = complete, 0 = peer closed, -1 = error
+    size_t got = 0;
+    while (got < len) {
+        ssize_t n = recv(fd, buf + got, len - got, MSG_WAITALL);
+        if (n == 0) return 0;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Receive failed: %s\n", strerror(errno));
+            return -1;
+        }
+        got += (size_t)n;
+    }
+    return 1;
+}
+
+static int receive_tcp(int listen_fd, stream_t *st, const options_t *opt) {
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+        fprintf(stderr, "Accept failed: %s\n", strerror(errno));
+        return -1;
+    }
+    printf("✓ Sender connected\n");
+
+    uint8_t *pkt = malloc(MAX_PACKET);
+    int ret = pkt ? 0 : -1;
+    while (ret == 0 && !done(st, opt)) {
+        int r = recv_all(fd, pkt, NET_SINK_HEADER_SIZE);
+        if (r <= 0) {
+            ret = r;
+            break;
+        }
+        net_packet_header_t h;
+        if (net_header_decode(pkt, &h) < 0) {
+            fprintf(stderr, "Stream out of sync (bad header after %llu packets)\n",
+                    (unsigned long long)st->packets);
+            ret = -1;
+            break;
+        }
+        r = recv_all(fd, pkt + NET_SINK_HEADER_SIZE, (size_t)h.samples * 4);
+        if (r <= 0) {
+            ret = r;
+            break;
+        }
+        ret = handle_packet(st, opt, pkt, NET_SINK_HEADER_SIZE + (size_t)h.samples * 4);
+    }
+    free(pkt);
+    close(fd);
+    return ret;
+}
+
+static int receive_udp(int fd, stream_t *st, const options_t *opt) {
+    uint8_t *slots = malloc((size_t)NET_SINK_BATCH * UDP_SLOT);
+    if (!slots) return -1;
+    struct mmsghdr msgs[NET_SINK_BATCH];
+    struct iovec iov[NET_SINK_BATCH];
+
+    int ret = 0;
+    while (!done(st, opt)) {
+        for (int i = 0; i < NET_SINK_BATCH; i++) {
+            iov[i] = (struct iovec) { &slots[(size_t)i * UDP_SLOT], UDP_SLOT };
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // Idle timeout only once the stream has started
+        struct timeval tv = { UDP_IDLE_MS / 1000, (UDP_IDLE_MS % 1000) * 1000 };
+        if (st->packets == 0) tv = (struct timeval) { 0, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        int n = recvmmsg(fd, msgs, NET_SINK_BATCH, MSG_WAITFORONE, NULL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            fprintf(stderr, "Receive failed: %s\n", strerror(errno));
+            ret = -1;
+            break;
+        }
+        for (int i = 0; ret == 0 && i < n; i++) {
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+                st->bad_packets++;
+                continue;
+            }
+            ret = handle_packet(st, opt, iov[i].iov_base, msgs[i].msg_len);
+        }
+        if (ret < 0) break;
+    }
+    free(slots);
+    return ret;
+}
+
+// =============================================================================
+// LOOPBACK BENCHMARK SENDER
+// =============================================================================
+
+typedef struct {
+    const options_t *opt;
+    int failed;
+} sender_t;
+
+static void *bench_sender(void *arg) {
+    sender_t *snd = (sender_t *)arg;
+    const options_t *opt = snd->opt;
+
+    // Noise at the 12-bit DAC scale (compressible like real captures)
+    int16_t *iq = malloc((size_t)BENCH_SAMPLES * 2 * sizeof(int16_t));
+    if (!iq) {
+        snd->failed = 1;
+        return NULL;
+    }
+    uint32_t x = 1;
+    for (uint32_t i = 0; i < 2 * BENCH_SAMPLES; i++) {
+        x = x * 1664525u + 1013904223u;
+        iq[i] = (int16_t)((x >> 20) % 1024) - 512;
+    }
+
+    char uri[64];
+    snprintf(uri, sizeof(uri), "%s:127.0.0.1:%u", opt->udp ? "udp" : "tcp", opt->port);
+    net_sink_t sink;
+    if (net_sink_open(&sink, uri, BENCH_RATE) < 0) {
+        free(iq);
+        snd->failed = 1;
+        return NULL;
+    }
+    if (opt->pace_set) sink.pace = opt->pace;
+
+    for (uint32_t b = 0; b < opt->bench_bursts; b++) {
+        if (net_sink_send_burst(&sink, iq, BENCH_SAMPLES) < 0) {
+            snd->failed = 1;
+            break;
+        }
+    }
+    if (sink.packets_dropped) {
+        printf("⚠ Sender: %llu datagrams dropped\n", (unsigned long long)sink.packets_dropped);
+    }
+    net_sink_close(&sink);
+    free(iq);
+    return NULL;
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options]\n\n", prog);
+    printf("  -u            UDP (default: TCP)\n");
+    printf("  -p <port>     Listen port (default %d)\n", NET_SINK_DEFAULT_PORT);
+    printf("  -n <bursts>   Stop after n complete bursts (default: end of stream)\n");
+    printf("  -o <file>     Save samples (.sgiq compressed, otherwise raw ci16)\n");
+    printf("  -b <bursts>   Loopback benchmark: send n synthetic 1 s bursts to this receiver\n");
+    printf("  -x <pace>     Benchmark send rate in × real time (0 = unpaced; UDP default %.0f)\n",
+           NET_SINK_UDP_PACE);
+    printf("  -v            Print burst starts\n");
+    printf("\nSender: sarsat_sgb -u tcp:<host>:<port> (or -d udp:<host>:<port>@serials)\n");
+}
+
+// Burst count: decimal, nonzero
+static int parse_count(const char *arg, uint32_t *count) {
+    char *end;
+    unsigned long value = strtoul(arg, &end, 10);
+    if (end == arg || *end != '\0' || value == 0 || value > UINT32_MAX) {
+        fprintf(stderr, "Invalid burst count '%s'\n", arg);
+        return -1;
+    }
+    *count = (uint32_t)value;
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    options_t opt = { .port = NET_SINK_DEFAULT_PORT };
+
+    int c;
+    while ((c = getopt(argc, argv, "up:n:o:b:x:vh")) != -1) {
+        switch (c) {
+            case 'u':
+                opt.udp = 1;
+                break;
+            case 'p':
+                opt.port = (uint16_t)atoi(optarg);
+                break;
+            case 'n':
+                if (parse_count(optarg, &opt.max_bursts) < 0) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'o':
+                opt.output = optarg;
+                break;
+            case 'b':
+                if (parse_count(optarg, &opt.bench_bursts) < 0) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'x':
+                opt.pace = strtod(optarg, NULL);
+                opt.pace_set = 1;
+                break;
+            case 'v':
+                opt.verbose = 1;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (opt.bench_bursts && !opt.max_bursts) {
+        opt.max_bursts = opt.bench_bursts;
+    }
+
+    int fd = socket(AF_INET6, (opt.udp ? SOCK_DGRAM : SOCK_STREAM) | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        fprintf(stderr, "Socket creation failed: %s\n", strerror(errno));
+        return 1;
+    }
+    int one = 1, zero = 0, rcvbuf = 8 * 1024 * 1024;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &zero, sizeof(zero));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    struct sockaddr_in6 addr = { .sin6_family = AF_INET6, .sin6_port = htons(opt.port),
+                                 .sin6_addr = in6addr_any };
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        (!opt.udp && listen(fd, 1) < 0)) {
+        fprintf(stderr, "Port %u: %s\n", opt.port, strerror(errno));
+        close(fd);
+        return 1;
+    }
+    printf("✓ Listening on %s port %u\n", opt.udp ? "UDP" : "TCP", opt.port);
+
+    pthread_t sender_thread;
+    sender_t sender = { .opt = &opt };
+    if (opt.bench_bursts) {
+        pthread_create(&sender_thread, NULL, bench_sender, &sender);
+    }
+
+    stream_t st;
+    memset(&st, 0, sizeof(st));
+    int ret = opt.udp ? receive_udp(fd, &st, &opt) : receive_tcp(fd, &st, &opt);
+    close(fd);
+
+    if (opt.bench_bursts) {
+        pthread_join(sender_thread, NULL);
+        if (sender.failed) ret = -1;
+    }
+    if (st.writer_open) {
+        if (st.raw) {
+            if (fclose(st.raw) != 0) ret = -1;
+        } else if (iq_writer_close(&st.sgiq) < 0) {
+            ret = -1;
+        }
+    }
+
+    // Summary
+    double elapsed = st.last_time - st.first_time;
+    double expected = (double)(st.packets + st.lost_packets);
+    printf("\nStream statistics:\n");
+    printf("  Packets: %llu  Lost: %llu (%.3f%%)  Reordered: %llu  Invalid: %llu\n",
+           (unsigned long long)st.packets, (unsigned long long)st.lost_packets,
+           expected > 0 ? 100.0 * st.lost_packets / expected : 0.0,
+           (unsigned long long)st.reordered, (unsigned long long)st.bad_packets);
+    printf("  Bursts: %u started, %u complete  Samples: %llu\n", st.bursts_started,
+           st.bursts_completed, (unsigned long long)st.samples);
+    if (elapsed > 0) {
+        double rate = st.samples / elapsed;
+        printf("  Throughput: %.1f Msamples/s, %.1f MB/s", rate / 1e6, st.bytes / elapsed / 1e6);
+        if (st.sample_rate) printf(" (%.1f× real time at %u Hz)", rate / st.sample_rate, st.sample_rate);
+        printf("\n");
+    }
+    if (opt.output && st.writer_open) {
+        printf("✓ Samples saved to %s\n", opt.output);
+    }
+
+    if (ret < 0) return 1;
+    return st.lost_packets || st.bad_packets ? 2 : 0;
+}
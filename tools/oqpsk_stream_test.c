@@ -0,0 +1,403 @@
+/**
+ * @file oqpsk_stream_test.c
+ * @brief Host harness for the integer streaming modulator (oqpsk_stream.c)
+ *
+ * Runs random frames through the Linux float path (oqpsk_modulate_frame()
+ * then the pluto_convert_ci16() conversion) and through oqpsk_stream_read()
+ * in random chunk sizes, and requires identical Q11 and Q15 samples:
+ * - Derives every table entry from the float bursts and checks that the
+ *   waveform is a function of (phase, I chip, Q chip) only
+ * - Compares the derived entries with the tables compiled into the engine
+ *   (-g writes fresh tables when the float path or the host changes)
+ * - Checks the self-test PRN against prn_get_frame_table()
+ * - Reports state size, table size and streaming throughput
+ *
+ * Usage: ./oqpsk_stream_test [-n frames] [-s seed] [-g file] [-B bursts]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <complex.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include "../include/oqpsk_stream.h"
+#include "../include/oqpsk_modulator.h"
+#include "../include/prn_generator.h"
+#include "../include/t018_protocol.h"
+
+#define HALF_CHIP           (OQPSK_STREAM_SPS / 2)
+#define MAX_CHUNK           5000                // Largest random read (samples)
+#define BENCH_CHUNK         4096                // Benchmark read (one DMA buffer)
+#define NUM_FORMATS         2
+
+// Table entries derived from float bursts (seen = filled)
+typedef struct {
+    int16_t table[NUM_FORMATS][2][2][OQPSK_STREAM_SPS][2];
+    int16_t tail[NUM_FORMATS][2][HALF_CHIP][2];
+    uint8_t seen[2][2][OQPSK_STREAM_SPS];
+    uint8_t tail_seen[2][HALF_CHIP];
+} derived_t;
+
+static const char *format_name[NUM_FORMATS] = { "Q11", "Q15" };
+
+static uint64_t rng_state = 0x5EED5A25A7ULL;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint32_t)(rng_state >> 16);
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// =============================================================================
+// REFERENCE PATH
+// =============================================================================
+
+// pluto_convert_ci16() conversion (pluto_control.c needs libiio), any scale
+static int16_t to_fixed(float x, float scale, int32_t max) {
+    int32_t v = (int16_t)(x * scale);
+    if (v > max) v = max;
+    if (v < -max - 1) v = -max - 1;
+    return (int16_t)v;
+}
+
+// Float burst, modulator progress output discarded
+static uint32_t modulate_quiet(const uint8_t *frame_bits, float complex *iq) {
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    }
+    uint32_t n = oqpsk_modulate_frame(frame_bits, iq);
+    fflush(stdout);
+    if (saved >= 0) {
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+    }
+    return n;
+}
+
+// Spread chip logic values (1 = -1) of one channel, as oqpsk_modulate_frame()
+static void reference_chips(const uint8_t *frame_bits, uint8_t mode, uint8_t channel, uint8_t *chips) {
+    const int8_t *prn = prn_get_frame_table(mode, channel);
+    for (uint32_t c = 0; c < OQPSK_STREAM_CHIPS; c++) {
+        uint32_t index = 2 * (c / PRN_CHIPS_PER_BIT) + channel;
+        uint8_t bit = (index < OQPSK_STREAM_PREAMBLE_BITS) ? 0
+                      : (frame_bits[index - OQPSK_STREAM_PREAMBLE_BITS] != 0);
+        chips[c] = (uint8_t)((prn[c] < 0) ^ bit);
+    }
+}
+
+// Record the float samples as table entries; -1 if one entry takes two values
+static int derive_entries(derived_t *d, const int16_t ref[NUM_FORMATS][2 * OQPSK_STREAM_SAMPLES],
+                          const uint8_t *chips_i, const uint8_t *chips_q) {
+    for (uint32_t n = 0; n < OQPSK_STREAM_SAMPLES; n++) {
+        uint32_t phase = n % OQPSK_STREAM_SPS;
+        uint32_t q_chip = (n + HALF_CHIP) / OQPSK_STREAM_SPS;
+        uint8_t ci = chips_i[n / OQPSK_STREAM_SPS];
+        int16_t *entry[NUM_FORMATS];
+        uint8_t *seen;
+
+        if (q_chip < OQPSK_STREAM_CHIPS) {
+            uint8_t cq = chips_q[q_chip];
+            seen = &d->seen[ci][cq][phase];
+            for (int f = 0; f < NUM_FORMATS; f++) entry[f] = d->table[f][ci][cq][phase];
+        } else {
+            seen = &d->tail_seen[ci][phase - HALF_CHIP];
+            for (int f = 0; f < NUM_FORMATS; f++) entry[f] = d->tail[f][ci][phase - HALF_CHIP];
+        }
+
+        for (int f = 0; f < NUM_FORMATS; f++) {
+            const int16_t *s = &ref[f][2 * n];
+            if (!*seen) {
+                entry[f][0] = s[0];
+                entry[f][1] = s[1];
+            } else if (entry[f][0] != s[0] || entry[f][1] != s[1]) {
+                fprintf(stderr, "✗ Sample %u (phase %u) differs from an earlier sample with the same chips\n",
+                        n, phase);
+                return -1;
+            }
+        }
+        *seen = 1;
+    }
+    return 0;
+}
+
+// =============================================================================
+// ENGINE CHECKS
+// =============================================================================
+
+// Stream one burst in random chunk sizes; returns mismatching samples
+static uint32_t compare_stream(const uint8_t *frame_bits, uint8_t mode, oqpsk_stream_format_t format,
+                               const int16_t *ref, int16_t *out) {
+    oqpsk_stream_t s;
+    oqpsk_stream_init(&s, frame_bits, mode, format);
+
+    uint32_t total = 0;
+    uint32_t n;
+    do {
+        n = oqpsk_stream_read(&s, &out[2 * total], rng_next() % MAX_CHUNK + 1);
+        total += n;
+    } while (n > 0);
+
+    if (total != OQPSK_STREAM_SAMPLES || oqpsk_stream_remaining(&s) != 0) {
+        fprintf(stderr, "✗ Burst length %u (expected %u)\n", total, OQPSK_STREAM_SAMPLES);
+        return OQPSK_STREAM_SAMPLES;
+    }
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < OQPSK_STREAM_SAMPLES; i++) {
+        if (out[2 * i] != ref[2 * i] || out[2 * i + 1] != ref[2 * i + 1]) {
+            if (mismatches == 0) {
+                fprintf(stderr, "✗ %s sample %u: (%d, %d), float path (%d, %d)\n", format_name[format], i,
+                        out[2 * i], out[2 * i + 1], ref[2 * i], ref[2 * i + 1]);
+            }
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+// Self-test PRN: expected samples from the engine tables and the self-test chips
+static uint32_t check_self_test(const uint8_t *frame_bits, int16_t *expected, int16_t *out,
+                                uint8_t *chips_i, uint8_t *chips_q) {
+    const int16_t (*tail)[HALF_CHIP][2];
+    const int16_t (*table)[2][OQPSK_STREAM_SPS][2] = oqpsk_stream_table(OQPSK_STREAM_Q11, &tail);
+
+    reference_chips(frame_bits, 1, 0, chips_i);
+    reference_chips(frame_bits, 1, 1, chips_q);
+    for (uint32_t n = 0; n < OQPSK_STREAM_SAMPLES; n++) {
+        uint32_t phase = n % OQPSK_STREAM_SPS;
+        uint32_t q_chip = (n + HALF_CHIP) / OQPSK_STREAM_SPS;
+        uint8_t ci = chips_i[n / OQPSK_STREAM_SPS];
+        const int16_t *e = (q_chip < OQPSK_STREAM_CHIPS) ? table[ci][chips_q[q_chip]][phase]
+                                                         : tail[ci][phase - HALF_CHIP];
+        expected[2 * n] = e[0];
+        expected[2 * n + 1] = e[1];
+    }
+    return compare_stream(frame_bits, 1, OQPSK_STREAM_Q11, expected, out);
+}
+
+// Derived tables against the ones compiled into oqpsk_stream.c
+static uint32_t compare_tables(const derived_t *d) {
+    uint32_t differences = 0;
+    uint32_t unseen = 0;
+
+    for (int f = 0; f < NUM_FORMATS; f++) {
+        const int16_t (*tail)[HALF_CHIP][2];
+        const int16_t (*table)[2][OQPSK_STREAM_SPS][2] = oqpsk_stream_table((oqpsk_stream_format_t)f, &tail);
+
+        for (int ci = 0; ci < 2; ci++) {
+            for (int cq = 0; cq < 2; cq++) {
+                for (int k = 0; k < OQPSK_STREAM_SPS; k++) {
+                    if (!d->seen[ci][cq][k]) { unseen++; continue; }
+                    differences += memcmp(table[ci][cq][k], d->table[f][ci][cq][k], 2 * sizeof(int16_t)) != 0;
+                }
+            }
+            for (int k = 0; k < HALF_CHIP; k++) {
+                if (!d->tail_seen[ci][k]) { unseen++; continue; }
+                differences += memcmp(tail[ci][k], d->tail[f][ci][k], 2 * sizeof(int16_t)) != 0;
+            }
+        }
+    }
+
+    if (unseen) {
+        fprintf(stderr, "⚠ %u table entries not exercised (run more frames)\n", unseen);
+    }
+    return differences;
+}
+
+// =============================================================================
+// TABLE GENERATION
+// =============================================================================
+
+static void write_rows(FILE *f, const int16_t (*rows)[2], int count, const char *indent) {
+    for (int k = 0; k < count; k++) {
+        if (k % 8 == 0) fprintf(f, "%s", indent);
+        fprintf(f, "{%6d,%6d}%s", rows[k][0], rows[k][1], (k == count - 1) ? "" : ",");
+        fprintf(f, (k % 8 == 7 || k == count - 1) ? "\n" : " ");
+    }
+}
+
+static int write_tables(const char *path, const derived_t *d) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    const char *prefix[NUM_FORMATS] = { "q11", "q15" };
+    fprintf(f, "// BEGIN GENERATED TABLES\n");
+    for (int fmt = 0; fmt < NUM_FORMATS; fmt++) {
+        fprintf(f, "static const int16_t %s_table[2][2][OQPSK_STREAM_SPS][2] = {\n", prefix[fmt]);
+        for (int ci = 0; ci < 2; ci++) {
+            fprintf(f, "    {\n");
+            for (int cq = 0; cq < 2; cq++) {
+                fprintf(f, "        { // I chip %s, Q chip %s\n", ci ? "-1" : "+1", cq ? "-1" : "+1");
+                write_rows(f, d->table[fmt][ci][cq], OQPSK_STREAM_SPS, "            ");
+                fprintf(f, "        }%s\n", cq ? "" : ",");
+            }
+            fprintf(f, "    }%s\n", ci ? "" : ",");
+        }
+        fprintf(f, "};\n");
+        fprintf(f, "static const int16_t %s_tail[2][HALF_CHIP][2] = {\n", prefix[fmt]);
+        for (int ci = 0; ci < 2; ci++) {
+            fprintf(f, "    { // I chip %s\n", ci ? "-1" : "+1");
+            write_rows(f, d->tail[fmt][ci], HALF_CHIP, "        ");
+            fprintf(f, "    }%s\n", ci ? "" : ",");
+        }
+        fprintf(f, "};\n");
+    }
+    fprintf(f, "// END GENERATED TABLES\n");
+
+    fclose(f);
+    printf("✓ Tables written to %s (replace the generated block of src/oqpsk_stream.c)\n", path);
+    return 0;
+}
+
+// =============================================================================
+// BENCHMARK
+// =============================================================================
+
+static void bench_stream(const uint8_t *frame_bits, uint32_t bursts) {
+    static int16_t buf[2 * BENCH_CHUNK];
+    volatile int16_t sink = 0;
+    double start = now_seconds();
+
+    for (uint32_t b = 0; b < bursts; b++) {
+        oqpsk_stream_t s;
+        oqpsk_stream_init(&s, frame_bits, 0, OQPSK_STREAM_Q11);
+        while (oqpsk_stream_read(&s, buf, BENCH_CHUNK) > 0) {
+            sink ^= buf[0];
+        }
+    }
+
+    double elapsed = now_seconds() - start;
+    double msps = (double)bursts * OQPSK_STREAM_SAMPLES / elapsed / 1e6;
+    printf("✓ Streaming: %u burst(s) in %.3f s, %.1f Msamples/s (%.0f× real time)\n",
+           bursts, elapsed, msps, msps * 1e6 / OQPSK_SAMPLE_RATE);
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  -n <frames>    Random frames through both paths (default: 4)\n"
+            "  -s <seed>      Random seed\n"
+            "  -g <file>      Write tables derived from the float path (C source)\n"
+            "  -B <bursts>    Streaming benchmark bursts (default: 20, 0 = off)\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = 4;
+    uint32_t bursts = 20;
+    const char *table_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            frames = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            rng_state = strtoull(argv[++i], NULL, 0) | 1;
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            table_path = argv[++i];
+        } else if (strcmp(argv[i], "-B") == 0 && i + 1 < argc) {
+            bursts = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (frames == 0) frames = 1;
+
+    printf("=== OQPSK streaming modulator harness ===\n");
+    printf("  State: %zu bytes, tables: %zu bytes (Q11 + Q15)\n", sizeof(oqpsk_stream_t),
+           (size_t)NUM_FORMATS * (2 * 2 * OQPSK_STREAM_SPS + 2 * HALF_CHIP) * 2 * sizeof(int16_t));
+
+    float complex *iq = malloc(OQPSK_TOTAL_SAMPLES * sizeof(float complex));
+    int16_t (*ref)[2 * OQPSK_STREAM_SAMPLES] = malloc(NUM_FORMATS * sizeof(*ref));
+    int16_t *out = malloc(2 * OQPSK_STREAM_SAMPLES * sizeof(int16_t));
+    uint8_t *chips_i = malloc(OQPSK_STREAM_CHIPS);
+    uint8_t *chips_q = malloc(OQPSK_STREAM_CHIPS);
+    derived_t *derived = calloc(1, sizeof(derived_t));
+    if (!iq || !ref || !out || !chips_i || !chips_q || !derived) {
+        fprintf(stderr, "Failed to allocate burst buffers\n");
+        return 1;
+    }
+
+    uint8_t frame_bits[T018_FRAME_BITS];
+    uint32_t failures = 0;
+
+    for (uint32_t f = 0; f < frames; f++) {
+        for (int b = 0; b < T018_FRAME_BITS; b++) {
+            frame_bits[b] = rng_next() & 1;
+        }
+
+        if (modulate_quiet(frame_bits, iq) != OQPSK_STREAM_SAMPLES) {
+            fprintf(stderr, "✗ Float modulator failed\n");
+            return 1;
+        }
+        for (uint32_t n = 0; n < OQPSK_STREAM_SAMPLES; n++) {
+            ref[OQPSK_STREAM_Q11][2 * n] = to_fixed(crealf(iq[n]), 2047.0f, 2047);
+            ref[OQPSK_STREAM_Q11][2 * n + 1] = to_fixed(cimagf(iq[n]), 2047.0f, 2047);
+            ref[OQPSK_STREAM_Q15][2 * n] = to_fixed(crealf(iq[n]), 32767.0f, 32767);
+            ref[OQPSK_STREAM_Q15][2 * n + 1] = to_fixed(cimagf(iq[n]), 32767.0f, 32767);
+        }
+
+        reference_chips(frame_bits, 0, 0, chips_i);
+        reference_chips(frame_bits, 0, 1, chips_q);
+        if (derive_entries(derived, (const int16_t (*)[2 * OQPSK_STREAM_SAMPLES])ref, chips_i, chips_q) < 0) {
+            return 1;
+        }
+
+        for (int fmt = 0; fmt < NUM_FORMATS; fmt++) {
+            uint32_t mismatches = compare_stream(frame_bits, 0, (oqpsk_stream_format_t)fmt, ref[fmt], out);
+            printf("%s Frame %u %s: %u/%u samples differ from the float path\n",
+                   mismatches ? "✗" : "✓", f + 1, format_name[fmt], mismatches, OQPSK_STREAM_SAMPLES);
+            failures += mismatches != 0;
+        }
+    }
+
+    uint32_t differences = compare_tables(derived);
+    printf("%s Compiled tables: %u entries differ from this host's float path%s\n",
+           differences ? "✗" : "✓", differences, differences ? " (regenerate with -g)" : "");
+    failures += differences != 0;
+
+    uint32_t self_test = check_self_test(frame_bits, ref[0], out, chips_i, chips_q);
+    printf("%s Self-test PRN: %u samples differ\n", self_test ? "✗" : "✓", self_test);
+    failures += self_test != 0;
+
+    if (table_path && write_tables(table_path, derived) < 0) {
+        failures++;
+    }
+    if (bursts) {
+        bench_stream(frame_bits, bursts);
+    }
+
+    free(iq);
+    free(ref);
+    free(out);
+    free(chips_i);
+    free(chips_q);
+    free(derived);
+
+    if (failures) {
+        printf("✗ %u check(s) failed\n", failures);
+        return 1;
+    }
+    printf("✓ Streaming modulator bit-exact with the float path\n");
+    return 0;
+}
@@ -0,0 +1,282 @@
+/**
+ * @file shm_iq_rx.c
+ * @brief Read the shared-memory I/Q ring (shm: TX backend) and check it
+ *
+ * Maps /dev/shm/<name> written by sarsat_sgb -u shm:<name>, follows the
+ * burst markers and consumes the samples in place (no copy out of the ring):
+ * - -f makes the producer wait for this reader instead of overwriting
+ * - -o saves the stream as raw cf32
+ * - -b runs an in-process benchmark: a producer thread modulates a T.018
+ *   frame directly into the ring, then queues copies of it as fast as the
+ *   reader consumes them (flow controlled)
+ *
+ * Usage: ./shm_iq_rx [-n name] [-f] [-c bursts] [-o file] [-b bursts] [-v]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/shm_ring.h"
+#include "../include/oqpsk_modulator.h"
+
+#define READ_MAX            65536       // Samples per peek
+#define IDLE_POLL_NS        1000000     // Reader poll when the ring is empty
+#define BENCH_NAME          "sarsat_iq_bench"
+#define BENCH_RING          (1u << 22)  // 4 Mi samples (1.7 bursts)
+#define BENCH_BURST         (OQPSK_BITS_PER_CHANNEL * OQPSK_CHIPS_PER_BIT * OQPSK_SAMPLES_PER_CHIP)
+
+typedef struct {
+    const char *name;
+    int flow_control;
+    uint32_t max_bursts;                // 0 = until the producer closes the ring
+    const char *output;
+    uint32_t bench_bursts;
+    int verbose;
+} options_t;
+
+// Reader statistics
+typedef struct {
+    uint64_t samples;
+    uint64_t damaged;                   // Released samples overwritten while read
+    uint32_t bursts_seen;               // Markers received
+    uint32_t bursts_complete;           // Markers whose samples were all read
+    uint64_t burst_end;                 // Stream index after the newest marked burst
+    double power_sum;                   // Σ|x|² (touches every sample)
+    double first_time;
+    double last_time;
+} stats_t;
+
+static volatile sig_atomic_t stop = 0;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop = 1;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// =============================================================================
+// READER
+// =============================================================================
+
+static void handle_markers(shm_ring_t *ring, stats_t *st, const options_t *opt) {
+    shm_ring_marker_t marker;
+    while (shm_ring_next_marker(ring, &marker)) {
+        st->bursts_seen++;
+        st->burst_end = marker.start + marker.samples;
+        if (opt->verbose) {
+            printf("  Burst %u: %u samples at stream index %llu\n", marker.burst,
+                   marker.samples, (unsigned long long)marker.start);
+        }
+    }
+}
+
+static int read_ring(shm_ring_t *ring, stats_t *st, const options_t *opt, FILE *out) {
+    while (!stop) {
+        handle_markers(ring, st, opt);
+
+        const float complex *iq;
+        int64_t n = shm_ring_peek(ring, &iq, READ_MAX);
+        if (n < 0) break;                   // Producer closed the ring
+        if (n == 0) {
+            if (opt->max_bursts && st->bursts_complete >= opt->max_bursts) break;
+            struct timespec ts = { 0, IDLE_POLL_NS };
+            nanosleep(&ts, NULL);
+            continue;
+        }
+
+        if (st->samples == 0) st->first_time = now_sec();
+        double power = 0.0;
+        for (int64_t i = 0; i < n; i++) {
+            power += crealf(iq[i]) * crealf(iq[i]) + cimagf(iq[i]) * cimagf(iq[i]);
+        }
+        if (out && fwrite(iq, sizeof(float complex), (size_t)n, out) != (size_t)n) {
+            fprintf(stderr, "Write error on %s\n", opt->output);
+            return -1;
+        }
+        if (shm_ring_release(ring, (uint32_t)n)) {
+            st->damaged += (uint64_t)n;
+        }
+        st->power_sum += power;
+        st->samples += (uint64_t)n;
+        st->last_time = now_sec();
+
+        if (st->bursts_seen && ring->read_pos >= st->burst_end &&
+            st->bursts_complete < st->bursts_seen) {
+            st->bursts_complete = st->bursts_seen;
+            if (opt->max_bursts && st->bursts_complete >= opt->max_bursts) break;
+        }
+    }
+    return 0;
+}
+
+// =============================================================================
+// BENCHMARK PRODUCER
+// =============================================================================
+
+typedef struct {
+    shm_ring_t *ring;
+    uint32_t bursts;
+    int failed;
+} producer_t;
+
+static void *bench_producer(void *arg) {
+    producer_t *prod = (producer_t *)arg;
+    shm_ring_t *ring = prod->ring;
+
+    uint8_t bits[250];
+    uint32_t x = 1;
+    for (int i = 0; i < 250; i++) {
+        x = x * 1664525u + 1013904223u;
+        bits[i] = (x >> 24) & 1;
+    }
+
+    // First burst rendered in place: the ring is the modulator's output buffer
+    float complex *burst = malloc(BENCH_BURST * sizeof(float complex));
+    float complex *first = burst ? shm_ring_reserve(ring, BENCH_BURST) : NULL;
+    if (first) {
+        shm_ring_mark_burst(ring, BENCH_BURST);
+        uint32_t n = oqpsk_modulate_frame(bits, first);
+        if (n != BENCH_BURST) {
+            fprintf(stderr, "Unexpected burst length %u\n", n);
+            prod->failed = 1;
+        }
+
+        // Keep a copy for the others (queued like the TX backend queues bursts)
+        memcpy(burst, first, BENCH_BURST * sizeof(float complex));
+        shm_ring_commit(ring, BENCH_BURST);
+    } else {
+        prod->failed = 1;
+    }
+
+    for (uint32_t b = 1; b < prod->bursts && !prod->failed; b++) {
+        if (shm_ring_write_burst(ring, burst, BENCH_BURST) < 0) {
+            prod->failed = 1;
+        }
+    }
+    free(burst);
+
+    // Closing marks the end of the stream for the reader
+    shm_ring_close(ring);
+    return NULL;
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options]\n\n", prog);
+    printf("  -n <name>     Ring name in /dev/shm (default %s)\n", SHM_RING_DEFAULT_NAME);
+    printf("  -f            Flow control: the producer waits for this reader\n");
+    printf("  -c <bursts>   Stop after n complete bursts (default: until the ring closes)\n");
+    printf("  -o <file>     Save the samples (raw cf32)\n");
+    printf("  -b <bursts>   Benchmark: in-process producer, n modulated bursts\n");
+    printf("  -v            Print burst markers\n");
+    printf("\nProducer: sarsat_sgb -u shm:<name> (or -d shm:<name>@serials)\n");
+}
+
+int main(int argc, char *argv[]) {
+    options_t opt = { .name = SHM_RING_DEFAULT_NAME };
+
+    int c;
+    while ((c = getopt(argc, argv, "n:fc:o:b:vh")) != -1) {
+        switch (c) {
+            case 'n': opt.name = optarg; break;
+            case 'f': opt.flow_control = 1; break;
+            case 'c': opt.max_bursts = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'o': opt.output = optarg; break;
+            case 'b': opt.bench_bursts = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'v': opt.verbose = 1; break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    // Benchmark: create the ring here, read it back flow controlled
+    shm_ring_t producer_ring;
+    if (opt.bench_bursts) {
+        opt.name = BENCH_NAME;
+        opt.flow_control = 1;
+        opt.max_bursts = opt.bench_bursts;
+        if (shm_ring_create(&producer_ring, BENCH_NAME, BENCH_RING, OQPSK_SAMPLE_RATE) < 0) {
+            return 1;
+        }
+    }
+
+    shm_ring_t ring;
+    if (shm_ring_open(&ring, opt.name, opt.flow_control) < 0) {
+        if (opt.bench_bursts) shm_ring_close(&producer_ring);
+        return 1;
+    }
+    uint32_t sample_rate = atomic_load(&ring.hdr->sample_rate);
+    printf("✓ Reading /dev/shm%s: %llu-sample ring, %u Hz%s\n", ring.path,
+           (unsigned long long)ring.hdr->capacity, sample_rate,
+           opt.flow_control ? ", flow controlled" : "");
+
+    FILE *out = NULL;
+    if (opt.output && !(out = fopen(opt.output, "wb"))) {
+        fprintf(stderr, "Cannot create %s\n", opt.output);
+        shm_ring_close(&ring);
+        return 1;
+    }
+
+    pthread_t producer_thread;
+    producer_t producer = { .ring = &producer_ring, .bursts = opt.bench_bursts };
+    if (opt.bench_bursts) {
+        pthread_create(&producer_thread, NULL, bench_producer, &producer);
+    }
+
+    stats_t st;
+    memset(&st, 0, sizeof(st));
+    int ret = read_ring(&ring, &st, &opt, out);
+
+    if (opt.bench_bursts) {
+        pthread_join(producer_thread, NULL);
+        if (producer.failed) ret = -1;
+    }
+    uint64_t overwritten = atomic_load(&ring.hdr->overwritten);
+    shm_ring_close(&ring);
+    if (out && fclose(out) != 0) ret = -1;
+
+    // Summary
+    double elapsed = st.last_time - st.first_time;
+    printf("\nRing statistics:\n");
+    printf("  Bursts: %u marked, %u complete  Samples: %llu  Mean power: %.3f\n",
+           st.bursts_seen, st.bursts_complete, (unsigned long long)st.samples,
+           st.samples ? st.power_sum / st.samples : 0.0);
+    printf("  Overruns: %llu skipped, %llu overwritten while read, %llu overwritten unread\n",
+           (unsigned long long)ring.overruns, (unsigned long long)st.damaged,
+           (unsigned long long)overwritten);
+    if (elapsed > 0) {
+        double rate = st.samples / elapsed;
+        printf("  Throughput: %.1f Msamples/s, %.1f MB/s", rate / 1e6,
+               rate * sizeof(float complex) / 1e6);
+        if (sample_rate) printf(" (%.1f× real time at %u Hz)", rate / sample_rate, sample_rate);
+        printf("\n");
+    }
+    if (opt.output) {
+        printf("✓ Samples saved to %s\n", opt.output);
+    }
+
+    if (ret < 0) return 1;
+    return ring.overruns || st.damaged || overwritten ? 2 : 0;
+}
@@ -0,0 +1,346 @@
+/**
+ * @file tx_journal_query.c
+ * @brief Query the binary transmission journal (sarsat_sgb --journal)
+ *
+ * Maps the journal read-only and scans the fixed-size records in place:
+ * millions of records per second, also while the transmitter appends.
+ * - Filters: sequence range, UTC range, serial, late, errors, waveform hash
+ * - Output: one line per burst, frames only (decode_frames input), or a
+ *   summary (counts, slack statistics, time span)
+ * - Audit (-a): sequence gaps and clocks going backwards
+ *
+ * Usage: ./tx_journal_query <journal> [-n first[-last]] [-f from] [-t to]
+ *                           [-s serial] [-l] [-e] [-H hash] [-F|-c] [-a]
+ */
+
+#define _GNU_SOURCE                 // strptime(), timegm()
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/tx_journal.h"
+
+#define NS_PER_SEC          1000000000LL
+
+typedef enum {
+    OUTPUT_LINES = 0,       // One line per record
+    OUTPUT_FRAMES,          // 63 hex digits per record (-F)
+    OUTPUT_SUMMARY          // Statistics only (-c)
+} output_mode_t;
+
+typedef struct {
+    uint64_t first_seq;
+    uint64_t last_seq;
+    int64_t from_ns;
+    int64_t to_ns;
+    int64_t serial;         // -1 = any
+    uint8_t late;
+    uint8_t errors;
+    uint8_t match_hash;
+    uint64_t hash;
+    output_mode_t output;
+    uint8_t audit;
+} query_t;
+
+typedef struct {
+    uint64_t matched;
+    uint64_t sent;
+    uint64_t offline;
+    uint64_t failed;
+    uint64_t late;
+    uint64_t reused;
+    int64_t slack_min_us;
+    int64_t slack_max_us;
+    double slack_sum_us;
+    uint64_t render_max_us;
+    int64_t first_utc_ns;
+    int64_t last_utc_ns;
+} summary_t;
+
+static const char hex_digits[] = "0123456789ABCDEF";
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// =============================================================================
+// FORMATTING
+// =============================================================================
+
+// "2026-10-18T12:34:56.789Z"
+static void format_utc(int64_t utc_ns, char *out, size_t size) {
+    time_t sec = (time_t)(utc_ns / NS_PER_SEC);
+    struct tm tm;
+    gmtime_r(&sec, &tm);
+    size_t n = strftime(out, size, "%Y-%m-%dT%H:%M:%S", &tm);
+    snprintf(out + n, size - n, ".%03dZ", (int)(utc_ns % NS_PER_SEC / 1000000));
+}
+
+// 252 frame bits as 63 hex digits (bch_enum / decode_frames layout)
+static void format_frame(const uint8_t *frame, char *out) {
+    for (int d = 0; d < 63; d++) {
+        uint8_t byte = frame[d / 2];
+        out[d] = hex_digits[(d & 1) ? (byte & 0xF) : (byte >> 4)];
+    }
+    out[63] = '\0';
+}
+
+static void format_flags(uint16_t flags, char *out) {
+    out[0] = (flags & TX_JOURNAL_SENT) ? 'S' : '-';
+    out[1] = (flags & TX_JOURNAL_OFFLINE) ? 'O' : '-';
+    out[2] = (flags & TX_JOURNAL_FAILED) ? 'X' : '-';
+    out[3] = (flags & TX_JOURNAL_REUSED) ? 'R' : '-';
+    out[4] = (flags & TX_JOURNAL_FANOUT) ? 'M' : '-';
+    out[5] = '\0';
+}
+
+static void print_record(const tx_journal_record_t *r) {
+    char utc[40];
+    char frame[64];
+    char flags[6];
+    format_utc(r->utc_ns, utc, sizeof(utc));
+    format_frame(r->frame, frame);
+    format_flags(r->flags, flags);
+
+    printf("%8llu %s %6u %5u %10.6f %3d %+9.3f %8.3f %u %s %016llx %s\n",
+           (unsigned long long)r->seq, utc, r->cycle, r->serial_number, r->frequency / 1e6,
+           r->gain_db, r->slack_us / 1000.0, r->render_us / 1000.0, r->devices, flags,
+           (unsigned long long)r->waveform_hash, frame);
+}
+
+// =============================================================================
+// SCAN
+// =============================================================================
+
+static inline int matches(const query_t *q, const tx_journal_record_t *r) {
+    if (r->seq < q->first_seq || r->seq > q->last_seq) return 0;
+    if (r->utc_ns < q->from_ns || r->utc_ns > q->to_ns) return 0;
+    if (q->serial >= 0 && r->serial_number != (uint32_t)q->serial) return 0;
+    if (q->late && r->slack_us >= -TX_JOURNAL_LATE_US) return 0;
+    if (q->errors && !(r->flags & (TX_JOURNAL_OFFLINE | TX_JOURNAL_FAILED))) return 0;
+    if (q->match_hash && r->waveform_hash != q->hash) return 0;
+    return 1;
+}
+
+static void account(summary_t *s, const tx_journal_record_t *r) {
+    if (s->matched == 0) {
+        s->slack_min_us = s->slack_max_us = r->slack_us;
+        s->first_utc_ns = r->utc_ns;
+    }
+    s->matched++;
+    s->sent += (r->flags & TX_JOURNAL_SENT) != 0;
+    s->offline += (r->flags & TX_JOURNAL_OFFLINE) != 0;
+    s->failed += (r->flags & TX_JOURNAL_FAILED) != 0;
+    s->reused += (r->flags & TX_JOURNAL_REUSED) != 0;
+    s->late += r->slack_us < -TX_JOURNAL_LATE_US;
+    if (r->slack_us < s->slack_min_us) s->slack_min_us = r->slack_us;
+    if (r->slack_us > s->slack_max_us) s->slack_max_us = r->slack_us;
+    s->slack_sum_us += r->slack_us;
+    if (r->render_us > s->render_max_us) s->render_max_us = r->render_us;
+    s->last_utc_ns = r->utc_ns;
+}
+
+// Sequence gaps, clocks going backwards; returns the number of findings
+static uint64_t audit(const tx_journal_t *j) {
+    const tx_journal_record_t *recs = tx_journal_records(j);
+    uint64_t findings = 0;
+
+    for (uint64_t i = 0; i < j->count; i++) {
+        const tx_journal_record_t *r = &recs[i];
+        if (r->seq != i + 1) {
+            fprintf(stderr, "⚠ Record %llu: sequence %llu\n", (unsigned long long)(i + 1),
+                    (unsigned long long)r->seq);
+            findings++;
+        }
+        if (i == 0) continue;
+        const tx_journal_record_t *prev = &recs[i - 1];
+        if (r->mono_ns < prev->mono_ns) {
+            // Monotonic clock restarts with the host: a new session, not an error
+            char utc[40];
+            format_utc(r->utc_ns, utc, sizeof(utc));
+            fprintf(stderr, "  Record %llu: new session at %s\n", (unsigned long long)r->seq, utc);
+        } else if (r->utc_ns < prev->utc_ns) {
+            fprintf(stderr, "⚠ Record %llu: UTC went back %.3f s (clock step)\n",
+                    (unsigned long long)r->seq, (prev->utc_ns - r->utc_ns) / 1e9);
+            findings++;
+        }
+    }
+    return findings;
+}
+
+static void print_summary(const summary_t *s, uint64_t scanned, double elapsed) {
+    printf("Records:   %llu matched of %llu (%.1f M records/s)\n",
+           (unsigned long long)s->matched, (unsigned long long)scanned,
+           elapsed > 0.0 ? scanned / elapsed / 1e6 : 0.0);
+    if (s->matched == 0) return;
+
+    char first[40], last[40];
+    format_utc(s->first_utc_ns, first, sizeof(first));
+    format_utc(s->last_utc_ns, last, sizeof(last));
+    printf("Span:      %s .. %s\n", first, last);
+    printf("Outcome:   %llu sent, %llu offline, %llu failed, %llu startup renders\n",
+           (unsigned long long)s->sent, (unsigned long long)s->offline,
+           (unsigned long long)s->failed, (unsigned long long)s->reused);
+    printf("Slack:     min %+.3f ms, mean %+.3f ms, max %+.3f ms, %llu late\n",
+           s->slack_min_us / 1000.0, s->slack_sum_us / s->matched / 1000.0,
+           s->slack_max_us / 1000.0, (unsigned long long)s->late);
+    printf("Render:    max %.3f ms\n", s->render_max_us / 1000.0);
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+// Epoch seconds or "YYYY-MM-DD[THH:MM[:SS]]" (UTC)
+static int parse_time(const char *arg, int64_t *ns) {
+    char *end;
+    double sec = strtod(arg, &end);
+    if (*end == '\0' && end != arg) {
+        *ns = (int64_t)(sec * NS_PER_SEC);
+        return 0;
+    }
+
+    static const char *formats[] = { "%Y-%m-%dT%H:%M:%S", "%Y-%m-%dT%H:%M", "%Y-%m-%d" };
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        struct tm tm;
+        memset(&tm, 0, sizeof(tm));
+        end = strptime(arg, formats[f], &tm);
+        if (end && (*end == '\0' || *end == 'Z')) {
+            *ns = (int64_t)timegm(&tm) * NS_PER_SEC;
+            return 0;
+        }
+    }
+    fprintf(stderr, "Invalid time '%s' (epoch seconds or YYYY-MM-DDTHH:MM:SS)\n", arg);
+    return -1;
+}
+
+// "first" or "first-last", first <= last
+static int parse_seq_range(const char *arg, uint64_t *first, uint64_t *last) {
+    char *end;
+    *first = strtoull(arg, &end, 10);
+    *last = *first;
+    if (end != arg && *end == '-' && isdigit((unsigned char)end[1]))
+        *last = strtoull(end + 1, &end, 10);
+    if (!isdigit((unsigned char)arg[0]) || *end != '\0' || *first > *last) {
+        fprintf(stderr, "Invalid sequence range '%s' (first[-last], first <= last)\n", arg);
+        return -1;
+    }
+    return 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s <journal> [options]\n"
+            "  -n <first>[-<last>]  Sequence range\n"
+            "  -f <time>            From UTC (epoch seconds or YYYY-MM-DDTHH:MM:SS)\n"
+            "  -t <time>            To UTC\n"
+            "  -s <serial>          Beacon serial\n"
+            "  -l                   Late bursts only (pushed over 1 ms after their deadline)\n"
+            "  -e                   Missed or failed bursts only\n"
+            "  -H <hash>            Waveform hash (hex)\n"
+            "  -F                   Frames only (decode_frames input)\n"
+            "  -c                   Summary only\n"
+            "  -a                   Audit: sequence gaps, UTC steps\n"
+            "\n"
+            "Columns: seq, UTC, cycle, serial, MHz, gain dB, slack ms, render ms, devices,\n"
+            "         flags (S sent, O offline, X failed, R startup render, M fan-out), hash, frame\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    query_t q = {
+        .first_seq = 1,
+        .last_seq = UINT64_MAX,
+        .from_ns = INT64_MIN,
+        .to_ns = INT64_MAX,
+        .serial = -1,
+        .output = OUTPUT_LINES
+    };
+    const char *path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            if (parse_seq_range(argv[++i], &q.first_seq, &q.last_seq) < 0) return 1;
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            if (parse_time(argv[++i], &q.from_ns) < 0) return 1;
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            if (parse_time(argv[++i], &q.to_ns) < 0) return 1;
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            q.serial = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-l") == 0) {
+            q.late = 1;
+        } else if (strcmp(argv[i], "-e") == 0) {
+            q.errors = 1;
+        } else if (strcmp(argv[i], "-H") == 0 && i + 1 < argc) {
+            q.match_hash = 1;
+            q.hash = strtoull(argv[++i], NULL, 16);
+        } else if (strcmp(argv[i], "-F") == 0) {
+            q.output = OUTPUT_FRAMES;
+        } else if (strcmp(argv[i], "-c") == 0) {
+            q.output = OUTPUT_SUMMARY;
+        } else if (strcmp(argv[i], "-a") == 0) {
+            q.audit = 1;
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!path) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    tx_journal_t journal;
+    if (tx_journal_open_read(&journal, path) < 0) {
+        return 1;
+    }
+
+    static char out_buf[1 << 20];
+    setvbuf(stdout, out_buf, _IOFBF, sizeof(out_buf));
+
+    // Sequence numbers are record positions: start the scan at first_seq
+    const tx_journal_record_t *recs = tx_journal_records(&journal);
+    uint64_t begin = q.first_seq > 0 ? q.first_seq - 1 : 0;
+    if (begin > journal.count) begin = journal.count;
+    uint64_t end = journal.count;
+    if (q.last_seq < end) end = q.last_seq;
+
+    summary_t summary = { 0 };
+    double start = now_seconds();
+    for (uint64_t i = begin; i < end; i++) {
+        const tx_journal_record_t *r = &recs[i];
+        if (!matches(&q, r)) continue;
+
+        account(&summary, r);
+        if (q.output == OUTPUT_LINES) {
+            print_record(r);
+        } else if (q.output == OUTPUT_FRAMES) {
+            char frame[64];
+            format_frame(r->frame, frame);
+            puts(frame);
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    if (q.output == OUTPUT_SUMMARY) {
+        print_summary(&summary, end > begin ? end - begin : 0, elapsed);
+    }
+    fflush(stdout);
+
+    int rc = 0;
+    if (q.audit) {
+        uint64_t findings = audit(&journal);
+        fprintf(stderr, "%s Audit: %llu records, %llu finding(s)\n", findings ? "⚠" : "✓",
+                (unsigned long long)journal.count, (unsigned long long)findings);
+        rc = findings ? 2 : 0;
+    }
+
+    tx_journal_close(&journal);
+    return rc;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file verify_chips.c
+ * @brief Bulk verification of chips dumps with the bit-parallel despreader
+ *
+ * Reads chips_after_spreading.bin dumps (int8 I/Q interleaved, 38400 chips
+ * per channel) and for each one:
+ * - Finds the PRN mode and code phase (XOR/popcount search over the preamble)
+ * - Despreads 150 I + 150 Q bits and counts chip errors
+ * - Checks the 50-bit preamble and the BCH(250,202) parity (both layouts)
+ *
+ * Optional soft mode adds Gaussian noise, quantizes to int8 and despreads
+ * with the dot-product path; -b compares float, int8 and XOR correlation.
+ *
+ * Usage: ./verify_chips [-o chips] [-n snr_db] [-b] [dump.bin ...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <time.h>
+#include "../include/despread.h"
+#include "../include/t018_protocol.h"
+
+#define DUMP_BYTES          (2 * PRN_FRAME_CHIPS)       // 76,800 bytes
+#define PREAMBLE_BITS       50                          // Transmitted preamble bits
+#define PREAMBLE_WORDS      (PREAMBLE_BITS / 2 * DESPREAD_BIT_WORDS)  // 25 zero bits per channel
+#define SOFT_AMPLITUDE      32.0f                       // int8 level of a noiseless chip
+#define BENCH_ITERATIONS    200
+
+typedef struct {
+    uint32_t offset;        // Random chips prepended (code phase to find)
+    int soft;               // Soft int8 despreading
+    float snr_db;           // Chip SNR in soft mode
+    int bench;              // Run benchmark
+} options_t;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static float gaussian(void) {
+    // Box-Muller
+    float u1 = (rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+    float u2 = (rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * (float)M_PI * u2);
+}
+
+static void print_hex(const uint8_t *bits, int num_bits) {
+    for (int i = 0; i < num_bits; i += 4) {
+        int nibble = 0;
+        for (int j = 0; j < 4; j++) {
+            nibble = (nibble << 1) | (i + j < num_bits ? bits[i + j] : 0);
+        }
+        printf("%X", nibble);
+    }
+    printf("\n");
+}
+
+static int bch_layout(const uint8_t *msg) {
+    // t018_verify_bch() takes the 252-bit frame: 2 header + 202 info + 48 parity
+    uint8_t frame[T018_FRAME_BITS];
+
+    // T.018 layout: the 250 bits are the codeword
+    frame[0] = frame[1] = 0;
+    memcpy(&frame[T018_HEADER_BITS], msg, T018_DATA_BITS);
+    if (t018_verify_bch(frame)) {
+        return 1;
+    }
+
+    // Header layout: 2 header bits first, the last 2 parity bits not sent
+    memcpy(frame, msg, T018_DATA_BITS);
+    for (int guess = 0; guess < 4; guess++) {
+        frame[T018_FRAME_BITS - 2] = (guess >> 1) & 1;
+        frame[T018_FRAME_BITS - 1] = guess & 1;
+        if (t018_verify_bch(frame)) {
+            return 2;
+        }
+    }
+    return 0;
+}
+
+// =============================================================================
+// VERIFICATION
+// =============================================================================
+
+static int verify_dump(const char *path, const options_t *opt) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return -1;
+    }
+
+    uint32_t total = opt->offset + PRN_FRAME_CHIPS;
+    int8_t *dump = malloc(DUMP_BYTES);
+    int8_t *chips[2] = { malloc(total), malloc(total) };
+    uint64_t *packed[2] = { calloc(despread_words(total) + 1, sizeof(uint64_t)),
+                            calloc(despread_words(total) + 1, sizeof(uint64_t)) };
+    if (!dump || !chips[0] || !chips[1] || !packed[0] || !packed[1]) {
+        fprintf(stderr, "Failed to allocate chip buffers\n");
+        fclose(f);
+        free(dump);
+        free(chips[0]);
+        free(chips[1]);
+        free(packed[0]);
+        free(packed[1]);
+        return -1;
+    }
+
+    size_t got = fread(dump, 1, DUMP_BYTES, f);
+    fclose(f);
+    int status = -1;
+    if (got != DUMP_BYTES) {
+        fprintf(stderr, "%s: expected %d bytes, got %zu\n", path, DUMP_BYTES, got);
+        goto out;
+    }
+
+    printf("%s\n", path);
+
+    // Unknown code phase: random chips ahead of the frame
+    for (int ch = 0; ch < 2; ch++) {
+        for (uint32_t i = 0; i < opt->offset; i++) {
+            chips[ch][i] = (rand() & 1) ? 1 : -1;
+        }
+        for (uint32_t i = 0; i < PRN_FRAME_CHIPS; i++) {
+            chips[ch][opt->offset + i] = dump[2 * i + ch];
+        }
+    }
+
+    if (opt->soft) {
+        float sigma = SOFT_AMPLITUDE / powf(10.0f, opt->snr_db / 20.0f);
+        for (int ch = 0; ch < 2; ch++) {
+            for (uint32_t i = 0; i < total; i++) {
+                float v = chips[ch][i] * SOFT_AMPLITUDE + sigma * gaussian();
+                despread_quantize(&v, 1, 1, 1.0f, &chips[ch][i]);
+            }
+        }
+        printf("  Soft int8 chips, SNR %.1f dB per chip\n", opt->snr_db);
+    }
+
+    for (int ch = 0; ch < 2; ch++) {
+        despread_pack_i8(chips[ch], 1, total, packed[ch]);
+    }
+
+    // Acquisition on the I preamble (25 zero bits: 6400 coherent chips)
+    uint8_t mode = 0;
+    uint32_t phase = 0;
+    int32_t peak = 0;
+    for (uint8_t m = 0; m < 2; m++) {
+        uint32_t off;
+        int32_t c = despread_search(packed[0], total, despread_prn_words(m, 0),
+                                    PREAMBLE_WORDS, opt->offset + PRN_CHIPS_PER_BIT, &off);
+        if (abs(c) > abs(peak)) {
+            peak = c;
+            phase = off;
+            mode = m;
+        }
+    }
+    printf("  PRN %s, code phase %u chips, preamble correlation %d/%d\n",
+           mode ? "self-test" : "normal", phase, peak, PREAMBLE_WORDS * DESPREAD_WORD_CHIPS);
+    if (phase + PRN_FRAME_CHIPS > total) {
+        fprintf(stderr, "  ⚠ Frame truncated at code phase %u\n", phase);
+        goto out;
+    }
+
+    // Dump integrity: the clean chips, aligned, against the detected PRN
+    uint8_t channel_bits[2][PRN_FRAME_BITS];
+    uint32_t dump_errors = 0;
+    for (int ch = 0; ch < 2; ch++) {
+        despread_pack_i8(dump + ch, 2, PRN_FRAME_CHIPS, packed[ch]);
+        dump_errors += despread_bits(packed[ch], 0, despread_prn_words(mode, ch),
+                                     PRN_FRAME_BITS, channel_bits[ch], NULL);
+    }
+
+    uint8_t tx[2 * PRN_FRAME_BITS];
+    for (int b = 0; b < PRN_FRAME_BITS; b++) {
+        tx[2 * b] = channel_bits[0][b];
+        tx[2 * b + 1] = channel_bits[1][b];
+    }
+    printf("  Chip errors: %u/%u\n", dump_errors, 2 * PRN_FRAME_CHIPS);
+
+    // Soft decisions on the noisy chips at the acquired code phase
+    int bit_errors = 0;
+    if (opt->soft) {
+        for (int ch = 0; ch < 2; ch++) {
+            uint8_t soft_bits[PRN_FRAME_BITS];
+            despread_bits_i8(&chips[ch][phase], prn_get_frame_table(mode, ch),
+                             PRN_FRAME_BITS, soft_bits, NULL);
+            for (int b = 0; b < PRN_FRAME_BITS; b++) {
+                bit_errors += soft_bits[b] != channel_bits[ch][b];
+            }
+        }
+        printf("  Soft despreading: %d/%d bit errors\n", bit_errors, 2 * PRN_FRAME_BITS);
+    }
+
+    int preamble_errors = 0;
+    for (int b = 0; b < PREAMBLE_BITS; b++) {
+        preamble_errors += tx[b];
+    }
+
+    const uint8_t *msg = &tx[PREAMBLE_BITS];
+    int layout = bch_layout(msg);
+
+    printf("  Preamble bit errors: %d/%d\n", preamble_errors, PREAMBLE_BITS);
+    printf("  Message: ");
+    print_hex(msg, T018_DATA_BITS);
+    if (layout) {
+        printf("  ✓ BCH valid (%s layout)\n", layout == 1 ? "T.018" : "2-bit header");
+    } else {
+        // Test patterns (generate_test_frame) carry no parity
+        printf("  BCH parity does not match (test pattern?)\n");
+    }
+
+    if (dump_errors == 0 && preamble_errors == 0 && bit_errors == 0) {
+        status = 0;
+    } else {
+        printf("  ⚠ Dump does not match a clean T.018 spreading\n");
+    }
+
+out:
+    free(dump);
+    free(chips[0]);
+    free(chips[1]);
+    free(packed[0]);
+    free(packed[1]);
+    return status;
+}
+
+// =============================================================================
+// BENCHMARK
+// =============================================================================
+
+static void benchmark(void) {
+    const int8_t *prn = prn_get_frame_table(0, 0);
+    const uint64_t *words = despread_prn_words(0, 0);
+    float *prn_f = malloc(PRN_FRAME_CHIPS * sizeof(float));
+    float *rx_f = malloc((PRN_FRAME_CHIPS + PRN_CHIPS_PER_BIT) * sizeof(float));
+    int8_t *rx_i8 = malloc(PRN_FRAME_CHIPS + PRN_CHIPS_PER_BIT);
+    uint64_t *rx_w = calloc(despread_words(PRN_FRAME_CHIPS + PRN_CHIPS_PER_BIT) + 1,
+                            sizeof(uint64_t));
+    if (!prn_f || !rx_f || !rx_i8 || !rx_w) {
+        fprintf(stderr, "Failed to allocate benchmark buffers\n");
+        goto out;
+    }
+
+    // Received frame: random bits, a few flipped chips, offset by one bit
+    for (int i = 0; i < PRN_FRAME_CHIPS + PRN_CHIPS_PER_BIT; i++) {
+        int8_t c = (i < PRN_CHIPS_PER_BIT) ? 1 : prn[i - PRN_CHIPS_PER_BIT];
+        if (rand() % 50 == 0) c = -c;
+        rx_i8[i] = c * (int8_t)SOFT_AMPLITUDE;
+        rx_f[i] = c;
+    }
+    for (int i = 0; i < PRN_FRAME_CHIPS; i++) {
+        prn_f[i] = prn[i];
+    }
+    despread_pack_i8(rx_i8, 1, PRN_FRAME_CHIPS + PRN_CHIPS_PER_BIT, rx_w);
+
+    printf("Despreading 150 bits (38400 chips), %d iterations:\n", BENCH_ITERATIONS);
+    volatile int32_t sink = 0;
+    uint8_t bits[PRN_FRAME_BITS];
+
+    double t0 = now_sec();
+    for (int it = 0; it < BENCH_ITERATIONS; it++) {
+        for (int b = 0; b < PRN_FRAME_BITS; b++) {
+            float acc = 0.0f;
+            const float *x = &rx_f[PRN_CHIPS_PER_BIT + b * PRN_CHIPS_PER_BIT];
+            for (int k = 0; k < PRN_CHIPS_PER_BIT; k++) {
+                acc += x[k] * prn_f[b * PRN_CHIPS_PER_BIT + k];
+            }
+            bits[b] = acc < 0.0f;
+        }
+        sink += bits[it % PRN_FRAME_BITS];
+    }
+    double t_float = (now_sec() - t0) / BENCH_ITERATIONS;
+
+    t0 = now_sec();
+    for (int it = 0; it < BENCH_ITERATIONS; it++) {
+        despread_bits_i8(&rx_i8[PRN_CHIPS_PER_BIT], prn, PRN_FRAME_BITS, bits, NULL);
+        sink += bits[it % PRN_FRAME_BITS];
+    }
+    double t_i8 = (now_sec() - t0) / BENCH_ITERATIONS;
+
+    t0 = now_sec();
+    for (int it = 0; it < BENCH_ITERATIONS; it++) {
+        sink += despread_bits(rx_w, PRN_CHIPS_PER_BIT, words, PRN_FRAME_BITS, bits, NULL);
+    }
+    double t_xor = (now_sec() - t0) / BENCH_ITERATIONS;
+
+    printf("  float MAC:    %8.1f µs\n", t_float * 1e6);
+    printf("  int8 dot:     %8.1f µs  (%.1fx)\n", t_i8 * 1e6, t_float / t_i8);
+    printf("  XOR/popcount: %8.1f µs  (%.1fx)\n", t_xor * 1e6, t_float / t_xor);
+
+    // Code-phase search: 6400-chip preamble window over 257 offsets
+    printf("Code-phase search (6400-chip window, 257 offsets):\n");
+    t0 = now_sec();
+    for (int it = 0; it < BENCH_ITERATIONS / 20; it++) {
+        float best = 0.0f;
+        for (int off = 0; off <= PRN_CHIPS_PER_BIT; off++) {
+            float acc = 0.0f;
+            for (int k = 0; k < PREAMBLE_WORDS * DESPREAD_WORD_CHIPS; k++) {
+                acc += rx_f[off + k] * prn_f[k];
+            }
+            if (fabsf(acc) > best) best = fabsf(acc);
+        }
+        sink += (int32_t)best;
+    }
+    double s_float = (now_sec() - t0) / (BENCH_ITERATIONS / 20);
+
+    t0 = now_sec();
+    uint32_t off = 0;
+    for (int it = 0; it < BENCH_ITERATIONS / 20; it++) {
+        sink += despread_search(rx_w, PRN_FRAME_CHIPS + PRN_CHIPS_PER_BIT, words,
+                                PREAMBLE_WORDS, PRN_CHIPS_PER_BIT, &off);
+    }
+    double s_xor = (now_sec() - t0) / (BENCH_ITERATIONS / 20);
+
+    printf("  float MAC:    %8.1f µs\n", s_float * 1e6);
+    printf("  XOR/popcount: %8.1f µs  (%.1fx, peak at %u)\n", s_xor * 1e6, s_float / s_xor, off);
+
+out:
+    free(prn_f);
+    free(rx_f);
+    free(rx_i8);
+    free(rx_w);
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options] [dump.bin ...]\n\n", prog);
+    printf("Verifies chips dumps (default: chips_after_spreading.bin)\n\n");
+    printf("Options:\n");
+    printf("  -o <chips>   Prepend random chips (exercise the code-phase search)\n");
+    printf("  -n <snr_db>  Soft int8 despreading with Gaussian noise at this chip SNR\n");
+    printf("  -b           Benchmark float, int8 and XOR correlation\n");
+    printf("  -h           Show this help\n");
+}
+
+int main(int argc, char *argv[]) {
+    options_t opt = { 0 };
+    int c;
+
+    while ((c = getopt(argc, argv, "o:n:bh")) != -1) {
+        switch (c) {
+            case 'o':
+                opt.offset = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                opt.soft = 1;
+                opt.snr_db = strtof(optarg, NULL);
+                break;
+            case 'b':
+                opt.bench = 1;
+                break;
+            case 'h':
+                usage(argv[0]);
+                return 0;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    srand(1);
+    if (opt.bench) {
+        benchmark();
+        return 0;
+    }
+
+    int failed = 0;
+    int count = 0;
+    if (optind >= argc) {
+        failed += verify_dump("chips_after_spreading.bin", &opt) < 0;
+        count++;
+    }
+    for (int i = optind; i < argc; i++, count++) {
+        failed += verify_dump(argv[i], &opt) < 0;
+    }
+
+    printf("\n%s %d/%d dumps verified\n", failed ? "⚠" : "✓", count - failed, count);
+    return failed ? 1 : 0;
+}